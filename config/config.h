@@ -82,6 +82,23 @@ extern "C" {
  */
 #define DEBUG_BUFFER_SIZE      256
 
+/**
+ * @def DEBUG_RECORD_MAX_PAYLOAD
+ * @brief Maximum payload size of a binary record in bytes.
+ */
+#define DEBUG_RECORD_MAX_PAYLOAD 256
+
+/**
+ * @def DEBUG_PANIC_SPIN_LIMIT
+ * @brief Upper bound on busy-wait iterations per poll in panic mode.
+ *
+ * @note
+ * Bounds the time a polled transport may wait for a single byte or
+ * transfer once debug_panic_enter() has been called, so fault handlers
+ * cannot hang on a dead link.
+ */
+#define DEBUG_PANIC_SPIN_LIMIT 100000
+
 /*******************************************************************************
  * Platform / OS Selection
  *******************************************************************************/
@@ -100,9 +117,15 @@ extern "C" {
  */
 #define DEBUG_USE_FREERTOS     NO
 
+/**
+ * @def DEBUG_USE_POSIX
+ * @brief Enable debug support for Linux host simulation builds.
+ */
+#define DEBUG_USE_POSIX        NO
+
 /* Compile-time guard for mutual exclusivity */
-#if (DEBUG_USE_BAREMETAL == YES && DEBUG_USE_FREERTOS == YES)
-#error "Only one execution environment can be selected (Baremetal OR FreeRTOS)."
+#if ((DEBUG_USE_BAREMETAL + DEBUG_USE_FREERTOS + DEBUG_USE_POSIX) > 1)
+#error "Only one execution environment can be selected (Baremetal, FreeRTOS OR POSIX)."
 #endif
 
 /*******************************************************************************
@@ -121,9 +144,204 @@ extern "C" {
  */
 #define DEBUG_USE_UART         NO
 
+/**
+ * @def DEBUG_USE_STDIO
+ * @brief Enable standard output as the debug transport (host builds).
+ */
+#define DEBUG_USE_STDIO        NO
+
+/**
+ * @def DEBUG_USE_RAM_BUFFER
+ * @brief Enable the RAM ring buffer transport.
+ *
+ * @note Mostly useful as the last link of a failover chain.
+ */
+#define DEBUG_USE_RAM_BUFFER   NO
+
+/**
+ * @def DEBUG_RAM_BUFFER_SIZE
+ * @brief Size of the RAM ring buffer transport in bytes.
+ */
+#define DEBUG_RAM_BUFFER_SIZE  2048
+
+/**
+ * @def DEBUG_USE_FILE
+ * @brief Enable the buffered file transport (host builds, needs DEBUG_USE_POSIX).
+ */
+#define DEBUG_USE_FILE         NO
+
+/** @name File transport durability levels */
+/** @{ */
+#define DEBUG_FILE_SYNC_NONE      0   /**< Never fdatasync */
+#define DEBUG_FILE_SYNC_INTERVAL  1   /**< fdatasync at most every DEBUG_FILE_SYNC_MS */
+#define DEBUG_FILE_SYNC_BUFFER    2   /**< fdatasync after every buffer */
+#define DEBUG_FILE_SYNC_RECORD    3   /**< Every write waits for fdatasync */
+/** @} */
+
+/**
+ * @def DEBUG_FILE_PATH
+ * @brief Output file of the file transport; rotated files get .1, .2, ...
+ */
+#define DEBUG_FILE_PATH             "debug.log"
+
+/**
+ * @def DEBUG_FILE_BUFFER_SIZE
+ * @brief Size of each file transport buffer in bytes.
+ */
+#define DEBUG_FILE_BUFFER_SIZE      (1024UL * 1024UL)
+
+/**
+ * @def DEBUG_FILE_BUFFER_COUNT
+ * @brief Number of file transport buffers; writers block when all are queued.
+ */
+#define DEBUG_FILE_BUFFER_COUNT     4
+
+/**
+ * @def DEBUG_FILE_FLUSH_MS
+ * @brief Maximum age of a partially filled buffer before it is written.
+ */
+#define DEBUG_FILE_FLUSH_MS         200
+
+/**
+ * @def DEBUG_FILE_DURABILITY
+ * @brief fdatasync policy, one of the DEBUG_FILE_SYNC_* levels.
+ */
+#define DEBUG_FILE_DURABILITY       DEBUG_FILE_SYNC_INTERVAL
+
+/**
+ * @def DEBUG_FILE_SYNC_MS
+ * @brief Sync interval for DEBUG_FILE_SYNC_INTERVAL.
+ */
+#define DEBUG_FILE_SYNC_MS          1000
+
+/**
+ * @def DEBUG_FILE_ROTATE_BYTES
+ * @brief Rotate the file before it grows past this size (0 = never).
+ */
+#define DEBUG_FILE_ROTATE_BYTES     (256ULL * 1024ULL * 1024ULL)
+
+/**
+ * @def DEBUG_FILE_ROTATE_SECONDS
+ * @brief Rotate the file after this many seconds (0 = never).
+ */
+#define DEBUG_FILE_ROTATE_SECONDS   0
+
+/**
+ * @def DEBUG_FILE_ROTATE_KEEP
+ * @brief Number of rotated files kept (0 = truncate in place).
+ */
+#define DEBUG_FILE_ROTATE_KEEP      8
+
+/**
+ * @def DEBUG_USE_FLASH
+ * @brief Enable the persistent flash log transport.
+ *
+ * @note The flash device is set with debug_transport_flash_set_device().
+ */
+#define DEBUG_USE_FLASH        NO
+
+/**
+ * @def DEBUG_FLASH_MAX_SECTORS
+ * @brief Maximum number of sectors in the flash log area.
+ */
+#define DEBUG_FLASH_MAX_SECTORS     64
+
+/**
+ * @def DEBUG_FLASH_PAGE_SIZE_MAX
+ * @brief Largest supported flash page (program batch) in bytes.
+ */
+#define DEBUG_FLASH_PAGE_SIZE_MAX   256
+
+/**
+ * @def DEBUG_FLASH_SPARE_SECTORS
+ * @brief Number of sectors debug_service() keeps erased ahead of the writer.
+ */
+#define DEBUG_FLASH_SPARE_SECTORS   1
+
+/**
+ * @def DEBUG_USB_CDC_TX_BUFFER_SIZE
+ * @brief Size of the USB CDC transmit staging buffer in bytes.
+ *
+ * @note Must hold a full text line (DEBUG_BUFFER_SIZE) and a full record
+ * frame (DEBUG_RECORD_HEADER_SIZE + DEBUG_RECORD_MAX_PAYLOAD +
+ * DEBUG_RECORD_TRAILER_SIZE, see debug_record.h): a larger write is
+ * rejected.
+ */
+#define DEBUG_USB_CDC_TX_FRAME_SIZE   (DEBUG_RECORD_HEADER_SIZE + DEBUG_RECORD_MAX_PAYLOAD + \
+                                       DEBUG_RECORD_TRAILER_SIZE)
+#define DEBUG_USB_CDC_TX_BUFFER_SIZE  ((DEBUG_USB_CDC_TX_FRAME_SIZE > DEBUG_BUFFER_SIZE) ? \
+                                       DEBUG_USB_CDC_TX_FRAME_SIZE : DEBUG_BUFFER_SIZE)
+
+/**
+ * @def DEBUG_USE_TRANSPORT_FAILOVER
+ * @brief Combine all enabled transports into a failover chain.
+ *
+ * @note
+ * - Output goes to the first ready link in the order USB CDC, UART,
+ *   flash, RAM.
+ * - When enabled, more than one transport may be selected above.
+ */
+#define DEBUG_USE_TRANSPORT_FAILOVER  NO
+
+/**
+ * @def DEBUG_FAILOVER_MAX_LINKS
+ * @brief Maximum number of links in the failover chain.
+ */
+#define DEBUG_FAILOVER_MAX_LINKS      4
+
+/**
+ * @def DEBUG_FAILOVER_BUSY_RETRIES
+ * @brief Write attempts on a ready but busy link before the record is
+ *        queued in the RAM ring (or dropped when there is none).
+ *
+ * @note
+ * - A busy link never moves output to the next link; only a link that
+ *   reports not ready does.
+ */
+#define DEBUG_FAILOVER_BUSY_RETRIES   DEBUG_PANIC_SPIN_LIMIT
+
+/**
+ * @def DEBUG_USE_TRANSPORT_MUX
+ * @brief Carry several channels (logs, telemetry, trace, ...) over the
+ *        selected transport.
+ *
+ * @note
+ * - The debug core writes to channel 0; other producers use
+ *   debug_transport_mux_write().
+ * - The link is the transport selected above, or the failover chain.
+ */
+#define DEBUG_USE_TRANSPORT_MUX       NO
+
+/**
+ * @def DEBUG_MUX_CHANNELS
+ * @brief Number of multiplexer channels (at most 128).
+ */
+#define DEBUG_MUX_CHANNELS            4
+
+/**
+ * @def DEBUG_MUX_POOL_SIZE
+ * @brief Bytes shared out as channel buffers (equal shares by default).
+ */
+#define DEBUG_MUX_POOL_SIZE           2048
+
+/**
+ * @def DEBUG_MUX_FRAME_MAX
+ * @brief Largest channel payload per frame on the link.
+ *
+ * @note Smaller frames interleave channels more finely; each frame costs
+ *       7 bytes of framing.
+ */
+#define DEBUG_MUX_FRAME_MAX           128
+
 /* Compile-time guard for transport exclusivity */
-#if (DEBUG_USE_USB_CDC == YES && DEBUG_USE_UART == YES)
-#error "Select only one debug transport (USB CDC OR UART)."
+#if (DEBUG_USE_TRANSPORT_FAILOVER == NO) && \
+    ((DEBUG_USE_USB_CDC + DEBUG_USE_UART + DEBUG_USE_RAM_BUFFER + \
+      DEBUG_USE_STDIO + DEBUG_USE_FLASH + DEBUG_USE_FILE) > 1)
+#error "Select only one debug transport (USB CDC, UART, RAM, STDIO, FLASH OR FILE), or enable DEBUG_USE_TRANSPORT_FAILOVER."
+#endif
+
+#if (DEBUG_USE_FILE == YES) && (DEBUG_USE_POSIX == NO)
+#error "DEBUG_USE_FILE requires DEBUG_USE_POSIX."
 #endif
 
 /*******************************************************************************
@@ -154,6 +372,450 @@ extern "C" {
  */
 #define DEBUG_ENABLE_MODULE_LOG       NO
 
+/**
+ * @def DEBUG_ENABLE_THREAD_LEVELS
+ * @brief Allow log level overrides per thread (task or ISR).
+ *
+ * @note
+ * See debug_set_thread_level(). While no override is set, the level
+ * check costs what it does without this option.
+ */
+#define DEBUG_ENABLE_THREAD_LEVELS    NO
+
+/**
+ * @def DEBUG_THREAD_LEVELS
+ * @brief Number of threads that can have their own log level.
+ */
+#define DEBUG_THREAD_LEVELS           8
+
+/**
+ * @def DEBUG_ENABLE_COMPACT_PREFIX
+ * @brief Send text lines with a compact prefix.
+ *
+ * @note
+ * "[00042][123456][SensorTask][DEBUG] " becomes "D1f4.3 ": the level
+ * letter, the timestamp delta to the previous line in hex and a thread
+ * ID (announced once by a "#T3 SensorTask" line). Every
+ * DEBUG_COMPACT_KEYFRAME lines, and whenever the deltas do not hold, a
+ * line goes out with the full prefix. debug_decode and log_ingest
+ * restore the full prefix.
+ */
+#define DEBUG_ENABLE_COMPACT_PREFIX   NO
+
+/**
+ * @def DEBUG_COMPACT_KEYFRAME
+ * @brief Compact lines between two lines with the full prefix.
+ */
+#define DEBUG_COMPACT_KEYFRAME        64
+
+/**
+ * @def DEBUG_COMPACT_THREADS
+ * @brief Number of thread IDs of the compact prefix (1..36).
+ */
+#define DEBUG_COMPACT_THREADS         16
+
+/**
+ * @def DEBUG_WIRE_TEXT
+ * @brief Wire format: every log line is sent as text.
+ */
+#define DEBUG_WIRE_TEXT               0
+
+/**
+ * @def DEBUG_WIRE_INTERNED
+ * @brief Wire format: binary log records with interned strings.
+ *
+ * @note
+ * Format strings and thread names are sent once as dictionary records
+ * and then referred to by ID; arguments travel in binary. The host
+ * tools (debug_decode, log_ingest) rebuild the text lines.
+ */
+#define DEBUG_WIRE_INTERNED           1
+
+/**
+ * @def DEBUG_WIRE_FORMAT
+ * @brief Wire format of log lines (DEBUG_WIRE_TEXT or DEBUG_WIRE_INTERNED).
+ */
+#define DEBUG_WIRE_FORMAT             DEBUG_WIRE_TEXT
+
+/**
+ * @def DEBUG_INTERN_SLOTS
+ * @brief Number of interned strings (power of two, at most 65536).
+ *
+ * @note
+ * Twelve bytes each on 32-bit targets. Lines whose strings do not fit
+ * are sent as text.
+ */
+#define DEBUG_INTERN_SLOTS            256
+
+/*******************************************************************************
+ * Timing and Backtraces
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_CYCLES_HZ
+ * @brief Frequency of the port get_cycles() counter.
+ *
+ * @note
+ * CPU clock for the DWT counter on Cortex-M; 1000000000 for the POSIX
+ * port, which counts nanoseconds.
+ */
+#define DEBUG_CYCLES_HZ               168000000UL
+
+/**
+ * @def DEBUG_TICK_HZ
+ * @brief Rate of the port get_timestamp() tick.
+ *
+ * @note
+ * configTICK_RATE_HZ for FreeRTOS; 1000 for the POSIX port.
+ */
+#define DEBUG_TICK_HZ                 1000UL
+
+/**
+ * @def DEBUG_ENABLE_SCOPE_STATS
+ * @brief Keep count/min/max/total per LOG_TIME_SCOPE() call site.
+ *
+ * @note
+ * Adds 40 bytes of RAM per call site and a few instructions per exit.
+ * The statistics travel in the slow-block records and in
+ * debug_scope_report().
+ */
+#define DEBUG_ENABLE_SCOPE_STATS      YES
+
+/**
+ * @def DEBUG_ENABLE_SYNC
+ * @brief Emit clock sync beacons and answer host pings.
+ *
+ * @note
+ * Beacons and pongs are sent from debug_service(). Pings are only seen
+ * on transports that implement read().
+ */
+#define DEBUG_ENABLE_SYNC             NO
+
+/**
+ * @def DEBUG_SYNC_INTERVAL_MS
+ * @brief Period of the clock sync beacon.
+ */
+#define DEBUG_SYNC_INTERVAL_MS        1000UL
+
+/**
+ * @def DEBUG_ENABLE_BACKTRACE
+ * @brief Attach a raw return-address backtrace record to LOG_ERROR lines.
+ */
+#define DEBUG_ENABLE_BACKTRACE        NO
+
+/**
+ * @def DEBUG_BACKTRACE_DEPTH
+ * @brief Maximum number of return addresses per backtrace record.
+ */
+#define DEBUG_BACKTRACE_DEPTH         8
+
+/**
+ * @def DEBUG_BACKTRACE_SCAN_WORDS
+ * @brief Maximum number of stack words inspected by the Cortex-M scanner.
+ *
+ * @note Bounds the capture cost; each word costs a few cycles.
+ */
+#define DEBUG_BACKTRACE_SCAN_WORDS    256
+
+/**
+ * @def DEBUG_CODE_START
+ * @brief Start address of the code region (flash).
+ */
+#define DEBUG_CODE_START              0x08000000UL
+
+/**
+ * @def DEBUG_CODE_END
+ * @brief End address (exclusive) of the code region (flash).
+ */
+#define DEBUG_CODE_END                0x08100000UL
+
+/*******************************************************************************
+ * Log Governor
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_GOVERNOR
+ * @brief Lower the effective log level automatically under load.
+ *
+ * @note
+ * Every DEBUG_GOVERNOR_WINDOW_MS the core checks the transport backlog,
+ * rejected writes, the offered byte rate and the cycles spent in
+ * debug_log(). Under pressure the effective level drops one step (never
+ * below LOG_ERROR, so errors are never shed); after
+ * DEBUG_GOVERNOR_CALM_WINDOWS quiet windows it rises one step, up to the
+ * level set with debug_set_level(). Each change is reported with a
+ * DEBUG_RECORD_GOVERNOR record.
+ */
+#define DEBUG_ENABLE_GOVERNOR         NO
+
+/**
+ * @def DEBUG_GOVERNOR_WINDOW_MS
+ * @brief Length of a measurement window.
+ */
+#define DEBUG_GOVERNOR_WINDOW_MS      100UL
+
+/**
+ * @def DEBUG_GOVERNOR_FILL_HIGH
+ * @brief Transport backlog (percent) that counts as pressure.
+ *
+ * @note Only for transports that implement fill().
+ */
+#define DEBUG_GOVERNOR_FILL_HIGH      75
+
+/**
+ * @def DEBUG_GOVERNOR_FILL_LOW
+ * @brief Transport backlog (percent) below which a window counts as calm.
+ */
+#define DEBUG_GOVERNOR_FILL_LOW       25
+
+/**
+ * @def DEBUG_GOVERNOR_BYTES_PER_S
+ * @brief Byte rate the link sustains; more offered counts as pressure.
+ *
+ * @note 0 disables the check (e.g. for transports that report fill()).
+ */
+#define DEBUG_GOVERNOR_BYTES_PER_S    0UL
+
+/**
+ * @def DEBUG_GOVERNOR_CPU_PERMILLE
+ * @brief Share of the CPU (per mille) debug_log() may use.
+ *
+ * @note 0 disables the check. Needs a port with get_cycles().
+ */
+#define DEBUG_GOVERNOR_CPU_PERMILLE   50UL
+
+/**
+ * @def DEBUG_GOVERNOR_CALM_WINDOWS
+ * @brief Consecutive calm windows before the level is raised one step.
+ */
+#define DEBUG_GOVERNOR_CALM_WINDOWS   10
+
+/*******************************************************************************
+ * Task Statistics (FreeRTOS)
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_TASK_STATS
+ * @brief Build the FreeRTOS run-time statistics collector
+ *        (port/freertos/debug_freertos_stats.c).
+ *
+ * @note
+ * Needs configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS. Each
+ * sample sends one DEBUG_RECORD_TASK_STATS record per task.
+ */
+#define DEBUG_ENABLE_TASK_STATS       NO
+
+/**
+ * @def DEBUG_TASK_STATS_MAX_TASKS
+ * @brief Largest number of tasks the collector can sample.
+ *
+ * @note Costs about 40 bytes of RAM per task.
+ */
+#define DEBUG_TASK_STATS_MAX_TASKS    16
+
+/**
+ * @def DEBUG_TASK_STATS_PERIOD_MS
+ * @brief Sampling period of debug_freertos_stats_task().
+ */
+#define DEBUG_TASK_STATS_PERIOD_MS    1000UL
+
+/*******************************************************************************
+ * Kernel Trace (FreeRTOS)
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_KERNEL_TRACE
+ * @brief Build the FreeRTOS kernel trace hooks
+ *        (port/freertos/debug_freertos_trace.c).
+ *
+ * @note
+ * Also include debug_freertos_trace.h at the end of FreeRTOSConfig.h.
+ * Needs configUSE_TRACE_FACILITY and an ARMv7-M or later core (lock-free
+ * ring built on LDREX/STREX).
+ */
+#define DEBUG_ENABLE_KERNEL_TRACE     NO
+
+/**
+ * @def DEBUG_KTRACE_EVENTS
+ * @brief Capacity of the kernel event ring in events (power of two).
+ *
+ * @note Each event takes 16 bytes. Events are dropped, and counted, while
+ *       the ring is full.
+ */
+#define DEBUG_KTRACE_EVENTS           512
+
+/**
+ * @def DEBUG_KTRACE_PERIOD_MS
+ * @brief Drain period of debug_ktrace_task().
+ */
+#define DEBUG_KTRACE_PERIOD_MS        10UL
+
+/*******************************************************************************
+ * Heap Trace
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_HEAP_TRACE
+ * @brief Build the heap allocation tracer (core/debug_heap.c).
+ *
+ * @note
+ * Hooked through traceMALLOC/traceFREE on FreeRTOS (debug_freertos_trace.h
+ * in FreeRTOSConfig.h) and through -Wl,--wrap=malloc,... on the POSIX
+ * port (port/posix/debug_heap_wrap.c). Call debug_heap_drain() regularly.
+ */
+#define DEBUG_ENABLE_HEAP_TRACE       NO
+
+/**
+ * @def DEBUG_HEAP_EVENTS
+ * @brief Capacity of the heap event ring in events (power of two).
+ *
+ * @note About 20 bytes per event on a 32-bit target. Events are dropped,
+ *       and counted, while the ring is full.
+ */
+#define DEBUG_HEAP_EVENTS             128
+
+/**
+ * @def DEBUG_HEAP_THREADS
+ * @brief Number of distinct threads whose names are sent with the events.
+ */
+#define DEBUG_HEAP_THREADS            16
+
+/*******************************************************************************
+ * Variable Watch
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_WATCH
+ * @brief Build the variable watch (core/debug_watch.c).
+ *
+ * @note
+ * Call debug_watch_sample() at a fixed rate (timer ISR or periodic hook)
+ * and debug_watch_flush() from a task or the main loop.
+ */
+#define DEBUG_ENABLE_WATCH            NO
+
+/**
+ * @def DEBUG_WATCH_MAX_VARS
+ * @brief Maximum number of watched variables (1..16, and at most 14 with
+ *        the default DEBUG_RECORD_MAX_PAYLOAD).
+ */
+#define DEBUG_WATCH_MAX_VARS          8
+
+/**
+ * @def DEBUG_WATCH_FRAMES
+ * @brief Capacity of the sample ring in frames (power of two).
+ *
+ * @note Holds the samples taken between two debug_watch_flush() calls;
+ *       samples are dropped, and counted, while it is full.
+ */
+#define DEBUG_WATCH_FRAMES            32
+
+/**
+ * @def DEBUG_WATCH_DEF_PERIOD
+ * @brief Re-send the variable table every N frame records.
+ *
+ * @note Lets a host that attaches late decode the stream. 0 sends it only
+ *       when the table changes.
+ */
+#define DEBUG_WATCH_DEF_PERIOD        64
+
+/*******************************************************************************
+ * Function Profiler
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_PROF
+ * @brief Build the function entry/exit profiler (core/debug_prof.c).
+ *
+ * @note
+ * Implements the -finstrument-functions hooks. Compile the application
+ * with -finstrument-functions and the debug module without it (see
+ * core/debug_prof.h). Call debug_prof_drain() regularly.
+ */
+#define DEBUG_ENABLE_PROF             NO
+
+/**
+ * @def DEBUG_PROF_THREADS
+ * @brief Number of threads that get their own event buffer.
+ *
+ * @note Further threads are not recorded.
+ */
+#define DEBUG_PROF_THREADS            4
+
+/**
+ * @def DEBUG_PROF_EVENTS
+ * @brief Capacity of each thread's event buffer in events (power of two).
+ *
+ * @note 8 bytes per event. Events are dropped, and counted, while the
+ *       buffer is full.
+ */
+#define DEBUG_PROF_EVENTS             512
+
+/*******************************************************************************
+ * PC Sampling Profiler
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_SAMPLE
+ * @brief Build the statistical PC-sampling profiler (core/debug_sample.c).
+ *
+ * @note
+ * A periodic timer interrupt records the interrupted PC and thread: the
+ * POSIX port uses a SIGPROF timer, on Cortex-M install
+ * DEBUG_PORT_SAMPLE_HANDLER (port/cortex_m/debug_port_sample.h) on SysTick
+ * or a spare timer. Call debug_sample_drain() regularly.
+ */
+#define DEBUG_ENABLE_SAMPLE           NO
+
+/**
+ * @def DEBUG_SAMPLE_EVENTS
+ * @brief Capacity of the sample ring in samples (power of two).
+ *
+ * @note 8 bytes per sample on a 32-bit target. Samples are dropped, and
+ *       counted, while the ring is full.
+ */
+#define DEBUG_SAMPLE_EVENTS           256
+
+/**
+ * @def DEBUG_SAMPLE_THREADS
+ * @brief Number of distinct threads whose names are sent with the samples.
+ */
+#define DEBUG_SAMPLE_THREADS          16
+
+/*******************************************************************************
+ * Fault Handling
+ *******************************************************************************/
+
+/**
+ * @def DEBUG_ENABLE_FAULT_HANDLER
+ * @brief Build the Cortex-M fault capture hook (port/cortex_m).
+ */
+#define DEBUG_ENABLE_FAULT_HANDLER    NO
+
+/**
+ * @def DEBUG_CRASH_STACK_WORDS
+ * @brief Number of stack words copied into a crash record.
+ *
+ * @note Clamped so the record fits in DEBUG_RECORD_MAX_PAYLOAD.
+ */
+#define DEBUG_CRASH_STACK_WORDS       32
+
+/**
+ * @def DEBUG_CRASH_STACK_TOP_SYMBOL
+ * @brief Linker symbol marking the top of the stack/RAM region.
+ *
+ * @note The stack slice of a crash record never reads past this address.
+ */
+#define DEBUG_CRASH_STACK_TOP_SYMBOL  _estack
+
+/**
+ * @def DEBUG_FAULT_RESET
+ * @brief Reset the system after a crash record has been emitted.
+ *
+ * @note Set to @ref NO to halt instead, e.g. to attach a debugger.
+ */
+#define DEBUG_FAULT_RESET             YES
+
 /*******************************************************************************
  * Vendor Selection
  *******************************************************************************/
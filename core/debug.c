@@ -39,8 +39,12 @@
 
 #include "config.h"
 #include "debug.h"
+#include "debug_record.h"
 #include "debug_transport.h"
 #include "debug_port.h"
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+#include "debug_intern.h"
+#endif
 
 /*******************************************************************************
  * Private Macros
@@ -48,169 +52,2078 @@
 
 /* Add private macros here if needed */
 
-/*******************************************************************************
- * Private Types
- *******************************************************************************/
+/** @brief Extra frames captured to cover the logger's own frames */
+#define DEBUG_BACKTRACE_SLACK   4U
+
+/** @brief Sync beacon period in port ticks */
+#define DEBUG_SYNC_INTERVAL_TICKS \
+    ((uint32_t)((DEBUG_SYNC_INTERVAL_MS * DEBUG_TICK_HZ) / 1000UL))
+
+/** @brief Governor window in port ticks (at least one) */
+#define DEBUG_GOVERNOR_WINDOW_TICKS \
+    ((uint32_t)(((DEBUG_GOVERNOR_WINDOW_MS * DEBUG_TICK_HZ) / 1000UL) + \
+                ((((DEBUG_GOVERNOR_WINDOW_MS * DEBUG_TICK_HZ) / 1000UL) == 0UL) ? 1UL : 0UL)))
+
+/** @brief Return address into the caller, for backtraces */
+#if DEBUG_ENABLE_BACKTRACE == YES
+#define DEBUG_CALLER()          ((uintptr_t)__builtin_return_address(0))
+#else
+#define DEBUG_CALLER()          ((uintptr_t)0)
+#endif
+
+/** @brief Longest text of one LOG_ARRAY() element ("%g" or 64-bit) */
+#define DEBUG_ARRAY_TEXT_MAX    24U
+
+/** @brief Size of a framed ping record */
+#define DEBUG_PING_FRAME_SIZE   (DEBUG_RECORD_HEADER_SIZE + \
+                                 sizeof(debug_ping_record_t) + \
+                                 DEBUG_RECORD_TRAILER_SIZE)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/**
+ * @brief Debug runtime context structure.
+ */
+typedef struct
+{
+    const debug_transport_hal_t *transport;   /**< Active transport HAL */
+    const debug_port_t          *debug_port;  /**< OS/platform port */
+    log_level_t                  level;       /**< Current log level */
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+    volatile uint8_t             level_min;   /**< Least verbose of global and overrides */
+    volatile uint8_t             level_max;   /**< Most verbose of global and overrides */
+#endif
+    uint8_t                      initialized; /**< Initialization state */
+    volatile uint8_t             panic;       /**< Panic (polled, lock-free) mode */
+    uint32_t                     service_refs;/**< debug_service() calls in flight */
+    const debug_transport_hal_t *retired;     /**< Swapped-out transport awaiting deinit */
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+    uint8_t                      link_up;     /**< Last is_ready() result */
+#endif
+#if DEBUG_ENABLE_SYNC == YES
+    volatile uint8_t             sync_due;    /**< Send a beacon on the next service */
+    uint32_t                     sync_last;   /**< Timestamp of the last beacon */
+#endif
+#if DEBUG_ENABLE_GOVERNOR == YES
+    log_level_t                  gov_level;   /**< Governor cap, LOG_DEBUG = inactive */
+    uint8_t                      gov_calm;    /**< Consecutive calm windows */
+    uint32_t                     gov_start;   /**< Timestamp the window started */
+    uint32_t                     gov_offered; /**< Bytes handed to the transport */
+    uint32_t                     gov_dropped; /**< Bytes the transport rejected */
+    uint32_t                     gov_cycles;  /**< Cycles spent in debug_log() (atomic) */
+    volatile uint32_t            gov_shed;    /**< Lines shed since the last record */
+#endif
+} debug_context_t;
+
+/**
+ * @brief Metadata of one log entry.
+ */
+typedef struct
+{
+    uint32_t    seq;                          /**< Sequence number */
+    uint32_t    ts;                           /**< Timestamp */
+    const char *thread;                       /**< Thread name */
+#if DEBUG_ENABLE_GOVERNOR == YES
+    uint32_t    gov_start;                    /**< Cycles at entry */
+#endif
+} debug_meta_t;
+
+#if DEBUG_ENABLE_COMPACT_PREFIX == YES
+/**
+ * @brief State of the compact prefix, guarded by the lock.
+ */
+typedef struct
+{
+    uint32_t    seq;                          /**< Sequence number of the last line */
+    uint32_t    ts;                           /**< Timestamp of the last line */
+    uint32_t    left;                         /**< Compact lines until a keyframe */
+    uint32_t    next;                         /**< Thread ID to reuse next */
+    const char *thread[DEBUG_COMPACT_THREADS];/**< Name pointer of each ID */
+    uint8_t     told[DEBUG_COMPACT_THREADS];  /**< ID announced since the keyframe */
+} debug_compact_t;
+#endif
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+/**
+ * @brief Log level override of one thread.
+ */
+typedef struct
+{
+    volatile uint8_t used;                    /**< Entry holds an override */
+    volatile uint8_t level;                   /**< log_level_t */
+    char             name[DEBUG_RECORD_NAME_LEN];
+} debug_thread_level_t;
+#endif
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Generate the next log sequence number (thread-safe via port layer).
+ *
+ * @return Next sequence number
+ */
+static uint32_t debug_next_sequence(void);
+
+/**
+ * @brief Acquire the port lock (skipped in panic mode).
+ */
+static void debug_lock(void);
+
+/**
+ * @brief Release the port lock (skipped in panic mode).
+ */
+static void debug_unlock(void);
+
+/**
+ * @brief Send bytes to the active transport (caller holds the lock).
+ *
+ * @param[in] data Data to send
+ * @param[in] len  Number of bytes
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int debug_emit(const uint8_t *data, size_t len);
+
+/**
+ * @brief Flush and deinitialize a transport that is no longer published.
+ *
+ * @param[in] old Transport swapped out by debug_set_transport()
+ */
+static void debug_transport_retire(const debug_transport_hal_t *old);
+
+/**
+ * @brief Frame and send a binary record (caller holds the lock).
+ *
+ * @param[in] type    Record type
+ * @param[in] payload Record payload
+ * @param[in] len     Payload length, at most DEBUG_RECORD_MAX_PAYLOAD
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int debug_emit_record(uint8_t type, const void *payload, size_t len);
+
+/**
+ * @brief Frame and send a record whose payload is already in s_record
+ *        (caller holds the lock).
+ *
+ * @param[in] type Record type
+ * @param[in] len  Payload length, at most DEBUG_RECORD_MAX_PAYLOAD
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int debug_emit_framed(uint8_t type, size_t len);
+
+/**
+ * @brief Format the "[seq][ts][thread][LEVEL] " prefix into s_buffer.
+ *
+ * @param[in] level  Log level
+ * @param[in] meta   Entry metadata
+ * @param[in] weight Sampling factor, 0 = not sampled
+ *
+ * @return Length of the prefix
+ */
+static size_t debug_format_prefix(log_level_t level, const debug_meta_t *meta,
+                                  uint32_t weight);
+
+#if DEBUG_ENABLE_COMPACT_PREFIX == YES
+/**
+ * @brief Format the compact "L<dt>.<id>[*N] " prefix into s_buffer,
+ *        after the announcement of a new thread ID if needed.
+ *
+ * @param[in] level  Log level
+ * @param[in] meta   Entry metadata
+ * @param[in] weight Sampling factor, 0 = not sampled
+ *
+ * @return Length written, 0 if the line needs the full prefix (keyframe)
+ */
+static size_t debug_format_compact(log_level_t level, const debug_meta_t *meta,
+                                   uint32_t weight);
+#endif
+
+/**
+ * @brief Take the metadata of a new log entry (level checked).
+ *
+ * @param[in]  level Log level
+ * @param[out] meta  Entry metadata
+ *
+ * @retval 0   Entry may go out
+ * @retval -1  Shed by the governor
+ */
+static int debug_log_meta(log_level_t level, debug_meta_t *meta);
+
+/**
+ * @brief Check a log call against the global and per-thread levels.
+ *
+ * @param[in] level Log level of the call
+ *
+ * @retval 0  The call goes on
+ * @retval 1  Filtered
+ */
+static inline int debug_level_filtered(log_level_t level);
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+/**
+ * @brief Level of the calling thread: its override or the global level.
+ */
+static log_level_t debug_thread_level(void);
+
+/**
+ * @brief Recompute level_min and level_max (caller holds the lock).
+ */
+static void debug_level_bounds(void);
+
+/**
+ * @brief Override entry of a thread name (caller holds the lock).
+ *
+ * @return Entry, or NULL if none
+ */
+static debug_thread_level_t *debug_thread_level_find(const char *thread);
+#endif
+
+/**
+ * @brief Print one array element as text.
+ *
+ * @param[out] out  Destination, at least DEBUG_ARRAY_TEXT_MAX bytes
+ * @param[in]  type Element type (DEBUG_ARRAY_xxx)
+ * @param[in]  p    Element
+ *
+ * @return Number of characters (no NUL)
+ */
+static size_t debug_array_format(char *out, uint8_t type, const uint8_t *p);
+
+/**
+ * @brief Send an array as text lines.
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int debug_log_array_text(log_level_t level, const debug_meta_t *meta,
+                                uint8_t type, const char *name,
+                                const uint8_t *data, size_t count);
+
+/**
+ * @brief Format and send a log line as text.
+ *
+ * @param[in] level  Log level
+ * @param[in] meta   Entry metadata
+ * @param[in] weight Sampling factor, 0 = not sampled
+ * @param[in] fmt    Format string
+ * @param[in] args   Arguments
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int debug_log_text(log_level_t level, const debug_meta_t *meta,
+                          uint32_t weight, const char *fmt, va_list args);
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+/**
+ * @brief Send a log line as an interned record, defining new strings first.
+ *
+ * @param[out] sent Transport result (bytes written, or -1 on error)
+ *
+ * @retval 0   Line sent (or attempted) as a record
+ * @retval -1  Line must go out as text (table full, string or arguments
+ *             too long)
+ */
+static int debug_log_interned(log_level_t level, const debug_meta_t *meta,
+                              uint32_t weight, const char *fmt, va_list args,
+                              int *sent);
+
+/**
+ * @brief Redefine every string if the link has come up since the last
+ *        check: it may be a new host (caller holds the lock).
+ */
+static void debug_intern_link_check(void);
+
+/**
+ * @brief Send the definition of an interned string (caller holds the lock).
+ *
+ * @param[in] text String
+ * @param[in] id   Wire ID
+ * @param[in] kind DEBUG_DICT_xxx
+ *
+ * @return 0 if sent, -1 if the transport rejected it (the ID is forgotten)
+ */
+static int debug_emit_dict(const char *text, uint16_t id, uint8_t kind);
+
+/**
+ * @brief Send an array as DEBUG_RECORD_ARRAY records.
+ *
+ * @param[out] sent Transport result (bytes written, or -1 on error)
+ *
+ * @retval 0   Array sent (or attempted) as records
+ * @retval -1  Array must go out as text (table full)
+ */
+static int debug_log_array_interned(log_level_t level, const debug_meta_t *meta,
+                                    uint8_t type, const char *name,
+                                    const uint8_t *data, size_t count, int *sent);
+#endif
+
+/**
+ * @brief Common part of debug_log() and debug_log_sampled() (level checked).
+ *
+ * @param[in] level  Log level
+ * @param[in] weight Sampling factor, 0 = not sampled
+ * @param[in] caller Return address into the call site (backtraces)
+ * @param[in] fmt    Format string
+ * @param[in] args   Arguments
+ *
+ * @return Number of bytes written, or 0 if shed by the governor
+ */
+static int debug_vlog(log_level_t level, uint32_t weight, uintptr_t caller,
+                      const char *fmt, va_list args);
+
+#if DEBUG_ENABLE_BACKTRACE == YES
+/**
+ * @brief Capture the call chain and send it as a backtrace record.
+ *
+ * @param[in] seq    Sequence number of the log line
+ * @param[in] caller Return address into the LOG_ERROR call site
+ */
+static void debug_emit_backtrace(uint32_t seq, uintptr_t caller);
+#endif
+
+#if DEBUG_ENABLE_SYNC == YES
+/**
+ * @brief Read the timestamp and cycle counter back to back.
+ *
+ * @param[out] ts     Port timestamp
+ * @param[out] cycles Cycle counter, 0 if the port has none
+ */
+static void debug_sync_sample(uint32_t *ts, uint32_t *cycles);
+
+/**
+ * @brief Poll the transport for pings and send the periodic beacon.
+ *
+ * @param[in] transport Transport referenced by debug_service()
+ *
+ * @return Number of records sent
+ */
+static int debug_sync_service(const debug_transport_hal_t *transport);
+#endif
+
+#if DEBUG_ENABLE_GOVERNOR == YES
+/**
+ * @brief Get the governor cap, closing the measurement window if it ran out.
+ *
+ * @return Most verbose level the governor currently lets through
+ */
+static log_level_t debug_governor_level(void);
+
+/**
+ * @brief Evaluate the finished window and adjust the cap (caller holds the lock).
+ *
+ * @param[in] now Current timestamp
+ */
+static void debug_governor_window(uint32_t now);
+
+/**
+ * @brief Add the cycles of one debug_log() call to the window.
+ *
+ * @param[in] start Cycle counter at entry
+ */
+static void debug_governor_account(uint32_t start);
+#endif
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/** @brief Global debug context */
+static debug_context_t debug_ctx = {0};
+
+/** @brief Global log sequence number */
+static uint32_t log_sequence_no = 0;
+
+/** @brief LOG_SAMPLED_RANDOM() PRNG state, never 0 (see debug_log_rand_next()) */
+static uint32_t debug_log_rand_state = 0x9E3779B9UL;
+
+/** @brief Internal buffer for formatted messages */
+static char s_buffer[DEBUG_BUFFER_SIZE];
+
+/** @brief Bytes per element of each DEBUG_ARRAY_xxx type (0 = invalid) */
+static const uint8_t s_array_size[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8, 8, 8 };
+
+/** @brief Internal buffer for framing binary records */
+static uint8_t s_record[DEBUG_RECORD_HEADER_SIZE + DEBUG_RECORD_MAX_PAYLOAD +
+                        DEBUG_RECORD_TRAILER_SIZE];
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+/** @brief Internal buffer for log record payloads */
+static uint8_t s_wire[DEBUG_RECORD_MAX_PAYLOAD];
+
+/** @brief Internal buffer for dictionary record payloads */
+static uint8_t s_dict[DEBUG_RECORD_MAX_PAYLOAD];
+#endif
+
+#if DEBUG_ENABLE_SYNC == YES
+/** @brief Ping frame being received */
+static uint8_t s_ping[DEBUG_PING_FRAME_SIZE];
+
+/** @brief Bytes collected in s_ping */
+static size_t s_ping_len = 0;
+#endif
+
+#if DEBUG_ENABLE_COMPACT_PREFIX == YES
+#if (DEBUG_COMPACT_THREADS < 1) || (DEBUG_COMPACT_THREADS > 36)
+#error "DEBUG_COMPACT_THREADS must be 1..36."
+#endif
+
+/** @brief Compact prefix state, zeroed: the first line is a keyframe */
+static debug_compact_t s_compact;
+#endif
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+/** @brief Per-thread level overrides */
+static debug_thread_level_t s_thread_level[DEBUG_THREAD_LEVELS];
+#endif
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void debug_lock(void)
+{
+    if ((0U == debug_ctx.panic) &&
+        (NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->lock))
+    {
+        debug_ctx.debug_port->ops->lock();
+    }
+}
+
+static void debug_unlock(void)
+{
+    if ((0U == debug_ctx.panic) &&
+        (NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->unlock))
+    {
+        debug_ctx.debug_port->ops->unlock();
+    }
+}
+
+static void debug_transport_retire(const debug_transport_hal_t *old)
+{
+    /* Push out what the old transport still buffers (RAM ring, flash page) */
+    if (NULL != old->ops->flush)
+    {
+        (void)old->ops->flush();
+    }
+
+    if (NULL != old->ops->deinit)
+    {
+        (void)old->ops->deinit();
+    }
+}
+
+static int debug_emit(const uint8_t *data, size_t len)
+{
+    /* Sample the transport once, under the lock (see debug_set_transport) */
+    const debug_transport_hal_t *transport = debug_ctx.transport;
+
+    if (NULL == transport)
+    {
+        return -1;
+    }
+
+    int (*write)(const uint8_t *, size_t) = transport->ops->write;
+
+    if ((0U != debug_ctx.panic) && (NULL != transport->ops->write_polled))
+    {
+        write = transport->ops->write_polled;
+    }
+
+    if (NULL == write)
+    {
+        return -1;
+    }
+
+#if DEBUG_ENABLE_GOVERNOR == YES
+    int ret = write(data, len);
+
+    debug_ctx.gov_offered += (uint32_t)len;
+    if ((size_t)((ret > 0) ? ret : 0) < len)
+    {
+        debug_ctx.gov_dropped += (uint32_t)(len - (size_t)((ret > 0) ? ret : 0));
+    }
+
+    return ret;
+#else
+    return write(data, len);
+#endif
+}
+
+static int debug_emit_record(uint8_t type, const void *payload, size_t len)
+{
+    if (0U != len)
+    {
+        memcpy(&s_record[DEBUG_RECORD_HEADER_SIZE], payload, len);
+    }
+
+    return debug_emit_framed(type, len);
+}
+
+static int debug_emit_framed(uint8_t type, size_t len)
+{
+    s_record[0] = DEBUG_RECORD_MARKER;
+    s_record[1] = type;
+    s_record[2] = (uint8_t)(len & 0xFFU);
+    s_record[3] = (uint8_t)(len >> 8);
+    s_record[DEBUG_RECORD_HEADER_SIZE + len] =
+        debug_record_crc8(0, &s_record[1], (DEBUG_RECORD_HEADER_SIZE - 1U) + len);
+
+    return debug_emit(s_record, DEBUG_RECORD_HEADER_SIZE + len +
+                                DEBUG_RECORD_TRAILER_SIZE);
+}
+
+#if DEBUG_ENABLE_COMPACT_PREFIX == YES
+static size_t debug_format_compact(log_level_t level, const debug_meta_t *meta,
+                                   uint32_t weight)
+{
+    uint32_t dt   = meta->ts - s_compact.ts;
+    int      full = (0U == s_compact.left) || ((uint32_t)level > (uint32_t)LOG_DEBUG);
+    uint32_t id   = 0;
+    size_t   n    = 0;
+
+#if DEBUG_ENABLE_SEQUENCE_NO == YES
+    full |= (meta->seq != (s_compact.seq + 1U));
+#endif
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+    full |= (meta->ts < s_compact.ts);
+#endif
+    s_compact.seq = meta->seq;
+    s_compact.ts  = meta->ts;
+
+    if (0 != full)
+    {
+        /* Keyframe: the host resyncs and the IDs are announced again */
+        memset(s_compact.told, 0, sizeof(s_compact.told));
+        s_compact.left = DEBUG_COMPACT_KEYFRAME;
+        return 0;
+    }
+    s_compact.left--;
+
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    while ((id < DEBUG_COMPACT_THREADS) && (s_compact.thread[id] != meta->thread))
+    {
+        id++;
+    }
+    if (id == DEBUG_COMPACT_THREADS)
+    {
+        /* Unknown thread: take the next ID in turn (dead threads age out) */
+        id                    = s_compact.next;
+        s_compact.next        = (id + 1U) % DEBUG_COMPACT_THREADS;
+        s_compact.thread[id]  = meta->thread;
+        s_compact.told[id]    = 0;
+    }
+    if (0U == s_compact.told[id])
+    {
+        int h = snprintf(s_buffer, sizeof(s_buffer) / 2U, "#T%c %s\r\n",
+                         digits[id], meta->thread);
+
+        n = (h > 0) ? (((size_t)h < (sizeof(s_buffer) / 2U)) ? (size_t)h :
+                       ((sizeof(s_buffer) / 2U) - 1U)) : 0U;
+        s_compact.told[id] = 1U;
+    }
+#endif
+
+    s_buffer[n++] = "EWID"[level];
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+    n += (size_t)snprintf(&s_buffer[n], sizeof(s_buffer) - n, "%lx", (unsigned long)dt);
+#else
+    (void)dt;
+#endif
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    s_buffer[n++] = '.';
+    s_buffer[n++] = digits[id];
+#else
+    (void)id;
+#endif
+    if (0U != weight)
+    {
+        n += (size_t)snprintf(&s_buffer[n], sizeof(s_buffer) - n, "*%lu",
+                              (unsigned long)weight);
+    }
+    s_buffer[n++] = ' ';
+    s_buffer[n]   = '\0';
+
+    return n;
+}
+#endif /* DEBUG_ENABLE_COMPACT_PREFIX */
+
+static size_t debug_format_prefix(log_level_t level, const debug_meta_t *meta,
+                                  uint32_t weight)
+{
+#if DEBUG_ENABLE_COMPACT_PREFIX == YES
+    size_t compact = debug_format_compact(level, meta, weight);
+
+    if (0U != compact)
+    {
+        return compact;
+    }
+#endif
+
+    const char *level_str = "LOG";
+    if (level == LOG_ERROR) level_str = "ERROR";
+    else if (level == LOG_WARN)  level_str = "WARN";
+    else if (level == LOG_INFO)  level_str = "INFO";
+    else if (level == LOG_DEBUG) level_str = "DEBUG";
+
+    size_t n = 0;
+
+    (void)meta;
+
+#if DEBUG_ENABLE_SEQUENCE_NO == YES
+    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%05lu]", (unsigned long)meta->seq);
+#endif
+
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%lu]", (unsigned long)meta->ts);
+#endif
+
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%s]", meta->thread);
+#endif
+
+    if (0U != weight)
+    {
+        n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%s][1/%lu] ",
+                      level_str, (unsigned long)weight);
+    }
+    else
+    {
+        n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%s] ", level_str);
+    }
+
+    return (n < sizeof(s_buffer)) ? n : (sizeof(s_buffer) - 1U);
+}
+
+static int debug_log_text(log_level_t level, const debug_meta_t *meta,
+                          uint32_t weight, const char *fmt, va_list args)
+{
+    debug_lock();
+
+    /* Prefix and emit under one lock: the compact prefix is a delta */
+    size_t n = debug_format_prefix(level, meta, weight);
+
+    vsnprintf(&s_buffer[n], sizeof(s_buffer) - n, fmt, args);
+
+    strncat(s_buffer, "\r\n",
+            sizeof(s_buffer) - strlen(s_buffer) - 1);
+
+    int ret = debug_emit((const uint8_t *)s_buffer, strlen(s_buffer));
+
+    debug_unlock();
+
+    return ret;
+}
+
+static size_t debug_array_format(char *out, uint8_t type, const uint8_t *p)
+{
+    uint64_t v      = 0;
+    int64_t  sv     = 0;
+    uint8_t  is_int = 1U;   /* 2 = signed */
+    double   f      = 0.0;
+
+    switch (type)
+    {
+        case DEBUG_ARRAY_U8:  { uint8_t  x; memcpy(&x, p, sizeof(x)); v  = x; break; }
+        case DEBUG_ARRAY_I8:  { int8_t   x; memcpy(&x, p, sizeof(x)); sv = x; is_int = 2U; break; }
+        case DEBUG_ARRAY_U16: { uint16_t x; memcpy(&x, p, sizeof(x)); v  = x; break; }
+        case DEBUG_ARRAY_I16: { int16_t  x; memcpy(&x, p, sizeof(x)); sv = x; is_int = 2U; break; }
+        case DEBUG_ARRAY_U32: { uint32_t x; memcpy(&x, p, sizeof(x)); v  = x; break; }
+        case DEBUG_ARRAY_I32: { int32_t  x; memcpy(&x, p, sizeof(x)); sv = x; is_int = 2U; break; }
+        case DEBUG_ARRAY_U64: { uint64_t x; memcpy(&x, p, sizeof(x)); v  = x; break; }
+        case DEBUG_ARRAY_I64: { int64_t  x; memcpy(&x, p, sizeof(x)); sv = x; is_int = 2U; break; }
+        case DEBUG_ARRAY_F32: { float    x; memcpy(&x, p, sizeof(x)); f  = x; is_int = 0U; break; }
+        case DEBUG_ARRAY_F64: { double   x; memcpy(&x, p, sizeof(x)); f  = x; is_int = 0U; break; }
+        default:
+            return 0;
+    }
+
+    if (0U == is_int)
+    {
+        int n = snprintf(out, DEBUG_ARRAY_TEXT_MAX, "%g", f);
+
+        return (n > 0) ? (size_t)n : 0U;
+    }
+
+    size_t n = 0;
+
+    if (2U == is_int)
+    {
+        if (sv < 0)
+        {
+            out[n++] = '-';
+            v = 0U - (uint64_t)sv;
+        }
+        else
+        {
+            v = (uint64_t)sv;
+        }
+    }
+
+    /* Digits backwards; 32-bit division once the value fits */
+    char     digits[20];
+    size_t   d = 0;
+    uint32_t w;
+
+    while (v > 0xFFFFFFFFULL)
+    {
+        digits[d++] = (char)('0' + (char)(v % 10U));
+        v /= 10U;
+    }
+    w = (uint32_t)v;
+    do
+    {
+        digits[d++] = (char)('0' + (char)(w % 10U));
+        w /= 10U;
+    } while (0U != w);
+
+    while (d > 0U)
+    {
+        out[n++] = digits[--d];
+    }
+
+    return n;
+}
+
+static int debug_log_array_text(log_level_t level, const debug_meta_t *meta,
+                                uint8_t type, const char *name,
+                                const uint8_t *data, size_t count)
+{
+    const size_t size  = s_array_size[type];
+    int          total = 0;
+    size_t       i     = 0;
+
+    debug_lock();
+
+    while (i < count)
+    {
+        /* "name[i]:" then as many elements as fit, at least one; a
+         * continuation repeats the prefix (a keyframe when compact) */
+        size_t n = debug_format_prefix(level, meta, 0U);
+        int    h = snprintf(&s_buffer[n], sizeof(s_buffer) - n, "%s[%lu]:",
+                            name, (unsigned long)i);
+
+        n += (h > 0) ? (size_t)h : 0U;
+        if (n > (sizeof(s_buffer) - 4U))
+        {
+            /* truncate the label so " x\r\n" still fits */
+            n = sizeof(s_buffer) - 4U;
+        }
+
+        size_t first = i;
+
+        while (i < count)
+        {
+            char   val[DEBUG_ARRAY_TEXT_MAX];
+            size_t len = debug_array_format(val, type, &data[i * size]);
+
+            if ((n + 1U + len + 2U) >= sizeof(s_buffer))
+            {
+                if (i != first)
+                {
+                    break;
+                }
+                len = sizeof(s_buffer) - n - 3U;
+            }
+            s_buffer[n++] = ' ';
+            memcpy(&s_buffer[n], val, len);
+            n += len;
+            i++;
+        }
+
+        s_buffer[n++] = '\r';
+        s_buffer[n++] = '\n';
+
+        int ret = debug_emit((const uint8_t *)s_buffer, n);
+
+        if (ret < 0)
+        {
+            total = -1;
+            break;
+        }
+        total += ret;
+    }
+
+    debug_unlock();
+
+    return total;
+}
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+static void debug_intern_link_check(void)
+{
+    const debug_transport_hal_t *transport = debug_ctx.transport;
+
+    if ((NULL != transport) && (NULL != transport->ops->is_ready))
+    {
+        uint8_t up = (0 != transport->ops->is_ready()) ? 1U : 0U;
+
+        if ((0U != up) && (0U == debug_ctx.link_up))
+        {
+            debug_intern_reset();
+        }
+        debug_ctx.link_up = up;
+    }
+}
+
+static int debug_emit_dict(const char *text, uint16_t id, uint8_t kind)
+{
+    debug_dict_record_t dict;
+    size_t              tlen = strlen(text);
+
+    dict.id       = id;
+    dict.kind     = kind;
+    dict.reserved = 0U;
+    memcpy(s_dict, &dict, sizeof(dict));
+    memcpy(&s_dict[sizeof(dict)], text, tlen);
+
+    if (debug_emit_record(DEBUG_RECORD_DICT, s_dict, sizeof(dict) + tlen) < 0)
+    {
+        debug_intern_forget(id);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int debug_log_interned(log_level_t level, const debug_meta_t *meta,
+                              uint32_t weight, const char *fmt, va_list args,
+                              int *sent)
+{
+    debug_log_record_t hdr;
+    const size_t max_text = DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_dict_record_t);
+    uint16_t fmt_id = 0;
+    uint16_t thread_id = 0;
+    int ret = -1;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.level = (uint8_t)level;
+
+    if (strlen(fmt) > max_text)
+    {
+        return -1;
+    }
+
+    debug_lock();
+
+    /* A link coming up may be a new host: define everything again */
+    debug_intern_link_check();
+
+    /* A sampled line carries its factor ahead of the arguments */
+    size_t pre = 0;
+
+    if (0U != weight)
+    {
+        pre = (size_t)debug_intern_put_varint(&s_wire[sizeof(hdr)],
+                                              sizeof(s_wire) - sizeof(hdr), weight);
+        hdr.flags |= DEBUG_LOG_HAS_WEIGHT;
+    }
+
+    int len = debug_intern_encode(&s_wire[sizeof(hdr) + pre],
+                                  sizeof(s_wire) - sizeof(hdr) - pre, fmt, args);
+
+    len = (len >= 0) ? (len + (int)pre) : len;
+    int def_fmt = (len >= 0) ? debug_intern_lookup(fmt, DEBUG_DICT_FORMAT, &fmt_id) : -1;
+    int def_thread = 0;
+
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    if ((def_fmt >= 0) && (strlen(meta->thread) <= max_text))
+    {
+        def_thread = debug_intern_lookup(meta->thread, DEBUG_DICT_THREAD, &thread_id);
+        hdr.flags |= DEBUG_LOG_HAS_THREAD;
+    }
+    else
+    {
+        def_thread = -1;
+    }
+#endif
+
+    if ((def_fmt > 0) && (def_thread < 0))
+    {
+        /* Falling back to text: the format is not defined on the link */
+        debug_intern_forget(fmt_id);
+    }
+
+    if ((def_fmt >= 0) && (def_thread >= 0))
+    {
+        ret = 0;
+
+        /* Definitions go out first; a record without them is useless */
+        if (((0 != def_fmt) &&
+             (0 != debug_emit_dict(fmt, fmt_id, DEBUG_DICT_FORMAT))) ||
+            ((0 != def_thread) &&
+             (0 != debug_emit_dict(meta->thread, thread_id, DEBUG_DICT_THREAD))))
+        {
+            if (0 != def_thread)
+            {
+                debug_intern_forget(thread_id);    /* May not have been tried */
+            }
+            *sent = -1;
+            debug_unlock();
+            return 0;
+        }
+
+#if DEBUG_ENABLE_SEQUENCE_NO == YES
+        hdr.flags |= DEBUG_LOG_HAS_SEQ;
+        hdr.seq    = meta->seq;
+#endif
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+        hdr.flags    |= DEBUG_LOG_HAS_TS;
+        hdr.timestamp = meta->ts;
+#endif
+        hdr.fmt_id    = fmt_id;
+        hdr.thread_id = thread_id;
+        memcpy(s_wire, &hdr, sizeof(hdr));
+        *sent = debug_emit_record(DEBUG_RECORD_LOG, s_wire, sizeof(hdr) + (size_t)len);
+    }
+
+    debug_unlock();
+
+    return ret;
+}
+
+static int debug_log_array_interned(log_level_t level, const debug_meta_t *meta,
+                                    uint8_t type, const char *name,
+                                    const uint8_t *data, size_t count, int *sent)
+{
+    debug_array_record_t hdr;
+    const size_t max_text = DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_dict_record_t);
+    const size_t size     = s_array_size[type];
+    const size_t per      = (DEBUG_RECORD_MAX_PAYLOAD - sizeof(hdr)) / size;
+    uint16_t name_id   = 0;
+    uint16_t thread_id = 0;
+
+    memset(&hdr, 0, sizeof(hdr));
+
+    if (strlen(name) > max_text)
+    {
+        return -1;
+    }
+
+    debug_lock();
+
+    debug_intern_link_check();
+
+    int def_name   = debug_intern_lookup(name, DEBUG_DICT_FORMAT, &name_id);
+    int def_thread = 0;
+
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    if ((def_name >= 0) && (strlen(meta->thread) <= max_text))
+    {
+        def_thread = debug_intern_lookup(meta->thread, DEBUG_DICT_THREAD, &thread_id);
+        hdr.flags |= DEBUG_LOG_HAS_THREAD;
+    }
+    else
+    {
+        def_thread = -1;
+    }
+#endif
+
+    if ((def_name < 0) || (def_thread < 0))
+    {
+        if (def_name > 0)
+        {
+            /* Falling back to text: the name is not defined on the link */
+            debug_intern_forget(name_id);
+        }
+        debug_unlock();
+        return -1;
+    }
+
+    /* Definitions go out first; a record without them is useless */
+    if (((0 != def_name) &&
+         (0 != debug_emit_dict(name, name_id, DEBUG_DICT_FORMAT))) ||
+        ((0 != def_thread) &&
+         (0 != debug_emit_dict(meta->thread, thread_id, DEBUG_DICT_THREAD))))
+    {
+        if (0 != def_thread)
+        {
+            debug_intern_forget(thread_id);        /* May not have been tried */
+        }
+        *sent = -1;
+        debug_unlock();
+        return 0;
+    }
+
+    hdr.version = DEBUG_ARRAY_VERSION;
+    hdr.level   = (uint8_t)level;
+    hdr.type    = type;
+#if DEBUG_ENABLE_SEQUENCE_NO == YES
+    hdr.flags |= DEBUG_LOG_HAS_SEQ;
+    hdr.seq    = meta->seq;
+#endif
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+    hdr.flags    |= DEBUG_LOG_HAS_TS;
+    hdr.timestamp = meta->ts;
+#endif
+    hdr.name_id   = name_id;
+    hdr.thread_id = thread_id;
+    hdr.total     = (uint16_t)count;
+
+    /* Elements are copied once, straight into the frame */
+    uint8_t *payload = &s_record[DEBUG_RECORD_HEADER_SIZE];
+    int      total   = 0;
+
+    for (size_t i = 0; i < count; i += per)
+    {
+        size_t n = ((count - i) < per) ? (count - i) : per;
+
+        hdr.index = (uint16_t)i;
+        memcpy(payload, &hdr, sizeof(hdr));
+        memcpy(&payload[sizeof(hdr)], &data[i * size], n * size);
+
+        int ret = debug_emit_framed(DEBUG_RECORD_ARRAY, sizeof(hdr) + (n * size));
+
+        if (ret < 0)
+        {
+            total = -1;
+            break;
+        }
+        total += ret;
+    }
+    *sent = total;
+
+    debug_unlock();
+
+    return 0;
+}
+#endif
+
+static uint32_t debug_next_sequence(void)
+{
+    uint32_t seq;
+
+    debug_lock();
+    seq = ++log_sequence_no;
+    debug_unlock();
+
+    return seq;
+}
+
+#if DEBUG_ENABLE_BACKTRACE == YES
+static void debug_emit_backtrace(uint32_t seq, uintptr_t caller)
+{
+    const debug_port_ops_t *ops = debug_ctx.debug_port->ops;
+
+    if (NULL == ops->get_backtrace)
+    {
+        return;
+    }
+
+    uintptr_t raw[DEBUG_BACKTRACE_DEPTH + DEBUG_BACKTRACE_SLACK];
+    uint8_t payload[sizeof(debug_backtrace_record_t) +
+                    (DEBUG_BACKTRACE_DEPTH * sizeof(uintptr_t))];
+
+    uint32_t start = (NULL != ops->get_cycles) ? ops->get_cycles() : 0U;
+    size_t count = ops->get_backtrace(raw, sizeof(raw) / sizeof(raw[0]));
+    uint32_t stop = (NULL != ops->get_cycles) ? ops->get_cycles() : 0U;
+
+    /* Frames up to the call site belong to the logger itself */
+    size_t first = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((raw[i] | 1U) == (caller | 1U))
+        {
+            first = i + 1U;
+            break;
+        }
+    }
+
+    uintptr_t addrs[DEBUG_BACKTRACE_DEPTH];
+    size_t depth = 0;
+
+    addrs[depth++] = caller;
+    for (size_t i = first; (i < count) && (depth < DEBUG_BACKTRACE_DEPTH); i++)
+    {
+        addrs[depth++] = raw[i];
+    }
+
+    debug_backtrace_record_t hdr;
+    hdr.seq       = seq;
+    hdr.cycles    = stop - start;
+    hdr.addr_size = (uint8_t)sizeof(uintptr_t);
+    hdr.depth     = (uint8_t)depth;
+    hdr.reserved  = 0U;
+
+    memcpy(payload, &hdr, sizeof(hdr));
+    memcpy(&payload[sizeof(hdr)], addrs, depth * sizeof(uintptr_t));
+
+    (void)debug_write_record(DEBUG_RECORD_BACKTRACE, payload,
+                             sizeof(debug_backtrace_record_t) +
+                             (depth * sizeof(uintptr_t)));
+}
+#endif
+
+#if DEBUG_ENABLE_SYNC == YES
+static void debug_sync_sample(uint32_t *ts, uint32_t *cycles)
+{
+    const debug_port_ops_t *ops = debug_ctx.debug_port->ops;
+
+    *cycles = (NULL != ops->get_cycles) ? ops->get_cycles() : 0U;
+    *ts     = (NULL != ops->get_timestamp) ? ops->get_timestamp() : 0U;
+}
+
+static int debug_sync_service(const debug_transport_hal_t *transport)
+{
+    int sent = 0;
+
+    if ((NULL != transport) && (NULL != transport->ops->read))
+    {
+        uint8_t chunk[16];
+        int     n;
+
+        while ((n = transport->ops->read(chunk, sizeof(chunk))) > 0)
+        {
+            uint32_t rx_ts;
+            uint32_t rx_cycles;
+
+            /* Stamp as early as possible; the wait in the transport counts as link delay */
+            debug_sync_sample(&rx_ts, &rx_cycles);
+
+            for (int i = 0; i < n; i++)
+            {
+                uint8_t b = chunk[i];
+
+                /* Resynchronize on anything that is not a ping header */
+                if (((0U == s_ping_len) && (DEBUG_RECORD_MARKER != b)) ||
+                    ((1U == s_ping_len) && (DEBUG_RECORD_PING != b)) ||
+                    ((2U == s_ping_len) && (sizeof(debug_ping_record_t) != b)) ||
+                    ((3U == s_ping_len) && (0U != b)))
+                {
+                    s_ping_len = (DEBUG_RECORD_MARKER == b) ? 1U : 0U;
+                    continue;
+                }
+
+                s_ping[s_ping_len++] = b;
+                if (s_ping_len < sizeof(s_ping))
+                {
+                    continue;
+                }
+                s_ping_len = 0;
+
+                if (s_ping[sizeof(s_ping) - 1U] !=
+                    debug_record_crc8(0, &s_ping[1], sizeof(s_ping) - 2U))
+                {
+                    continue;
+                }
+
+                debug_ping_record_t ping;
+                debug_pong_record_t pong;
+                uint32_t            tx_ts;
+                uint32_t            tx_cycles;
+
+                memcpy(&ping, &s_ping[DEBUG_RECORD_HEADER_SIZE], sizeof(ping));
+                debug_sync_sample(&tx_ts, &tx_cycles);
+                pong.id           = ping.id;
+                pong.host_time    = ping.host_time;
+                pong.rx_timestamp = rx_ts;
+                pong.rx_cycles    = rx_cycles;
+                pong.tx_timestamp = tx_ts;
+                pong.tx_cycles    = tx_cycles;
+
+                if (debug_write_record(DEBUG_RECORD_PONG, &pong, sizeof(pong)) > 0)
+                {
+                    sent++;
+                }
+            }
+        }
+    }
+
+    uint32_t now = debug_timestamp();
+
+    if ((0U != debug_ctx.sync_due) ||
+        ((uint32_t)(now - debug_ctx.sync_last) >= DEBUG_SYNC_INTERVAL_TICKS))
+    {
+        if (debug_sync() > 0)
+        {
+            sent++;
+        }
+    }
+
+    return sent;
+}
+#endif
+
+#if DEBUG_ENABLE_GOVERNOR == YES
+static log_level_t debug_governor_level(void)
+{
+    if (0U != debug_ctx.panic)
+    {
+        return LOG_DEBUG;       /* Everything goes out in panic mode */
+    }
+
+    uint32_t now = debug_timestamp();
+
+    if ((uint32_t)(now - debug_ctx.gov_start) >= DEBUG_GOVERNOR_WINDOW_TICKS)
+    {
+        debug_lock();
+        /* Another caller may have closed the window meanwhile */
+        if ((uint32_t)(now - debug_ctx.gov_start) >= DEBUG_GOVERNOR_WINDOW_TICKS)
+        {
+            debug_governor_window(now);
+        }
+        debug_unlock();
+    }
+
+    return debug_ctx.gov_level;
+}
+
+static void debug_governor_window(uint32_t now)
+{
+    const debug_transport_hal_t *transport = debug_ctx.transport;
+    const debug_port_ops_t      *ops       = debug_ctx.debug_port->ops;
+    uint32_t                     elapsed   = now - debug_ctx.gov_start;
+    int                          fill      = -1;
+    uint32_t                     cpu       = 0;
+    uint32_t                     cycles    = __atomic_exchange_n(&debug_ctx.gov_cycles, 0U,
+                                                                 __ATOMIC_RELAXED);
+    uint8_t                      reasons   = 0;
+
+    if ((NULL != transport) && (NULL != transport->ops->fill))
+    {
+        fill = transport->ops->fill();
+    }
+    if (fill >= DEBUG_GOVERNOR_FILL_HIGH)
+    {
+        reasons |= DEBUG_GOVERNOR_FILL;
+    }
+    if (0U != debug_ctx.gov_dropped)
+    {
+        reasons |= DEBUG_GOVERNOR_DROP;
+    }
+#if DEBUG_GOVERNOR_BYTES_PER_S > 0
+    if (((uint64_t)debug_ctx.gov_offered * DEBUG_TICK_HZ) >
+        ((uint64_t)DEBUG_GOVERNOR_BYTES_PER_S * elapsed))
+    {
+        reasons |= DEBUG_GOVERNOR_RATE;
+    }
+#endif
+    if (NULL != ops->get_cycles)
+    {
+        cpu = (uint32_t)(((uint64_t)cycles * 1000U * DEBUG_TICK_HZ) /
+                         ((uint64_t)elapsed * DEBUG_CYCLES_HZ));
+#if DEBUG_GOVERNOR_CPU_PERMILLE > 0
+        if (cpu > DEBUG_GOVERNOR_CPU_PERMILLE)
+        {
+            reasons |= DEBUG_GOVERNOR_CPU;
+        }
+#endif
+    }
+
+    log_level_t base   = debug_ctx.level;
+    log_level_t before = (debug_ctx.gov_level < base) ? debug_ctx.gov_level : base;
+
+    if (0U != reasons)
+    {
+        /* Shed one more level, but never errors */
+        debug_ctx.gov_calm = 0;
+        if (before > LOG_ERROR)
+        {
+            debug_ctx.gov_level = (log_level_t)(before - 1);
+        }
+    }
+    else if ((fill <= DEBUG_GOVERNOR_FILL_LOW) && (debug_ctx.gov_level < base))
+    {
+        /* Hysteresis: come back one level per DEBUG_GOVERNOR_CALM_WINDOWS */
+        if (++debug_ctx.gov_calm >= DEBUG_GOVERNOR_CALM_WINDOWS)
+        {
+            debug_ctx.gov_calm  = 0;
+            debug_ctx.gov_level = (log_level_t)(debug_ctx.gov_level + 1);
+            if (debug_ctx.gov_level >= base)
+            {
+                debug_ctx.gov_level = LOG_DEBUG;
+            }
+        }
+    }
+    else
+    {
+        debug_ctx.gov_calm = 0;
+    }
+
+    log_level_t after = (debug_ctx.gov_level < base) ? debug_ctx.gov_level : base;
+
+    if (after != before)
+    {
+        debug_governor_record_t rec;
+
+        rec.version      = DEBUG_GOVERNOR_VERSION;
+        rec.level        = (uint8_t)after;
+        rec.base         = (uint8_t)base;
+        rec.reasons      = reasons;
+        rec.timestamp    = now;
+        rec.window       = elapsed;
+        rec.offered      = debug_ctx.gov_offered;
+        rec.dropped      = debug_ctx.gov_dropped;
+        rec.shed         = debug_ctx.gov_shed;
+        rec.cpu_permille = (uint16_t)((cpu > 0xFFFFU) ? 0xFFFFU : cpu);
+        rec.fill         = (uint8_t)((fill < 0) ? 0xFFU : (unsigned)fill);
+        rec.reserved     = 0U;
+
+        debug_ctx.gov_shed = 0;
+        (void)debug_emit_record(DEBUG_RECORD_GOVERNOR, &rec, sizeof(rec));
+    }
+
+    debug_ctx.gov_start   = now;
+    debug_ctx.gov_offered = 0;
+    debug_ctx.gov_dropped = 0;
+}
+
+static void debug_governor_account(uint32_t start)
+{
+    const debug_port_ops_t *ops = debug_ctx.debug_port->ops;
+
+    if (NULL != ops->get_cycles)
+    {
+        uint32_t spent = ops->get_cycles() - start;
+
+        /* An atomic add, not a second lock round trip on every line */
+        (void)__atomic_fetch_add(&debug_ctx.gov_cycles, spent, __ATOMIC_RELAXED);
+    }
+}
+#endif
+
+static inline int debug_level_filtered(log_level_t level)
+{
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+    /* Only levels between the least and the most verbose setting depend
+     * on the thread; without overrides both bounds are the global level */
+    if (level <= (log_level_t)debug_ctx.level_min)
+    {
+        return 0;
+    }
+    if (level > (log_level_t)debug_ctx.level_max)
+    {
+        return 1;
+    }
+
+    return (level > debug_thread_level()) ? 1 : 0;
+#else
+    return (level > debug_ctx.level) ? 1 : 0;
+#endif
+}
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+static log_level_t debug_thread_level(void)
+{
+    const char *name = debug_thread_name();
+
+    if (NULL == name)
+    {
+        return debug_ctx.level;
+    }
+
+    for (uint32_t i = 0; i < DEBUG_THREAD_LEVELS; i++)
+    {
+        debug_thread_level_t *e = &s_thread_level[i];
+
+        if (0U == e->used)
+        {
+            continue;
+        }
+
+        /* Matched by name only: a name buffer (POSIX TLS, FreeRTOS TCB)
+         * is reused by the next thread, so its address proves nothing */
+        if (0 == strncmp(e->name, name, sizeof(e->name) - 1U))
+        {
+            return (log_level_t)e->level;
+        }
+    }
+
+    return debug_ctx.level;
+}
+
+static void debug_level_bounds(void)
+{
+    uint8_t lo = (uint8_t)debug_ctx.level;
+    uint8_t hi = (uint8_t)debug_ctx.level;
+
+    for (uint32_t i = 0; i < DEBUG_THREAD_LEVELS; i++)
+    {
+        if (0U != s_thread_level[i].used)
+        {
+            lo = (s_thread_level[i].level < lo) ? s_thread_level[i].level : lo;
+            hi = (s_thread_level[i].level > hi) ? s_thread_level[i].level : hi;
+        }
+    }
+
+    debug_ctx.level_min = lo;
+    debug_ctx.level_max = hi;
+}
+
+static debug_thread_level_t *debug_thread_level_find(const char *thread)
+{
+    for (uint32_t i = 0; i < DEBUG_THREAD_LEVELS; i++)
+    {
+        if ((0U != s_thread_level[i].used) &&
+            (0 == strncmp(s_thread_level[i].name, thread,
+                          sizeof(s_thread_level[i].name) - 1U)))
+        {
+            return &s_thread_level[i];
+        }
+    }
+
+    return NULL;
+}
+#endif /* DEBUG_ENABLE_THREAD_LEVELS */
+
+static int debug_log_meta(log_level_t level, debug_meta_t *meta)
+{
+#if DEBUG_ENABLE_GOVERNOR == YES
+    if (level > debug_governor_level())
+    {
+        debug_ctx.gov_shed++;   /* Approximate: not worth a lock */
+        return -1;
+    }
+
+    meta->gov_start = (NULL != debug_ctx.debug_port->ops->get_cycles) ?
+                      debug_ctx.debug_port->ops->get_cycles() : 0U;
+#else
+    (void)level;
+#endif
+
+    meta->ts     = 0;
+    meta->seq    = 0;
+    meta->thread = "MAIN";
+
+#if DEBUG_ENABLE_TIME_DATE_INFO == YES
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->get_timestamp))
+    {
+        meta->ts = debug_ctx.debug_port->ops->get_timestamp();
+    }
+#endif
+
+#if DEBUG_ENABLE_THREAD_INFO == YES
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->get_thread_name))
+    {
+        meta->thread = debug_ctx.debug_port->ops->get_thread_name();
+    }
+#endif
+
+#if DEBUG_ENABLE_SEQUENCE_NO == YES
+    meta->seq = debug_next_sequence();
+#endif
+
+    return 0;
+}
+
+static int debug_vlog(log_level_t level, uint32_t weight, uintptr_t caller,
+                      const char *fmt, va_list args)
+{
+    debug_meta_t meta;
+
+    if (0 != debug_log_meta(level, &meta))
+    {
+        return 0;
+    }
+
+    int ret = -1;
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+    va_list copy;
+
+    va_copy(copy, args);
+    int interned = debug_log_interned(level, &meta, weight, fmt, copy, &ret);
+    va_end(copy);
+
+    if (0 != interned)
+#endif
+    {
+        ret = debug_log_text(level, &meta, weight, fmt, args);
+    }
+
+#if DEBUG_ENABLE_BACKTRACE == YES
+    if (LOG_ERROR == level)
+    {
+        debug_emit_backtrace(meta.seq, caller);
+    }
+#else
+    (void)caller;
+#endif
+
+#if DEBUG_ENABLE_GOVERNOR == YES
+    debug_governor_account(meta.gov_start);
+#endif
+
+    return ret;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the debug framework.
+ *
+ * @param[in] trns_hal   Pointer to transport HAL (UART, USB CDC, etc.)
+ * @param[in] debug_port Pointer to OS/platform port abstraction
+ *
+ * @return 0 on success, negative value on failure
+ */
+int debug_init(const debug_transport_hal_t *trns_hal,
+               const debug_port_t *debug_port)
+{
+    if ((NULL == trns_hal) || (NULL == debug_port))
+    {
+        return -1;
+    }
+
+    debug_ctx.transport   = trns_hal;
+    debug_ctx.debug_port  = debug_port;
+    debug_ctx.level       = LOG_DEBUG;
+    debug_ctx.initialized = 0;
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+    debug_level_bounds();
+#endif
+
+    if ((NULL == debug_ctx.transport->ops->init) ||
+        (NULL == debug_ctx.debug_port->ops->init))
+    {
+        return -1;
+    }
+
+    if (0 != debug_ctx.transport->ops->init())
+    {
+        return -8;
+    }
+
+    if (0 != debug_ctx.debug_port->ops->init())
+    {
+        return -8;
+    }
+
+#if DEBUG_ENABLE_SYNC == YES
+    debug_ctx.sync_due = 1;
+#endif
+
+#if DEBUG_ENABLE_GOVERNOR == YES
+    debug_ctx.gov_level = LOG_DEBUG;
+    debug_ctx.gov_calm  = 0;
+    debug_ctx.gov_start = debug_timestamp();
+#endif
+
+    debug_ctx.initialized = 1;
+    return 0;
+}
+
+/**
+ * @brief Set the current log level.
+ *
+ * @param[in] level Desired log level
+ */
+void debug_set_level(log_level_t level)
+{
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+    debug_lock();
+    debug_ctx.level = level;
+    debug_level_bounds();
+    debug_unlock();
+#else
+    debug_ctx.level = level;
+#endif
+}
+
+/**
+ * @brief Get the current log level.
+ *
+ * @return Current log level
+ */
+log_level_t debug_get_level(void)
+{
+    return debug_ctx.level;
+}
+
+/**
+ * @brief Get the level actually applied to log calls.
+ *
+ * @return The level set with debug_set_level(), or a less verbose one
+ *         while the governor (DEBUG_ENABLE_GOVERNOR) sheds load
+ */
+log_level_t debug_get_effective_level(void)
+{
+#if DEBUG_ENABLE_GOVERNOR == YES
+    log_level_t cap = debug_ctx.gov_level;
+
+    if ((0U == debug_ctx.panic) && (cap < debug_ctx.level))
+    {
+        return cap;
+    }
+#endif
+
+    return debug_ctx.level;
+}
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+/**
+ * @brief Give one thread its own log level.
+ *
+ * @param[in] thread Thread or task name (DEBUG_THREAD_ISR for ISRs)
+ * @param[in] level  Level for that thread
+ *
+ * @retval 0   Done
+ * @retval -1  Invalid name, or the override table is full
+ */
+int debug_set_thread_level(const char *thread, log_level_t level)
+{
+    if ((NULL == thread) || ('\0' == thread[0]) || (level > LOG_DEBUG))
+    {
+        return -1;
+    }
+
+    int ret = 0;
+
+    debug_lock();
+
+    debug_thread_level_t *e = debug_thread_level_find(thread);
+
+    for (uint32_t i = 0; (NULL == e) && (i < DEBUG_THREAD_LEVELS); i++)
+    {
+        if (0U == s_thread_level[i].used)
+        {
+            e = &s_thread_level[i];
+            memset(e->name, 0, sizeof(e->name));
+            strncpy(e->name, thread, sizeof(e->name) - 1U);
+        }
+    }
+
+    if (NULL == e)
+    {
+        ret = -1;
+    }
+    else
+    {
+        e->level = (uint8_t)level;
+        __atomic_store_n(&e->used, 1U, __ATOMIC_RELEASE);
+        debug_level_bounds();
+    }
+
+    debug_unlock();
+
+    return ret;
+}
+
+/**
+ * @brief Remove the override of a thread.
+ *
+ * @param[in] thread Thread or task name
+ *
+ * @retval 0   Done
+ * @retval -1  No override for that name
+ */
+int debug_clear_thread_level(const char *thread)
+{
+    if (NULL == thread)
+    {
+        return -1;
+    }
+
+    debug_lock();
+
+    debug_thread_level_t *e = debug_thread_level_find(thread);
+
+    if (NULL != e)
+    {
+        __atomic_store_n(&e->used, 0U, __ATOMIC_RELEASE);
+        debug_level_bounds();
+    }
+
+    debug_unlock();
+
+    return (NULL != e) ? 0 : -1;
+}
+#endif /* DEBUG_ENABLE_THREAD_LEVELS */
+
+/**
+ * @brief Replace the active transport at runtime.
+ *
+ * @param[in] trns_hal Pointer to the new transport HAL
+ *
+ * @return 0 on success, negative value on failure
+ *
+ * @note
+ * The new transport is initialized before it is published. The pointer
+ * is swapped while holding the port lock, so no writer can still be using
+ * the old transport once the lock is released (quiescent point); only then
+ * is the old transport flushed and deinitialized. A record that was being
+ * written during the swap completes on the old transport, the next one
+ * goes to the new transport.
+ *
+ * debug_service() references the transport under the lock too. While a
+ * service call is in flight the old transport is retired by the last
+ * debug_service() to finish instead; a second swap before that returns -9.
+ */
+int debug_set_transport(const debug_transport_hal_t *trns_hal)
+{
+    if ((NULL == trns_hal) || (NULL == trns_hal->ops) ||
+        (NULL == trns_hal->ops->write))
+    {
+        return -1;
+    }
+
+    if ((NULL != trns_hal->ops->init) && (0 != trns_hal->ops->init()))
+    {
+        return -8;
+    }
+
+    debug_lock();
+
+    if (NULL != debug_ctx.retired)
+    {
+        /* The previous swap still waits for debug_service() to finish */
+        debug_unlock();
+        if ((NULL != trns_hal->ops->deinit) &&
+            (trns_hal->ops != debug_ctx.transport->ops))
+        {
+            (void)trns_hal->ops->deinit();
+        }
+        return -9;
+    }
+
+    const debug_transport_hal_t *old = debug_ctx.transport;
+    debug_ctx.transport = trns_hal;
+#if DEBUG_ENABLE_SYNC == YES
+    debug_ctx.sync_due = 1;     /* A new host may be listening */
+#endif
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+    debug_intern_reset();       /* Define every string again on the new link */
+#endif
+
+    if ((NULL == old) || (old->ops == trns_hal->ops))
+    {
+        old = NULL;
+    }
+    else if (0U != debug_ctx.service_refs)
+    {
+        debug_ctx.retired = old;    /* Left to the last debug_service() */
+        old = NULL;
+    }
+    debug_unlock();
+
+    /* Quiescent point reached: nobody holds the old transport any more */
+    if (NULL != old)
+    {
+        debug_transport_retire(old);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the current port timestamp.
+ *
+ * @return Timestamp from the port layer, or 0 if unavailable
+ */
+uint32_t debug_timestamp(void)
+{
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->get_timestamp))
+    {
+        return debug_ctx.debug_port->ops->get_timestamp();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Read the port's high-resolution cycle counter.
+ *
+ * @return Counter value, or 0 if the port provides none
+ */
+uint32_t debug_cycles(void)
+{
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->get_cycles))
+    {
+        return debug_ctx.debug_port->ops->get_cycles();
+    }
+
+    return 0;
+}
 
 /**
- * @brief Debug runtime context structure.
+ * @brief Name of the calling thread, as given by the port.
+ *
+ * @return Thread name, or NULL if the port does not provide one
  */
-typedef struct
+const char *debug_thread_name(void)
 {
-    const debug_transport_hal_t *transport;   /**< Active transport HAL */
-    const debug_port_t          *debug_port;  /**< OS/platform port */
-    log_level_t                  level;       /**< Current log level */
-    uint8_t                      initialized; /**< Initialization state */
-} debug_context_t;
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->get_thread_name))
+    {
+        return debug_ctx.debug_port->ops->get_thread_name();
+    }
 
-/*******************************************************************************
- * Private Function Prototypes (Static)
- *******************************************************************************/
+    return NULL;
+}
 
 /**
- * @brief Generate the next log sequence number (thread-safe via port layer).
+ * @brief Check whether the caller runs in an interrupt handler.
  *
- * @return Next sequence number
+ * @return Non-zero in an ISR, 0 otherwise or if the port cannot tell
  */
-static uint32_t debug_next_sequence(void);
-
-/*******************************************************************************
- * Private Variables (Static)
- *******************************************************************************/
-
-/** @brief Global debug context */
-static debug_context_t debug_ctx = {0};
-
-/** @brief Global log sequence number */
-static uint32_t log_sequence_no = 0;
-
-/** @brief Internal buffer for formatted messages */
-static char s_buffer[DEBUG_BUFFER_SIZE];
-
-/*******************************************************************************
- * Private Function Definitions (Static)
- *******************************************************************************/
-
-static uint32_t debug_next_sequence(void)
+int debug_in_isr(void)
 {
-    uint32_t seq;
-
     if ((NULL != debug_ctx.debug_port) &&
-        (NULL != debug_ctx.debug_port->ops->lock))
+        (NULL != debug_ctx.debug_port->ops->is_isr))
     {
-        debug_ctx.debug_port->ops->lock();
+        return debug_ctx.debug_port->ops->is_isr();
     }
 
-    seq = ++log_sequence_no;
+    return 0;
+}
 
+/**
+ * @brief Start or stop the port's PC sampling timer.
+ *
+ * @param[in] hz Sampling rate, 0 to stop
+ *
+ * @retval 0   Done
+ * @retval 1   The port has no sampling timer
+ * @retval -1  The timer failed
+ */
+int debug_sample_timer(uint32_t hz)
+{
     if ((NULL != debug_ctx.debug_port) &&
-        (NULL != debug_ctx.debug_port->ops->unlock))
+        (NULL != debug_ctx.debug_port->ops->sample_timer))
     {
-        debug_ctx.debug_port->ops->unlock();
+        return debug_ctx.debug_port->ops->sample_timer(hz);
     }
 
-    return seq;
+    return 1;
 }
 
-/*******************************************************************************
- * Public Function Definitions
- *******************************************************************************/
-
 /**
- * @brief Initialize the debug framework.
+ * @brief Take the debug core's lock for short bookkeeping.
  *
- * @param[in] trns_hal   Pointer to transport HAL (UART, USB CDC, etc.)
- * @param[in] debug_port Pointer to OS/platform port abstraction
+ * @note Skipped in panic mode, like every use of the lock.
+ */
+void debug_lock_acquire(void)
+{
+    debug_lock();
+}
+
+/**
+ * @brief Release the lock taken with debug_lock_acquire().
+ */
+void debug_lock_release(void)
+{
+    debug_unlock();
+}
+
+/**
+ * @brief Write a raw string to the debug transport.
  *
- * @return 0 on success, negative value on failure
+ * @param[in] str Null-terminated string
+ * @return Number of bytes written, or -1 on error
  */
-int debug_init(const debug_transport_hal_t *trns_hal,
-               const debug_port_t *debug_port)
+int debug_write(const char *str)
 {
-    if ((NULL == trns_hal) || (NULL == debug_port))
+    if (0 == debug_ctx.initialized)
     {
-        return -1;
+        return 0;
     }
 
-    debug_ctx.transport   = trns_hal;
-    debug_ctx.debug_port  = debug_port;
-    debug_ctx.level       = LOG_DEBUG;
-    debug_ctx.initialized = 0;
-
-    if ((NULL == debug_ctx.transport->ops->init) ||
-        (NULL == debug_ctx.debug_port->ops->init))
+    if (NULL == str)
     {
         return -1;
     }
 
-    if (0 != debug_ctx.transport->ops->init())
+    debug_lock();
+    int ret = debug_emit((const uint8_t *)str, strlen(str));
+    debug_unlock();
+
+    return ret;
+}
+
+/**
+ * @brief Write a framed binary record to the debug transport.
+ *
+ * @param[in] type    Record type (debug_record_type_t)
+ * @param[in] payload Record payload
+ * @param[in] len     Payload length in bytes
+ *
+ * @return Number of bytes written, or -1 on error
+ *
+ * @note
+ * The record is framed as described in debug_record.h and sent with a
+ * single transport write, so it cannot be interleaved with other output.
+ */
+int debug_write_record(uint8_t type, const void *payload, size_t len)
+{
+    if (0 == debug_ctx.initialized)
     {
-        return -8;
+        return 0;
     }
 
-    if (0 != debug_ctx.debug_port->ops->init())
+    if (((NULL == payload) && (0U != len)) ||
+        (len > DEBUG_RECORD_MAX_PAYLOAD))
     {
-        return -8;
+        return -1;
     }
 
-    debug_ctx.initialized = 1;
-    return 0;
+    debug_lock();
+    int ret = debug_emit_record(type, payload, len);
+    debug_unlock();
+
+    return ret;
 }
 
 /**
- * @brief Set the current log level.
+ * @brief Run background work of the active transport.
  *
- * @param[in] level Desired log level
+ * @return Transport result (>0 work done, 0 idle, <0 error)
+ *
+ * @note
+ * Call periodically from an idle task or the main loop. Slow operations
+ * such as flash sector erases happen here instead of in the logging
+ * path. The transport's service() runs without the debug lock so it
+ * cannot stall other writers; it is skipped in panic mode. The transport
+ * is referenced under the lock, so debug_set_transport() cannot
+ * deinitialize it while service() or read() runs.
  */
-void debug_set_level(log_level_t level)
+int debug_service(void)
 {
-    debug_ctx.level = level;
+    if ((0 == debug_ctx.initialized) || (0U != debug_ctx.panic))
+    {
+        return 0;
+    }
+
+    int ret = 0;
+
+    debug_lock();
+    const debug_transport_hal_t *transport = debug_ctx.transport;
+    debug_ctx.service_refs++;
+    debug_unlock();
+
+#if DEBUG_ENABLE_SYNC == YES
+    ret = debug_sync_service(transport);
+#endif
+
+    if ((NULL != transport) && (NULL != transport->ops->service))
+    {
+        int rc = transport->ops->service();
+
+        ret = (rc < 0) ? rc : (ret + rc);
+    }
+
+    const debug_transport_hal_t *retired = NULL;
+
+    debug_lock();
+    if (0U == --debug_ctx.service_refs)
+    {
+        retired = debug_ctx.retired;
+        debug_ctx.retired = NULL;
+    }
+    debug_unlock();
+
+    if (NULL != retired)
+    {
+        debug_transport_retire(retired);
+    }
+
+    return ret;
 }
 
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
 /**
- * @brief Get the current log level.
+ * @brief Send every interned string again before its next use.
  *
- * @return Current log level
+ * @note
+ * Called automatically on debug_set_transport() and when the
+ * transport's is_ready() goes from 0 to 1. Call it when a host attaches
+ * to a link without link state (e.g. a UART), or periodically.
  */
-log_level_t debug_get_level(void)
+void debug_wire_reannounce(void)
 {
-    return debug_ctx.level;
+    debug_lock();
+    debug_intern_reset();
+    debug_unlock();
 }
+#endif
 
+#if DEBUG_ENABLE_SYNC == YES
 /**
- * @brief Write a raw string to the debug transport.
+ * @brief Send a clock sync beacon now.
  *
- * @param[in] str Null-terminated string
  * @return Number of bytes written, or -1 on error
+ *
+ * @note
+ * debug_service() calls this every DEBUG_SYNC_INTERVAL_MS and right
+ * after debug_init() or a transport change; call it directly to mark a
+ * point of interest (e.g. right before a test step).
  */
-int debug_write(const char *str)
+int debug_sync(void)
 {
-    if (0 == debug_ctx.initialized)
+    if ((0 == debug_ctx.initialized) || (NULL == debug_ctx.debug_port))
     {
         return 0;
     }
 
-    if ((NULL == debug_ctx.transport) ||
-        (NULL == debug_ctx.transport->ops->write) ||
-        (NULL == str))
-    {
-        return -1;
-    }
+    debug_sync_record_t rec;
+    uint32_t            ts;
+    uint32_t            cycles;
+
+    debug_sync_sample(&ts, &cycles);
+    memset(&rec, 0, sizeof(rec));
+    rec.version   = DEBUG_SYNC_VERSION;
+    rec.seq       = log_sequence_no;
+    rec.timestamp = ts;
+    rec.tick_hz   = DEBUG_TICK_HZ;
+    rec.cycles    = cycles;
+    rec.cycles_hz = (NULL != debug_ctx.debug_port->ops->get_cycles) ?
+                    DEBUG_CYCLES_HZ : 0U;
+
+    debug_ctx.sync_last = ts;
+    debug_ctx.sync_due  = 0;
+
+    return debug_write_record(DEBUG_RECORD_SYNC, &rec, sizeof(rec));
+}
+#endif
 
-    if (debug_ctx.debug_port && debug_ctx.debug_port->ops->lock)
+/**
+ * @brief Switch the debug framework into panic (polled) mode.
+ *
+ * @note
+ * Masks interrupts through the port, stops using the port lock and
+ * routes all further output through the transport's polled write. Any
+ * data buffered by the transport is flushed synchronously. There is no
+ * way back; panic mode is meant for fault handlers and failed asserts.
+ */
+void debug_panic_enter(void)
+{
+    if ((NULL != debug_ctx.debug_port) &&
+        (NULL != debug_ctx.debug_port->ops->panic_enter))
     {
-        debug_ctx.debug_port->ops->lock();
+        debug_ctx.debug_port->ops->panic_enter();
     }
 
-    int ret = debug_ctx.transport->ops->write(
-        (const uint8_t *)str, strlen(str));
+    debug_ctx.panic = 1;
+
+    const debug_transport_hal_t *transport = debug_ctx.transport;
 
-    if (debug_ctx.debug_port && debug_ctx.debug_port->ops->unlock)
+    if ((NULL != transport) && (NULL != transport->ops->flush))
     {
-        debug_ctx.debug_port->ops->unlock();
+        (void)transport->ops->flush();
     }
+}
 
-    return ret;
+/**
+ * @brief Check whether panic mode is active.
+ *
+ * @return 1 if panic mode is active, 0 otherwise
+ */
+int debug_panic_active(void)
+{
+    return (0U != debug_ctx.panic) ? 1 : 0;
 }
 
 /**
@@ -257,69 +2170,130 @@ int debug_printf(const char *fmt, ...)
  * @param[in] fmt   Format string (printf-style)
  * @param[in] ...   Variable arguments
  * @return Number of bytes written, or 0 if filtered
+ *
+ * @note
+ * With DEBUG_ENABLE_BACKTRACE, a LOG_ERROR line is followed by a
+ * backtrace record carrying the raw return addresses of the call chain;
+ * symbolization is left to the host decoder.
+ *
+ * With DEBUG_ENABLE_GOVERNOR, lines above the effective level (see
+ * debug_get_effective_level()) are shed and counted.
  */
 int debug_log(log_level_t level, const char *fmt, ...)
 {
-    if ((0 == debug_ctx.initialized) || (level > debug_ctx.level))
+    if ((0 == debug_ctx.initialized) || (0 != debug_level_filtered(level)))
     {
         return 0; /* Filtered */
     }
 
-    uint32_t ts = 0;
-    uint32_t seq = 0;
-    const char *thread = "MAIN";
+    va_list args;
 
-#if DEBUG_ENABLE_TIME_DATE_INFO == YES
-    if ((NULL != debug_ctx.debug_port) &&
-        (NULL != debug_ctx.debug_port->ops->get_timestamp))
+    va_start(args, fmt);
+    int ret = debug_vlog(level, 0U, DEBUG_CALLER(), fmt, args);
+    va_end(args);
+
+    return ret;
+}
+
+/**
+ * @brief Log a message that stands for @p weight calls of its call site.
+ *
+ * @param[in] level  Log level of the message
+ * @param[in] weight Sampling factor (1-of-N), carried in the line prefix
+ * @param[in] fmt    Format string (printf-style)
+ * @param[in] ...    Variable arguments
+ * @return Number of bytes written, or 0 if filtered
+ *
+ * @note Used by the LOG_xxx_SAMPLED macros, which do the sampling.
+ */
+int debug_log_sampled(log_level_t level, uint32_t weight, const char *fmt, ...)
+{
+    if ((0 == debug_ctx.initialized) || (0 != debug_level_filtered(level)))
     {
-        ts = debug_ctx.debug_port->ops->get_timestamp();
+        return 0; /* Filtered */
     }
-#endif
 
-#if DEBUG_ENABLE_THREAD_INFO == YES
-    if ((NULL != debug_ctx.debug_port) &&
-        (NULL != debug_ctx.debug_port->ops->get_thread_name))
+    va_list args;
+
+    va_start(args, fmt);
+    int ret = debug_vlog(level, (0U != weight) ? weight : 1U, DEBUG_CALLER(),
+                         fmt, args);
+    va_end(args);
+
+    return ret;
+}
+
+/**
+ * @brief Next value of the PRNG of LOG_SAMPLED_RANDOM() (xorshift32).
+ *
+ * @return Pseudo-random value
+ */
+uint32_t debug_log_rand_next(void)
+{
+    uint32_t x = debug_log_rand_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    debug_log_rand_state = x;
+
+    return x;
+}
+
+/**
+ * @brief Log an array of samples as one entry.
+ *
+ * @param[in] level Log level of the entry
+ * @param[in] type  Element type (DEBUG_ARRAY_xxx)
+ * @param[in] name  Constant label
+ * @param[in] data  Elements
+ * @param[in] count Number of elements
+ * @return Number of bytes written, 0 if filtered, or -1 on error
+ *
+ * @note
+ * With DEBUG_WIRE_INTERNED the elements are copied into
+ * DEBUG_RECORD_ARRAY records as they are, so the cost is about one
+ * memcpy per element. In text they are printed with an integer formatter
+ * (floats with "%g") on as few lines as DEBUG_BUFFER_SIZE allows.
+ */
+int debug_log_array(log_level_t level, uint8_t type, const char *name,
+                    const void *data, size_t count)
+{
+    if ((0 == debug_ctx.initialized) || (0U == count) ||
+        (0 != debug_level_filtered(level)))
     {
-        thread = debug_ctx.debug_port->ops->get_thread_name();
+        return 0; /* Filtered */
     }
-#endif
 
-#if DEBUG_ENABLE_SEQUENCE_NO == YES
-    seq = debug_next_sequence();
-#endif
+    if ((type >= sizeof(s_array_size)) || (0U == s_array_size[type]) ||
+        (NULL == name) || (NULL == data) || (count > 0xFFFFU))
+    {
+        return -1;
+    }
 
-    const char *level_str = "LOG";
-    if (level == LOG_ERROR) level_str = "ERROR";
-    else if (level == LOG_WARN)  level_str = "WARN";
-    else if (level == LOG_INFO)  level_str = "INFO";
-    else if (level == LOG_DEBUG) level_str = "DEBUG";
+    debug_meta_t meta;
 
-    size_t n = 0;
+    if (0 != debug_log_meta(level, &meta))
+    {
+        return 0;
+    }
 
-#if DEBUG_ENABLE_SEQUENCE_NO == YES
-    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%05lu]", (unsigned long)seq);
-#endif
+    int ret = -1;
 
-#if DEBUG_ENABLE_TIME_DATE_INFO == YES
-    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%lu]", (unsigned long)ts);
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+    if (0 != debug_log_array_interned(level, &meta, type, name,
+                                      (const uint8_t *)data, count, &ret))
 #endif
+    {
+        ret = debug_log_array_text(level, &meta, type, name,
+                                   (const uint8_t *)data, count);
+    }
 
-#if DEBUG_ENABLE_THREAD_INFO == YES
-    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%s]", thread);
+#if DEBUG_ENABLE_GOVERNOR == YES
+    debug_governor_account(meta.gov_start);
 #endif
 
-    n += snprintf(&s_buffer[n], sizeof(s_buffer) - n, "[%s] ", level_str);
-
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(&s_buffer[n], sizeof(s_buffer) - n, fmt, args);
-    va_end(args);
-
-    strncat(s_buffer, "\r\n",
-            sizeof(s_buffer) - strlen(s_buffer) - 1);
-
-    return debug_write(s_buffer);
+    return ret;
 }
 
 /** @} */ // End of DEBUG_MODULE
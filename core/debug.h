@@ -42,6 +42,7 @@ extern "C" {
 #include <stdarg.h>
 
 #include "config.h"
+#include "debug_record.h"
 #include "debug_transport.h"
 #include "debug_port.h"
 
@@ -98,12 +99,111 @@ typedef enum
 /** @brief Log a debug-level message. */
 #define LOG_DEBUG(...)  debug_log(LOG_DEBUG, __VA_ARGS__)
 
+/** @brief Sampling factor of the LOG_xxx_SAMPLED macros: @p n, at least 1 */
+#define DEBUG_LOG_SAMPLED_N(n)  (((uint32_t)(n) > 1U) ? (uint32_t)(n) : 1U)
+
+/**
+ * @brief Log one call in @p n of this call site (the 1st, n+1th, ...).
+ *
+ * Skipped calls cost one counter decrement; the arguments are not
+ * evaluated. The line carries the factor ("[LEVEL][1/n]") so host tools
+ * can scale counts. The counter is per call site and not atomic: calls
+ * racing from two contexts may shift which one is logged.
+ *
+ * @p n must be at least 1; 0 is taken as 1 (every call is logged).
+ */
+#define LOG_SAMPLED(level, n, ...)                                         \
+    do                                                                     \
+    {                                                                      \
+        static uint32_t debug_skip_;                                       \
+        if (0U == debug_skip_)                                             \
+        {                                                                  \
+            const uint32_t debug_n_ = DEBUG_LOG_SAMPLED_N(n);              \
+            debug_skip_ = debug_n_ - 1U;                                   \
+            (void)debug_log_sampled((level), debug_n_, __VA_ARGS__);       \
+        }                                                                  \
+        else                                                               \
+        {                                                                  \
+            debug_skip_--;                                                 \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief Log each call of this call site with probability 1 / @p n.
+ *
+ * Costs one xorshift step per call; the arguments are only evaluated
+ * for logged calls. Unlike LOG_SAMPLED(), this cannot lock onto a
+ * periodic pattern in the calls.
+ *
+ * @p n must be at least 1; 0 is taken as 1 (every call is logged).
+ */
+#define LOG_SAMPLED_RANDOM(level, n, ...)                                  \
+    do                                                                     \
+    {                                                                      \
+        const uint32_t debug_n_ = DEBUG_LOG_SAMPLED_N(n);                  \
+        if (debug_log_rand_next() <= (0xFFFFFFFFUL / debug_n_))          \
+        {                                                                  \
+            (void)debug_log_sampled((level), debug_n_, __VA_ARGS__);       \
+        }                                                                  \
+    } while (0)
+
+/** @brief Log one error-level call in n. */
+#define LOG_ERROR_SAMPLED(n, ...)  LOG_SAMPLED(LOG_ERROR, (n), __VA_ARGS__)
+
+/** @brief Log one warning-level call in n. */
+#define LOG_WARN_SAMPLED(n, ...)   LOG_SAMPLED(LOG_WARN,  (n), __VA_ARGS__)
+
+/** @brief Log one informational call in n. */
+#define LOG_INFO_SAMPLED(n, ...)   LOG_SAMPLED(LOG_INFO,  (n), __VA_ARGS__)
+
+/** @brief Log one debug-level call in n. */
+#define LOG_DEBUG_SAMPLED(n, ...)  LOG_SAMPLED(LOG_DEBUG, (n), __VA_ARGS__)
+
+/** @brief Log an error-level call with probability 1/n. */
+#define LOG_ERROR_SAMPLED_RANDOM(n, ...)  LOG_SAMPLED_RANDOM(LOG_ERROR, (n), __VA_ARGS__)
+
+/** @brief Log a warning-level call with probability 1/n. */
+#define LOG_WARN_SAMPLED_RANDOM(n, ...)   LOG_SAMPLED_RANDOM(LOG_WARN,  (n), __VA_ARGS__)
+
+/** @brief Log an informational call with probability 1/n. */
+#define LOG_INFO_SAMPLED_RANDOM(n, ...)   LOG_SAMPLED_RANDOM(LOG_INFO,  (n), __VA_ARGS__)
+
+/** @brief Log a debug-level call with probability 1/n. */
+#define LOG_DEBUG_SAMPLED_RANDOM(n, ...)  LOG_SAMPLED_RANDOM(LOG_DEBUG, (n), __VA_ARGS__)
+
+/**
+ * @brief Log @p count elements of a buffer as one entry, labelled with
+ *        the expression @p ptr.
+ *
+ * @p type is a DEBUG_ARRAY_xxx code matching the element type. With the
+ * interned wire format the elements are copied raw into binary records;
+ * in text they are printed "name[index]: v v ...", several lines for a
+ * long array.
+ *
+ * @code
+ *   LOG_ARRAY(LOG_DEBUG, DEBUG_ARRAY_U16, adc_buf, 64);
+ * @endcode
+ */
+#define LOG_ARRAY(level, type, ptr, count) \
+    debug_log_array((level), (type), #ptr, (ptr), (size_t)(count))
+
 #else  /* DEBUG_ENABLE == NO */
 
 #define LOG_ERROR(...)
 #define LOG_WARN(...)
 #define LOG_INFO(...)
 #define LOG_DEBUG(...)
+#define LOG_SAMPLED(level, n, ...)
+#define LOG_SAMPLED_RANDOM(level, n, ...)
+#define LOG_ERROR_SAMPLED(n, ...)
+#define LOG_WARN_SAMPLED(n, ...)
+#define LOG_INFO_SAMPLED(n, ...)
+#define LOG_DEBUG_SAMPLED(n, ...)
+#define LOG_ERROR_SAMPLED_RANDOM(n, ...)
+#define LOG_WARN_SAMPLED_RANDOM(n, ...)
+#define LOG_INFO_SAMPLED_RANDOM(n, ...)
+#define LOG_DEBUG_SAMPLED_RANDOM(n, ...)
+#define LOG_ARRAY(level, type, ptr, count)
 
 #endif /* DEBUG_ENABLE */
 
@@ -125,6 +225,24 @@ typedef enum
 int debug_init(const debug_transport_hal_t *trns_hal,
                const debug_port_t *debug_port);
 
+/**
+ * @brief Replace the active debug transport at runtime.
+ *
+ * @param[in] trns_hal Pointer to the new transport HAL
+ *
+ * @retval 0   Transport replaced
+ * @retval -1  Invalid transport
+ * @retval -8  New transport failed to initialize
+ * @retval -9  The previous transport is still being serviced; retry later
+ *
+ * @note
+ * Safe to call while other tasks are logging or servicing: the swap
+ * happens under the port lock, and the previous transport is flushed and
+ * deinitialized only after every in-flight write and debug_service() call
+ * using it has completed.
+ */
+int debug_set_transport(const debug_transport_hal_t *trns_hal);
+
 /**
  * @brief Set the current debug log level.
  *
@@ -139,6 +257,99 @@ void debug_set_level(log_level_t level);
  */
 log_level_t debug_get_level(void);
 
+/**
+ * @brief Get the log level currently applied to log calls.
+ *
+ * @return Configured level, or a less verbose one while the governor
+ *         sheds load (DEBUG_ENABLE_GOVERNOR)
+ */
+log_level_t debug_get_effective_level(void);
+
+#if DEBUG_ENABLE_THREAD_LEVELS == YES
+/** @brief Thread name the ports give interrupt handlers */
+#define DEBUG_THREAD_ISR    "ISR"
+
+/**
+ * @brief Give one thread its own log level, in place of the global one.
+ *
+ * @param[in] thread Thread or task name (DEBUG_THREAD_ISR for ISRs)
+ * @param[in] level  Level for that thread, more or less verbose than
+ *                   the global level
+ *
+ * @retval 0   Done
+ * @retval -1  Invalid name, or DEBUG_THREAD_LEVELS overrides already set
+ *
+ * @note
+ * The override applies to every thread of that name, including threads
+ * created later. The governor (DEBUG_ENABLE_GOVERNOR) still caps every
+ * thread.
+ */
+int debug_set_thread_level(const char *thread, log_level_t level);
+
+/**
+ * @brief Remove the override of a thread; it follows the global level.
+ *
+ * @param[in] thread Thread or task name
+ *
+ * @retval 0   Done
+ * @retval -1  No override for that name
+ */
+int debug_clear_thread_level(const char *thread);
+#endif
+
+/**
+ * @brief Get the current timestamp from the port layer.
+ *
+ * @return Port timestamp (ticks), or 0 if the port provides none
+ */
+uint32_t debug_timestamp(void);
+
+/**
+ * @brief Read the port's high-resolution cycle counter.
+ *
+ * @return Counter value (DEBUG_CYCLES_HZ), or 0 if the port has none
+ */
+uint32_t debug_cycles(void);
+
+/**
+ * @brief Name of the calling thread, as given by the port.
+ *
+ * @return Thread name, or NULL if the port does not provide one
+ */
+const char *debug_thread_name(void);
+
+/**
+ * @brief Check whether the caller runs in an interrupt handler.
+ *
+ * @return Non-zero in an ISR, 0 otherwise or if the port cannot tell
+ */
+int debug_in_isr(void);
+
+/**
+ * @brief Start or stop the port's PC sampling timer (see debug_sample.h).
+ *
+ * @param[in] hz Sampling rate, 0 to stop
+ *
+ * @retval 0   Done
+ * @retval 1   The port has no sampling timer
+ * @retval -1  The timer failed
+ */
+int debug_sample_timer(uint32_t hz);
+
+/**
+ * @brief Take the debug core's lock (port lock) for short bookkeeping.
+ *
+ * @note
+ * For modules built on the core (e.g. debug_scope.c). Nothing that logs
+ * or writes records may be called while the lock is held.
+ */
+void debug_lock_acquire(void);
+
+/**
+ * @brief Release the lock taken with debug_lock_acquire().
+ */
+void debug_lock_release(void);
+
 /**
  * @brief Write a raw string to the debug output.
  *
@@ -149,6 +360,69 @@ log_level_t debug_get_level(void);
  */
 int debug_write(const char *str);
 
+/**
+ * @brief Write a framed binary record to the debug output.
+ *
+ * @param[in] type    Record type (see debug_record_type_t in debug_record.h)
+ * @param[in] payload Record payload
+ * @param[in] len     Payload length, at most DEBUG_RECORD_MAX_PAYLOAD
+ *
+ * @retval >=0  Number of bytes successfully written
+ * @retval -1   Error occurred or payload too large
+ */
+int debug_write_record(uint8_t type, const void *payload, size_t len);
+
+/**
+ * @brief Run background work of the active transport (e.g. flash erases).
+ *
+ * With DEBUG_ENABLE_SYNC, also answers host pings and sends the periodic
+ * clock sync beacon.
+ *
+ * @return >0 if work was done, 0 if idle, negative value on error
+ */
+int debug_service(void);
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+/**
+ * @brief Re-send the definitions of interned strings before their next use.
+ *
+ * @note Needed only for links without link state, when a host attaches.
+ */
+void debug_wire_reannounce(void);
+#endif
+
+#if DEBUG_ENABLE_SYNC == YES
+/**
+ * @brief Send a clock sync beacon (DEBUG_RECORD_SYNC) immediately.
+ *
+ * @retval >=0  Number of bytes successfully written
+ * @retval -1   Error occurred
+ *
+ * @note Beacons are also sent periodically by debug_service().
+ */
+int debug_sync(void);
+#endif
+
+/**
+ * @brief Enter panic mode for output from fault handlers or failed asserts.
+ *
+ * Masks interrupts via the port layer, bypasses all locks and switches the
+ * transport to its polled write implementation. Buffered transport data
+ * (e.g. the RAM ring of a failover chain) is flushed synchronously, with
+ * every wait bounded by DEBUG_PANIC_SPIN_LIMIT.
+ *
+ * @note Panic mode cannot be left; it is intended to precede a reset.
+ */
+void debug_panic_enter(void);
+
+/**
+ * @brief Check whether panic mode is active.
+ *
+ * @retval 1  Panic mode active
+ * @retval 0  Normal operation
+ */
+int debug_panic_active(void);
+
 /**
  * @brief Print a formatted string to the debug output.
  *
@@ -173,6 +447,48 @@ int debug_printf(const char *fmt, ...);
  */
 int debug_log(log_level_t level, const char *fmt, ...);
 
+/**
+ * @brief Log a sampled message (see LOG_SAMPLED()).
+ *
+ * @param[in] level  Log severity level
+ * @param[in] weight Sampling factor: calls this line stands for
+ * @param[in] fmt    printf-style format string
+ * @param[in] ...    Variable arguments
+ *
+ * @retval >=0  Number of bytes successfully written
+ * @retval 0    Message filtered by current log level
+ * @retval -1   Error occurred
+ */
+int debug_log_sampled(log_level_t level, uint32_t weight, const char *fmt, ...);
+
+/**
+ * @brief Next value of the PRNG of LOG_SAMPLED_RANDOM() (xorshift32).
+ *
+ * @return Pseudo-random value
+ *
+ * @note Not atomic; a race only repeats a value, the state never becomes 0.
+ */
+uint32_t debug_log_rand_next(void);
+
+/**
+ * @brief Log an array of samples (see LOG_ARRAY()).
+ *
+ * @param[in] level Log severity level
+ * @param[in] type  Element type (DEBUG_ARRAY_xxx)
+ * @param[in] name  Label; must be a constant string
+ * @param[in] data  Elements (any alignment)
+ * @param[in] count Number of elements, at most 65535
+ *
+ * @retval >0   Number of bytes successfully written
+ * @retval 0    Filtered by the log level, or @p count is 0
+ * @retval -1   Invalid argument or transport error
+ *
+ * @note All records or lines of one array share a sequence number and
+ *       go out under one hold of the lock, without interleaving.
+ */
+int debug_log_array(log_level_t level, uint8_t type, const char *name,
+                    const void *data, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,277 @@
+/**
+ * @file      debug_heap.c
+ * @brief     Heap allocation tracer.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_heap.h. Events go through a multi-producer, single-consumer
+ * ring: a producer claims the slot at head with a compare-and-swap, fills
+ * it and publishes it by writing its type last. The drain takes published
+ * slots in order and encodes them with varints, so a typical event costs
+ * 10 to 15 bytes on the wire.
+ *
+ * The ring claim and the thread table are those of debug_tracebuf.h; the
+ * drain sends each thread name once, before the events that use it.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_HEAP
+ *  @{
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "config.h"
+#include "debug.h"
+#include "debug_heap.h"
+#include "debug_record.h"
+#include "debug_tracebuf.h"
+
+#if DEBUG_ENABLE_HEAP_TRACE == YES
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_HEAP_EVENTS & (DEBUG_HEAP_EVENTS - 1)) != 0
+#error "DEBUG_HEAP_EVENTS must be a power of two."
+#endif
+
+/* One record must hold the header and the largest event */
+#if DEBUG_RECORD_MAX_PAYLOAD < 64
+#error "DEBUG_RECORD_MAX_PAYLOAD too small for heap trace records."
+#endif
+
+/** @brief Ring index mask */
+#define HEAP_MASK          ((uint32_t)DEBUG_HEAP_EVENTS - 1U)
+
+/** @brief Largest encoded event: type, thread, 5 + 3 x 10 varint bytes */
+#define HEAP_EVENT_MAX     37U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Ring slot */
+typedef struct
+{
+    uintptr_t        addr;
+    uintptr_t        caller;
+    uint32_t         size;
+    uint32_t         timestamp;
+    uint8_t          thread;
+    volatile uint8_t type;      /**< 0 = free, written last */
+} heap_slot_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static heap_slot_t             s_ring[DEBUG_HEAP_EVENTS];
+static uint32_t                s_head    = 0;  /**< Slots claimed by producers */
+static uint32_t                s_tail    = 0;  /**< Slots taken by the drain */
+static uint32_t                s_dropped = 0;  /**< Events lost to a full ring */
+static debug_tracebuf_thread_t s_thread[DEBUG_HEAP_THREADS];
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Thread table index of the calling thread.
+ *
+ * @return Index, or DEBUG_HEAP_NO_THREAD if unknown or the table is full
+ */
+static uint8_t heap_thread_index(void)
+{
+    const char *key = debug_thread_name();
+
+    if (NULL == key)
+    {
+        return DEBUG_HEAP_NO_THREAD;
+    }
+
+    int i = debug_tracebuf_thread(s_thread, DEBUG_HEAP_THREADS, key);
+
+    return (i >= 0) ? (uint8_t)i : DEBUG_HEAP_NO_THREAD;
+}
+
+/**
+ * @brief Claim, fill and publish a ring slot.
+ */
+static void heap_put(uint8_t type, const void *addr, size_t size,
+                     const void *caller)
+{
+    uint32_t head;
+
+    if (0 != debug_tracebuf_claim(&s_head, &s_tail, DEBUG_HEAP_EVENTS,
+                                  &s_dropped, &head))
+    {
+        return;
+    }
+
+    heap_slot_t *slot = &s_ring[head & HEAP_MASK];
+
+    slot->addr      = (uintptr_t)addr;
+    slot->caller    = (uintptr_t)caller;
+    slot->size      = (uint32_t)size;
+    slot->timestamp = debug_timestamp();
+    slot->thread    = heap_thread_index();
+    __atomic_store_n(&slot->type, type, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Append a 64-bit varint.
+ *
+ * @return Bytes written
+ */
+static size_t heap_varint(uint8_t *out, uint64_t v)
+{
+    size_t n = 0;
+
+    while (v >= 0x80U)
+    {
+        out[n++] = (uint8_t)(v | 0x80U);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+
+    return n;
+}
+
+/**
+ * @brief Send one batch if it holds any event.
+ */
+static void heap_send(uint8_t *payload, size_t len, uint8_t count,
+                      uint32_t base)
+{
+    debug_heap_record_t rec;
+
+    if (0U == count)
+    {
+        return;
+    }
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version   = DEBUG_HEAP_VERSION;
+    rec.count     = count;
+    rec.timestamp = base;
+    rec.dropped   = __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+    memcpy(payload, &rec, sizeof(rec));
+
+    (void)debug_write_record(DEBUG_RECORD_HEAP, payload, len);
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+void debug_heap_alloc(const void *addr, size_t size, const void *caller)
+{
+    heap_put(DEBUG_HEAP_ALLOC, addr, size, caller);
+}
+
+void debug_heap_free(const void *addr, size_t size, const void *caller)
+{
+    if (NULL != addr)
+    {
+        heap_put(DEBUG_HEAP_FREE, addr, size, caller);
+    }
+}
+
+int debug_heap_drain(void)
+{
+    uint8_t  payload[DEBUG_RECORD_MAX_PAYLOAD];
+    size_t   len   = sizeof(debug_heap_record_t);
+    uint8_t  count = 0;
+    int      sent  = 0;
+    uint32_t end   = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t tail  = s_tail;
+    uint32_t base  = debug_timestamp();
+    uint32_t last  = base;
+
+    /* Thread names first, so the host knows them before their events */
+    for (uint32_t i = 0; i < DEBUG_HEAP_THREADS; i++)
+    {
+        const char *name = debug_tracebuf_thread_pending(&s_thread[i]);
+
+        if (NULL == name)
+        {
+            continue;
+        }
+
+        size_t n = strnlen(name, sizeof(s_thread[i].name));
+
+        if ((len + 3U + n) > sizeof(payload))
+        {
+            heap_send(payload, len, count, base);
+            len   = sizeof(debug_heap_record_t);
+            count = 0;
+        }
+        payload[len++] = DEBUG_HEAP_THREAD;
+        payload[len++] = (uint8_t)i;
+        payload[len++] = (uint8_t)n;
+        memcpy(&payload[len], name, n);
+        len += n;
+        count++;
+        debug_tracebuf_thread_sent(&s_thread[i]);
+    }
+
+    while (tail != end)
+    {
+        heap_slot_t *slot = &s_ring[tail & HEAP_MASK];
+        uint8_t      type = __atomic_load_n(&slot->type, __ATOMIC_ACQUIRE);
+
+        if (0U == type)
+        {
+            break;  /* Claimed but not yet published */
+        }
+
+        if (((len + HEAP_EVENT_MAX) > sizeof(payload)) || (0xFFU == count))
+        {
+            heap_send(payload, len, count, base);
+            len   = sizeof(debug_heap_record_t);
+            count = 0;
+            base  = last;
+        }
+
+        int32_t delta = (int32_t)(slot->timestamp - last);
+
+        payload[len++] = type;
+        payload[len++] = slot->thread;
+        len += heap_varint(&payload[len], ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+        len += heap_varint(&payload[len], slot->addr);
+        len += heap_varint(&payload[len], slot->size);
+        len += heap_varint(&payload[len], slot->caller);
+        last = slot->timestamp;
+        count++;
+        sent++;
+
+        /* Free the slot before handing it back to the producers */
+        __atomic_store_n(&slot->type, 0U, __ATOMIC_RELAXED);
+        tail++;
+        __atomic_store_n(&s_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    heap_send(payload, len, count, base);
+
+    return sent;
+}
+
+#endif /* DEBUG_ENABLE_HEAP_TRACE */
+
+/** @} */ // End of DEBUG_HEAP
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,106 @@
+/**
+ * @file      debug_heap.h
+ * @brief     Heap allocation tracer.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Records every allocation and free (address, size, caller, thread and
+ * timestamp) into a lock-free ring. debug_heap_drain() sends the ring as
+ * compact DEBUG_RECORD_HEAP records; tools/heap_replay rebuilds the live
+ * heap from them and reports the usage timeline, the peak and the blocks
+ * that were never freed.
+ *
+ * The hooks only touch the ring, so they may run where the debug lock
+ * cannot be taken: inside pvPortMalloc() with the scheduler suspended, or
+ * inside malloc() called by the transport itself. The allocator is hooked
+ * by the port:
+ *  - FreeRTOS: traceMALLOC/traceFREE in debug_freertos_trace.h
+ *  - POSIX: -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+ *    with port/posix/debug_heap_wrap.c
+ *
+ * Threads are told apart by the name pointer returned by the port and by
+ * the name (a buffer reused by a later thread of another name is a new
+ * thread), and the name of each is sent once.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_HEAP Debug Heap Tracer
+ *  @brief Allocation events for leak and fragmentation analysis.
+ *  @{
+ */
+
+#ifndef DEBUG_HEAP_H
+#define DEBUG_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config.h"
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+#if DEBUG_ENABLE_HEAP_TRACE == YES
+
+/**
+ * @brief Record an allocation.
+ *
+ * @param[in] addr   Block returned by the allocator (NULL if it failed)
+ * @param[in] size   Requested size in bytes
+ * @param[in] caller Return address into the allocating code
+ *
+ * @note Lock-free; counts a drop if the ring is full.
+ */
+void debug_heap_alloc(const void *addr, size_t size, const void *caller);
+
+/**
+ * @brief Record a free.
+ *
+ * @param[in] addr   Block being freed (NULL is ignored)
+ * @param[in] size   Block size if the allocator knows it, else 0
+ * @param[in] caller Return address into the freeing code
+ *
+ * @note Lock-free; counts a drop if the ring is full.
+ */
+void debug_heap_free(const void *addr, size_t size, const void *caller);
+
+/**
+ * @brief Send the recorded events as DEBUG_RECORD_HEAP records.
+ *
+ * @return Number of events sent
+ *
+ * @note
+ * Single consumer: call from one thread only, outside the allocator.
+ * Allocations made by the transport while draining go out with the next
+ * call.
+ */
+int debug_heap_drain(void);
+
+#endif /* DEBUG_ENABLE_HEAP_TRACE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_HEAP_H */
+
+/** @} */ // End of DEBUG_HEAP
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,370 @@
+/**
+ * @file      debug_intern.c
+ * @brief     String interning and argument encoding for the binary wire format.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_intern.h. The table is DEBUG_INTERN_SLOTS entries with
+ * linear probing; entries are never removed, as the strings of a
+ * firmware image are a fixed set.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_INTERN
+ *  @{
+ */
+
+#include "config.h"
+
+#if DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+#include <stddef.h>
+
+#include "debug_intern.h"
+#include "debug_record.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if ((DEBUG_INTERN_SLOTS & (DEBUG_INTERN_SLOTS - 1)) != 0) || \
+    (DEBUG_INTERN_SLOTS > 65536)
+#error "DEBUG_INTERN_SLOTS must be a power of two, at most 65536."
+#endif
+
+/** @brief Slot index mask */
+#define INTERN_MASK     ((uint32_t)DEBUG_INTERN_SLOTS - 1U)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/**
+ * @brief Table entry.
+ */
+typedef struct
+{
+    const char *key;    /**< String address, NULL = free */
+    uint32_t    check;  /**< Content hash (thread names only) */
+    uint8_t     gen;    /**< Generation of the last definition, 0 = none */
+    uint8_t     kind;   /**< DEBUG_DICT_xxx */
+} intern_slot_t;
+
+/** @brief printf length modifiers */
+typedef enum
+{
+    LEN_NONE = 0,
+    LEN_HH,
+    LEN_H,
+    LEN_L,
+    LEN_LL,
+    LEN_Z,
+    LEN_J,
+    LEN_T,
+    LEN_BIG_L
+} intern_len_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/** @brief String table */
+static intern_slot_t s_slots[DEBUG_INTERN_SLOTS];
+
+/** @brief Current generation (never 0) */
+static uint8_t s_gen = 1;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief FNV-1a hash of a string.
+ */
+static uint32_t intern_fnv(const char *str)
+{
+    uint32_t h = 2166136261UL;
+
+    while ('\0' != *str)
+    {
+        h = (h ^ (uint8_t)*str++) * 16777619UL;
+    }
+
+    return h;
+}
+
+/**
+ * @brief Append an unsigned LEB128 varint.
+ *
+ * @return New position, or cap + 1 if it does not fit
+ */
+static size_t intern_put_uvar(uint8_t *out, size_t pos, size_t cap, uint64_t v)
+{
+    do
+    {
+        if (pos >= cap)
+        {
+            return cap + 1U;
+        }
+        out[pos++] = (uint8_t)((v & 0x7FU) | ((v > 0x7FU) ? 0x80U : 0U));
+        v >>= 7;
+    } while (0U != v);
+
+    return pos;
+}
+
+/**
+ * @brief Append a zigzag-encoded signed varint.
+ */
+static size_t intern_put_svar(uint8_t *out, size_t pos, size_t cap, int64_t v)
+{
+    return intern_put_uvar(out, pos, cap,
+                           ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_intern_lookup(const char *str, uint8_t kind, uint16_t *id)
+{
+    uint32_t check = (DEBUG_DICT_THREAD == kind) ? intern_fnv(str) : 0U;
+    uint32_t h     = (uint32_t)((uintptr_t)str >> 2) * 2654435761UL;
+
+    h ^= h >> 16;
+
+    for (uint32_t i = 0; i < DEBUG_INTERN_SLOTS; i++)
+    {
+        uint32_t       index = (h + i) & INTERN_MASK;
+        intern_slot_t *slot  = &s_slots[index];
+
+        if (NULL == slot->key)
+        {
+            slot->key  = str;
+            slot->kind = kind;
+        }
+        else if ((slot->key != str) || (slot->kind != kind))
+        {
+            continue;
+        }
+
+        *id = (uint16_t)index;
+
+        if ((slot->gen == s_gen) && (slot->check == check))
+        {
+            return 0;
+        }
+
+        slot->gen   = s_gen;
+        slot->check = check;
+        return 1;
+    }
+
+    return -1;
+}
+
+void debug_intern_forget(uint16_t id)
+{
+    if (id < DEBUG_INTERN_SLOTS)
+    {
+        s_slots[id].gen = 0;
+    }
+}
+
+void debug_intern_reset(void)
+{
+    if (0U == ++s_gen)
+    {
+        /* Wrapped: make sure no slot matches the new generation by chance */
+        for (uint32_t i = 0; i < DEBUG_INTERN_SLOTS; i++)
+        {
+            s_slots[i].gen = 0;
+        }
+        s_gen = 1;
+    }
+}
+
+int debug_intern_encode(uint8_t *out, size_t cap, const char *fmt, va_list args)
+{
+    size_t n = 0;
+
+    for (const char *p = fmt; '\0' != *p; p++)
+    {
+        if ('%' != *p)
+        {
+            continue;
+        }
+        if ('%' == *++p)
+        {
+            continue;
+        }
+
+        /* Flags */
+        while ((NULL != strchr("-+ #0'", *p)) && ('\0' != *p))
+        {
+            p++;
+        }
+
+        /* Width and precision */
+        for (int part = 0; part < 2; part++)
+        {
+            if ((1 == part) && ('.' != *p))
+            {
+                break;
+            }
+            if (1 == part)
+            {
+                p++;
+            }
+            if ('*' == *p)
+            {
+                n = intern_put_svar(out, n, cap, va_arg(args, int));
+                p++;
+            }
+            while ((*p >= '0') && (*p <= '9'))
+            {
+                p++;
+            }
+        }
+
+        /* Length modifier */
+        intern_len_t len = LEN_NONE;
+
+        switch (*p)
+        {
+            case 'h': len = ('h' == p[1]) ? LEN_HH : LEN_H;  break;
+            case 'l': len = ('l' == p[1]) ? LEN_LL : LEN_L;  break;
+            case 'z': len = LEN_Z;     break;
+            case 'j': len = LEN_J;     break;
+            case 't': len = LEN_T;     break;
+            case 'L': len = LEN_BIG_L; break;
+            default:                   break;
+        }
+        if (LEN_NONE != len)
+        {
+            p += ((LEN_HH == len) || (LEN_LL == len)) ? 2 : 1;
+        }
+
+        switch (*p)
+        {
+            case 'd':
+            case 'i':
+            {
+                int64_t v;
+
+                switch (len)
+                {
+                    case LEN_L:  v = va_arg(args, long);      break;
+                    case LEN_LL: v = va_arg(args, long long); break;
+                    case LEN_Z:  v = (int64_t)va_arg(args, size_t);    break;
+                    case LEN_J:  v = va_arg(args, intmax_t);  break;
+                    case LEN_T:  v = va_arg(args, ptrdiff_t); break;
+                    default:     v = va_arg(args, int);       break;
+                }
+                n = intern_put_svar(out, n, cap, v);
+                break;
+            }
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            {
+                uint64_t v;
+
+                switch (len)
+                {
+                    case LEN_L:  v = va_arg(args, unsigned long);      break;
+                    case LEN_LL: v = va_arg(args, unsigned long long); break;
+                    case LEN_Z:  v = va_arg(args, size_t);             break;
+                    case LEN_J:  v = va_arg(args, uintmax_t);          break;
+                    case LEN_T:  v = (uint64_t)va_arg(args, ptrdiff_t); break;
+                    default:     v = va_arg(args, unsigned int);       break;
+                }
+                n = intern_put_uvar(out, n, cap, v);
+                break;
+            }
+
+            case 'c':
+                n = intern_put_uvar(out, n, cap, (uint8_t)va_arg(args, int));
+                break;
+
+            case 'p':
+                n = intern_put_uvar(out, n, cap, (uintptr_t)va_arg(args, void *));
+                break;
+
+            case 'a': case 'A':
+            case 'e': case 'E':
+            case 'f': case 'F':
+            case 'g': case 'G':
+            {
+                double v = (LEN_BIG_L == len) ? (double)va_arg(args, long double) :
+                                                va_arg(args, double);
+
+                if ((n + sizeof(v)) > cap)
+                {
+                    return -1;
+                }
+                memcpy(&out[n], &v, sizeof(v));   /* Little-endian targets */
+                n += sizeof(v);
+                break;
+            }
+
+            case 's':
+            {
+                const char *s = va_arg(args, const char *);
+                size_t      l;
+
+                if (NULL == s)
+                {
+                    s = "(null)";
+                }
+                l = strlen(s);
+                n = intern_put_uvar(out, n, cap, l);
+                if ((n > cap) || ((n + l) > cap))
+                {
+                    return -1;
+                }
+                memcpy(&out[n], s, l);
+                n += l;
+                break;
+            }
+
+            default:
+                return -1;      /* %n, or a malformed conversion */
+        }
+
+        if (n > cap)
+        {
+            return -1;
+        }
+    }
+
+    return (int)n;
+}
+
+int debug_intern_put_varint(uint8_t *out, size_t cap, uint32_t v)
+{
+    size_t n = intern_put_uvar(out, 0, cap, v);
+
+    return (n > cap) ? 0 : (int)n;
+}
+
+#endif /* DEBUG_WIRE_FORMAT == DEBUG_WIRE_INTERNED */
+
+/** @} */ // End of DEBUG_INTERN
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
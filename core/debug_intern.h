@@ -0,0 +1,111 @@
+/**
+ * @file      debug_intern.h
+ * @brief     String interning and argument encoding for the binary wire format.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Used by the debug core when DEBUG_WIRE_FORMAT is DEBUG_WIRE_INTERNED.
+ * Format strings and thread names are entered in a fixed open-addressing
+ * table keyed by their address; the slot index is the wire ID. The first
+ * use of a string in a generation asks the caller to send its definition
+ * (DEBUG_RECORD_DICT); debug_intern_reset() starts a new generation so
+ * every string is defined again before its next use, e.g. after the host
+ * has reconnected.
+ *
+ * Format strings are assumed to be constant. Thread names are also
+ * checked by content, as a port may reuse a name buffer.
+ *
+ * None of these functions lock; the core calls them with its lock held.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_INTERN Debug String Interning
+ *  @brief Dictionary and argument encoder of the interned wire format.
+ *  @{
+ */
+
+#ifndef DEBUG_INTERN_H
+#define DEBUG_INTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Look up (or enter) a string.
+ *
+ * @param[in]  str  String; its address is the key
+ * @param[in]  kind DEBUG_DICT_FORMAT or DEBUG_DICT_THREAD
+ * @param[out] id   Wire ID
+ *
+ * @retval 1   New in this generation: send a definition first
+ * @retval 0   Already defined
+ * @retval -1  Table full
+ */
+int debug_intern_lookup(const char *str, uint8_t kind, uint16_t *id);
+
+/**
+ * @brief Mark an ID as not defined (its definition could not be sent).
+ *
+ * @param[in] id Wire ID
+ */
+void debug_intern_forget(uint16_t id);
+
+/**
+ * @brief Start a new generation: every string is defined again on next use.
+ */
+void debug_intern_reset(void);
+
+/**
+ * @brief Encode printf arguments for a log record.
+ *
+ * @param[out] out  Destination
+ * @param[in]  cap  Size of out
+ * @param[in]  fmt  Format string
+ * @param[in]  args Arguments matching fmt
+ *
+ * @return Bytes written, or -1 if they do not fit or fmt uses a
+ *         conversion the wire format cannot carry (%n)
+ */
+int debug_intern_encode(uint8_t *out, size_t cap, const char *fmt, va_list args);
+
+/**
+ * @brief Encode one unsigned LEB128 varint.
+ *
+ * @param[out] out Destination
+ * @param[in]  cap Size of out (5 bytes always suffice)
+ * @param[in]  v   Value
+ *
+ * @return Bytes written, 0 if it does not fit
+ */
+int debug_intern_put_varint(uint8_t *out, size_t cap, uint32_t v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_INTERN_H */
+
+/** @} */ // End of DEBUG_INTERN
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
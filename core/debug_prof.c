@@ -0,0 +1,356 @@
+/**
+ * @file      debug_prof.c
+ * @brief     Function entry/exit profiler (-finstrument-functions).
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_prof.h. Each thread owns a single-producer, single-consumer
+ * ring: the hooks of that thread are the only writers of its head, and
+ * debug_prof_drain() the only writer of its tail, so an event costs a
+ * cycle counter read, two stores and a release, with no lock and no
+ * atomic read-modify-write. The exit flag is kept in bit 0 of the cycle
+ * count, so a slot is 8 bytes.
+ *
+ * When the ring is full, events are counted as dropped, and the next event
+ * stored is preceded by a gap marker (address 0) at which the host drops
+ * the calls it believed open.
+ *
+ * The drain turns the absolute cycle counts into deltas from the previous
+ * event, which is what goes on the wire; a record ends early when a delta
+ * would not fit in 31 bits, and the next one carries the absolute count.
+ *
+ * A thread claims its buffer through the thread table of debug_tracebuf.h:
+ * buffer i belongs to entry i. The name is sent once, before the thread's
+ * first events.
+ *
+ * The hooks call back into the port (is_isr(), get_thread_name(),
+ * get_cycles()), which may reach RTOS or HAL code that is itself
+ * instrumented. A reentrancy guard drops the events raised from inside
+ * prof_event(), so that recursion ends at one level. It is per thread on
+ * POSIX; elsewhere it is one flag, so a thread that preempts another
+ * inside prof_event() loses that event too. The host closes a call whose
+ * exit was lost at the exit of its caller, and ignores an unmatched exit.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_PROF
+ *  @{
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "config.h"
+#include "debug.h"
+#include "debug_prof.h"
+#include "debug_record.h"
+#include "debug_tracebuf.h"
+
+#if DEBUG_ENABLE_PROF == YES
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_PROF_EVENTS & (DEBUG_PROF_EVENTS - 1)) != 0
+#error "DEBUG_PROF_EVENTS must be a power of two."
+#endif
+
+#if (DEBUG_PROF_THREADS < 1) || (DEBUG_PROF_THREADS > 255)
+#error "DEBUG_PROF_THREADS must be 1..255."
+#endif
+
+/** @brief Ring index mask */
+#define PROF_MASK          ((uint32_t)DEBUG_PROF_EVENTS - 1U)
+
+/** @brief Events per record */
+#define PROF_BATCH         ((DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_prof_record_t)) / \
+                            sizeof(debug_prof_event_t))
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Ring slot */
+typedef struct
+{
+    uint32_t stamp;             /**< Cycle counter, bit 0 = exit */
+    uint32_t addr;              /**< Function address (low half) */
+} prof_slot_t;
+
+/** @brief Per-thread buffer */
+typedef struct
+{
+    uint32_t         head;      /**< Written by the owning thread only */
+    uint32_t         tail;      /**< Written by the drain only */
+    uint32_t         dropped;   /**< Written by the owning thread only */
+    uint32_t         gap;       /**< Events lost since the last one stored */
+    prof_slot_t      ring[DEBUG_PROF_EVENTS];
+} prof_thread_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static prof_thread_t           s_thread[DEBUG_PROF_THREADS];
+static debug_tracebuf_thread_t s_names[DEBUG_PROF_THREADS];  /**< Owner of each buffer */
+static uint8_t                 s_running = 0;
+static uint32_t                s_addr_hi = 0;  /**< Upper half of code addresses */
+
+/** @brief Set while the calling context is inside prof_event() */
+#if DEBUG_USE_POSIX
+static __thread uint8_t        s_inside  = 0;
+#else
+static volatile uint8_t        s_inside  = 0;
+#endif
+
+/** @brief Record being built by the drain */
+static uint8_t s_payload[DEBUG_RECORD_MAX_PAYLOAD];
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Buffer of the calling thread, claimed on first use.
+ *
+ * @return Buffer, or NULL if the thread is unknown or none is left
+ */
+static DEBUG_PROF_EXCLUDE prof_thread_t *prof_thread(void)
+{
+    const char *key = debug_thread_name();
+
+    if (NULL == key)
+    {
+        return NULL;
+    }
+
+    int i = debug_tracebuf_thread(s_names, DEBUG_PROF_THREADS, key);
+
+    return (i >= 0) ? &s_thread[i] : NULL;
+}
+
+/**
+ * @brief Record one event in the calling thread's buffer (guard held).
+ */
+static DEBUG_PROF_EXCLUDE void prof_store(const void *fn, uint32_t exit)
+{
+    if (0 != debug_in_isr())
+    {
+        return;
+    }
+
+    prof_thread_t *t = prof_thread();
+
+    if (NULL == t)
+    {
+        return;
+    }
+
+    uint32_t head  = t->head;
+    uint32_t used  = head - __atomic_load_n(&t->tail, __ATOMIC_ACQUIRE);
+    uint32_t stamp = debug_cycles() & ~1UL;
+
+    /* After a loss the first event is a gap marker, so the host knows
+     * exactly where its view of the call stack stops being valid */
+    if ((used + t->gap) >= DEBUG_PROF_EVENTS)
+    {
+        t->dropped++;
+        t->gap = 1U;
+        return;
+    }
+    if (0U != t->gap)
+    {
+        t->ring[head & PROF_MASK] = (prof_slot_t){ .stamp = stamp, .addr = 0U };
+        head++;
+        t->gap = 0U;
+    }
+
+    prof_slot_t *slot = &t->ring[head & PROF_MASK];
+
+    slot->stamp = stamp | exit;
+    slot->addr  = (uint32_t)(uintptr_t)fn;
+    __atomic_store_n(&t->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Record one event, unless raised from inside the profiler.
+ */
+static DEBUG_PROF_EXCLUDE void prof_event(const void *fn, uint32_t exit)
+{
+    if (0U == __atomic_load_n(&s_running, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    if (0U != s_inside)
+    {
+        return;     /* Raised by a port call of prof_store() */
+    }
+
+    s_inside = 1U;
+    prof_store(fn, exit);
+    s_inside = 0U;
+}
+
+/**
+ * @brief Send the name of a thread buffer.
+ *
+ * @retval 0   Sent
+ * @retval -1  Transport error
+ */
+static int prof_send_name(uint8_t index)
+{
+    debug_prof_record_t rec;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version   = DEBUG_PROF_VERSION;
+    rec.thread    = index;
+    rec.flags     = DEBUG_PROF_FLAG_NAME;
+    rec.addr_hi   = s_addr_hi;
+    rec.cycles_hz = (uint32_t)DEBUG_CYCLES_HZ;
+
+    memcpy(s_payload, &rec, sizeof(rec));
+    memcpy(&s_payload[sizeof(rec)], s_names[index].name, DEBUG_RECORD_NAME_LEN);
+
+    return (debug_write_record(DEBUG_RECORD_PROF, s_payload,
+                               sizeof(rec) + DEBUG_RECORD_NAME_LEN) < 0) ? -1 : 0;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Start recording function entries and exits.
+ */
+void debug_prof_start(void)
+{
+    s_addr_hi = (uint32_t)((uint64_t)(uintptr_t)&debug_prof_drain >> 32);
+    __atomic_store_n(&s_running, 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Stop recording.
+ */
+void debug_prof_stop(void)
+{
+    __atomic_store_n(&s_running, 0U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Send the recorded events.
+ *
+ * @return Number of events sent
+ */
+int debug_prof_drain(void)
+{
+    int sent = 0;
+
+    for (uint32_t i = 0; i < DEBUG_PROF_THREADS; i++)
+    {
+        prof_thread_t *t     = &s_thread[i];
+        uint8_t        state = __atomic_load_n(&s_names[i].state, __ATOMIC_ACQUIRE);
+
+        if (state < DEBUG_TRACEBUF_THREAD_READY)
+        {
+            continue;   /* Unused, or name still being copied */
+        }
+        if (NULL != debug_tracebuf_thread_pending(&s_names[i]))
+        {
+            if (0 != prof_send_name((uint8_t)i))
+            {
+                continue;
+            }
+            debug_tracebuf_thread_sent(&s_names[i]);
+        }
+
+        uint32_t tail = t->tail;
+        uint32_t head = __atomic_load_n(&t->head, __ATOMIC_ACQUIRE);
+
+        while (tail != head)
+        {
+            debug_prof_record_t rec;
+            uint32_t            first = t->ring[tail & PROF_MASK].stamp & ~1UL;
+            uint32_t            prev  = first;
+            uint8_t             count = 0;
+
+            while ((tail != head) && (count < PROF_BATCH))
+            {
+                const prof_slot_t *slot  = &t->ring[tail & PROF_MASK];
+                uint32_t           stamp = slot->stamp & ~1UL;
+                debug_prof_event_t ev;
+
+                ev.delta = stamp - prev;
+                if (ev.delta > DEBUG_PROF_DELTA_MASK)
+                {
+                    break;      /* Next record restarts from an absolute count */
+                }
+                if (0U != (slot->stamp & 1UL))
+                {
+                    ev.delta |= DEBUG_PROF_EXIT;
+                }
+                ev.addr = slot->addr;
+                memcpy(&s_payload[sizeof(rec) + (count * sizeof(ev))], &ev, sizeof(ev));
+
+                prev = stamp;
+                count++;
+                tail++;
+            }
+
+            memset(&rec, 0, sizeof(rec));
+            rec.version   = DEBUG_PROF_VERSION;
+            rec.thread    = (uint8_t)i;
+            rec.count     = count;
+            rec.cycles    = first;
+            rec.addr_hi   = s_addr_hi;
+            rec.cycles_hz = (uint32_t)DEBUG_CYCLES_HZ;
+            rec.dropped   = __atomic_load_n(&t->dropped, __ATOMIC_RELAXED);
+            memcpy(s_payload, &rec, sizeof(rec));
+
+            /* Slots are free once copied into the record */
+            __atomic_store_n(&t->tail, tail, __ATOMIC_RELEASE);
+
+            (void)debug_write_record(DEBUG_RECORD_PROF, s_payload,
+                                     sizeof(rec) + (count * sizeof(debug_prof_event_t)));
+            sent += count;
+        }
+    }
+
+    return sent;
+}
+
+/**
+ * @brief Compiler hook: function entry.
+ */
+void __cyg_profile_func_enter(void *fn, void *site)
+{
+    (void)site;
+    prof_event(fn, 0U);
+}
+
+/**
+ * @brief Compiler hook: function exit.
+ */
+void __cyg_profile_func_exit(void *fn, void *site)
+{
+    (void)site;
+    prof_event(fn, 1U);
+}
+
+#endif /* DEBUG_ENABLE_PROF */
+
+/** @} */ // End of DEBUG_PROF
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,113 @@
+/**
+ * @file      debug_prof.h
+ * @brief     Function entry/exit profiler (-finstrument-functions).
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Implements __cyg_profile_func_enter() and __cyg_profile_func_exit(),
+ * which GCC and Clang call around every function of code compiled with
+ * -finstrument-functions. Each call stores an 8-byte event (cycle counter
+ * and function address) in a buffer owned by the calling thread, without
+ * locks. debug_prof_drain() sends the buffers as DEBUG_RECORD_PROF
+ * records; tools/prof_flame rebuilds the call stacks and writes flame
+ * graphs and call-count tables.
+ *
+ * Exclusions:
+ *  - The debug module, the RTOS kernel and the HAL must be built without
+ *    instrumentation: the hooks call the port (is_isr(), get_thread_name(),
+ *    get_cycles()), which reaches kernel and HAL functions. A reentrancy
+ *    guard stops the recursion, but drops every event raised inside the
+ *    hooks, and off POSIX also events of threads that preempt a hook:
+ * @code
+ *   -finstrument-functions \
+ *   -finstrument-functions-exclude-file-list=debug/core,debug/port,debug/transport,FreeRTOS/Source,Drivers
+ * @endcode
+ *  - Interrupt handlers are skipped at run time through the port's
+ *    is_isr(). To keep their cost out entirely, exclude them by name
+ *    (-finstrument-functions-exclude-function-list=_IRQHandler,_Handler)
+ *    or mark them DEBUG_PROF_EXCLUDE.
+ *
+ * Events are recorded between debug_prof_start() and debug_prof_stop(),
+ * after debug_init(). Threads are told apart by the name pointer the port
+ * returns and by the name; the first DEBUG_PROF_THREADS threads get a
+ * buffer.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_PROF Debug Function Profiler
+ *  @brief Instrumented function entry/exit events.
+ *  @{
+ */
+
+#ifndef DEBUG_PROF_H
+#define DEBUG_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "config.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Keep a function out of -finstrument-functions */
+#define DEBUG_PROF_EXCLUDE  __attribute__((no_instrument_function))
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+#if DEBUG_ENABLE_PROF == YES
+
+/**
+ * @brief Start recording function entries and exits.
+ */
+void debug_prof_start(void);
+
+/**
+ * @brief Stop recording. Events already recorded can still be drained.
+ */
+void debug_prof_stop(void);
+
+/**
+ * @brief Send the recorded events.
+ *
+ * @return Number of events sent
+ *
+ * @note Single consumer: call from one thread only, not from an ISR.
+ *       Call at least every 2^31 cycles (about 12 s at 168 MHz) while
+ *       profiling, so the host can extend the 32-bit cycle counter.
+ */
+int debug_prof_drain(void);
+
+/** @brief Compiler hook: function entry */
+void __cyg_profile_func_enter(void *fn, void *site) DEBUG_PROF_EXCLUDE;
+
+/** @brief Compiler hook: function exit */
+void __cyg_profile_func_exit(void *fn, void *site) DEBUG_PROF_EXCLUDE;
+
+#endif /* DEBUG_ENABLE_PROF */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_PROF_H */
+
+/** @} */ // End of DEBUG_PROF
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
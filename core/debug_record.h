@@ -0,0 +1,703 @@
+/**
+ * @file      debug_record.h
+ * @brief     Binary record framing for the debug output stream.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Besides plain text lines, the debug framework can emit compact binary
+ * records (crash dumps, backtraces, ...) on the same transport. Text
+ * output never contains a NUL byte, so a record is introduced by
+ * @ref DEBUG_RECORD_MARKER and can be told apart from text without any
+ * escaping:
+ *
+ * @code
+ *   +--------+------+-----------+-------------------+-------+
+ *   | 0x00   | type | len (LE)  | payload (len)     | crc8  |
+ *   +--------+------+-----------+-------------------+-------+
+ *     1 byte  1 byte   2 bytes                        1 byte
+ * @endcode
+ *
+ * The CRC-8 (polynomial 0x07, init 0x00) covers type, length and payload.
+ *
+ * This header only uses fixed-width types and does not depend on
+ * config.h, so host-side tools can include it to decode the stream.
+ * All multi-byte fields are little-endian.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_RECORD Debug Binary Records
+ *  @brief Wire format of binary records in the debug stream.
+ *  @{
+ */
+
+#ifndef DEBUG_RECORD_H
+#define DEBUG_RECORD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief First byte of every binary record */
+#define DEBUG_RECORD_MARKER         0x00U
+
+/** @brief Size of the record header (marker, type, length) */
+#define DEBUG_RECORD_HEADER_SIZE    4U
+
+/** @brief Size of the record trailer (CRC-8) */
+#define DEBUG_RECORD_TRAILER_SIZE   1U
+
+/** @brief Crash record format version */
+#define DEBUG_CRASH_VERSION         1U
+
+/** @brief Crash record flag: fault taken from thread mode using PSP */
+#define DEBUG_CRASH_FLAG_PSP        0x01U
+
+/** @brief Crash record flag: extended (FPU) exception frame */
+#define DEBUG_CRASH_FLAG_FPU        0x02U
+
+/** @brief Crash record flag: fault taken from thread mode */
+#define DEBUG_CRASH_FLAG_THREAD     0x04U
+
+/** @brief Sync record format version */
+#define DEBUG_SYNC_VERSION          1U
+
+/** @brief Dictionary entry kind: printf format string */
+#define DEBUG_DICT_FORMAT           1U
+
+/** @brief Dictionary entry kind: thread name */
+#define DEBUG_DICT_THREAD           2U
+
+/** @brief Log record flag: seq field valid */
+#define DEBUG_LOG_HAS_SEQ           0x01U
+
+/** @brief Log record flag: timestamp field valid */
+#define DEBUG_LOG_HAS_TS            0x02U
+
+/** @brief Log record flag: thread_id field valid */
+#define DEBUG_LOG_HAS_THREAD        0x04U
+
+/** @brief Log record flag: sampled line, a varint factor precedes the arguments */
+#define DEBUG_LOG_HAS_WEIGHT        0x08U
+
+/** @brief Governor record format version */
+#define DEBUG_GOVERNOR_VERSION      1U
+
+/** @brief Governor reason: transport backlog above DEBUG_GOVERNOR_FILL_HIGH */
+#define DEBUG_GOVERNOR_FILL         0x01U
+
+/** @brief Governor reason: the transport rejected bytes */
+#define DEBUG_GOVERNOR_DROP         0x02U
+
+/** @brief Governor reason: offered rate above DEBUG_GOVERNOR_BYTES_PER_S */
+#define DEBUG_GOVERNOR_RATE         0x04U
+
+/** @brief Governor reason: debug_log() above DEBUG_GOVERNOR_CPU_PERMILLE */
+#define DEBUG_GOVERNOR_CPU          0x08U
+
+/** @brief Scope record format version */
+#define DEBUG_SCOPE_VERSION         1U
+
+/** @brief Scope record flag: the block ran over its threshold */
+#define DEBUG_SCOPE_SLOW            0x01U
+
+/** @brief Scope record flag: statistics summary (debug_scope_report()) */
+#define DEBUG_SCOPE_SUMMARY         0x02U
+
+/** @brief Scope record flag: count/min/max/total are valid */
+#define DEBUG_SCOPE_HAS_STATS       0x04U
+
+/** @brief Task statistics record format version */
+#define DEBUG_TASK_STATS_VERSION    1U
+
+/** @brief Task statistics flag: first sample of this task (totals since creation) */
+#define DEBUG_TASK_STATS_NEW        0x01U
+
+/** @brief Task statistics flag: last record of the sample */
+#define DEBUG_TASK_STATS_LAST       0x02U
+
+/** @brief Kernel trace record format version */
+#define DEBUG_KTRACE_VERSION        1U
+
+/** @brief Kernel event: task switched in (object = TCB) */
+#define DEBUG_KTRACE_SWITCH_IN      1U
+/** @brief Kernel event: task switched out (object = TCB) */
+#define DEBUG_KTRACE_SWITCH_OUT     2U
+/** @brief Kernel event: task created (object = TCB, arg = priority) */
+#define DEBUG_KTRACE_TASK_CREATE    3U
+/** @brief Kernel event: 7 more bytes of a task name (arg, then data[]) */
+#define DEBUG_KTRACE_TASK_NAME      4U
+/** @brief Kernel event: task deleted (object = TCB) */
+#define DEBUG_KTRACE_TASK_DELETE    5U
+/** @brief Kernel event: interrupt entry (object = exception number) */
+#define DEBUG_KTRACE_ISR_ENTER      6U
+/** @brief Kernel event: interrupt exit */
+#define DEBUG_KTRACE_ISR_EXIT       7U
+/** @brief Kernel event: queue send / semaphore give (arg = queue type) */
+#define DEBUG_KTRACE_QUEUE_SEND     8U
+/** @brief Kernel event: queue receive / semaphore take (arg = queue type) */
+#define DEBUG_KTRACE_QUEUE_RECEIVE  9U
+/** @brief Kernel event: blocking on a full queue (arg = queue type) */
+#define DEBUG_KTRACE_BLOCK_SEND     10U
+/** @brief Kernel event: blocking on an empty queue (arg = queue type) */
+#define DEBUG_KTRACE_BLOCK_RECEIVE  11U
+/** @brief Kernel event: task notified (object = notified TCB) */
+#define DEBUG_KTRACE_NOTIFY         12U
+/** @brief Kernel event: blocking on a notification (object = TCB) */
+#define DEBUG_KTRACE_NOTIFY_WAIT    13U
+
+/** @brief Kernel event flag (data[0]): raised from an ISR API */
+#define DEBUG_KTRACE_FROM_ISR       0x01U
+
+/** @brief Heap trace record format version */
+#define DEBUG_HEAP_VERSION          1U
+
+/** @brief Heap event: allocation (address 0 = failed) */
+#define DEBUG_HEAP_ALLOC            1U
+/** @brief Heap event: free */
+#define DEBUG_HEAP_FREE             2U
+/** @brief Heap event: name of a thread index */
+#define DEBUG_HEAP_THREAD           3U
+
+/** @brief Heap event thread index when the thread is not known */
+#define DEBUG_HEAP_NO_THREAD        0xFFU
+
+/** @brief Watch record format version */
+#define DEBUG_WATCH_VERSION         1U
+
+/** @brief Watch variable type: uint8_t */
+#define DEBUG_WATCH_U8              1U
+/** @brief Watch variable type: int8_t */
+#define DEBUG_WATCH_I8              2U
+/** @brief Watch variable type: uint16_t */
+#define DEBUG_WATCH_U16             3U
+/** @brief Watch variable type: int16_t */
+#define DEBUG_WATCH_I16             4U
+/** @brief Watch variable type: uint32_t */
+#define DEBUG_WATCH_U32             5U
+/** @brief Watch variable type: int32_t */
+#define DEBUG_WATCH_I32             6U
+/** @brief Watch variable type: float */
+#define DEBUG_WATCH_F32             7U
+/** @brief Watch variable type: uint64_t */
+#define DEBUG_WATCH_U64             8U
+/** @brief Watch variable type: int64_t */
+#define DEBUG_WATCH_I64             9U
+/** @brief Watch variable type: double */
+#define DEBUG_WATCH_F64             10U
+
+/** @brief Array record format version */
+#define DEBUG_ARRAY_VERSION         1U
+
+/** @brief Array element type: uint8_t (same codes as DEBUG_WATCH_xxx) */
+#define DEBUG_ARRAY_U8              DEBUG_WATCH_U8
+/** @brief Array element type: int8_t */
+#define DEBUG_ARRAY_I8              DEBUG_WATCH_I8
+/** @brief Array element type: uint16_t */
+#define DEBUG_ARRAY_U16             DEBUG_WATCH_U16
+/** @brief Array element type: int16_t */
+#define DEBUG_ARRAY_I16             DEBUG_WATCH_I16
+/** @brief Array element type: uint32_t */
+#define DEBUG_ARRAY_U32             DEBUG_WATCH_U32
+/** @brief Array element type: int32_t */
+#define DEBUG_ARRAY_I32             DEBUG_WATCH_I32
+/** @brief Array element type: float */
+#define DEBUG_ARRAY_F32             DEBUG_WATCH_F32
+/** @brief Array element type: uint64_t */
+#define DEBUG_ARRAY_U64             DEBUG_WATCH_U64
+/** @brief Array element type: int64_t */
+#define DEBUG_ARRAY_I64             DEBUG_WATCH_I64
+/** @brief Array element type: double */
+#define DEBUG_ARRAY_F64             DEBUG_WATCH_F64
+
+/** @brief Profiler record format version */
+#define DEBUG_PROF_VERSION          1U
+
+/** @brief Profiler record flag: a thread name follows instead of events */
+#define DEBUG_PROF_FLAG_NAME        0x01U
+
+/** @brief Profiler event flag (delta word): function exit, else entry */
+#define DEBUG_PROF_EXIT             0x80000000UL
+
+/** @brief Profiler event delta bits (delta word) */
+#define DEBUG_PROF_DELTA_MASK       0x7FFFFFFFUL
+
+/** @brief Sample record format version */
+#define DEBUG_SAMPLE_VERSION        1U
+
+/** @brief Sample record flag: a thread name follows instead of samples */
+#define DEBUG_SAMPLE_FLAG_NAME      0x01U
+
+/** @brief Sample thread index: interrupt context */
+#define DEBUG_SAMPLE_ISR            0xFEU
+
+/** @brief Sample thread index: thread not known */
+#define DEBUG_SAMPLE_NO_THREAD      0xFFU
+
+/** @brief Mux frame flag (channel byte): a drop count follows the header */
+#define DEBUG_MUX_FLAG_DROPPED      0x80U
+
+/** @brief Mux frame channel ID bits (channel byte) */
+#define DEBUG_MUX_CHANNEL_MASK      0x7FU
+
+/** @brief Length of the task name field in records */
+#define DEBUG_RECORD_NAME_LEN       16U
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @enum debug_record_type_t
+ * @brief Binary record types.
+ */
+typedef enum
+{
+    DEBUG_RECORD_CRASH = 1,     /*!< Fault dump, see debug_crash_record_t */
+    DEBUG_RECORD_BACKTRACE,     /*!< Error call chain, see debug_backtrace_record_t */
+    DEBUG_RECORD_SYNC,          /*!< Clock beacon, see debug_sync_record_t */
+    DEBUG_RECORD_PING,          /*!< Host to device, see debug_ping_record_t */
+    DEBUG_RECORD_PONG,          /*!< Answer to a ping, see debug_pong_record_t */
+    DEBUG_RECORD_DICT,          /*!< String definition, see debug_dict_record_t */
+    DEBUG_RECORD_LOG,           /*!< Interned log line, see debug_log_record_t */
+    DEBUG_RECORD_GOVERNOR,      /*!< Effective level change, see debug_governor_record_t */
+    DEBUG_RECORD_SCOPE,         /*!< Slow block or timer summary, see debug_scope_record_t */
+    DEBUG_RECORD_TASK_STATS,    /*!< Per-task run time, see debug_task_stats_record_t */
+    DEBUG_RECORD_KTRACE,        /*!< Kernel events, see debug_ktrace_record_t */
+    DEBUG_RECORD_HEAP,          /*!< Heap events, see debug_heap_record_t */
+    DEBUG_RECORD_WATCH_DEF,     /*!< Watched variables, see debug_watch_def_record_t */
+    DEBUG_RECORD_WATCH,         /*!< Watch samples, see debug_watch_record_t */
+    DEBUG_RECORD_MUX,           /*!< Channel frame, see debug_mux_record_t */
+    DEBUG_RECORD_ARRAY,         /*!< Logged array, see debug_array_record_t */
+    DEBUG_RECORD_PROF,          /*!< Function entries/exits, see debug_prof_record_t */
+    DEBUG_RECORD_SAMPLE,        /*!< PC samples, see debug_sample_record_t */
+} debug_record_type_t;
+
+/**
+ * @brief Crash dump record payload.
+ *
+ * Followed by @c stack_words 32-bit words copied from the faulting stack,
+ * starting right above the exception frame.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;                       /**< DEBUG_CRASH_VERSION */
+    uint8_t  flags;                         /**< DEBUG_CRASH_FLAG_xxx */
+    uint16_t stack_words;                   /**< Number of trailing stack words */
+    uint32_t r0;                            /**< Stacked R0 */
+    uint32_t r1;                            /**< Stacked R1 */
+    uint32_t r2;                            /**< Stacked R2 */
+    uint32_t r3;                            /**< Stacked R3 */
+    uint32_t r12;                           /**< Stacked R12 */
+    uint32_t lr;                            /**< Stacked LR */
+    uint32_t pc;                            /**< Stacked PC (faulting instruction) */
+    uint32_t xpsr;                          /**< Stacked xPSR */
+    uint32_t exc_return;                    /**< EXC_RETURN value in handler LR */
+    uint32_t sp;                            /**< SP before the exception */
+    uint32_t cfsr;                          /**< Configurable Fault Status */
+    uint32_t hfsr;                          /**< HardFault Status */
+    uint32_t mmfar;                         /**< MemManage Fault Address */
+    uint32_t bfar;                          /**< BusFault Address */
+    uint32_t timestamp;                     /**< Port timestamp at capture */
+    char     task[DEBUG_RECORD_NAME_LEN];   /**< Faulting task, NUL padded */
+} debug_crash_record_t;
+
+/**
+ * @brief Backtrace record payload.
+ *
+ * Follows the text line of the LOG_ERROR it belongs to. Followed by
+ * @c depth return addresses of @c addr_size bytes each, innermost
+ * (the LOG_ERROR call site) first.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t seq;          /**< Sequence number of the log line (0 if disabled) */
+    uint32_t cycles;       /**< Capture cost in DEBUG_CYCLES_HZ ticks */
+    uint8_t  addr_size;    /**< Size of each address: 4 or 8 */
+    uint8_t  depth;        /**< Number of addresses */
+    uint16_t reserved;     /**< Zero */
+} debug_backtrace_record_t;
+
+/**
+ * @brief Clock sync beacon payload.
+ *
+ * Sent periodically so the host can relate the device timestamps of the
+ * surrounding lines to its own clock. @c timestamp and @c cycles are
+ * sampled back to back; the cycle counter refines the port tick.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_SYNC_VERSION */
+    uint8_t  reserved[3];  /**< Zero */
+    uint32_t seq;          /**< Last sequence number issued */
+    uint32_t timestamp;    /**< Port timestamp (get_timestamp) */
+    uint32_t tick_hz;      /**< Rate of the port timestamp */
+    uint32_t cycles;       /**< Port cycle counter (0 if none) */
+    uint32_t cycles_hz;    /**< Rate of the cycle counter (0 if none) */
+} debug_sync_record_t;
+
+/**
+ * @brief Ping record payload (host to device).
+ *
+ * @c host_time is opaque to the device and echoed in the pong; the host
+ * tools put their send time in nanoseconds there.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t id;           /**< Host chosen identifier */
+    uint64_t host_time;    /**< Echoed unchanged */
+} debug_ping_record_t;
+
+/**
+ * @brief Pong record payload (device to host).
+ *
+ * Carries the device time at which the ping was received and at which
+ * the pong was sent. With the host send and receive times this gives
+ * one NTP-style offset sample whose error is bounded by half the
+ * round trip.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t id;           /**< From the ping */
+    uint64_t host_time;    /**< From the ping */
+    uint32_t rx_timestamp; /**< Port timestamp when the ping was read */
+    uint32_t rx_cycles;    /**< Cycle counter when the ping was read */
+    uint32_t tx_timestamp; /**< Port timestamp when the pong was built */
+    uint32_t tx_cycles;    /**< Cycle counter when the pong was built */
+} debug_pong_record_t;
+
+/**
+ * @brief Dictionary record payload.
+ *
+ * Defines (or redefines) the string behind an ID used by log records.
+ * Followed by the string bytes, without a terminating NUL. IDs are
+ * shared by all kinds.
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t id;           /**< String ID */
+    uint8_t  kind;         /**< DEBUG_DICT_xxx */
+    uint8_t  reserved;     /**< Zero */
+} debug_dict_record_t;
+
+/**
+ * @brief Interned log line payload.
+ *
+ * Stands for the text line "[seq][ts][thread][LEVEL] message", or
+ * "[seq][ts][thread][LEVEL][1/N] message" for a sampled line. With
+ * DEBUG_LOG_HAS_WEIGHT, the sampling factor N follows as a LEB128
+ * varint. Then come the printf arguments, encoded in the order of the
+ * conversions in the format string:
+ *  - '*' width/precision, d, i: zigzag LEB128 varint
+ *  - u, o, x, X, c, p: LEB128 varint
+ *  - a, e, f, g (any case): IEEE 754 double, 8 bytes
+ *  - s: varint length, then the bytes (no NUL)
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  flags;        /**< DEBUG_LOG_HAS_xxx */
+    uint8_t  level;        /**< log_level_t */
+    uint16_t fmt_id;       /**< DEBUG_DICT_FORMAT string */
+    uint16_t thread_id;    /**< DEBUG_DICT_THREAD string */
+    uint32_t seq;          /**< Sequence number */
+    uint32_t timestamp;    /**< Port timestamp */
+} debug_log_record_t;
+
+/**
+ * @brief Governor state change payload.
+ *
+ * Sent when the effective log level changes. The counters cover the
+ * window that triggered the change.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_GOVERNOR_VERSION */
+    uint8_t  level;        /**< New effective level (log_level_t) */
+    uint8_t  base;         /**< Level set with debug_set_level() */
+    uint8_t  reasons;      /**< DEBUG_GOVERNOR_xxx, 0 when restoring */
+    uint32_t timestamp;    /**< Port timestamp */
+    uint32_t window;       /**< Window length in port ticks */
+    uint32_t offered;      /**< Bytes handed to the transport */
+    uint32_t dropped;      /**< Bytes the transport rejected */
+    uint32_t shed;         /**< Lines filtered by the governor since the last record */
+    uint16_t cpu_permille; /**< Share of the window spent in debug_log() */
+    uint8_t  fill;         /**< Transport backlog in percent, 0xFF = unknown */
+    uint8_t  reserved;     /**< Zero */
+} debug_governor_record_t;
+
+/**
+ * @brief Scoped timer payload (LOG_TIME_SCOPE()).
+ *
+ * All times are in cycles of the port's get_cycles() counter. Followed
+ * by name_len bytes of the scope name (no NUL).
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_SCOPE_VERSION */
+    uint8_t  flags;        /**< DEBUG_SCOPE_xxx */
+    uint8_t  name_len;     /**< Length of the name that follows */
+    uint8_t  reserved;     /**< Zero */
+    uint32_t timestamp;    /**< Port timestamp at the end of the block */
+    uint32_t cycles_hz;    /**< Counter rate (DEBUG_CYCLES_HZ) */
+    uint32_t elapsed;      /**< This run (0 in a summary) */
+    uint32_t threshold;    /**< Reporting threshold */
+    uint32_t count;        /**< Runs so far */
+    uint32_t over;         /**< Runs over the threshold */
+    uint32_t min;          /**< Fastest run */
+    uint32_t max;          /**< Slowest run */
+    uint64_t total;        /**< Sum of all runs */
+} debug_scope_record_t;
+
+/**
+ * @brief Task statistics payload (one record per task per sample).
+ *
+ * Run times are deltas of the FreeRTOS run-time counter since the
+ * previous sample, so run_time / total_time is the CPU share of the task
+ * over the period.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;       /**< DEBUG_TASK_STATS_VERSION */
+    uint8_t  flags;         /**< DEBUG_TASK_STATS_xxx */
+    uint8_t  state;         /**< eTaskState: 0 running .. 4 deleted */
+    uint8_t  tasks;         /**< Tasks in this sample */
+    uint16_t sample;        /**< Sample number (wraps) */
+    uint8_t  priority;      /**< Current priority */
+    uint8_t  base_priority; /**< Base priority (before inheritance) */
+    uint32_t task_number;   /**< xTaskNumber, unique per task */
+    uint32_t timestamp;     /**< Port timestamp of the sample */
+    uint32_t run_time;      /**< Run-time counter delta of this task */
+    uint32_t total_time;    /**< Run-time counter delta of the sample */
+    uint32_t stack_free;    /**< Stack high-water mark in bytes */
+    char     name[DEBUG_RECORD_NAME_LEN]; /**< Task name, NUL padded */
+} debug_task_stats_record_t;
+
+/**
+ * @brief One kernel trace event (fixed size, 16 bytes).
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t cycles;       /**< Cycle counter when the event was raised */
+    uint32_t object;       /**< Task, queue or exception number */
+    uint32_t arg;          /**< Event specific (see DEBUG_KTRACE_xxx) */
+    uint8_t  type;         /**< DEBUG_KTRACE_xxx */
+    uint8_t  data[3];      /**< Flags in data[0]; name bytes for TASK_NAME */
+} debug_ktrace_event_t;
+
+/**
+ * @brief Kernel trace payload: a batch of events drained from the ring.
+ *
+ * Followed by count debug_ktrace_event_t, oldest first.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_KTRACE_VERSION */
+    uint8_t  count;        /**< Events that follow */
+    uint16_t reserved;     /**< Zero */
+    uint32_t cycles_hz;    /**< Cycle counter rate (DEBUG_CYCLES_HZ) */
+    uint32_t dropped;      /**< Events lost to a full ring since boot */
+} debug_ktrace_record_t;
+
+/**
+ * @brief Heap trace payload: a batch of allocation events.
+ *
+ * Followed by count events, each starting with a type and a thread
+ * index byte:
+ *  - DEBUG_HEAP_ALLOC / DEBUG_HEAP_FREE: zigzag varint timestamp delta
+ *    (from the previous event, the first from timestamp), then varints
+ *    address, size (0 if unknown on free) and caller address.
+ *  - DEBUG_HEAP_THREAD: name length byte and the name of the index.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_HEAP_VERSION */
+    uint8_t  count;        /**< Events that follow */
+    uint16_t reserved;     /**< Zero */
+    uint32_t timestamp;    /**< Port timestamp the first delta is based on */
+    uint32_t dropped;      /**< Events lost to a full ring since boot */
+} debug_heap_record_t;
+
+/**
+ * @brief Watch table payload: the variables in a frame, in order.
+ *
+ * Followed by count debug_watch_var_t entries. Sent before the first
+ * frames of a layout and every DEBUG_WATCH_DEF_PERIOD frame records.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_WATCH_VERSION */
+    uint8_t  layout;       /**< Layout number, changes with the table */
+    uint8_t  count;        /**< Variables that follow */
+    uint8_t  reserved;     /**< Zero */
+    uint32_t cycles_hz;    /**< Rate of the frame timestamps (DEBUG_CYCLES_HZ) */
+} debug_watch_def_record_t;
+
+/** @brief Watched variable description */
+typedef struct __attribute__((packed))
+{
+    uint8_t  type;                          /**< DEBUG_WATCH_xxx */
+    char     name[DEBUG_RECORD_NAME_LEN];   /**< Variable name, NUL padded */
+} debug_watch_var_t;
+
+/**
+ * @brief Watch frames payload: consecutive samples of one layout.
+ *
+ * Followed by count frames, each a 32-bit cycle counter value and the
+ * variables of the layout, packed little-endian in table order. Frame
+ * i is sample seq + i; a gap in seq between records means samples were
+ * dropped on the target.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_WATCH_VERSION */
+    uint8_t  layout;       /**< Layout of the frames (see the table record) */
+    uint8_t  count;        /**< Frames that follow */
+    uint8_t  reserved;     /**< Zero */
+    uint32_t seq;          /**< Sample number of the first frame */
+    uint32_t dropped;      /**< Samples lost to a full ring since boot */
+} debug_watch_record_t;
+
+/**
+ * @brief Multiplexer frame payload: a piece of one channel's stream.
+ *
+ * With DEBUG_MUX_FLAG_DROPPED in @c channel, followed by a uint32_t count
+ * of the writes the channel dropped since boot; then the channel data.
+ * The data of consecutive frames of a channel concatenate to its stream.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  channel;      /**< Channel ID and DEBUG_MUX_FLAG_xxx */
+    uint8_t  seq;          /**< Frame counter of the channel */
+} debug_mux_record_t;
+
+/**
+ * @brief Logged array payload (LOG_ARRAY()), or a slice of one.
+ *
+ * Followed by the raw elements, little-endian, as many as fit in the
+ * record. An array that does not fit in one record is sent as several
+ * records with the same sequence number and increasing @c index. Each
+ * stands for the text line "[seq][ts][thread][LEVEL] name[index]: v v ...".
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_ARRAY_VERSION */
+    uint8_t  level;        /**< log_level_t */
+    uint8_t  type;         /**< DEBUG_ARRAY_xxx */
+    uint8_t  flags;        /**< DEBUG_LOG_HAS_xxx (WEIGHT unused) */
+    uint16_t name_id;      /**< DEBUG_DICT_FORMAT string: array label */
+    uint16_t thread_id;    /**< DEBUG_DICT_THREAD string */
+    uint32_t seq;          /**< Sequence number */
+    uint32_t timestamp;    /**< Port timestamp */
+    uint16_t index;        /**< Index of the first element in this record */
+    uint16_t total;        /**< Number of elements in the whole array */
+} debug_array_record_t;
+
+/**
+ * @brief Function profiler payload: a batch of one thread's events.
+ *
+ * Followed by count debug_prof_event_t, or with DEBUG_PROF_FLAG_NAME by
+ * the thread's name (DEBUG_RECORD_NAME_LEN bytes, NUL padded).
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_PROF_VERSION */
+    uint8_t  thread;       /**< Thread buffer index */
+    uint8_t  count;        /**< Events that follow */
+    uint8_t  flags;        /**< DEBUG_PROF_FLAG_xxx */
+    uint32_t cycles;       /**< Cycle counter at the first event */
+    uint32_t addr_hi;      /**< Upper half of the addresses (64-bit hosts) */
+    uint32_t cycles_hz;    /**< Cycle counter rate (DEBUG_CYCLES_HZ) */
+    uint32_t dropped;      /**< Events of this thread lost since boot */
+} debug_prof_record_t;
+
+/**
+ * @brief Function entry or exit.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t delta;        /**< Cycles since the previous event, DEBUG_PROF_EXIT */
+    uint32_t addr;         /**< Function address (low half), 0 = events lost here */
+} debug_prof_event_t;
+
+/**
+ * @brief PC sampling payload: a batch of samples of any thread.
+ *
+ * Followed by count debug_sample_t, or with DEBUG_SAMPLE_FLAG_NAME by the
+ * name of thread index @c thread (DEBUG_RECORD_NAME_LEN bytes, NUL padded).
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;      /**< DEBUG_SAMPLE_VERSION */
+    uint8_t  count;        /**< Samples that follow */
+    uint8_t  flags;        /**< DEBUG_SAMPLE_FLAG_xxx */
+    uint8_t  thread;       /**< Thread index (name records) */
+    uint32_t addr_hi;      /**< Upper half of the addresses (64-bit hosts) */
+    uint32_t rate_hz;      /**< Sampling rate, 0 if unknown */
+    uint32_t dropped;      /**< Samples lost to a full ring since boot */
+} debug_sample_record_t;
+
+/**
+ * @brief One PC sample.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t pc;           /**< Interrupted PC (low half), 0 = outside the image */
+    uint8_t  thread;       /**< Thread index, DEBUG_SAMPLE_ISR or _NO_THREAD */
+} debug_sample_t;
+
+/*******************************************************************************
+ * Inline Functions
+ *******************************************************************************/
+
+/**
+ * @brief Update a record CRC-8 (polynomial 0x07).
+ *
+ * @param[in] crc  Running CRC (0 to start)
+ * @param[in] data Data to add
+ * @param[in] len  Number of bytes
+ *
+ * @return Updated CRC
+ */
+static inline uint8_t debug_record_crc8(uint8_t crc, const uint8_t *data,
+                                        size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (0U != (crc & 0x80U)) ? (uint8_t)((crc << 1) ^ 0x07U) :
+                                          (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_RECORD_H */
+
+/** @} */ // End of DEBUG_RECORD
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,239 @@
+/**
+ * @file      debug_sample.c
+ * @brief     Statistical PC-sampling profiler.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_sample.h. The ring and the thread table are those of
+ * debug_tracebuf.h: a producer claims the slot at head with a
+ * compare-and-swap, fills it and publishes it by setting its ready flag
+ * last, so the POSIX signal may run on several threads at once. A sample is the low 32 bits
+ * of the PC and a thread index; a PC outside the 4 GiB window of the
+ * image (shared libraries on a 64-bit host) is sent as 0.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_SAMPLE
+ *  @{
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "config.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "debug_sample.h"
+#include "debug_tracebuf.h"
+
+#if DEBUG_ENABLE_SAMPLE == YES
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_SAMPLE_EVENTS & (DEBUG_SAMPLE_EVENTS - 1)) != 0
+#error "DEBUG_SAMPLE_EVENTS must be a power of two."
+#endif
+
+#if (DEBUG_SAMPLE_THREADS < 1) || (DEBUG_SAMPLE_THREADS > 254)
+#error "DEBUG_SAMPLE_THREADS must be 1..254."
+#endif
+
+/** @brief Ring index mask */
+#define SAMPLE_MASK          ((uint32_t)DEBUG_SAMPLE_EVENTS - 1U)
+
+/** @brief Samples per record */
+#define SAMPLE_BATCH         ((DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_sample_record_t)) / \
+                              sizeof(debug_sample_t))
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Ring slot */
+typedef struct
+{
+    uint32_t         pc;
+    uint8_t          thread;
+    volatile uint8_t ready;     /**< Written last */
+} sample_slot_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static sample_slot_t           s_ring[DEBUG_SAMPLE_EVENTS];
+static uint32_t                s_head    = 0;  /**< Slots claimed by producers */
+static uint32_t                s_tail    = 0;  /**< Slots taken by the drain */
+static uint32_t                s_dropped = 0;  /**< Samples lost to a full ring */
+static uint8_t                 s_running = 0;
+static uint32_t                s_rate    = 0;
+static uint32_t                s_addr_hi = 0;  /**< Upper half of code addresses */
+static debug_tracebuf_thread_t s_thread[DEBUG_SAMPLE_THREADS];
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Thread table index of a name pointer.
+ *
+ * @return Index, or DEBUG_SAMPLE_NO_THREAD if the table is full
+ */
+static uint8_t sample_thread_index(const char *key)
+{
+    int i = debug_tracebuf_thread(s_thread, DEBUG_SAMPLE_THREADS, key);
+
+    return (i >= 0) ? (uint8_t)i : DEBUG_SAMPLE_NO_THREAD;
+}
+
+/**
+ * @brief Fill and send a record header and its samples.
+ */
+static void sample_send(uint8_t *payload, uint8_t flags, uint8_t thread,
+                        uint8_t count, size_t len)
+{
+    debug_sample_record_t rec;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version = DEBUG_SAMPLE_VERSION;
+    rec.count   = count;
+    rec.flags   = flags;
+    rec.thread  = thread;
+    rec.addr_hi = s_addr_hi;
+    rec.rate_hz = s_rate;
+    rec.dropped = __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+    memcpy(payload, &rec, sizeof(rec));
+
+    (void)debug_write_record(DEBUG_RECORD_SAMPLE, payload, len);
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_sample_start(uint32_t hz)
+{
+    s_rate    = hz;
+    s_addr_hi = (uint32_t)((uint64_t)(uintptr_t)&debug_sample_drain >> 32);
+    __atomic_store_n(&s_running, 1U, __ATOMIC_RELEASE);
+
+    int ret = debug_sample_timer(hz);
+
+    if (ret < 0)
+    {
+        __atomic_store_n(&s_running, 0U, __ATOMIC_RELEASE);
+    }
+
+    return ret;
+}
+
+void debug_sample_stop(void)
+{
+    (void)debug_sample_timer(0U);
+    __atomic_store_n(&s_running, 0U, __ATOMIC_RELEASE);
+}
+
+void debug_sample_tick(uintptr_t pc, const char *thread)
+{
+    if (0U == __atomic_load_n(&s_running, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    uint8_t  index = (NULL != thread) ? sample_thread_index(thread) : DEBUG_SAMPLE_ISR;
+    uint32_t head;
+
+    if (0 != debug_tracebuf_claim(&s_head, &s_tail, DEBUG_SAMPLE_EVENTS,
+                                  &s_dropped, &head))
+    {
+        return;
+    }
+
+    sample_slot_t *slot = &s_ring[head & SAMPLE_MASK];
+
+    slot->pc     = ((uint32_t)((uint64_t)pc >> 32) == s_addr_hi) ? (uint32_t)pc : 0U;
+    slot->thread = index;
+    __atomic_store_n(&slot->ready, 1U, __ATOMIC_RELEASE);
+}
+
+int debug_sample_drain(void)
+{
+    uint8_t  payload[DEBUG_RECORD_MAX_PAYLOAD];
+    uint8_t  count = 0;
+    int      sent  = 0;
+    uint32_t end   = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t tail  = s_tail;
+
+    /* Thread names first, so the host knows them before their samples */
+    for (uint32_t i = 0; i < DEBUG_SAMPLE_THREADS; i++)
+    {
+        const char *name = debug_tracebuf_thread_pending(&s_thread[i]);
+
+        if (NULL == name)
+        {
+            continue;
+        }
+
+        memcpy(&payload[sizeof(debug_sample_record_t)], name,
+               DEBUG_RECORD_NAME_LEN);
+        sample_send(payload, DEBUG_SAMPLE_FLAG_NAME, (uint8_t)i, 0U,
+                    sizeof(debug_sample_record_t) + DEBUG_RECORD_NAME_LEN);
+        debug_tracebuf_thread_sent(&s_thread[i]);
+    }
+
+    while (tail != end)
+    {
+        sample_slot_t *slot = &s_ring[tail & SAMPLE_MASK];
+
+        if (0U == __atomic_load_n(&slot->ready, __ATOMIC_ACQUIRE))
+        {
+            break;  /* Claimed but not yet published */
+        }
+
+        debug_sample_t s = { .pc = slot->pc, .thread = slot->thread };
+
+        memcpy(&payload[sizeof(debug_sample_record_t) + (count * sizeof(s))],
+               &s, sizeof(s));
+        count++;
+        sent++;
+
+        /* Free the slot before handing it back to the producers */
+        __atomic_store_n(&slot->ready, 0U, __ATOMIC_RELAXED);
+        tail++;
+        __atomic_store_n(&s_tail, tail, __ATOMIC_RELEASE);
+
+        if (SAMPLE_BATCH == count)
+        {
+            sample_send(payload, 0U, 0U, count, sizeof(debug_sample_record_t) +
+                                                (count * sizeof(debug_sample_t)));
+            count = 0;
+        }
+    }
+
+    if (0U != count)
+    {
+        sample_send(payload, 0U, 0U, count, sizeof(debug_sample_record_t) +
+                                            (count * sizeof(debug_sample_t)));
+    }
+
+    return sent;
+}
+
+#endif /* DEBUG_ENABLE_SAMPLE */
+
+/** @} */ // End of DEBUG_SAMPLE
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,109 @@
+/**
+ * @file      debug_sample.h
+ * @brief     Statistical PC-sampling profiler.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * A periodic timer interrupt calls debug_sample_tick() with the PC it
+ * interrupted and the thread that was running. Samples go into a
+ * lock-free ring and debug_sample_drain() sends them as DEBUG_RECORD_SAMPLE
+ * records, 48 per record; tools/prof_sample counts them per function
+ * against the ELF. Unlike core/debug_prof.h, no code is instrumented: the
+ * cost is one interrupt per sample, whatever the application does.
+ *
+ * Timer:
+ *  - POSIX port: debug_sample_start() arms a SIGPROF timer on the CPU time
+ *    of the process, so idle threads are not sampled.
+ *  - Cortex-M: define the SysTick or a spare timer handler with
+ *    DEBUG_PORT_SAMPLE_HANDLER (port/cortex_m/debug_port_sample.h), which
+ *    reads the PC from the exception frame, and start the timer yourself;
+ *    @p hz is then only reported to the host.
+ *
+ * Threads are reported under the name the port gives them. On POSIX, threads whose
+ * name is empty all count as "MAIN"; name them (pthread_setname_np() or
+ * debug_port_posix_set_thread_name()) to see them separately.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_SAMPLE Debug PC Sampling Profiler
+ *  @brief Timer-driven PC samples.
+ *  @{
+ */
+
+#ifndef DEBUG_SAMPLE_H
+#define DEBUG_SAMPLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+
+#include "config.h"
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+#if DEBUG_ENABLE_SAMPLE == YES
+
+/**
+ * @brief Start sampling.
+ *
+ * @param[in] hz Sampling rate
+ *
+ * @retval 0   Started with the port's timer
+ * @retval 1   Started, the port has no timer: the application drives
+ *             debug_sample_tick()
+ * @retval -1  The port's timer failed
+ */
+int debug_sample_start(uint32_t hz);
+
+/**
+ * @brief Stop sampling. Samples already taken can still be drained.
+ */
+void debug_sample_stop(void);
+
+/**
+ * @brief Record one sample.
+ *
+ * @param[in] pc     Interrupted program counter
+ * @param[in] thread Name pointer of the interrupted thread (as returned by
+ *                   the port), NULL if an interrupt handler was running
+ *
+ * @note Lock-free: call from the sampling interrupt or signal handler.
+ */
+void debug_sample_tick(uintptr_t pc, const char *thread);
+
+/**
+ * @brief Send the recorded samples.
+ *
+ * @return Number of samples sent
+ *
+ * @note Single consumer: call from one thread only, not from an ISR.
+ */
+int debug_sample_drain(void);
+
+#endif /* DEBUG_ENABLE_SAMPLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_SAMPLE_H */
+
+/** @} */ // End of DEBUG_SAMPLE
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,162 @@
+/**
+ * @file      debug_scope.c
+ * @brief     Threshold-triggered scoped timers.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_scope.h. Only slow runs and debug_scope_report() get here;
+ * the normal case is handled inline by debug_scope_exit().
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_SCOPE
+ *  @{
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "config.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "debug_scope.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Longest scope name sent in a record */
+#define SCOPE_NAME_MAX  (DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_scope_record_t))
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+/** @brief Call sites that have run, most recent first */
+static debug_scope_site_t *s_sites = NULL;
+#endif
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Build and send a scope record.
+ *
+ * @return Number of bytes written, or -1 on error
+ */
+static int scope_send(const debug_scope_site_t *site, uint8_t flags,
+                      uint32_t elapsed)
+{
+    uint8_t              payload[DEBUG_RECORD_MAX_PAYLOAD];
+    debug_scope_record_t rec;
+    size_t               len = strlen(site->name);
+
+    if (len > SCOPE_NAME_MAX)
+    {
+        len = SCOPE_NAME_MAX;
+    }
+    if (len > 0xFFU)
+    {
+        len = 0xFFU;
+    }
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version   = DEBUG_SCOPE_VERSION;
+    rec.flags     = flags;
+    rec.name_len  = (uint8_t)len;
+    rec.timestamp = debug_timestamp();
+    rec.cycles_hz = DEBUG_CYCLES_HZ;
+    rec.elapsed   = elapsed;
+    rec.threshold = site->threshold;
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    rec.flags    |= DEBUG_SCOPE_HAS_STATS;
+    rec.count     = site->count;
+    rec.over      = site->over;
+    rec.min       = site->min;
+    rec.max       = site->max;
+    rec.total     = site->total;
+#endif
+
+    memcpy(payload, &rec, sizeof(rec));
+    memcpy(&payload[sizeof(rec)], site->name, len);
+
+    return debug_write_record(DEBUG_RECORD_SCOPE, payload, sizeof(rec) + len);
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+void debug_scope_register(debug_scope_site_t *site)
+{
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    /* Two first runs racing would link the site twice; check again */
+    debug_lock_acquire();
+    if (0U == site->listed)
+    {
+        site->next   = s_sites;
+        s_sites      = site;
+        site->listed = 1U;
+    }
+    debug_lock_release();
+#else
+    (void)site;
+#endif
+}
+
+void debug_scope_slow(debug_scope_site_t *site, uint32_t elapsed)
+{
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    if (0U == site->listed)
+    {
+        debug_scope_register(site);
+    }
+    if ((0U == site->count) || (elapsed < site->min))
+    {
+        site->min = elapsed;
+    }
+    if (elapsed > site->max)
+    {
+        site->max = elapsed;
+    }
+    site->count++;
+    site->over++;
+    site->total += elapsed;
+#endif
+
+    (void)scope_send(site, DEBUG_SCOPE_SLOW, elapsed);
+}
+
+int debug_scope_report(void)
+{
+    int sent = 0;
+
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    for (const debug_scope_site_t *site = s_sites; NULL != site; site = site->next)
+    {
+        if (scope_send(site, DEBUG_SCOPE_SUMMARY, 0U) > 0)
+        {
+            sent++;
+        }
+    }
+#endif
+
+    return sent;
+}
+
+/** @} */ // End of DEBUG_SCOPE
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,207 @@
+/**
+ * @file      debug_scope.h
+ * @brief     Threshold-triggered scoped timers.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * LOG_TIME_SCOPE() times the rest of the enclosing block with the port's
+ * cycle counter and sends a DEBUG_RECORD_SCOPE record only when the block
+ * took longer than its threshold:
+ *
+ * @code
+ *   void control_step(void)
+ *   {
+ *       LOG_TIME_SCOPE("ctrl", 250);    // Report runs over 250 us
+ *       ...
+ *   }
+ * @endcode
+ *
+ * The normal case costs two counter reads, a compare and, with
+ * DEBUG_ENABLE_SCOPE_STATS, an update of the call site's count, min, max
+ * and total. debug_scope_report() sends those statistics for every call
+ * site that has run.
+ *
+ * The end of the block is caught with the GCC/Clang cleanup attribute,
+ * so return, break and goto out of the block are all timed. Without a
+ * cycle counter in the port (get_cycles() NULL) nothing is reported.
+ *
+ * The statistics of a call site are updated without a lock: a scope that
+ * runs in several threads at once may lose an update, never more.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_SCOPE Debug Scoped Timers
+ *  @brief Report blocks that run over a time threshold.
+ *  @{
+ */
+
+#ifndef DEBUG_SCOPE_H
+#define DEBUG_SCOPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+
+#include "config.h"
+#include "debug.h"
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Per call site state of LOG_TIME_SCOPE() (static storage).
+ */
+typedef struct debug_scope_site
+{
+    const char              *name;      /**< Scope name */
+    uint32_t                 threshold; /**< Reporting threshold in cycles */
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    struct debug_scope_site *next;      /**< Registration list */
+    uint8_t                  listed;    /**< On the registration list */
+    uint32_t                 count;     /**< Runs */
+    uint32_t                 over;      /**< Runs over the threshold */
+    uint32_t                 min;       /**< Fastest run */
+    uint32_t                 max;       /**< Slowest run */
+    uint64_t                 total;     /**< Sum of all runs */
+#endif
+} debug_scope_site_t;
+
+/**
+ * @brief One run of a timed scope (automatic storage).
+ */
+typedef struct
+{
+    debug_scope_site_t *site;   /**< Call site */
+    uint32_t            start;  /**< Counter at entry */
+} debug_scope_t;
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Microseconds to cycles of the port counter */
+#define DEBUG_US_TO_CYCLES(us) \
+    ((uint32_t)(((uint64_t)(us) * DEBUG_CYCLES_HZ) / 1000000ULL))
+
+/** @brief Token pasting helpers for unique local names */
+#define DEBUG_SCOPE_CAT2(a, b)  a##b
+#define DEBUG_SCOPE_CAT(a, b)   DEBUG_SCOPE_CAT2(a, b)
+
+#if DEBUG_ENABLE == YES
+
+/**
+ * @brief Time the rest of the enclosing block; report it if it takes
+ *        longer than @p threshold_us microseconds.
+ *
+ * @param scope_name   Scope name (string literal, sent in the record)
+ * @param threshold_us Reporting threshold in microseconds
+ */
+#define LOG_TIME_SCOPE(scope_name, threshold_us)                                \
+    static debug_scope_site_t DEBUG_SCOPE_CAT(debug_site_, __LINE__) =          \
+        { .name      = (scope_name),                                            \
+          .threshold = DEBUG_US_TO_CYCLES(threshold_us) };                      \
+    debug_scope_t DEBUG_SCOPE_CAT(debug_scope_, __LINE__)                       \
+        __attribute__((cleanup(debug_scope_exit), unused)) =                    \
+        { .site  = &DEBUG_SCOPE_CAT(debug_site_, __LINE__),                     \
+          .start = debug_cycles() }
+
+#else  /* DEBUG_ENABLE == NO */
+
+#define LOG_TIME_SCOPE(scope_name, threshold_us)
+
+#endif /* DEBUG_ENABLE */
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Send the record of a slow run and update its statistics.
+ *
+ * @param[in,out] site    Call site
+ * @param[in]     elapsed Duration of the run in cycles
+ *
+ * @note Called by debug_scope_exit(); not meant to be called directly.
+ */
+void debug_scope_slow(debug_scope_site_t *site, uint32_t elapsed);
+
+/**
+ * @brief Register a call site for debug_scope_report() (first run only).
+ *
+ * @param[in,out] site Call site
+ *
+ * @note Called by debug_scope_exit(); not meant to be called directly.
+ */
+void debug_scope_register(debug_scope_site_t *site);
+
+/**
+ * @brief Send a summary record for every call site that has run.
+ *
+ * @return Number of records sent
+ *
+ * @note Only available with DEBUG_ENABLE_SCOPE_STATS; returns 0 otherwise.
+ */
+int debug_scope_report(void);
+
+/*******************************************************************************
+ * Inline Functions
+ *******************************************************************************/
+
+/**
+ * @brief End of a timed scope (cleanup handler of LOG_TIME_SCOPE()).
+ *
+ * @param[in] scope Run that ends
+ */
+static inline void debug_scope_exit(debug_scope_t *scope)
+{
+    uint32_t            elapsed = debug_cycles() - scope->start;
+    debug_scope_site_t *site    = scope->site;
+
+    if (elapsed > site->threshold)
+    {
+        debug_scope_slow(site, elapsed);
+        return;
+    }
+
+#if DEBUG_ENABLE_SCOPE_STATS == YES
+    if (0U == site->listed)
+    {
+        debug_scope_register(site);
+    }
+    if ((0U == site->count) || (elapsed < site->min))
+    {
+        site->min = elapsed;
+    }
+    if (elapsed > site->max)
+    {
+        site->max = elapsed;
+    }
+    site->count++;
+    site->total += elapsed;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_SCOPE_H */
+
+/** @} */ // End of DEBUG_SCOPE
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,118 @@
+/**
+ * @file      debug_tracebuf.c
+ * @brief     Lock-free event ring and thread table shared by the tracers.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_tracebuf.h. A thread entry is claimed with a compare-and-swap
+ * on its key; the name is copied while the entry is BUSY and published by
+ * the release store of READY, so the drain never sends a partial name.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_TRACEBUF
+ *  @{
+ */
+
+#include "config.h"
+
+#if (DEBUG_ENABLE_HEAP_TRACE == YES) || (DEBUG_ENABLE_SAMPLE == YES) || \
+    (DEBUG_ENABLE_PROF == YES) || (DEBUG_ENABLE_KERNEL_TRACE == YES)
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+#include <stddef.h>
+
+#include "debug_tracebuf.h"
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_tracebuf_claim(uint32_t *head, const uint32_t *tail, uint32_t size,
+                         uint32_t *dropped, uint32_t *pos)
+{
+    uint32_t h = __atomic_load_n(head, __ATOMIC_RELAXED);
+
+    do
+    {
+        if ((h - __atomic_load_n(tail, __ATOMIC_ACQUIRE)) >= size)
+        {
+            (void)__atomic_fetch_add(dropped, 1U, __ATOMIC_RELAXED);
+            return -1;
+        }
+    } while (!__atomic_compare_exchange_n(head, &h, h + 1U, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    *pos = h;
+    return 0;
+}
+
+int debug_tracebuf_thread(debug_tracebuf_thread_t *table, uint32_t count,
+                          const char *key)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        debug_tracebuf_thread_t *e   = &table[i];
+        const char              *cur = __atomic_load_n(&e->key, __ATOMIC_ACQUIRE);
+
+        if ((NULL == cur) &&
+            __atomic_compare_exchange_n(&e->key, &cur, key, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            e->state = DEBUG_TRACEBUF_THREAD_BUSY;
+            strncpy(e->name, key, sizeof(e->name) - 1U);
+            __atomic_store_n(&e->state, DEBUG_TRACEBUF_THREAD_READY, __ATOMIC_RELEASE);
+            return (int)i;
+        }
+
+        /* A failed claim leaves in cur the key of the context that won */
+        if (cur != key)
+        {
+            continue;
+        }
+
+        /* Same buffer, but a thread that exited may have left it to a
+         * thread of another name: that one gets an entry of its own. An
+         * entry still being claimed is taken to hold the same name. */
+        if ((__atomic_load_n(&e->state, __ATOMIC_ACQUIRE) < DEBUG_TRACEBUF_THREAD_READY) ||
+            (0 == strncmp(e->name, key, sizeof(e->name) - 1U)))
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+const char *debug_tracebuf_thread_pending(const debug_tracebuf_thread_t *entry)
+{
+    if (DEBUG_TRACEBUF_THREAD_READY != __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+
+    return entry->name;
+}
+
+void debug_tracebuf_thread_sent(debug_tracebuf_thread_t *entry)
+{
+    entry->state = DEBUG_TRACEBUF_THREAD_SENT;
+}
+
+#endif /* tracers */
+
+/** @} */ // End of DEBUG_TRACEBUF
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
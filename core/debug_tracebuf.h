@@ -0,0 +1,132 @@
+/**
+ * @file      debug_tracebuf.h
+ * @brief     Lock-free event ring and thread table shared by the tracers.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Building blocks of the heap tracer, the PC sampler, the function
+ * profiler and the FreeRTOS kernel trace:
+ *  - debug_tracebuf_claim() claims the slot at head of a multi-producer,
+ *    single-consumer ring with a compare-and-swap. The caller fills the
+ *    slot and publishes it with its own release store (type or ready
+ *    flag); the drain advances tail.
+ *  - debug_tracebuf_thread() maps the calling thread to a table entry,
+ *    claimed on first use. The drain sends each entry's name once, before
+ *    the events that use it (debug_tracebuf_thread_pending() and
+ *    debug_tracebuf_thread_sent()).
+ *
+ * Thread entries match on the name pointer from the port and on the name:
+ * name buffers (POSIX TLS, FreeRTOS TCBs) are reused by later threads,
+ * which get an entry of their own.
+ *
+ * All functions may run in interrupt or signal context.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @defgroup DEBUG_TRACEBUF Debug Trace Buffers
+ *  @brief Ring claim and thread table of the lock-free tracers.
+ *  @{
+ */
+
+#ifndef DEBUG_TRACEBUF_H
+#define DEBUG_TRACEBUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+
+#include "debug_record.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Thread entry states */
+#define DEBUG_TRACEBUF_THREAD_FREE   0U
+#define DEBUG_TRACEBUF_THREAD_BUSY   1U   /**< Claimed, name being copied */
+#define DEBUG_TRACEBUF_THREAD_READY  2U   /**< Name to be sent */
+#define DEBUG_TRACEBUF_THREAD_SENT   3U
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** @brief Thread table entry */
+typedef struct
+{
+    const char      *key;       /**< Name pointer from the port */
+    volatile uint8_t state;     /**< DEBUG_TRACEBUF_THREAD_xxx */
+    char             name[DEBUG_RECORD_NAME_LEN];
+} debug_tracebuf_thread_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Claim the slot at head of a multi-producer ring.
+ *
+ * @param[in,out] head    Slots claimed by producers
+ * @param[in]     tail    Slots taken by the drain
+ * @param[in]     size    Ring size (power of two)
+ * @param[in,out] dropped Counter of events lost to a full ring
+ * @param[out]    pos     Claimed position (mask it with size - 1)
+ *
+ * @retval 0   Slot claimed
+ * @retval -1  Ring full; *dropped was incremented
+ */
+int debug_tracebuf_claim(uint32_t *head, const uint32_t *tail, uint32_t size,
+                         uint32_t *dropped, uint32_t *pos);
+
+/**
+ * @brief Table entry of a thread, claimed on first use.
+ *
+ * @param[in,out] table Thread table
+ * @param[in]     count Number of entries
+ * @param[in]     key   Thread name pointer from the port
+ *
+ * @retval >=0  Entry index
+ * @retval -1   Table full
+ */
+int debug_tracebuf_thread(debug_tracebuf_thread_t *table, uint32_t count,
+                          const char *key);
+
+/**
+ * @brief Name of an entry whose definition has not been sent yet.
+ *
+ * @param[in] entry Thread table entry
+ *
+ * @return Name to send, or NULL if the entry is free, busy or sent
+ */
+const char *debug_tracebuf_thread_pending(const debug_tracebuf_thread_t *entry);
+
+/**
+ * @brief Mark the name of an entry as sent (drain only).
+ *
+ * @param[in,out] entry Thread table entry
+ */
+void debug_tracebuf_thread_sent(debug_tracebuf_thread_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_TRACEBUF_H */
+
+/** @} */ // End of DEBUG_TRACEBUF
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,389 @@
+/**
+ * @file      debug_watch.c
+ * @brief     Variable watch: sampled binary frames of live variables.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_watch.h. The sampler and the flush share a single-producer,
+ * single-consumer frame ring. Each frame keeps the table state it was
+ * sampled with (layout number and variable mask in one word), so the
+ * flush only sends frames that match the table it describes; frames
+ * sampled before a change of the table are dropped.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/** @addtogroup DEBUG_WATCH
+ *  @{
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "config.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "debug_watch.h"
+
+#if DEBUG_ENABLE_WATCH == YES
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_WATCH_FRAMES & (DEBUG_WATCH_FRAMES - 1)) != 0
+#error "DEBUG_WATCH_FRAMES must be a power of two."
+#endif
+
+/* The state word has one mask bit per variable */
+#if (DEBUG_WATCH_MAX_VARS < 1) || (DEBUG_WATCH_MAX_VARS > 16)
+#error "DEBUG_WATCH_MAX_VARS must be 1..16."
+#endif
+
+/* The table record must hold every variable */
+#if (8 + (DEBUG_WATCH_MAX_VARS * 17)) > DEBUG_RECORD_MAX_PAYLOAD
+#error "DEBUG_WATCH_MAX_VARS too large for DEBUG_RECORD_MAX_PAYLOAD."
+#endif
+
+/** @brief Ring index mask */
+#define WATCH_MASK         ((uint32_t)DEBUG_WATCH_FRAMES - 1U)
+
+/** @brief Largest frame: every variable 8 bytes */
+#define WATCH_FRAME_MAX    (DEBUG_WATCH_MAX_VARS * 8U)
+
+/** @brief Table state word: layout number and variable mask */
+#define WATCH_STATE(layout, mask)  (((uint32_t)(layout) << 16) | (mask))
+#define WATCH_STATE_LAYOUT(state)  ((uint8_t)((state) >> 16))
+#define WATCH_STATE_MASK(state)    ((state) & 0xFFFFU)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Watch table entry */
+typedef struct
+{
+    const volatile void *addr;
+    uint8_t              type;      /**< DEBUG_WATCH_xxx */
+    char                 name[DEBUG_RECORD_NAME_LEN];
+} watch_var_t;
+
+/** @brief Ring slot */
+typedef struct
+{
+    uint32_t state;                 /**< Table state when sampled */
+    uint32_t seq;                   /**< Sample number */
+    uint32_t cycles;                /**< Cycle counter when sampled */
+    uint8_t  len;                   /**< Bytes used in data[] */
+    uint8_t  data[WATCH_FRAME_MAX];
+} watch_frame_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static watch_var_t   s_var[DEBUG_WATCH_MAX_VARS];
+static uint32_t      s_state   = 0;     /**< Current table (WATCH_STATE) */
+static watch_frame_t s_frame[DEBUG_WATCH_FRAMES];
+static uint32_t      s_head    = 0;     /**< Frames written by the sampler */
+static uint32_t      s_tail    = 0;     /**< Frames taken by the flush */
+static uint32_t      s_seq     = 0;     /**< Samples taken or dropped */
+static uint32_t      s_dropped = 0;     /**< Samples lost since boot */
+static uint32_t      s_sent    = 0;     /**< Table state last described */
+static uint32_t      s_records = 0;     /**< Frame records since the table */
+
+/** @brief Size in bytes of each DEBUG_WATCH_xxx type */
+static const uint8_t s_size[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8, 8, 8 };
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Copy a variable into a frame with a single load where possible.
+ *
+ * @return Bytes written
+ */
+static size_t watch_read(uint8_t *out, const watch_var_t *var)
+{
+    switch (s_size[var->type])
+    {
+        case 1U:
+        {
+            uint8_t v = *(const volatile uint8_t *)var->addr;
+            memcpy(out, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case 2U:
+        {
+            uint16_t v = *(const volatile uint16_t *)var->addr;
+            memcpy(out, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case 4U:
+        {
+            uint32_t v = *(const volatile uint32_t *)var->addr;
+            memcpy(out, &v, sizeof(v));
+            return sizeof(v);
+        }
+        default:
+        {
+            uint64_t v = *(const volatile uint64_t *)var->addr;
+            memcpy(out, &v, sizeof(v));
+            return sizeof(v);
+        }
+    }
+}
+
+/**
+ * @brief Send the table record for a state, if it is still current.
+ *
+ * @retval 0  Sent (or the transport failed; the frames follow anyway)
+ * @retval -1 The table changed since the frame was sampled
+ */
+static int watch_send_def(uint32_t state)
+{
+    uint8_t                  payload[DEBUG_RECORD_MAX_PAYLOAD];
+    debug_watch_def_record_t rec;
+    size_t                   len = sizeof(rec);
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version   = DEBUG_WATCH_VERSION;
+    rec.layout    = WATCH_STATE_LAYOUT(state);
+    rec.cycles_hz = DEBUG_CYCLES_HZ;
+
+    debug_lock_acquire();
+    if (__atomic_load_n(&s_state, __ATOMIC_ACQUIRE) != state)
+    {
+        debug_lock_release();
+        return -1;
+    }
+    for (uint32_t i = 0; i < DEBUG_WATCH_MAX_VARS; i++)
+    {
+        if (0U != (WATCH_STATE_MASK(state) & (1UL << i)))
+        {
+            debug_watch_var_t var;
+
+            var.type = s_var[i].type;
+            memcpy(var.name, s_var[i].name, sizeof(var.name));
+            memcpy(&payload[len], &var, sizeof(var));
+            len += sizeof(var);
+            rec.count++;
+        }
+    }
+    debug_lock_release();
+
+    memcpy(payload, &rec, sizeof(rec));
+    (void)debug_write_record(DEBUG_RECORD_WATCH_DEF, payload, len);
+
+    s_sent    = state;
+    s_records = 0;
+    return 0;
+}
+
+/**
+ * @brief Send one batch of frames if it holds any.
+ */
+static void watch_send(uint8_t *payload, size_t len, uint8_t count,
+                       uint32_t state, uint32_t seq)
+{
+    debug_watch_record_t rec;
+
+    if (0U == count)
+    {
+        return;
+    }
+
+    memset(&rec, 0, sizeof(rec));
+    rec.version = DEBUG_WATCH_VERSION;
+    rec.layout  = WATCH_STATE_LAYOUT(state);
+    rec.count   = count;
+    rec.seq     = seq;
+    rec.dropped = __atomic_load_n(&s_dropped, __ATOMIC_RELAXED);
+    memcpy(payload, &rec, sizeof(rec));
+
+    (void)debug_write_record(DEBUG_RECORD_WATCH, payload, len);
+    s_records++;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_watch_add(const char *name, const volatile void *addr, uint8_t type)
+{
+    int handle = -1;
+
+    if ((NULL == name) || (NULL == addr) ||
+        (0U == type) || (type > DEBUG_WATCH_F64))
+    {
+        return -1;
+    }
+
+    debug_lock_acquire();
+
+    uint32_t state = s_state;
+
+    for (uint32_t i = 0; i < DEBUG_WATCH_MAX_VARS; i++)
+    {
+        if (0U == (WATCH_STATE_MASK(state) & (1UL << i)))
+        {
+            s_var[i].addr = addr;
+            s_var[i].type = type;
+            memset(s_var[i].name, 0, sizeof(s_var[i].name));
+            memcpy(s_var[i].name, name, strnlen(name, sizeof(s_var[i].name)));
+
+            state = WATCH_STATE(WATCH_STATE_LAYOUT(state) + 1U,
+                                WATCH_STATE_MASK(state) | (1UL << i));
+            __atomic_store_n(&s_state, state, __ATOMIC_RELEASE);
+            handle = (int)i;
+            break;
+        }
+    }
+
+    debug_lock_release();
+
+    return handle;
+}
+
+int debug_watch_remove(int handle)
+{
+    int ret = -1;
+
+    if ((handle < 0) || (handle >= (int)DEBUG_WATCH_MAX_VARS))
+    {
+        return -1;
+    }
+
+    debug_lock_acquire();
+
+    uint32_t state = s_state;
+
+    if (0U != (WATCH_STATE_MASK(state) & (1UL << handle)))
+    {
+        state = WATCH_STATE(WATCH_STATE_LAYOUT(state) + 1U,
+                            WATCH_STATE_MASK(state) & ~(1UL << handle));
+        __atomic_store_n(&s_state, state, __ATOMIC_RELEASE);
+        ret = 0;
+    }
+
+    debug_lock_release();
+
+    return ret;
+}
+
+void debug_watch_sample(void)
+{
+    uint32_t state = __atomic_load_n(&s_state, __ATOMIC_ACQUIRE);
+    uint32_t head  = s_head;
+
+    if (0U == WATCH_STATE_MASK(state))
+    {
+        return;
+    }
+
+    uint32_t seq = s_seq++;
+
+    if ((head - __atomic_load_n(&s_tail, __ATOMIC_ACQUIRE)) >= DEBUG_WATCH_FRAMES)
+    {
+        (void)__atomic_fetch_add(&s_dropped, 1U, __ATOMIC_RELAXED);
+        return;
+    }
+
+    watch_frame_t *frame = &s_frame[head & WATCH_MASK];
+    size_t         len   = 0;
+
+    frame->state  = state;
+    frame->seq    = seq;
+    frame->cycles = debug_cycles();
+    for (uint32_t i = 0; i < DEBUG_WATCH_MAX_VARS; i++)
+    {
+        if (0U != (WATCH_STATE_MASK(state) & (1UL << i)))
+        {
+            len += watch_read(&frame->data[len], &s_var[i]);
+        }
+    }
+    frame->len = (uint8_t)len;
+
+    __atomic_store_n(&s_head, head + 1U, __ATOMIC_RELEASE);
+}
+
+int debug_watch_flush(void)
+{
+    uint8_t  payload[DEBUG_RECORD_MAX_PAYLOAD];
+    size_t   len   = 0;
+    uint8_t  count = 0;
+    uint32_t state = 0;
+    uint32_t first = 0;
+    int      sent  = 0;
+    uint32_t head  = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t tail  = s_tail;
+
+    while (tail != head)
+    {
+        const watch_frame_t *frame = &s_frame[tail & WATCH_MASK];
+
+        /* Close the batch on a new layout, a gap or a full record */
+        if ((0U != count) &&
+            ((frame->state != state) || (frame->seq != (first + count)) ||
+             ((len + sizeof(frame->cycles) + frame->len) > sizeof(payload)) ||
+             (0xFFU == count)))
+        {
+            watch_send(payload, len, count, state, first);
+            count = 0;
+        }
+
+        if (0U == count)
+        {
+            int stale = (frame->state != __atomic_load_n(&s_state, __ATOMIC_ACQUIRE));
+
+            if ((0 == stale) &&
+                ((frame->state != s_sent) ||
+                 ((0 != DEBUG_WATCH_DEF_PERIOD) && (s_records >= DEBUG_WATCH_DEF_PERIOD))))
+            {
+                stale = (0 != watch_send_def(frame->state));
+            }
+            if (0 != stale)
+            {
+                /* Sampled with a table that no longer exists */
+                (void)__atomic_fetch_add(&s_dropped, 1U, __ATOMIC_RELAXED);
+                tail++;
+                __atomic_store_n(&s_tail, tail, __ATOMIC_RELEASE);
+                continue;
+            }
+            state = frame->state;
+            first = frame->seq;
+            len   = sizeof(debug_watch_record_t);
+        }
+
+        memcpy(&payload[len], &frame->cycles, sizeof(frame->cycles));
+        len += sizeof(frame->cycles);
+        memcpy(&payload[len], frame->data, frame->len);
+        len += frame->len;
+        count++;
+        sent++;
+
+        tail++;
+        __atomic_store_n(&s_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    watch_send(payload, len, count, state, first);
+
+    return sent;
+}
+
+#endif /* DEBUG_ENABLE_WATCH */
+
+/** @} */ // End of DEBUG_WATCH
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -12,6 +12,8 @@
  *   - ISR detection (CMSIS-based)
  *   - Timestamp retrieval (stub, user-overridable)
  *   - Thread name access (returns "MAIN" or "ISR")
+ *   - Panic entry (masks interrupts via PRIMASK)
+ *   - Cycle counter and backtraces (DWT / stack scan on Cortex-M)
  *
  * @contact     elektronikaembedded@gmail.com
  * @website     https://elektronikaembedded.wordpress.com
@@ -29,6 +31,7 @@
 /* CMSIS core header for __get_IPSR() */
 #if defined(__ARM_ARCH)
 #include "cmsis_gcc.h"
+#include "debug_port_cortex_m.h"
 #endif
 
 /****************************** Static function prototypes ******************************/
@@ -39,6 +42,9 @@ static void     debug_port_baremetal_unlock(void);
 static uint32_t debug_port_baremetal_get_timestamp(void);
 static int      debug_port_baremetal_is_isr(void);
 static const char *debug_port_baremetal_get_thread_name(void);
+static void     debug_port_baremetal_panic_enter(void);
+static uint32_t debug_port_baremetal_get_cycles(void);
+static size_t   debug_port_baremetal_get_backtrace(uintptr_t *addrs, size_t max);
 
 /****************************** Static variable definitions ******************************/
 static const debug_port_ops_t DEBUG_PORT_BAREMETAL_OPS =
@@ -49,7 +55,11 @@ static const debug_port_ops_t DEBUG_PORT_BAREMETAL_OPS =
     .unlock          = debug_port_baremetal_unlock,
     .get_timestamp   = debug_port_baremetal_get_timestamp,
     .is_isr          = debug_port_baremetal_is_isr,
-    .get_thread_name = debug_port_baremetal_get_thread_name
+    .get_thread_name = debug_port_baremetal_get_thread_name,
+    .panic_enter     = debug_port_baremetal_panic_enter,
+    .get_cycles      = debug_port_baremetal_get_cycles,
+    .get_backtrace   = debug_port_baremetal_get_backtrace,
+    .sample_timer    = NULL     /* Application timer, DEBUG_PORT_SAMPLE_HANDLER */
 };
 
 /****************************** Function definitions ************************************/
@@ -61,6 +71,9 @@ static const debug_port_ops_t DEBUG_PORT_BAREMETAL_OPS =
  */
 static int debug_port_baremetal_init(void)
 {
+#if defined(__ARM_ARCH)
+    debug_cortex_m_cycles_init();
+#endif
     return 0;
 }
 
@@ -130,6 +143,53 @@ static const char *debug_port_baremetal_get_thread_name(void)
     return debug_port_baremetal_is_isr() ? "ISR" : "MAIN";
 }
 
+/**
+ * @brief Enter panic mode
+ *
+ * @note
+ * Masks all configurable interrupts so that panic output cannot be
+ * preempted. Interrupts are never re-enabled by the debug framework.
+ */
+static void debug_port_baremetal_panic_enter(void)
+{
+#if defined(__ARM_ARCH)
+    __disable_irq();
+#endif
+}
+
+/**
+ * @brief Get the high-resolution cycle count
+ *
+ * @return DWT cycle counter (0 where unavailable)
+ */
+static uint32_t debug_port_baremetal_get_cycles(void)
+{
+#if defined(__ARM_ARCH)
+    return debug_cortex_m_cycles();
+#else
+    return 0U;
+#endif
+}
+
+/**
+ * @brief Capture the current call chain
+ *
+ * @param[out] addrs Destination for return addresses
+ * @param[in]  max   Capacity of @p addrs
+ *
+ * @return Number of addresses captured
+ */
+static size_t debug_port_baremetal_get_backtrace(uintptr_t *addrs, size_t max)
+{
+#if defined(__ARM_ARCH)
+    return debug_cortex_m_backtrace(addrs, max);
+#else
+    (void)addrs;
+    (void)max;
+    return 0U;
+#endif
+}
+
 /**
  * @brief Get bare-metal debug port operations table
  *
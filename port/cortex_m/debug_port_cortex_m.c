@@ -0,0 +1,127 @@
+/****************************************************************************************
+ * @file        debug_port_cortex_m.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M helpers shared by the port implementations
+ *
+ * @details
+ * Implements the DWT cycle counter access and the stack-scanning call
+ * chain capture used for error backtraces.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if defined(__ARM_ARCH)
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "debug_port_cortex_m.h"
+
+/****************************** Macros **************************************************/
+
+/** @brief Debug Exception and Monitor Control Register */
+#define CM_REG_DEMCR        (*(volatile uint32_t *)0xE000EDFCUL)
+#define CM_DEMCR_TRCENA     (1UL << 24)
+
+/** @brief DWT control and cycle count registers */
+#define CM_REG_DWT_CTRL     (*(volatile uint32_t *)0xE0001000UL)
+#define CM_REG_DWT_CYCCNT   (*(volatile uint32_t *)0xE0001004UL)
+#define CM_DWT_CYCCNTENA    (1UL << 0)
+
+/** @brief BL (T1, first halfword) and BLX register encodings */
+#define THUMB_BL_HI_MASK    0xF800U
+#define THUMB_BL_HI_VALUE   0xF000U
+#define THUMB_BL_LO_MASK    0xD000U
+#define THUMB_BL_LO_VALUE   0xD000U
+#define THUMB_BLX_MASK      0xFF87U
+#define THUMB_BLX_VALUE     0x4780U
+
+/****************************** Static variable definitions ******************************/
+
+/** @brief End of the stack region (linker symbol) */
+extern uint32_t DEBUG_CRASH_STACK_TOP_SYMBOL;
+
+/****************************** Static function prototypes ******************************/
+static int cm_is_return_address(uint32_t value);
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Check whether a stack word is a plausible return address
+ *
+ * @param[in] value Stack word
+ *
+ * @return 1 if @p value is a Thumb address in code that follows BL/BLX
+ */
+static int cm_is_return_address(uint32_t value)
+{
+    if ((0U == (value & 1U)) ||
+        (value < (DEBUG_CODE_START + 5U)) || (value >= DEBUG_CODE_END))
+    {
+        return 0;
+    }
+
+    uintptr_t ret = (uintptr_t)(value & ~1UL);
+    uint16_t hw_hi = *(const uint16_t *)(ret - 4U);
+    uint16_t hw_lo = *(const uint16_t *)(ret - 2U);
+
+    if (((hw_hi & THUMB_BL_HI_MASK) == THUMB_BL_HI_VALUE) &&
+        ((hw_lo & THUMB_BL_LO_MASK) == THUMB_BL_LO_VALUE))
+    {
+        return 1;
+    }
+
+    return ((hw_lo & THUMB_BLX_MASK) == THUMB_BLX_VALUE) ? 1 : 0;
+}
+
+void debug_cortex_m_cycles_init(void)
+{
+#if !defined(__ARM_ARCH_6M__)
+    CM_REG_DEMCR |= CM_DEMCR_TRCENA;
+    CM_REG_DWT_CYCCNT = 0;
+    CM_REG_DWT_CTRL |= CM_DWT_CYCCNTENA;
+#endif
+}
+
+uint32_t debug_cortex_m_cycles(void)
+{
+#if !defined(__ARM_ARCH_6M__)
+    return CM_REG_DWT_CYCCNT;
+#else
+    return 0U;
+#endif
+}
+
+size_t debug_cortex_m_backtrace(uintptr_t *addrs, size_t max)
+{
+    const uint32_t *sp;
+    size_t          count = 0;
+
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+
+    const uint32_t *top = &DEBUG_CRASH_STACK_TOP_SYMBOL;
+    const uint32_t *end = sp + DEBUG_BACKTRACE_SCAN_WORDS;
+
+    if (end > top)
+    {
+        end = top;
+    }
+
+    for (const uint32_t *p = sp; (p < end) && (count < max); p++)
+    {
+        if (0 != cm_is_return_address(*p))
+        {
+            addrs[count++] = (uintptr_t)*p;
+        }
+    }
+
+    return count;
+}
+
+#endif /* __ARM_ARCH */
+
+/****************************** End of file *********************************************/
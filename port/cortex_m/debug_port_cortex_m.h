@@ -0,0 +1,76 @@
+/****************************************************************************************
+ * @file        debug_port_cortex_m.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M helpers shared by the port implementations
+ *
+ * @details
+ * Architecture services used by the bare-metal and FreeRTOS ports:
+ *   - DWT cycle counter (high-resolution timing)
+ *   - Heuristic call-chain capture by stack scanning
+ *
+ * The stack scan needs no frame pointers and no unwind tables: it walks a
+ * bounded number of words upwards from the current SP and keeps values
+ * that are Thumb addresses inside the code region and that directly follow
+ * a BL or BLX instruction. The result can contain stale return addresses
+ * left on the stack, but it is cheap and bounded.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_PORT_CORTEX_M_H
+#define DEBUG_PORT_CORTEX_M_H
+
+#include "config.h"
+
+#if defined(__ARM_ARCH)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "common.h"
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Enable the DWT cycle counter
+ *
+ * @note No-op on ARMv6-M (Cortex-M0/M0+), which has no cycle counter.
+ */
+void debug_cortex_m_cycles_init(void);
+
+/**
+ * @brief           Read the DWT cycle counter
+ *
+ * @return          Current CPU cycle count (0 on ARMv6-M)
+ */
+uint32_t debug_cortex_m_cycles(void);
+
+/**
+ * @brief           Capture return addresses by scanning the stack
+ *
+ * @param[out]      addrs   Destination for return addresses (Thumb bit set)
+ * @param[in]       max     Capacity of @p addrs
+ *
+ * @return          Number of addresses stored
+ *
+ * @note
+ * Scans at most DEBUG_BACKTRACE_SCAN_WORDS words and never past
+ * DEBUG_CRASH_STACK_TOP_SYMBOL. Only addresses within
+ * [DEBUG_CODE_START, DEBUG_CODE_END) are considered.
+ */
+size_t debug_cortex_m_backtrace(uintptr_t *addrs, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ARM_ARCH */
+#endif /* DEBUG_PORT_CORTEX_M_H */
+
+/****************************** End of file *********************************************/
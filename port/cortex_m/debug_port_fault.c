@@ -0,0 +1,209 @@
+/****************************************************************************************
+ * @file        debug_port_fault.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M fault handler hook implementation
+ *
+ * @details
+ * Captures the exception frame, the fault status registers, the faulting
+ * task and a bounded stack slice into a DEBUG_RECORD_CRASH record and
+ * emits it through the debug framework in panic mode.
+ *
+ * All working storage is static so that the capture itself uses as little
+ * of the (possibly corrupted) stack as possible. The stack slice is clamped
+ * to DEBUG_CRASH_STACK_TOP_SYMBOL so the dump cannot fault on unmapped
+ * memory past the end of RAM.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if (DEBUG_ENABLE_FAULT_HANDLER == YES) && defined(__ARM_ARCH)
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include <string.h>
+#include "debug_port_fault.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "cmsis_gcc.h"
+
+#if DEBUG_USE_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/****************************** Macros **************************************************/
+
+/** @brief System Control Block fault registers */
+#define FAULT_REG_CFSR     (*(volatile uint32_t *)0xE000ED28UL)
+#define FAULT_REG_HFSR     (*(volatile uint32_t *)0xE000ED2CUL)
+#define FAULT_REG_MMFAR    (*(volatile uint32_t *)0xE000ED34UL)
+#define FAULT_REG_BFAR     (*(volatile uint32_t *)0xE000ED38UL)
+#define FAULT_REG_AIRCR    (*(volatile uint32_t *)0xE000ED0CUL)
+
+/** @brief AIRCR write key with SYSRESETREQ */
+#define FAULT_AIRCR_RESET  0x05FA0004UL
+
+/** @brief EXC_RETURN bits */
+#define EXC_RETURN_PSP     0x04UL
+#define EXC_RETURN_THREAD  0x08UL
+#define EXC_RETURN_NO_FPU  0x10UL
+
+/** @brief Exception frame sizes in words */
+#define FRAME_WORDS_BASIC  8U
+#define FRAME_WORDS_FPU    26U
+
+/** @brief xPSR bit indicating stack realignment padding */
+#define XPSR_STACK_ALIGN   (1UL << 9)
+
+/** @brief Number of stack words that fit in a record */
+#define FAULT_STACK_WORDS_MAX \
+    ((DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_crash_record_t)) / sizeof(uint32_t))
+
+/****************************** Static variable definitions ******************************/
+
+/** @brief End of the stack region (linker symbol) */
+extern uint32_t DEBUG_CRASH_STACK_TOP_SYMBOL;
+
+/** @brief Record storage, kept in RAM for inspection with a debugger */
+static uint8_t s_fault_record[sizeof(debug_crash_record_t) +
+                              (DEBUG_CRASH_STACK_WORDS * sizeof(uint32_t))];
+
+/****************************** Static function prototypes ******************************/
+static void fault_task_name(char *dst, uint32_t exc_return);
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Resolve the name of the faulting context
+ *
+ * @param[out] dst         Destination, DEBUG_RECORD_NAME_LEN bytes
+ * @param[in]  exc_return  EXC_RETURN value
+ */
+static void fault_task_name(char *dst, uint32_t exc_return)
+{
+    const char *name = "ISR";
+
+    if (0U != (exc_return & EXC_RETURN_THREAD))
+    {
+#if DEBUG_USE_FREERTOS
+        name = pcTaskGetName(xTaskGetCurrentTaskHandle());
+        if (NULL == name)
+        {
+            name = "TASK";
+        }
+#else
+        name = "MAIN";
+#endif
+    }
+
+    memset(dst, 0, DEBUG_RECORD_NAME_LEN);
+    strncpy(dst, name, DEBUG_RECORD_NAME_LEN - 1U);
+}
+
+/**
+ * @brief Capture and emit a crash record
+ *
+ * @param[in] frame       Exception frame of the faulting context
+ * @param[in] exc_return  EXC_RETURN value from the handler LR
+ */
+void debug_port_fault_capture(const uint32_t *frame, uint32_t exc_return)
+{
+    debug_crash_record_t *rec = (debug_crash_record_t *)s_fault_record;
+
+    debug_panic_enter();
+
+    memset(s_fault_record, 0, sizeof(s_fault_record));
+
+    rec->version    = DEBUG_CRASH_VERSION;
+    rec->r0         = frame[0];
+    rec->r1         = frame[1];
+    rec->r2         = frame[2];
+    rec->r3         = frame[3];
+    rec->r12        = frame[4];
+    rec->lr         = frame[5];
+    rec->pc         = frame[6];
+    rec->xpsr       = frame[7];
+    rec->exc_return = exc_return;
+    rec->cfsr       = FAULT_REG_CFSR;
+    rec->hfsr       = FAULT_REG_HFSR;
+    rec->mmfar      = FAULT_REG_MMFAR;
+    rec->bfar       = FAULT_REG_BFAR;
+    rec->timestamp  = debug_timestamp();
+
+    uint32_t frame_words = FRAME_WORDS_BASIC;
+
+    if (0U != (exc_return & EXC_RETURN_PSP))
+    {
+        rec->flags |= DEBUG_CRASH_FLAG_PSP;
+    }
+    if (0U != (exc_return & EXC_RETURN_THREAD))
+    {
+        rec->flags |= DEBUG_CRASH_FLAG_THREAD;
+    }
+    if (0U == (exc_return & EXC_RETURN_NO_FPU))
+    {
+        rec->flags |= DEBUG_CRASH_FLAG_FPU;
+        frame_words = FRAME_WORDS_FPU;
+    }
+
+    /* SP of the faulting context before the exception was stacked */
+    uintptr_t sp = (uintptr_t)frame + (frame_words * sizeof(uint32_t));
+    if (0U != (rec->xpsr & XPSR_STACK_ALIGN))
+    {
+        sp += sizeof(uint32_t);
+    }
+    rec->sp = (uint32_t)sp;
+
+    fault_task_name(rec->task, exc_return);
+
+    /* Bounded stack slice, clamped to the top of the stack region */
+    uintptr_t top   = (uintptr_t)&DEBUG_CRASH_STACK_TOP_SYMBOL;
+    size_t    words = DEBUG_CRASH_STACK_WORDS;
+
+    if (words > FAULT_STACK_WORDS_MAX)
+    {
+        words = FAULT_STACK_WORDS_MAX;
+    }
+    if (sp >= top)
+    {
+        words = 0;
+    }
+    else if (words > ((top - sp) / sizeof(uint32_t)))
+    {
+        words = (top - sp) / sizeof(uint32_t);
+    }
+
+    memcpy(&s_fault_record[sizeof(debug_crash_record_t)],
+           (const void *)sp, words * sizeof(uint32_t));
+    rec->stack_words = (uint16_t)words;
+
+    (void)debug_write_record(DEBUG_RECORD_CRASH, s_fault_record,
+                             sizeof(debug_crash_record_t) +
+                             (words * sizeof(uint32_t)));
+
+    (void)debug_printf("\r\n[FAULT] task=%s pc=0x%08lx lr=0x%08lx "
+                       "cfsr=0x%08lx hfsr=0x%08lx\r\n",
+                       rec->task,
+                       (unsigned long)rec->pc, (unsigned long)rec->lr,
+                       (unsigned long)rec->cfsr, (unsigned long)rec->hfsr);
+
+#if DEBUG_FAULT_RESET == YES
+    __DSB();
+    FAULT_REG_AIRCR = FAULT_AIRCR_RESET;
+    __DSB();
+#endif
+
+    for (;;)
+    {
+        /* Halt here; attach a debugger to inspect s_fault_record */
+    }
+}
+
+#endif /* DEBUG_ENABLE_FAULT_HANDLER && __ARM_ARCH */
+
+/****************************** End of file *********************************************/
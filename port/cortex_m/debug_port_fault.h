@@ -0,0 +1,94 @@
+/****************************************************************************************
+ * @file        debug_port_fault.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M fault handler hook
+ *
+ * @details
+ * Declares the fault capture hook of the port layer. When installed as the
+ * body of HardFault_Handler (and optionally MemManage/BusFault/UsageFault),
+ * it captures:
+ *   - The stacked exception frame (R0-R3, R12, LR, PC, xPSR)
+ *   - CFSR, HFSR, MMFAR and BFAR
+ *   - The name of the interrupted task (or "ISR"/"MAIN")
+ *   - A bounded slice of the faulting stack
+ *
+ * The capture is emitted as a DEBUG_RECORD_CRASH binary record (see
+ * debug_record.h) plus a one-line text summary, using panic mode so it
+ * works with interrupts masked. The host tool tools/debug_decode
+ * symbolizes the record against the ELF file.
+ *
+ * Usage (replaces the CubeMX generated handler in stm32xxxx_it.c):
+ * @code
+ *   #include "debug_port_fault.h"
+ *   DEBUG_PORT_FAULT_HANDLER(HardFault_Handler)
+ * @endcode
+ *
+ * @note
+ * Requires ARMv7-M or ARMv8-M Mainline (Cortex-M3/M4/M7/M33).
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_PORT_FAULT_H
+#define DEBUG_PORT_FAULT_H
+
+#include "config.h"
+
+#if (DEBUG_ENABLE_FAULT_HANDLER == YES) && defined(__ARM_ARCH)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "common.h"
+
+/****************************** Macros **************************************************/
+
+/**
+ * @brief Define a naked fault handler that forwards to the capture hook.
+ *
+ * Selects MSP or PSP from EXC_RETURN and passes the exception frame and
+ * EXC_RETURN to @ref debug_port_fault_capture without touching the stack.
+ *
+ * @param name Handler name, e.g. HardFault_Handler
+ */
+#define DEBUG_PORT_FAULT_HANDLER(name)                                   \
+    __attribute__((naked)) void name(void)                               \
+    {                                                                    \
+        __asm volatile(                                                  \
+            "tst   lr, #4                   \n"                          \
+            "ite   eq                       \n"                          \
+            "mrseq r0, msp                  \n"                          \
+            "mrsne r0, psp                  \n"                          \
+            "mov   r1, lr                   \n"                          \
+            "b     debug_port_fault_capture \n");                        \
+    }
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Capture and emit a crash record
+ *
+ * @param[in]       frame       Exception frame (stacked R0) of the faulting context
+ * @param[in]       exc_return  EXC_RETURN value from the handler LR
+ *
+ * @note
+ * Enters debug panic mode and does not return: depending on
+ * DEBUG_FAULT_RESET the system is reset or halted after the dump.
+ */
+void debug_port_fault_capture(const uint32_t *frame, uint32_t exc_return)
+    __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_ENABLE_FAULT_HANDLER && __ARM_ARCH */
+#endif /* DEBUG_PORT_FAULT_H */
+
+/****************************** End of file *********************************************/
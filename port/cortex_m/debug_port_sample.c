@@ -0,0 +1,70 @@
+/****************************************************************************************
+ * @file        debug_port_sample.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M PC sampling interrupt hook implementation
+ *
+ * @details
+ * Takes the stacked PC of the interrupted context and the running task
+ * and hands them to debug_sample_tick(). The task name pointer is the one
+ * the FreeRTOS port returns, so samples and logs name tasks alike.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if (DEBUG_ENABLE_SAMPLE == YES) && defined(__ARM_ARCH)
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "debug_port_sample.h"
+#include "debug_sample.h"
+
+#if DEBUG_USE_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/****************************** Macros **************************************************/
+
+/** @brief EXC_RETURN bit: the interrupted context ran in thread mode */
+#define EXC_RETURN_THREAD  0x08UL
+
+/** @brief Stacked PC index in the exception frame */
+#define FRAME_PC           6U
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Record the PC of an exception frame as a sample
+ *
+ * @param[in] frame       Exception frame of the interrupted context
+ * @param[in] exc_return  EXC_RETURN value from the handler LR
+ */
+void debug_port_sample_capture(const uint32_t *frame, uint32_t exc_return)
+{
+    const char *thread = NULL;
+
+    if (0U != (exc_return & EXC_RETURN_THREAD))
+    {
+#if DEBUG_USE_FREERTOS
+        thread = pcTaskGetName(xTaskGetCurrentTaskHandle());
+        if (NULL == thread)
+        {
+            thread = "TASK";
+        }
+#else
+        thread = "MAIN";
+#endif
+    }
+
+    debug_sample_tick((uintptr_t)frame[FRAME_PC], thread);
+}
+
+#endif /* DEBUG_ENABLE_SAMPLE && __ARM_ARCH */
+
+/****************************** End of file *********************************************/
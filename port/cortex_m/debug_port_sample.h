@@ -0,0 +1,99 @@
+/****************************************************************************************
+ * @file        debug_port_sample.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       Cortex-M PC sampling interrupt hook
+ *
+ * @details
+ * Declares the sampling hook of the port layer for core/debug_sample.h.
+ * DEBUG_PORT_SAMPLE_HANDLER defines a naked interrupt handler that reads
+ * the interrupted PC from the exception frame, records it with the
+ * running task (or as an ISR sample), then branches to the original
+ * handler of the interrupt with EXC_RETURN intact.
+ *
+ * Usage with SysTick (rename the HAL/FreeRTOS handler, e.g. map
+ * xPortSysTickHandler to SysTick_Original in FreeRTOSConfig.h):
+ * @code
+ *   #include "debug_port_sample.h"
+ *   DEBUG_PORT_SAMPLE_HANDLER(SysTick_Handler, SysTick_Original)
+ *   ...
+ *   debug_sample_start(configTICK_RATE_HZ);
+ * @endcode
+ *
+ * A spare timer at a rate that is not a multiple of the tick avoids
+ * sampling in step with periodic tasks:
+ * @code
+ *   void TIM7_Ack(void) { TIM7->SR = 0; }
+ *   DEBUG_PORT_SAMPLE_HANDLER(TIM7_IRQHandler, TIM7_Ack)
+ * @endcode
+ *
+ * @note
+ * Requires ARMv7-M or ARMv8-M Mainline (Cortex-M3/M4/M7/M33). Samples
+ * taken while a lower-priority ISR runs are reported as ISR time.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_PORT_SAMPLE_H
+#define DEBUG_PORT_SAMPLE_H
+
+#include "config.h"
+
+#if (DEBUG_ENABLE_SAMPLE == YES) && defined(__ARM_ARCH)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "common.h"
+
+/****************************** Macros **************************************************/
+
+/**
+ * @brief Define a naked handler that samples the PC, then runs @p next.
+ *
+ * Selects MSP or PSP from EXC_RETURN, passes the exception frame and
+ * EXC_RETURN to @ref debug_port_sample_capture, and tail-calls @p next
+ * with LR still holding EXC_RETURN, so @p next returns from the exception.
+ *
+ * @param name Handler name, e.g. SysTick_Handler
+ * @param next Function doing the interrupt's own work (acknowledge, tick)
+ */
+#define DEBUG_PORT_SAMPLE_HANDLER(name, next)                            \
+    extern void next(void);                                              \
+    __attribute__((naked)) void name(void)                               \
+    {                                                                    \
+        __asm volatile(                                                  \
+            "tst   lr, #4                    \n"                         \
+            "ite   eq                        \n"                         \
+            "mrseq r0, msp                   \n"                         \
+            "mrsne r0, psp                   \n"                         \
+            "mov   r1, lr                    \n"                         \
+            "push  {r0, lr}                  \n"                         \
+            "bl    debug_port_sample_capture \n"                         \
+            "pop   {r0, lr}                  \n"                         \
+            "b     " #next "                 \n");                       \
+    }
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Record the PC of an exception frame as a sample
+ *
+ * @param[in]       frame       Exception frame (stacked R0) of the interrupted context
+ * @param[in]       exc_return  EXC_RETURN value from the handler LR
+ */
+void debug_port_sample_capture(const uint32_t *frame, uint32_t exc_return);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_ENABLE_SAMPLE && __ARM_ARCH */
+#endif /* DEBUG_PORT_SAMPLE_H */
+
+/****************************** End of file *********************************************/
@@ -12,6 +12,7 @@
  * Supported port layers:
  *  - FreeRTOS
  *  - Bare-metal
+ *  - POSIX (Linux host)
  *
  * Provides a unified interface for synchronization, timing,
  * and thread-related services to keep the debug framework
@@ -40,6 +41,10 @@
 #include "debug_port_baremetal.h"
 #endif
 
+#if DEBUG_USE_POSIX
+#include "debug_port_posix.h"
+#endif
+
 /*******************************************************************************
  * Private Macros
  *******************************************************************************/
@@ -87,8 +92,10 @@ int debug_port_init(debug_port_t *port)
     port->ops = debug_port_freertos_ops();
 #elif DEBUG_USE_BAREMETAL
     port->ops = debug_port_baremetal_ops();
+#elif DEBUG_USE_POSIX
+    port->ops = debug_port_posix_ops();
 #else
-#error "No debug port selected! Define DEBUG_USE_FREERTOS or DEBUG_USE_BAREMETAL in config.h"
+#error "No debug port selected! Define DEBUG_USE_FREERTOS, DEBUG_USE_BAREMETAL or DEBUG_USE_POSIX in config.h"
 #endif
 
     if (NULL != port->ops->init)
@@ -12,6 +12,8 @@
  *  - ISR detection
  *  - Timestamp retrieval
  *  - Thread/task name retrieval
+ *  - High-resolution cycle counter
+ *  - Call-chain capture for error backtraces
  *
  * The actual port implementation (FreeRTOS or Bare-metal) is selected at
  * compile time via macros in config.h.
@@ -81,6 +83,11 @@ typedef struct
     uint32_t (*get_timestamp)(void);      /**< Retrieve system timestamp */
     int  (*is_isr)(void);          /**< Check if currently in ISR context */
     const char *(*get_thread_name)(void); /**< Get current thread/task name */
+    void (*panic_enter)(void);     /**< Mask interrupts for panic output (optional) */
+    uint32_t (*get_cycles)(void);  /**< High-resolution counter, DEBUG_CYCLES_HZ (optional) */
+    size_t (*get_backtrace)(uintptr_t *addrs,
+                            size_t max);   /**< Capture return addresses, innermost first (optional) */
+    int  (*sample_timer)(uint32_t hz);     /**< Start (hz > 0) or stop (0) the PC sampling timer (optional) */
 } debug_port_ops_t;
 
 /**
@@ -0,0 +1,167 @@
+/****************************************************************************************
+ * @file        debug_freertos_stats.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       FreeRTOS run-time statistics collector implementation
+ *
+ * @details
+ * Keeps the run-time counter of every task from the previous sample and
+ * sends the differences. Tasks seen for the first time are flagged
+ * DEBUG_TASK_STATS_NEW and report their counter since creation; deleted
+ * tasks simply stop appearing. Unsigned 32-bit differences stay correct
+ * across one wrap of the counter per period.
+ *
+ * All working storage is static; nothing is formatted on the target.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if DEBUG_USE_FREERTOS && (DEBUG_ENABLE_TASK_STATS == YES)
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include <string.h>
+#include "debug_freertos_stats.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TRACE_FACILITY != 1) || (configGENERATE_RUN_TIME_STATS != 1)
+#error "Task statistics need configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS."
+#endif
+
+/****************************** Macros **************************************************/
+
+/* FreeRTOS before V10.5 has no configurable run-time counter type */
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE    uint32_t
+#endif
+
+/****************************** Static variables ****************************************/
+
+/** @brief Output of uxTaskGetSystemState() */
+static TaskStatus_t stats_status[DEBUG_TASK_STATS_MAX_TASKS];
+
+/** @brief Run-time counters of the previous sample */
+static struct
+{
+    UBaseType_t number;     /**< xTaskNumber */
+    uint32_t    run_time;   /**< ulRunTimeCounter */
+} stats_prev[DEBUG_TASK_STATS_MAX_TASKS];
+
+static UBaseType_t stats_prev_count = 0;    /**< Entries in stats_prev */
+static uint32_t    stats_prev_total = 0;    /**< Total run time of the previous sample */
+static uint16_t    stats_sample     = 0;    /**< Sample number */
+
+/****************************** Static function definitions *****************************/
+
+/**
+ * @brief Find a task in the previous sample
+ *
+ * @return Index in stats_prev, or -1 for a new task
+ */
+static int debug_freertos_stats_find(UBaseType_t number)
+{
+    for (UBaseType_t i = 0; i < stats_prev_count; i++)
+    {
+        if (stats_prev[i].number == number)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Sample all tasks and send their statistics records
+ *
+ * @return Number of tasks sampled, -1 if the table is too small
+ */
+int debug_freertos_stats_sample(void)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t count = uxTaskGetSystemState(stats_status,
+                                             DEBUG_TASK_STATS_MAX_TASKS,
+                                             &total);
+
+    if (0U == count)
+    {
+        return -1;
+    }
+
+    uint32_t timestamp  = debug_timestamp();
+    uint32_t total_time = (uint32_t)total - stats_prev_total;
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t       *task = &stats_status[i];
+        debug_task_stats_record_t rec;
+        int                       prev = debug_freertos_stats_find(task->xTaskNumber);
+
+        memset(&rec, 0, sizeof(rec));
+        rec.version       = DEBUG_TASK_STATS_VERSION;
+        rec.flags         = (prev < 0) ? DEBUG_TASK_STATS_NEW : 0U;
+        rec.state         = (uint8_t)task->eCurrentState;
+        rec.tasks         = (uint8_t)count;
+        rec.sample        = stats_sample;
+        rec.priority      = (uint8_t)task->uxCurrentPriority;
+        rec.base_priority = (uint8_t)task->uxBasePriority;
+        rec.task_number   = (uint32_t)task->xTaskNumber;
+        rec.timestamp     = timestamp;
+        rec.run_time      = (uint32_t)task->ulRunTimeCounter;
+        rec.total_time    = total_time;
+        rec.stack_free    = (uint32_t)task->usStackHighWaterMark * sizeof(StackType_t);
+        strncpy(rec.name, task->pcTaskName, sizeof(rec.name) - 1U);
+
+        if (prev >= 0)
+        {
+            rec.run_time -= stats_prev[prev].run_time;
+        }
+        if ((i + 1U) == count)
+        {
+            rec.flags |= DEBUG_TASK_STATS_LAST;
+        }
+
+        (void)debug_write_record(DEBUG_RECORD_TASK_STATS, &rec, sizeof(rec));
+    }
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        stats_prev[i].number   = stats_status[i].xTaskNumber;
+        stats_prev[i].run_time = (uint32_t)stats_status[i].ulRunTimeCounter;
+    }
+    stats_prev_count = count;
+    stats_prev_total = (uint32_t)total;
+    stats_sample++;
+
+    return (int)count;
+}
+
+/**
+ * @brief Collector task body
+ *
+ * @param[in] arg Unused
+ */
+void debug_freertos_stats_task(void *arg)
+{
+    TickType_t last = xTaskGetTickCount();
+
+    (void)arg;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(DEBUG_TASK_STATS_PERIOD_MS));
+        (void)debug_freertos_stats_sample();
+    }
+}
+
+#endif /* DEBUG_USE_FREERTOS && DEBUG_ENABLE_TASK_STATS */
+
+/****************************** End of file *********************************************/
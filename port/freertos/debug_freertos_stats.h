@@ -0,0 +1,81 @@
+/****************************************************************************************
+ * @file        debug_freertos_stats.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       FreeRTOS run-time statistics collector
+ *
+ * @details
+ * Samples uxTaskGetSystemState() and sends one DEBUG_RECORD_TASK_STATS
+ * record per task: run time since the previous sample, the total run time
+ * of the period, stack high-water mark, state and priorities. This
+ * replaces vTaskGetRunTimeStats(), which formats the whole table into a
+ * string with the scheduler suspended.
+ *
+ * Deltas are computed here against the previous sample, keyed by task
+ * number, so the host only has to divide. tools/task_stats renders the
+ * records as a per-period table or CSV.
+ *
+ * Usage:
+ * @code
+ *   xTaskCreate(debug_freertos_stats_task, "stats", 256, NULL,
+ *               tskIDLE_PRIORITY + 1, NULL);
+ * @endcode
+ *
+ * @note
+ * Needs configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS. The
+ * DWT cycle counter of the port makes a good run-time counter:
+ * portGET_RUN_TIME_COUNTER_VALUE() -> debug_cortex_m_cycles().
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_FREERTOS_STATS_H
+#define DEBUG_FREERTOS_STATS_H
+
+#include "config.h"
+
+#if DEBUG_USE_FREERTOS && (DEBUG_ENABLE_TASK_STATS == YES)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "common.h"
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Sample all tasks and send their statistics records
+ *
+ * @return          Number of tasks sampled, -1 if there are more than
+ *                  DEBUG_TASK_STATS_MAX_TASKS tasks
+ *
+ * @note
+ * Not reentrant: call from one task only. Stack high-water marks are
+ * computed by scanning each stack, which is the main cost of a sample.
+ */
+int debug_freertos_stats_sample(void);
+
+/**
+ * @brief           Collector task body
+ *
+ * @param[in]       arg Unused
+ *
+ * @note
+ * Calls debug_freertos_stats_sample() every DEBUG_TASK_STATS_PERIOD_MS.
+ * Pass it to xTaskCreate(); it never returns.
+ */
+void debug_freertos_stats_task(void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_FREERTOS && DEBUG_ENABLE_TASK_STATS */
+#endif /* DEBUG_FREERTOS_STATS_H */
+
+/****************************** End of file *********************************************/
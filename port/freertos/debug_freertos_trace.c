@@ -0,0 +1,261 @@
+/****************************************************************************************
+ * @file        debug_freertos_trace.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       FreeRTOS kernel trace hooks implementation
+ *
+ * @details
+ * Multi-producer, single-consumer ring of fixed-size events:
+ *   - A producer claims the slot at head with debug_tracebuf_claim(),
+ *     fills it and publishes it by writing its type last (release).
+ *   - The consumer (debug_ktrace_drain()) takes slots in order while
+ *     their type is non-zero, clears them and advances tail.
+ * A producer interrupted between claim and publish only delays the
+ * consumer until the next drain; nothing is ever overwritten.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if DEBUG_USE_FREERTOS && (DEBUG_ENABLE_KERNEL_TRACE == YES)
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug_freertos_trace.h"
+#include "debug.h"
+#include "debug_record.h"
+#include "debug_tracebuf.h"
+#include "core_cm4.h"  /* Replace with correct core header if needed */
+#include "debug_port_cortex_m.h"
+
+/****************************** Macros **************************************************/
+
+#if (DEBUG_KTRACE_EVENTS & (DEBUG_KTRACE_EVENTS - 1)) != 0
+#error "DEBUG_KTRACE_EVENTS must be a power of two."
+#endif
+
+/** @brief Ring index mask */
+#define KTRACE_MASK       ((uint32_t)DEBUG_KTRACE_EVENTS - 1U)
+
+/** @brief Events per record */
+#define KTRACE_PER_RECORD ((DEBUG_RECORD_MAX_PAYLOAD - sizeof(debug_ktrace_record_t)) / \
+                           sizeof(debug_ktrace_event_t))
+
+/** @brief Task name bytes carried by one TASK_NAME event */
+#define KTRACE_NAME_CHUNK 7U
+
+/****************************** Types ***************************************************/
+
+/** @brief Ring slot (aligned twin of debug_ktrace_event_t) */
+typedef struct
+{
+    uint32_t         cycles;
+    uint32_t         object;
+    uint32_t         arg;
+    volatile uint8_t type;      /**< 0 = free, written last */
+    uint8_t          data[3];
+} ktrace_slot_t;
+
+/****************************** Static variables ****************************************/
+static ktrace_slot_t ktrace_ring[DEBUG_KTRACE_EVENTS];
+static uint32_t      ktrace_head    = 0;   /**< Slots claimed by producers */
+static uint32_t      ktrace_tail    = 0;   /**< Slots taken by the consumer */
+static uint32_t      ktrace_dropped = 0;   /**< Events lost to a full ring */
+
+/****************************** Static function definitions *****************************/
+
+/**
+ * @brief Claim a free slot
+ *
+ * @return Slot to fill, or NULL if the ring is full
+ */
+static ktrace_slot_t *debug_ktrace_claim(void)
+{
+    uint32_t head;
+
+    if (0 != debug_tracebuf_claim(&ktrace_head, &ktrace_tail, DEBUG_KTRACE_EVENTS,
+                                  &ktrace_dropped, &head))
+    {
+        return NULL;
+    }
+
+    return &ktrace_ring[head & KTRACE_MASK];
+}
+
+/**
+ * @brief Fill and publish a claimed slot
+ */
+static void debug_ktrace_put(uint8_t type, uint32_t object, uint32_t arg,
+                             const uint8_t data[3])
+{
+    ktrace_slot_t *slot = debug_ktrace_claim();
+
+    if (slot == NULL)
+    {
+        return;
+    }
+
+    slot->cycles  = debug_cortex_m_cycles();
+    slot->object  = object;
+    slot->arg     = arg;
+    slot->data[0] = data[0];
+    slot->data[1] = data[1];
+    slot->data[2] = data[2];
+    __atomic_store_n(&slot->type, type, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Move published events to a record payload
+ *
+ * @param[out] events Destination for up to KTRACE_PER_RECORD events
+ * @param[in]  end    Stop at this head position
+ *
+ * @return Number of events taken
+ */
+static size_t debug_ktrace_take(uint8_t *events, uint32_t end)
+{
+    uint32_t tail  = ktrace_tail;
+    size_t   count = 0;
+
+    while ((tail != end) && (count < KTRACE_PER_RECORD))
+    {
+        ktrace_slot_t *slot = &ktrace_ring[tail & KTRACE_MASK];
+        uint8_t        type = __atomic_load_n(&slot->type, __ATOMIC_ACQUIRE);
+
+        if (type == 0U)
+        {
+            break;  /* Claimed but not yet published */
+        }
+
+        debug_ktrace_event_t ev =
+        {
+            .cycles = slot->cycles,
+            .object = slot->object,
+            .arg    = slot->arg,
+            .type   = type,
+            .data   = { slot->data[0], slot->data[1], slot->data[2] }
+        };
+
+        memcpy(&events[count * sizeof(ev)], &ev, sizeof(ev));
+        count++;
+
+        /* Free the slot before handing it back to the producers */
+        __atomic_store_n(&slot->type, 0U, __ATOMIC_RELAXED);
+        tail++;
+        __atomic_store_n(&ktrace_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Record one kernel event
+ */
+void debug_ktrace_event(uint8_t type, const void *object, uint32_t arg,
+                        uint8_t flags)
+{
+    const uint8_t data[3] = { flags, 0U, 0U };
+
+    debug_ktrace_put(type, (uint32_t)(uintptr_t)object, arg, data);
+}
+
+/**
+ * @brief Record a task creation and its name
+ *
+ * @note The name follows as TASK_NAME events of 7 bytes each, until the
+ *       chunk that holds its NUL.
+ */
+void debug_ktrace_task_create(const void *tcb, const char *name,
+                              uint32_t priority)
+{
+    const uint8_t none[3] = { 0U, 0U, 0U };
+    size_t        len     = strnlen(name, configMAX_TASK_NAME_LEN);
+
+    debug_ktrace_put(DEBUG_KTRACE_TASK_CREATE, (uint32_t)(uintptr_t)tcb,
+                     priority, none);
+
+    for (size_t pos = 0; pos <= len; pos += KTRACE_NAME_CHUNK)
+    {
+        uint8_t chunk[KTRACE_NAME_CHUNK] = { 0U };
+        size_t  n = ((len - pos) < KTRACE_NAME_CHUNK) ? (len - pos) : KTRACE_NAME_CHUNK;
+        uint32_t arg;
+
+        memcpy(chunk, &name[pos], n);
+        memcpy(&arg, chunk, sizeof(arg));
+        debug_ktrace_put(DEBUG_KTRACE_TASK_NAME, (uint32_t)(uintptr_t)tcb,
+                         arg, &chunk[sizeof(arg)]);
+    }
+}
+
+/**
+ * @brief Record an interrupt entry or exit
+ */
+void debug_ktrace_isr(uint8_t type)
+{
+    const uint8_t none[3] = { 0U, 0U, 0U };
+
+    debug_ktrace_put(type, __get_IPSR(), 0U, none);
+}
+
+/**
+ * @brief Send all events in the ring as DEBUG_RECORD_KTRACE records
+ *
+ * @return Number of events sent
+ *
+ * @note Stops at the head seen on entry, so events raised by the transport
+ *       while draining cannot keep the loop going.
+ */
+int debug_ktrace_drain(void)
+{
+    uint8_t               payload[DEBUG_RECORD_MAX_PAYLOAD];
+    debug_ktrace_record_t hdr;
+    uint32_t              end  = __atomic_load_n(&ktrace_head, __ATOMIC_ACQUIRE);
+    size_t                count;
+    int                   sent = 0;
+
+    while ((count = debug_ktrace_take(&payload[sizeof(hdr)], end)) > 0U)
+    {
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.version   = DEBUG_KTRACE_VERSION;
+        hdr.count     = (uint8_t)count;
+        hdr.cycles_hz = DEBUG_CYCLES_HZ;
+        hdr.dropped   = __atomic_load_n(&ktrace_dropped, __ATOMIC_RELAXED);
+        memcpy(payload, &hdr, sizeof(hdr));
+
+        (void)debug_write_record(DEBUG_RECORD_KTRACE, payload,
+                                 sizeof(hdr) + (count * sizeof(debug_ktrace_event_t)));
+        sent += (int)count;
+    }
+
+    return sent;
+}
+
+/**
+ * @brief Drain task body
+ *
+ * @param[in] arg Unused
+ */
+void debug_ktrace_task(void *arg)
+{
+    TickType_t last = xTaskGetTickCount();
+
+    (void)arg;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(DEBUG_KTRACE_PERIOD_MS));
+        (void)debug_ktrace_drain();
+    }
+}
+
+#endif /* DEBUG_USE_FREERTOS && DEBUG_ENABLE_KERNEL_TRACE */
+
+/****************************** End of file *********************************************/
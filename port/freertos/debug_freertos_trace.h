@@ -0,0 +1,179 @@
+/****************************************************************************************
+ * @file        debug_freertos_trace.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       FreeRTOS kernel and heap trace hooks
+ *
+ * @details
+ * With DEBUG_ENABLE_HEAP_TRACE, traceMALLOC and traceFREE feed the heap
+ * tracer (core/debug_heap.h) with the caller of pvPortMalloc() and
+ * vPortFree().
+ *
+ * With DEBUG_ENABLE_KERNEL_TRACE, the kernel writes fixed-size binary
+ * events (16 bytes, DWT cycle timestamp) into a lock-free ring:
+ *   - Task switch in / out, create (with name), delete
+ *   - Queue send / receive and blocking on a full / empty queue; these
+ *     cover semaphore give / take and mutexes, told apart by queue type
+ *   - Task notify (task and ISR APIs) and blocking on a notification
+ *   - ISR enter / exit (traceISR_xxx of ports that have them, or
+ *     DEBUG_KTRACE_IRQ_ENTER() / DEBUG_KTRACE_IRQ_EXIT() by hand)
+ *
+ * The ring is drained into DEBUG_RECORD_KTRACE records by
+ * debug_ktrace_drain(), normally from debug_ktrace_task(). The host tool
+ * tools/ktrace_perfetto converts them into a trace for ui.perfetto.dev.
+ *
+ * Usage, at the end of FreeRTOSConfig.h:
+ * @code
+ *   #include "debug_freertos_trace.h"
+ * @endcode
+ *
+ * @note
+ * Producers take a slot with a compare-and-swap, so hooks are safe from
+ * tasks and ISRs of any priority. The kernel lock is never taken.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_FREERTOS_TRACE_H
+#define DEBUG_FREERTOS_TRACE_H
+
+#include "config.h"
+
+#if DEBUG_USE_FREERTOS && !defined(__ASSEMBLER__) && !defined(__IAR_SYSTEMS_ASM__)
+
+/****************************** Heap trace **********************************************/
+#if DEBUG_ENABLE_HEAP_TRACE == YES
+
+#include "debug_heap.h"
+
+/* Expanded inside pvPortMalloc() / vPortFree(): return address 0 is their caller */
+#define traceMALLOC(pvAddress, uiSize) \
+    debug_heap_alloc((pvAddress), (uiSize), __builtin_return_address(0))
+#define traceFREE(pvAddress, uiSize) \
+    debug_heap_free((pvAddress), (uiSize), __builtin_return_address(0))
+
+#endif /* DEBUG_ENABLE_HEAP_TRACE */
+
+/****************************** Kernel trace ********************************************/
+#if DEBUG_ENABLE_KERNEL_TRACE == YES
+
+#if (configUSE_TRACE_FACILITY != 1)
+#error "Kernel trace needs configUSE_TRACE_FACILITY (queue types in events)."
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "debug_record.h"
+
+/****************************** Macros **************************************************/
+
+/** @brief Record an event of the running task */
+#define DEBUG_KTRACE_TASK(type, tcb) \
+    debug_ktrace_event((type), (tcb), 0U, 0U)
+
+/** @brief Record a queue event (arg = queue type) */
+#define DEBUG_KTRACE_QUEUE(type, queue, flags) \
+    debug_ktrace_event((type), (queue), (uint32_t)(queue)->ucQueueType, (flags))
+
+/** @brief Call first thing in an interrupt handler */
+#define DEBUG_KTRACE_IRQ_ENTER()  debug_ktrace_isr(DEBUG_KTRACE_ISR_ENTER)
+
+/** @brief Call last thing in an interrupt handler */
+#define DEBUG_KTRACE_IRQ_EXIT()   debug_ktrace_isr(DEBUG_KTRACE_ISR_EXIT)
+
+/* Scheduler */
+#define traceTASK_SWITCHED_IN()         DEBUG_KTRACE_TASK(DEBUG_KTRACE_SWITCH_IN, pxCurrentTCB)
+#define traceTASK_SWITCHED_OUT()        DEBUG_KTRACE_TASK(DEBUG_KTRACE_SWITCH_OUT, pxCurrentTCB)
+#define traceTASK_CREATE(pxNewTCB)      debug_ktrace_task_create((pxNewTCB), \
+                                            (pxNewTCB)->pcTaskName,          \
+                                            (uint32_t)(pxNewTCB)->uxPriority)
+#define traceTASK_DELETE(pxTCB)         DEBUG_KTRACE_TASK(DEBUG_KTRACE_TASK_DELETE, pxTCB)
+
+/* Queues, semaphores and mutexes */
+#define traceQUEUE_SEND(pxQueue)                DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_QUEUE_SEND, pxQueue, 0U)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_QUEUE_SEND, pxQueue, DEBUG_KTRACE_FROM_ISR)
+#define traceQUEUE_RECEIVE(pxQueue)             DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_QUEUE_RECEIVE, pxQueue, 0U)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_QUEUE_RECEIVE, pxQueue, DEBUG_KTRACE_FROM_ISR)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)    DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_BLOCK_SEND, pxQueue, 0U)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) DEBUG_KTRACE_QUEUE(DEBUG_KTRACE_BLOCK_RECEIVE, pxQueue, 0U)
+
+/* Task notifications (argument lists differ between kernel versions) */
+#define traceTASK_NOTIFY(...)                debug_ktrace_event(DEBUG_KTRACE_NOTIFY, pxTCB, 0U, 0U)
+#define traceTASK_NOTIFY_FROM_ISR(...)       debug_ktrace_event(DEBUG_KTRACE_NOTIFY, pxTCB, 0U, DEBUG_KTRACE_FROM_ISR)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(...)  debug_ktrace_event(DEBUG_KTRACE_NOTIFY, pxTCB, 0U, DEBUG_KTRACE_FROM_ISR)
+#define traceTASK_NOTIFY_TAKE_BLOCK(...)     DEBUG_KTRACE_TASK(DEBUG_KTRACE_NOTIFY_WAIT, pxCurrentTCB)
+#define traceTASK_NOTIFY_WAIT_BLOCK(...)     DEBUG_KTRACE_TASK(DEBUG_KTRACE_NOTIFY_WAIT, pxCurrentTCB)
+
+/* Interrupts (FreeRTOS V11 ports call these from their own handlers) */
+#define traceISR_ENTER()                DEBUG_KTRACE_IRQ_ENTER()
+#define traceISR_EXIT()                 DEBUG_KTRACE_IRQ_EXIT()
+#define traceISR_EXIT_TO_SCHEDULER()    DEBUG_KTRACE_IRQ_EXIT()
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Record one kernel event
+ *
+ * @param[in]       type    DEBUG_KTRACE_xxx
+ * @param[in]       object  Task, queue or other kernel object
+ * @param[in]       arg     Event specific argument
+ * @param[in]       flags   DEBUG_KTRACE_FROM_ISR or 0
+ *
+ * @note Lock-free; callable from any context. Counts a drop if the ring
+ *       is full.
+ */
+void debug_ktrace_event(uint8_t type, const void *object, uint32_t arg,
+                        uint8_t flags);
+
+/**
+ * @brief           Record a task creation and its name
+ *
+ * @param[in]       tcb      New task
+ * @param[in]       name     Task name
+ * @param[in]       priority Task priority
+ */
+void debug_ktrace_task_create(const void *tcb, const char *name,
+                              uint32_t priority);
+
+/**
+ * @brief           Record an interrupt entry or exit (exception number from IPSR)
+ *
+ * @param[in]       type    DEBUG_KTRACE_ISR_ENTER or DEBUG_KTRACE_ISR_EXIT
+ */
+void debug_ktrace_isr(uint8_t type);
+
+/**
+ * @brief           Send all events in the ring as DEBUG_RECORD_KTRACE records
+ *
+ * @return          Number of events sent
+ *
+ * @note
+ * Single consumer: call from one task only. Events raised while draining
+ * (e.g. by the transport's own locking) go out with the next call.
+ */
+int debug_ktrace_drain(void);
+
+/**
+ * @brief           Drain task body
+ *
+ * @param[in]       arg Unused
+ *
+ * @note Calls debug_ktrace_drain() every DEBUG_KTRACE_PERIOD_MS; never returns.
+ */
+void debug_ktrace_task(void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_ENABLE_KERNEL_TRACE */
+#endif /* DEBUG_USE_FREERTOS && !assembler */
+#endif /* DEBUG_FREERTOS_TRACE_H */
+
+/****************************** End of file *********************************************/
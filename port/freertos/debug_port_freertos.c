@@ -25,6 +25,7 @@
 #include "task.h"
 #include "semphr.h"
 #include "core_cm4.h"  /* Replace with correct core header if needed */
+#include "debug_port_cortex_m.h"
 
 /****************************** Static function prototypes ******************************/
 static int      debug_port_freertos_init(void);
@@ -34,6 +35,9 @@ static void     debug_port_freertos_unlock(void);
 static uint32_t debug_port_freertos_get_timestamp(void);
 static int      debug_port_freertos_is_isr(void);
 static const char *debug_port_freertos_get_thread_name(void);
+static void     debug_port_freertos_panic_enter(void);
+static uint32_t debug_port_freertos_get_cycles(void);
+static size_t   debug_port_freertos_get_backtrace(uintptr_t *addrs, size_t max);
 
 /****************************** Static variables ****************************************/
 static SemaphoreHandle_t debug_mutex = NULL;
@@ -49,7 +53,11 @@ static const debug_port_ops_t DEBUG_PORT_FREERTOS_OPS =
     .unlock          = debug_port_freertos_unlock,
     .get_timestamp   = debug_port_freertos_get_timestamp,
     .is_isr          = debug_port_freertos_is_isr,
-    .get_thread_name = debug_port_freertos_get_thread_name
+    .get_thread_name = debug_port_freertos_get_thread_name,
+    .panic_enter     = debug_port_freertos_panic_enter,
+    .get_cycles      = debug_port_freertos_get_cycles,
+    .get_backtrace   = debug_port_freertos_get_backtrace,
+    .sample_timer    = NULL     /* Application timer, DEBUG_PORT_SAMPLE_HANDLER */
 };
 
 /****************************** Function definitions ************************************/
@@ -59,10 +67,12 @@ static const debug_port_ops_t DEBUG_PORT_FREERTOS_OPS =
  *
  * @return 0 on success, -1 on failure
  *
- * @note Creates a mutex for thread-safe debug output.
+ * @note Creates a mutex for thread-safe debug output and enables the
+ *       DWT cycle counter.
  */
 static int debug_port_freertos_init(void)
 {
+    debug_cortex_m_cycles_init();
     debug_mutex = xSemaphoreCreateMutex();
     return (debug_mutex != NULL) ? 0 : -1;
 }
@@ -150,6 +160,42 @@ static const char *debug_port_freertos_get_thread_name(void)
     return (name != NULL) ? name : "TASK";
 }
 
+/**
+ * @brief Enter panic mode
+ *
+ * @note
+ * Uses PRIMASK rather than taskDISABLE_INTERRUPTS(), so interrupts above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY are masked as well. The debug core
+ * stops taking the mutex once panic mode is active.
+ */
+static void debug_port_freertos_panic_enter(void)
+{
+    __disable_irq();
+}
+
+/**
+ * @brief Get the high-resolution cycle count
+ *
+ * @return DWT cycle counter (0 where unavailable)
+ */
+static uint32_t debug_port_freertos_get_cycles(void)
+{
+    return debug_cortex_m_cycles();
+}
+
+/**
+ * @brief Capture the current call chain
+ *
+ * @param[out] addrs Destination for return addresses
+ * @param[in]  max   Capacity of @p addrs
+ *
+ * @return Number of addresses captured
+ */
+static size_t debug_port_freertos_get_backtrace(uintptr_t *addrs, size_t max)
+{
+    return debug_cortex_m_backtrace(addrs, max);
+}
+
 /**
  * @brief Get FreeRTOS debug port operations table
  *
@@ -1,34 +1,35 @@
 /****************************************************************************************
- * @file        debug_port_baremetal.h
+ * @file        debug_port_freertos.h
  * @author      Sarath S
- * @date        2026-01-02
- * @version     1.0
- * @brief       Bare-metal debug port interface
+ * @date        2026-10-17
+ * @version     1.1
+ * @brief       FreeRTOS debug port interface
  *
  * @details
- * Declares the bare-metal debug port layer for the debug framework.
- * This implementation provides minimal OS abstraction services suitable
- * for systems without an RTOS.
+ * Declares the FreeRTOS debug port layer for the debug framework.
+ * This implementation provides OS abstraction services for applications
+ * running on FreeRTOS.
  *
  * Features:
- *   - Locking / unlocking        : No-op
- *   - ISR detection              : Stub or architecture-specific
- *   - Timestamp retrieval        : Stub or system tick based
- *   - Thread name access         : Static string ("MAIN" or "ISR")
+ *   - Locking / unlocking        : FreeRTOS mutex (skipped in ISR context)
+ *   - ISR detection              : IPSR register
+ *   - Timestamp retrieval        : Kernel tick count
+ *   - Thread name access         : Current task name or "ISR"
+ *   - Panic entry                : Masks interrupts via PRIMASK
  *
  * The debug core accesses this layer only via the operations table returned
- * by @ref debug_port_baremetal_ops, keeping the framework OS-agnostic.
+ * by @ref debug_port_freertos_ops, keeping the framework OS-agnostic.
  *
  * @contact     elektronikaembedded@gmail.com
  * @website     https://elektronikaembedded.wordpress.com
  ****************************************************************************************/
 
-#ifndef DEBUG_PORT_BAREMETAL_H
-#define DEBUG_PORT_BAREMETAL_H
+#ifndef DEBUG_PORT_FREERTOS_H
+#define DEBUG_PORT_FREERTOS_H
 
 #include "config.h"
 
-#if DEBUG_USE_BAREMETAL
+#if DEBUG_USE_FREERTOS
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,25 +43,25 @@ extern "C" {
 /****************************** Function declarations ************************************/
 
 /**
- * @brief           Get bare-metal debug port operations table
+ * @brief           Get FreeRTOS debug port operations table
  *
- * Returns a pointer to the bare-metal debug port operations structure.
- * This structure contains function pointers implementing the minimal
- * services required by the debug framework on non-RTOS systems.
+ * Returns a pointer to the FreeRTOS debug port operations structure.
+ * This structure contains function pointers implementing the services
+ * required by the debug framework on FreeRTOS-based systems.
  *
- * @return          Pointer to bare-metal debug port operations table
+ * @return          Pointer to FreeRTOS debug port operations table
  *
  * @note
- * Intended for systems running without an RTOS.
- * All operations are lightweight and ISR-safe.
+ * The mutex used for locking is created by the init operation, so the
+ * port must be initialized before the scheduler-dependent services are used.
  */
-const debug_port_ops_t *debug_port_baremetal_ops(void);
+const debug_port_ops_t *debug_port_freertos_ops(void);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* DEBUG_USE_BAREMETAL */
-#endif /* DEBUG_PORT_BAREMETAL_H */
+#endif /* DEBUG_USE_FREERTOS */
+#endif /* DEBUG_PORT_FREERTOS_H */
 
 /****************************** End of file *********************************************/
@@ -0,0 +1,103 @@
+/****************************************************************************************
+ * @file        debug_heap_wrap.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       POSIX malloc/free wrappers for the heap tracer
+ *
+ * @details
+ * Link with
+ * @code
+ *   -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+ * @endcode
+ * and every call to these functions from the linked objects goes through
+ * the wrappers below, which forward to the C library and record the event
+ * with debug_heap_alloc() / debug_heap_free(). A realloc() that moves or
+ * resizes a block is recorded as a free followed by an allocation.
+ *
+ * Allocations made inside the C library itself (strdup(), fopen(), ...)
+ * do not go through the linker wrap and are not seen.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#include "config.h"
+
+#if DEBUG_USE_POSIX && (DEBUG_ENABLE_HEAP_TRACE == YES)
+
+/****************************** Header include files ************************************/
+#include <stddef.h>
+#include "debug_heap.h"
+
+/****************************** Function declarations ***********************************/
+
+/* C library entry points, provided by the linker for --wrap */
+void *__real_malloc(size_t size);
+void  __real_free(void *ptr);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size);
+void  __wrap_free(void *ptr);
+void *__wrap_calloc(size_t nmemb, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief malloc() with tracing
+ */
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+
+    debug_heap_alloc(ptr, size, __builtin_return_address(0));
+    return ptr;
+}
+
+/**
+ * @brief free() with tracing
+ */
+void __wrap_free(void *ptr)
+{
+    debug_heap_free(ptr, 0U, __builtin_return_address(0));
+    __real_free(ptr);
+}
+
+/**
+ * @brief calloc() with tracing
+ */
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = __real_calloc(nmemb, size);
+
+    debug_heap_alloc(ptr, nmemb * size, __builtin_return_address(0));
+    return ptr;
+}
+
+/**
+ * @brief realloc() with tracing
+ *
+ * @note On failure the old block stays allocated; only a failed
+ *       allocation is recorded.
+ */
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    const void *caller = __builtin_return_address(0);
+    void       *moved  = __real_realloc(ptr, size);
+
+    if ((moved != NULL) || (size == 0U))
+    {
+        debug_heap_free(ptr, 0U, caller);
+    }
+    if ((moved != NULL) || (size != 0U))
+    {
+        debug_heap_alloc(moved, size, caller);
+    }
+    return moved;
+}
+
+#endif /* DEBUG_USE_POSIX && DEBUG_ENABLE_HEAP_TRACE */
+
+/****************************** End of file *********************************************/
@@ -0,0 +1,359 @@
+/****************************************************************************************
+ * @file        debug_port_posix.c
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       POSIX (Linux host) debug port implementation
+ *
+ * @details
+ * Implements the debug port layer on top of pthreads and clock_gettime()
+ * for host simulation builds.
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+/* Must precede every system header: pthread_getname_np() is a GNU extension */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "config.h"
+
+#if DEBUG_USE_POSIX
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <execinfo.h>
+#include "debug_port_posix.h"
+#include "debug_port.h"
+#if DEBUG_ENABLE_SAMPLE == YES
+#include <errno.h>
+#include <signal.h>
+#include <ucontext.h>
+#include "debug_sample.h"
+#endif
+
+/****************************** Macros **************************************************/
+
+/** @brief Length of a pthread name including the terminator */
+#define POSIX_THREAD_NAME_LEN   16U
+
+/** @brief Upper bound on frames requested from backtrace() */
+#define POSIX_BACKTRACE_MAX     64
+
+/** @brief Most samples recorded for one SIGPROF (1 + timer overruns) */
+#define POSIX_SAMPLE_OVERRUN_MAX 64
+
+/****************************** Static function prototypes ******************************/
+static int      debug_port_posix_init(void);
+static int      debug_port_posix_deinit(void);
+static void     debug_port_posix_lock(void);
+static void     debug_port_posix_unlock(void);
+static uint32_t debug_port_posix_get_timestamp(void);
+static int      debug_port_posix_is_isr(void);
+static const char *debug_port_posix_get_thread_name(void);
+static uint32_t debug_port_posix_get_cycles(void);
+static size_t   debug_port_posix_get_backtrace(uintptr_t *addrs, size_t max);
+#if DEBUG_ENABLE_SAMPLE == YES
+static int      debug_port_posix_sample_timer(uint32_t hz);
+#endif
+
+/****************************** Static variables ****************************************/
+static pthread_mutex_t debug_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief Per-thread name buffer */
+static __thread char s_thread_name[POSIX_THREAD_NAME_LEN];
+
+#if DEBUG_ENABLE_SAMPLE == YES
+/** @brief PC sampling timer */
+static timer_t s_sample_timer;
+static uint8_t s_sample_armed = 0;
+#endif
+
+/**
+ * @brief POSIX debug port operations table
+ */
+static const debug_port_ops_t DEBUG_PORT_POSIX_OPS =
+{
+    .init            = debug_port_posix_init,
+    .deinit          = debug_port_posix_deinit,
+    .lock            = debug_port_posix_lock,
+    .unlock          = debug_port_posix_unlock,
+    .get_timestamp   = debug_port_posix_get_timestamp,
+    .is_isr          = debug_port_posix_is_isr,
+    .get_thread_name = debug_port_posix_get_thread_name,
+    .panic_enter     = NULL,
+    .get_cycles      = debug_port_posix_get_cycles,
+    .get_backtrace   = debug_port_posix_get_backtrace,
+#if DEBUG_ENABLE_SAMPLE == YES
+    .sample_timer    = debug_port_posix_sample_timer
+#else
+    .sample_timer    = NULL
+#endif
+};
+
+/****************************** Function definitions ************************************/
+
+/**
+ * @brief Initialize POSIX debug port
+ *
+ * @return 0 on success
+ */
+static int debug_port_posix_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief Deinitialize POSIX debug port
+ *
+ * @return 0 on success
+ */
+static int debug_port_posix_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief Lock debug output
+ */
+static void debug_port_posix_lock(void)
+{
+    (void)pthread_mutex_lock(&debug_mutex);
+}
+
+/**
+ * @brief Unlock debug output
+ */
+static void debug_port_posix_unlock(void)
+{
+    (void)pthread_mutex_unlock(&debug_mutex);
+}
+
+/**
+ * @brief Get system timestamp
+ *
+ * @return Monotonic time in milliseconds
+ */
+static uint32_t debug_port_posix_get_timestamp(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000U) +
+                      ((uint64_t)ts.tv_nsec / 1000000U));
+}
+
+/**
+ * @brief Check whether current context is ISR
+ *
+ * @return Always 0 on the host
+ */
+static int debug_port_posix_is_isr(void)
+{
+    return 0;
+}
+
+/**
+ * @brief Get current thread name
+ *
+ * @return pthread name, or "MAIN" if none was set
+ */
+static const char *debug_port_posix_get_thread_name(void)
+{
+    if ('\0' == s_thread_name[0])
+    {
+        if ((0 != pthread_getname_np(pthread_self(), s_thread_name,
+                                     sizeof(s_thread_name))) ||
+            ('\0' == s_thread_name[0]))
+        {
+            return "MAIN";
+        }
+    }
+
+    return s_thread_name;
+}
+
+/**
+ * @brief Get the high-resolution cycle count
+ *
+ * @return Monotonic time in nanoseconds (wraps every ~4.3 s)
+ */
+static uint32_t debug_port_posix_get_cycles(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000U) +
+                      (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * @brief Capture the current call chain
+ *
+ * @param[out] addrs Destination for return addresses
+ * @param[in]  max   Capacity of @p addrs
+ *
+ * @return Number of addresses captured
+ */
+static size_t debug_port_posix_get_backtrace(uintptr_t *addrs, size_t max)
+{
+    void *frames[POSIX_BACKTRACE_MAX];
+    int   want = (max < POSIX_BACKTRACE_MAX) ? (int)max : POSIX_BACKTRACE_MAX;
+    int   n    = backtrace(frames, want);
+
+    for (int i = 0; i < n; i++)
+    {
+        addrs[i] = (uintptr_t)frames[i];
+    }
+
+    return (n > 0) ? (size_t)n : 0U;
+}
+
+#if DEBUG_ENABLE_SAMPLE == YES
+/**
+ * @brief SIGPROF handler: sample the interrupted PC
+ *
+ * @param[in] sig  Signal number
+ * @param[in] info Signal information
+ * @param[in] uctx Interrupted context (ucontext_t)
+ */
+static void debug_port_posix_sample_signal(int sig, siginfo_t *info, void *uctx)
+{
+    const ucontext_t *uc    = uctx;
+    uintptr_t         pc    = 0;
+    int               saved = errno;
+
+    (void)sig;
+
+#if defined(__x86_64__)
+    pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__i386__)
+    pc = (uintptr_t)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__aarch64__)
+    pc = (uintptr_t)uc->uc_mcontext.pc;
+#elif defined(__arm__)
+    pc = (uintptr_t)uc->uc_mcontext.arm_pc;
+#else
+    (void)uc;   /* Unknown context layout: samples count as outside the image */
+#endif
+
+    /* Runs on the interrupted thread, so its name is the right one. The
+     * kernel checks CPU timers on its own tick: periods that expired in
+     * between arrive as overruns and are charged to this PC, so the count
+     * still matches the requested rate. */
+    const char *thread = debug_port_posix_get_thread_name();
+    int         count  = 1 + ((SI_TIMER == info->si_code) ? info->si_overrun : 0);
+
+    if (count > POSIX_SAMPLE_OVERRUN_MAX)
+    {
+        count = POSIX_SAMPLE_OVERRUN_MAX;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        debug_sample_tick(pc, thread);
+    }
+    errno = saved;
+}
+
+/**
+ * @brief Start or stop the PC sampling timer
+ *
+ * @param[in] hz Sampling rate, 0 to stop
+ *
+ * @return 0 on success, -1 on failure
+ *
+ * @note
+ * The timer counts the CPU time of the whole process, so only running
+ * threads are sampled; Linux delivers the signal to the thread that
+ * was running, at most once per kernel tick. The handler stays
+ * installed after a stop, in case a signal is still pending.
+ */
+static int debug_port_posix_sample_timer(uint32_t hz)
+{
+    if (0U != s_sample_armed)
+    {
+        (void)timer_delete(s_sample_timer);
+        s_sample_armed = 0;
+    }
+    if (0U == hz)
+    {
+        return 0;
+    }
+
+    struct sigaction sa;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = debug_port_posix_sample_signal;
+    sa.sa_flags     = SA_SIGINFO | SA_RESTART;
+    (void)sigemptyset(&sa.sa_mask);
+    if (0 != sigaction(SIGPROF, &sa, NULL))
+    {
+        return -1;
+    }
+
+    struct sigevent sev;
+
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo  = SIGPROF;
+    if (0 != timer_create(CLOCK_PROCESS_CPUTIME_ID, &sev, &s_sample_timer))
+    {
+        return -1;
+    }
+
+    uint64_t          ns = 1000000000ULL / hz;
+    struct itimerspec its;
+
+    its.it_interval.tv_sec  = (time_t)(ns / 1000000000ULL);
+    its.it_interval.tv_nsec = (long)(ns % 1000000000ULL);
+    its.it_value            = its.it_interval;
+    if (0 != timer_settime(s_sample_timer, 0, &its, NULL))
+    {
+        (void)timer_delete(s_sample_timer);
+        return -1;
+    }
+    s_sample_armed = 1;
+
+    return 0;
+}
+#endif /* DEBUG_ENABLE_SAMPLE */
+
+/**
+ * @brief Name the calling thread and refresh the cached name
+ *
+ * @param[in] name Thread name
+ *
+ * @return 0 on success, -1 if the name was rejected
+ */
+int debug_port_posix_set_thread_name(const char *name)
+{
+    if ((NULL == name) || (0 != pthread_setname_np(pthread_self(), name)))
+    {
+        return -1;
+    }
+
+    /* Cleared first: a signal in between reads the pthread name again */
+    s_thread_name[0] = '\0';
+    (void)pthread_getname_np(pthread_self(), s_thread_name, sizeof(s_thread_name));
+
+    return 0;
+}
+
+/**
+ * @brief Get POSIX debug port operations table
+ *
+ * @return Pointer to operations table
+ */
+const debug_port_ops_t *debug_port_posix_ops(void)
+{
+    return &DEBUG_PORT_POSIX_OPS;
+}
+
+#endif /* DEBUG_USE_POSIX */
+
+/****************************** End of file *********************************************/
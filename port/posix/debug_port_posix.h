@@ -0,0 +1,77 @@
+/****************************************************************************************
+ * @file        debug_port_posix.h
+ * @author      Sarath S
+ * @date        2026-10-17
+ * @version     1.0
+ * @brief       POSIX (Linux host) debug port interface
+ *
+ * @details
+ * Declares the host debug port layer, used to run the debug framework in
+ * host simulation builds and benchmarks on Linux.
+ *
+ * Features:
+ *   - Locking / unlocking        : pthread mutex
+ *   - ISR detection              : Always thread context
+ *   - Timestamp retrieval        : CLOCK_MONOTONIC in milliseconds
+ *   - Thread name access         : pthread name, cached per thread ("MAIN"
+ *                                  if unnamed, shared by all such threads)
+ *   - Cycle counter              : CLOCK_MONOTONIC in nanoseconds
+ *   - Backtraces                 : glibc backtrace()
+ *   - PC sampling timer          : SIGPROF on the process CPU time
+ *
+ * @contact     elektronikaembedded@gmail.com
+ * @website     https://elektronikaembedded.wordpress.com
+ ****************************************************************************************/
+
+#ifndef DEBUG_PORT_POSIX_H
+#define DEBUG_PORT_POSIX_H
+
+#include "config.h"
+
+#if DEBUG_USE_POSIX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************** Header include files ************************************/
+#include <stdint.h>
+#include "common.h"
+#include "debug_port.h"   /*!< Required for debug_port_ops_t */
+
+/****************************** Function declarations ************************************/
+
+/**
+ * @brief           Get POSIX debug port operations table
+ *
+ * @return          Pointer to POSIX debug port operations table
+ *
+ * @note
+ * get_cycles() counts nanoseconds, so set DEBUG_CYCLES_HZ to 1000000000
+ * in host builds.
+ */
+const debug_port_ops_t *debug_port_posix_ops(void);
+
+/**
+ * @brief           Name the calling thread for the debug output
+ *
+ * @param[in]       name  Thread name (at most 15 characters are kept)
+ *
+ * @return          0 on success, -1 if the name was rejected
+ *
+ * @note
+ * The port reads the pthread name once, on the first log line of a thread,
+ * and caches it. A thread renamed later with pthread_setname_np() keeps
+ * the old name in the output; rename it with this function instead.
+ * Threads without a name are all reported as "MAIN".
+ */
+int debug_port_posix_set_thread_name(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_POSIX */
+#endif /* DEBUG_PORT_POSIX_H */
+
+/****************************** End of file *********************************************/
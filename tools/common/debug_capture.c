@@ -0,0 +1,223 @@
+/**
+ * @file      debug_capture.c
+ * @brief     In-place access to capture files for host tools.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_capture.h.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "debug_capture.h"
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+typedef struct
+{
+    debug_capture_part_t *part;
+    debug_capture_walk_t  walk;
+} capture_job_t;
+
+static void *capture_thread(void *arg)
+{
+    capture_job_t *job = arg;
+
+    job->walk(job->part);
+    return NULL;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_capture_map(debug_capture_map_t *m, const char *path)
+{
+    struct stat st;
+
+    if (m->fd < 0)
+    {
+        m->buf  = NULL;
+        m->size = 0;
+        m->fd   = open(path, O_RDONLY | O_CLOEXEC);
+        if (m->fd < 0)
+        {
+            return -1;
+        }
+    }
+    if (0 != fstat(m->fd, &st))
+    {
+        return -1;
+    }
+    if ((uint64_t)st.st_size == m->size)
+    {
+        return 0;
+    }
+
+    if (NULL != m->buf)
+    {
+        munmap((void *)m->buf, (size_t)m->size);
+        m->buf  = NULL;
+        m->size = 0;
+    }
+    if (0 == st.st_size)
+    {
+        return 0;
+    }
+
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, m->fd, 0);
+
+    if (MAP_FAILED == p)
+    {
+        return -1;
+    }
+    (void)madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    m->buf  = p;
+    m->size = (uint64_t)st.st_size;
+
+    return 0;
+}
+
+void debug_capture_unmap(debug_capture_map_t *m)
+{
+    if (NULL != m->buf)
+    {
+        munmap((void *)m->buf, (size_t)m->size);
+        m->buf = NULL;
+    }
+    if (m->fd >= 0)
+    {
+        close(m->fd);
+        m->fd = -1;
+    }
+    m->size = 0;
+}
+
+debug_capture_entry_t debug_capture_entry(const uint8_t *buf, uint64_t size,
+                                          uint64_t p, uint64_t *len)
+{
+    if (DEBUG_RECORD_MARKER == buf[p])
+    {
+        long r = debug_stream_record_at(&buf[p], (size_t)(size - p));
+
+        if (r < 0)
+        {
+            return DEBUG_CAPTURE_NONE;
+        }
+        if (r > 0)
+        {
+            *len = (uint64_t)r;
+            return DEBUG_CAPTURE_RECORD;
+        }
+        /* Bad record: the bytes are text up to the next LF */
+    }
+
+    const uint8_t *nl = memchr(&buf[p], '\n', (size_t)(size - p));
+
+    if (NULL == nl)
+    {
+        return DEBUG_CAPTURE_NONE;      /* Line still being written */
+    }
+
+    *len = (uint64_t)(nl - &buf[p]) + 1U;
+    return DEBUG_CAPTURE_LINE;
+}
+
+unsigned debug_capture_parallel(const uint8_t *buf, uint64_t size,
+                                uint64_t from, unsigned jobs,
+                                uint64_t min_chunk,
+                                debug_capture_part_t *parts,
+                                debug_capture_walk_t walk)
+{
+    uint64_t      span = size - from;
+    pthread_t     tid[DEBUG_CAPTURE_MAX_JOBS];
+    capture_job_t job[DEBUG_CAPTURE_MAX_JOBS];
+
+    if (jobs > DEBUG_CAPTURE_MAX_JOBS) jobs = DEBUG_CAPTURE_MAX_JOBS;
+    if (jobs < 1U)                     jobs = 1U;
+    while ((jobs > 1U) && ((span / jobs) < min_chunk))
+    {
+        jobs--;
+    }
+
+    /* Guess split points at line starts */
+    for (unsigned i = 0; i < jobs; i++)
+    {
+        uint64_t nominal = from + ((span * i) / jobs);
+
+        parts[i].buf   = buf;
+        parts[i].size  = size;
+        parts[i].index = i;
+
+        if (0U == i)
+        {
+            parts[i].start = from;
+        }
+        else
+        {
+            const uint8_t *nl = memchr(&buf[nominal - 1U], '\n',
+                                       (size_t)(size - nominal + 1U));
+            parts[i].start = (NULL != nl) ? (uint64_t)(nl - buf) + 1U : size;
+        }
+    }
+    for (unsigned i = 0; i < jobs; i++)
+    {
+        parts[i].stop = ((i + 1U) < jobs) ? parts[i + 1U].start : size;
+        parts[i].end  = parts[i].start;
+    }
+
+    for (unsigned i = 1; i < jobs; i++)
+    {
+        job[i].part = &parts[i];
+        job[i].walk = walk;
+        if (0 != pthread_create(&tid[i], NULL, capture_thread, &job[i]))
+        {
+            tid[i] = 0;
+            walk(&parts[i]);
+        }
+    }
+    walk(&parts[0]);
+    for (unsigned i = 1; i < jobs; i++)
+    {
+        if (0 != tid[i])
+        {
+            pthread_join(tid[i], NULL);
+        }
+    }
+
+    /* Redo any part whose guessed start was inside a record */
+    for (unsigned i = 1; i < jobs; i++)
+    {
+        if (parts[i].start != parts[i - 1U].end)
+        {
+            parts[i].start = parts[i - 1U].end;
+            parts[i].end   = parts[i].start;
+            walk(&parts[i]);
+        }
+    }
+
+    return jobs;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
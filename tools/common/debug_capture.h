@@ -0,0 +1,163 @@
+/**
+ * @file      debug_capture.h
+ * @brief     In-place access to capture files for host tools.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Helpers for tools that process a whole capture at once rather than a
+ * live stream:
+ *
+ *  - mapping a capture read-only, and remapping it when it has grown
+ *  - walking it entry by entry (text lines and binary records)
+ *  - splitting it across threads
+ *
+ * A capture can only be split at line starts, but binary records may
+ * contain line feeds, so a guessed split point can fall inside a record.
+ * debug_capture_parallel() detects this after the parallel pass (the
+ * previous part did not end where the next one started) and walks the
+ * affected part again from the correct position.
+ *
+ * Records are recognized at line starts only, which is where the device
+ * emits them.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_CAPTURE_H
+#define DEBUG_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Most parts debug_capture_parallel() creates */
+#define DEBUG_CAPTURE_MAX_JOBS  64U
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Read-only capture mapping.
+ */
+typedef struct
+{
+    int            fd;      /**< Open file, -1 before the first map */
+    const uint8_t *buf;     /**< Mapped bytes (NULL for an empty file) */
+    uint64_t       size;    /**< Mapped size */
+} debug_capture_map_t;
+
+/**
+ * @brief Kind of entry at a position.
+ */
+typedef enum
+{
+    DEBUG_CAPTURE_NONE = 0, /**< Incomplete entry at end of data */
+    DEBUG_CAPTURE_LINE,     /**< Text line, including its LF */
+    DEBUG_CAPTURE_RECORD    /**< Binary record with a valid CRC */
+} debug_capture_entry_t;
+
+/**
+ * @brief One part of a parallel walk.
+ */
+typedef struct
+{
+    const uint8_t *buf;     /**< Whole capture */
+    uint64_t       size;    /**< Capture size */
+    uint64_t       start;   /**< First entry of the part starts here */
+    uint64_t       stop;    /**< No entry of the part starts at or after this */
+    uint64_t       end;     /**< Set by the walk: where it stopped */
+    unsigned       index;   /**< Part number */
+    void          *user;    /**< Tool state for this part */
+} debug_capture_part_t;
+
+/**
+ * @brief Walk one part.
+ *
+ * Must process the entries starting in [start, stop), set end to the
+ * position after the last one, and discard the results of an earlier
+ * call for the same part (it is called again after a bad split).
+ */
+typedef void (*debug_capture_walk_t)(debug_capture_part_t *part);
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Map a capture, or remap it if its size has changed.
+ *
+ * @param[in,out] m    Mapping; set fd to -1 before the first call
+ * @param[in]     path Capture file
+ *
+ * @retval 0   Success
+ * @retval -1  The file could not be opened or mapped (see errno)
+ */
+int debug_capture_map(debug_capture_map_t *m, const char *path);
+
+/**
+ * @brief Unmap and close a capture.
+ *
+ * @param[in,out] m Mapping
+ */
+void debug_capture_unmap(debug_capture_map_t *m);
+
+/**
+ * @brief Classify the entry starting at p.
+ *
+ * @param[in]  buf  Capture bytes
+ * @param[in]  size Bytes available
+ * @param[in]  p    Entry start (a line start)
+ * @param[out] len  Entry length
+ *
+ * @return Entry kind
+ */
+debug_capture_entry_t debug_capture_entry(const uint8_t *buf, uint64_t size,
+                                          uint64_t p, uint64_t *len);
+
+/**
+ * @brief Walk [from, size) in parallel.
+ *
+ * @param[in]     buf       Capture bytes
+ * @param[in]     size      Capture size
+ * @param[in]     from      Entry start to begin at
+ * @param[in]     jobs      Threads to use
+ * @param[in]     min_chunk Smallest part size; fewer parts are used for
+ *                          small inputs
+ * @param[in,out] parts     Array of DEBUG_CAPTURE_MAX_JOBS parts; user must
+ *                          be set by the caller
+ * @param[in]     walk      Walk callback
+ *
+ * @return Number of parts used; parts[n - 1].end is where the walk ended
+ */
+unsigned debug_capture_parallel(const uint8_t *buf, uint64_t size,
+                                uint64_t from, unsigned jobs,
+                                uint64_t min_chunk,
+                                debug_capture_part_t *parts,
+                                debug_capture_walk_t walk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_CAPTURE_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,308 @@
+/**
+ * @file      debug_clock.c
+ * @brief     Device clock offset and drift estimation.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_clock.h.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "debug_clock.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Points further than this many RMS from the line are rejected */
+#define CLOCK_REJECT_SIGMA  3.0
+
+/** @brief Sanity limit on the one-sided bucket table */
+#define CLOCK_MAX_BUCKETS   1e8
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static int clock_grow(debug_clock_t *c, size_t need)
+{
+    if (need <= c->cap)
+    {
+        return 0;
+    }
+
+    size_t cap = (0U != c->cap) ? c->cap : 256U;
+
+    while (cap < need)
+    {
+        cap *= 2U;
+    }
+
+    double *x = realloc(c->x, cap * sizeof(double));
+    if (NULL != x) c->x = x;
+    double *y = realloc(c->y, cap * sizeof(double));
+    if (NULL != y) c->y = y;
+    double *w = realloc(c->w, cap * sizeof(double));
+    if (NULL != w) c->w = w;
+
+    if ((NULL == x) || (NULL == y) || (NULL == w))
+    {
+        return -1;
+    }
+
+    /* New one-sided buckets start out empty (weight 0) */
+    memset(&c->w[c->cap], 0, (cap - c->cap) * sizeof(double));
+    c->cap = cap;
+
+    return 0;
+}
+
+/**
+ * @brief Weighted least squares over the points with keep[i] set.
+ */
+static int clock_lsq(const debug_clock_t *c, const unsigned char *keep,
+                     debug_clock_fit_t *fit)
+{
+    double sw = 0, sx = 0, sy = 0;
+    uint64_t n = 0;
+
+    for (size_t i = 0; i < c->count; i++)
+    {
+        if ((0 != keep[i]) && (c->w[i] > 0.0))
+        {
+            sw += c->w[i];
+            sx += c->w[i] * c->x[i];
+            sy += c->w[i] * c->y[i];
+            n++;
+        }
+    }
+    if (0U == n)
+    {
+        return -1;
+    }
+
+    double mx = sx / sw;
+    double my = sy / sw;
+    double sxx = 0, sxy = 0;
+
+    for (size_t i = 0; i < c->count; i++)
+    {
+        if ((0 != keep[i]) && (c->w[i] > 0.0))
+        {
+            double dx = c->x[i] - mx;
+
+            sxx += c->w[i] * dx * dx;
+            sxy += c->w[i] * dx * (c->y[i] - my);
+        }
+    }
+
+    fit->t0     = mx;
+    fit->offset = my;
+    fit->drift  = ((n > 1U) && (sxx > 0.0)) ? (sxy / sxx) : 0.0;
+    fit->points = n;
+
+    double se = 0;
+
+    for (size_t i = 0; i < c->count; i++)
+    {
+        if ((0 != keep[i]) && (c->w[i] > 0.0))
+        {
+            double r = c->y[i] - (fit->offset + (fit->drift * (c->x[i] - mx)));
+
+            se += c->w[i] * r * r;
+        }
+    }
+    fit->jitter = sqrt(se / sw);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+void debug_clock_init(debug_clock_t *c, int one_sided, double bucket)
+{
+    memset(c, 0, sizeof(*c));
+    c->one_sided = one_sided;
+    c->bucket    = (bucket > 0.0) ? bucket : 1.0;
+}
+
+int debug_clock_add(debug_clock_t *c, double dev, double ref, double weight)
+{
+    double y = ref - dev;
+
+    if (0U == c->samples)
+    {
+        c->first = dev;
+    }
+    c->samples++;
+
+    if (0 == c->one_sided)
+    {
+        if (0 != clock_grow(c, c->count + 1U))
+        {
+            return -1;
+        }
+        c->x[c->count] = dev;
+        c->y[c->count] = y;
+        c->w[c->count] = (weight > 0.0) ? weight : 1.0;
+        c->count++;
+        return 0;
+    }
+
+    double pos = (dev - c->first) / c->bucket;
+    size_t b   = (pos > 0.0) ? (size_t)pos : 0U;
+
+    if ((pos > CLOCK_MAX_BUCKETS) || (0 != clock_grow(c, b + 1U)))
+    {
+        return -1;
+    }
+    if (b >= c->count)
+    {
+        c->count = b + 1U;
+    }
+
+    /* Keep the least delayed sample of the bucket */
+    if ((0.0 == c->w[b]) || (y < c->y[b]))
+    {
+        c->x[b] = dev;
+        c->y[b] = y;
+        c->w[b] = 1.0;
+    }
+
+    return 0;
+}
+
+int debug_clock_solve(const debug_clock_t *c, debug_clock_fit_t *fit)
+{
+    unsigned char *keep = malloc((0U != c->count) ? c->count : 1U);
+
+    memset(fit, 0, sizeof(*fit));
+    if (NULL == keep)
+    {
+        return -1;
+    }
+    memset(keep, 1, c->count);
+
+    int rc = clock_lsq(c, keep, fit);
+
+    /* One rejection pass: drop points far off the first fit */
+    if ((0 == rc) && (fit->points > 2U) && (fit->jitter > 0.0))
+    {
+        double   limit    = CLOCK_REJECT_SIGMA * fit->jitter;
+        uint64_t rejected = 0;
+
+        for (size_t i = 0; i < c->count; i++)
+        {
+            double r = c->y[i] - (fit->offset + (fit->drift * (c->x[i] - fit->t0)));
+
+            if (fabs(r) > limit)
+            {
+                keep[i] = 0;
+                rejected++;
+            }
+        }
+        if ((0U != rejected) && (rejected < fit->points))
+        {
+            rc = clock_lsq(c, keep, fit);
+        }
+    }
+
+    free(keep);
+    return rc;
+}
+
+double debug_clock_map(const debug_clock_fit_t *fit, double dev)
+{
+    return dev + fit->offset + (fit->drift * (dev - fit->t0));
+}
+
+void debug_clock_dev_init(debug_clock_dev_t *d, double tick_hz, double cycles_hz)
+{
+    memset(d, 0, sizeof(*d));
+    d->tick_hz   = tick_hz;
+    d->cycles_hz = cycles_hz;
+}
+
+double debug_clock_dev_time(debug_clock_dev_t *d, uint32_t ts, uint32_t cycles,
+                            double *frac)
+{
+    double coarse_last = (double)d->ts_ext / d->tick_hz;
+
+    if (0 == d->started)
+    {
+        d->ts_ext  = ts;
+        d->cyc_ext = cycles;
+        d->phase   = INFINITY;
+        d->started = 1;
+    }
+    else
+    {
+        d->ts_ext += (int32_t)(ts - d->ts_last);
+
+        /* Whole counter wraps between the samples, from the coarse clock */
+        double   elapsed = ((double)d->ts_ext / d->tick_hz) - coarse_last;
+        uint32_t delta   = cycles - d->cyc_last;
+        double   wraps   = 0.0;
+
+        if (d->cycles_hz > 0.0)
+        {
+            wraps = round(((elapsed * d->cycles_hz) - (double)delta) / 4294967296.0);
+        }
+        d->cyc_ext += (int64_t)delta + ((int64_t)wraps * 4294967296LL);
+    }
+    d->ts_last  = ts;
+    d->cyc_last = cycles;
+
+    double coarse = (double)d->ts_ext / d->tick_hz;
+
+    if (!(d->cycles_hz > 0.0))
+    {
+        if (NULL != frac)
+        {
+            *frac = 0.0;
+        }
+        return coarse;
+    }
+
+    /*
+     * The cycle time lies within the tick the timestamp names, so the
+     * smallest difference seen marks the cycle count at a tick edge.
+     */
+    double fine = (double)d->cyc_ext / d->cycles_hz;
+
+    if ((fine - coarse) < d->phase)
+    {
+        d->phase = fine - coarse;
+    }
+    if (NULL != frac)
+    {
+        *frac = (fine - d->phase) - coarse;
+    }
+
+    return fine - d->phase;
+}
+
+void debug_clock_free(debug_clock_t *c)
+{
+    free(c->x);
+    free(c->y);
+    free(c->w);
+    memset(c, 0, sizeof(*c));
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
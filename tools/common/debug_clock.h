@@ -0,0 +1,196 @@
+/**
+ * @file      debug_clock.h
+ * @brief     Device clock offset and drift estimation.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Fits a linear model that maps device time (timestamp / tick rate, in
+ * seconds) to a reference time base:
+ *
+ * @code
+ *   ref = dev + offset + drift * (dev - t0)
+ * @endcode
+ *
+ * Two kinds of samples are supported:
+ *
+ *  - One-sided: the reference time is the device time plus a positive,
+ *    variable delay, e.g. the host arrival time of a line. Samples are
+ *    grouped into buckets of device time and only the smallest
+ *    (ref - dev) of each bucket is kept: the line that waited least in
+ *    buffers and queues is the best estimate of the link delay floor.
+ *    Memory grows with the capture duration, not with the line count.
+ *  - Symmetric: every sample is an unbiased but noisy observation, e.g.
+ *    the same event seen by two devices, or the midpoint of a ping.
+ *
+ * The model is then fitted by weighted least squares. One pass rejects
+ * outliers (bucket minima inflated by a burst) and refits.
+ *
+ * debug_clock_dev_t turns the 32-bit (timestamp, cycles) pairs of sync
+ * and pong records into device seconds: the timestamp is unwrapped, and
+ * the cycle counter, unwrapped against the timestamp, adds the part of
+ * the time below one tick.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_CLOCK_H
+#define DEBUG_CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Fitted clock model.
+ */
+typedef struct
+{
+    double   offset;    /**< ref - dev at t0, seconds */
+    double   drift;     /**< Rate error (ref/dev - 1); 1e-6 = 1 ppm */
+    double   t0;        /**< Device time the offset refers to */
+    double   jitter;    /**< RMS residual of the fitted points, seconds */
+    uint64_t points;    /**< Points used in the fit */
+} debug_clock_fit_t;
+
+/**
+ * @brief Sample collector.
+ */
+typedef struct
+{
+    int      one_sided; /**< Keep bucket minima only */
+    double   bucket;    /**< Bucket length in device seconds */
+    double   first;     /**< Device time of the first sample */
+    double  *x;         /**< Device time per point */
+    double  *y;         /**< ref - dev per point */
+    double  *w;         /**< Weight per point */
+    size_t   count;     /**< Points */
+    size_t   cap;       /**< Allocated points */
+    uint64_t samples;   /**< Samples added */
+} debug_clock_t;
+
+/**
+ * @brief Device time reconstruction from timestamp and cycle counter.
+ */
+typedef struct
+{
+    double   tick_hz;   /**< Timestamp rate */
+    double   cycles_hz; /**< Cycle counter rate, 0 = timestamp only */
+    int      started;   /**< A sample was seen */
+    uint32_t ts_last;   /**< Previous raw timestamp */
+    uint32_t cyc_last;  /**< Previous raw cycle count */
+    int64_t  ts_ext;    /**< Unwrapped timestamp */
+    int64_t  cyc_ext;   /**< Unwrapped cycle count */
+    double   phase;     /**< Smallest (cycle time - tick time) seen */
+} debug_clock_dev_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Initialize a collector.
+ *
+ * @param[out] c         Collector
+ * @param[in]  one_sided Non-zero for delay-biased samples
+ * @param[in]  bucket    Bucket length in device seconds (one-sided only)
+ */
+void debug_clock_init(debug_clock_t *c, int one_sided, double bucket);
+
+/**
+ * @brief Add a sample.
+ *
+ * @param[in,out] c      Collector
+ * @param[in]     dev    Device time, seconds
+ * @param[in]     ref    Reference time, seconds
+ * @param[in]     weight Weight of a symmetric sample (e.g. 1 / rtt^2);
+ *                       ignored for one-sided samples
+ *
+ * @retval 0   Success
+ * @retval -1  Out of memory
+ */
+int debug_clock_add(debug_clock_t *c, double dev, double ref, double weight);
+
+/**
+ * @brief Fit the model.
+ *
+ * With a single point only the offset is estimated.
+ *
+ * @param[in]  c   Collector
+ * @param[out] fit Model
+ *
+ * @retval 0   Success
+ * @retval -1  No samples
+ */
+int debug_clock_solve(const debug_clock_t *c, debug_clock_fit_t *fit);
+
+/**
+ * @brief Map a device time to the reference time base.
+ *
+ * @param[in] fit Model
+ * @param[in] dev Device time, seconds
+ *
+ * @return Reference time, seconds
+ */
+double debug_clock_map(const debug_clock_fit_t *fit, double dev);
+
+/**
+ * @brief Initialize a device time tracker.
+ *
+ * @param[out] d         Tracker
+ * @param[in]  tick_hz   Timestamp rate (sync record tick_hz)
+ * @param[in]  cycles_hz Cycle counter rate (sync record cycles_hz), 0 if
+ *                       the device has no cycle counter
+ */
+void debug_clock_dev_init(debug_clock_dev_t *d, double tick_hz, double cycles_hz);
+
+/**
+ * @brief Convert a (timestamp, cycles) pair to device seconds.
+ *
+ * Pairs must be passed in device time order, less than half a timestamp
+ * wrap apart. The result is on the timestamp's time base (the same
+ * seconds a line with this timestamp has) plus the fraction of a tick
+ * given by the cycle counter. Timestamp and cycle counter are assumed
+ * to run from the same oscillator.
+ *
+ * @param[in,out] d      Tracker
+ * @param[in]     ts     Raw timestamp
+ * @param[in]     cycles Raw cycle count
+ * @param[out]    frac   Seconds past the start of the tick (may be NULL)
+ *
+ * @return Device time, seconds
+ */
+double debug_clock_dev_time(debug_clock_dev_t *d, uint32_t ts, uint32_t cycles,
+                            double *frac);
+
+/**
+ * @brief Release a collector.
+ *
+ * @param[in,out] c Collector
+ */
+void debug_clock_free(debug_clock_t *c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_CLOCK_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
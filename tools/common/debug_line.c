@@ -0,0 +1,385 @@
+/**
+ * @file      debug_line.c
+ * @brief     Host-side parser for the text line prefix.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_line.h.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include "debug_line.h"
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static const char *const LEVEL_NAMES[DEBUG_LINE_LEVELS] =
+{
+    "ERROR", "WARN", "INFO", "DEBUG"
+};
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Value of a thread ID character, -1 if it is not one.
+ */
+static int line_thread_id(char ch)
+{
+    if ((ch >= '0') && (ch <= '9'))
+    {
+        return ch - '0';
+    }
+    if ((ch >= 'a') && (ch <= 'z'))
+    {
+        return (ch - 'a') + 10;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Append to a buffer, truncating at its end.
+ */
+static void line_put(char *buf, size_t size, size_t *n, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    int h = vsnprintf(&buf[*n], size - *n, fmt, args);
+    va_end(args);
+
+    *n = ((h >= 0) && ((*n + (size_t)h) < size)) ? (*n + (size_t)h) : (size - 1U);
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_line_level(const char *name, size_t len)
+{
+    /* Cheap reject first: every group that is not a level gets here */
+    if ((len < 4U) || (len > 5U))
+    {
+        return -1;
+    }
+
+    int level;
+
+    switch (name[0] | 0x20)
+    {
+        case 'e': level = 0; break;
+        case 'w': level = 1; break;
+        case 'i': level = 2; break;
+        case 'd': level = 3; break;
+        default:  return -1;
+    }
+
+    return ((strlen(LEVEL_NAMES[level]) == len) &&
+            (0 == strncasecmp(LEVEL_NAMES[level], name, len))) ? level : -1;
+}
+
+const char *debug_line_level_name(int level)
+{
+    return ((level >= 0) && (level < (int)DEBUG_LINE_LEVELS)) ?
+           LEVEL_NAMES[level] : "?";
+}
+
+int debug_line_parse(const char *line, size_t len, debug_line_t *out)
+{
+    size_t pos   = 0;
+    int    count = 0;
+
+    memset(out, 0, sizeof(*out));
+    out->weight = 1U;
+
+    while ((len > 0U) && (('\n' == line[len - 1U]) || ('\r' == line[len - 1U])))
+    {
+        len--;
+    }
+
+    /* At most four groups: seq, ts, thread, level */
+    while ((count < 4) && (pos < len) && ('[' == line[pos]))
+    {
+        const char *grp = &line[pos + 1U];
+        const char *end = memchr(grp, ']', len - pos - 1U);
+
+        if (NULL == end)
+        {
+            break;
+        }
+
+        size_t glen    = (size_t)(end - grp);
+        int    numeric = (glen > 0U) && (glen <= 20U);
+        uint64_t value = 0;
+
+        for (size_t i = 0; (0 != numeric) && (i < glen); i++)
+        {
+            if ((grp[i] < '0') || (grp[i] > '9'))
+            {
+                numeric = 0;
+            }
+            else
+            {
+                value = (value * 10U) + (uint64_t)(grp[i] - '0');
+            }
+        }
+
+        int level = (0 != numeric) ? -1 : debug_line_level(grp, glen);
+
+        if ((0 != numeric) && (0U == (out->fields & DEBUG_LINE_HAS_SEQ)) &&
+            (0U == (out->fields & (DEBUG_LINE_HAS_THREAD | DEBUG_LINE_HAS_LEVEL))))
+        {
+            out->seq     = value;
+            out->fields |= DEBUG_LINE_HAS_SEQ;
+        }
+        else if ((0 != numeric) && (0U == (out->fields & DEBUG_LINE_HAS_TS)) &&
+                 (0U == (out->fields & (DEBUG_LINE_HAS_THREAD | DEBUG_LINE_HAS_LEVEL))))
+        {
+            out->ts      = value;
+            out->fields |= DEBUG_LINE_HAS_TS;
+        }
+        else if ((level >= 0) && (0U == (out->fields & DEBUG_LINE_HAS_LEVEL)))
+        {
+            out->level   = level;
+            out->fields |= DEBUG_LINE_HAS_LEVEL;
+        }
+        else if (0U == (out->fields & (DEBUG_LINE_HAS_THREAD | DEBUG_LINE_HAS_LEVEL)))
+        {
+            out->thread     = grp;
+            out->thread_len = glen;
+            out->fields    |= DEBUG_LINE_HAS_THREAD;
+        }
+        else
+        {
+            break;      /* Bracket in the message text */
+        }
+
+        count++;
+        pos += glen + 2U;
+    }
+
+    /* Sampling factor of a LOG_xxx_SAMPLED line: "[1/N]" after the level */
+    if ((0U != (out->fields & DEBUG_LINE_HAS_LEVEL)) && ((pos + 4U) < len) &&
+        (0 == memcmp(&line[pos], "[1/", 3U)))
+    {
+        size_t   i      = pos + 3U;
+        uint64_t weight = 0;
+
+        while ((i < len) && (line[i] >= '0') && (line[i] <= '9') &&
+               (weight <= 0xFFFFFFFFULL))
+        {
+            weight = (weight * 10U) + (uint64_t)(line[i] - '0');
+            i++;
+        }
+
+        if ((i > (pos + 3U)) && (i < len) && (']' == line[i]) &&
+            (0U != weight) && (weight <= 0xFFFFFFFFULL))
+        {
+            out->weight  = (uint32_t)weight;
+            out->fields |= DEBUG_LINE_HAS_WEIGHT;
+            pos          = i + 1U;
+        }
+    }
+
+    /* The level group is followed by a single space */
+    if ((0U != (out->fields & DEBUG_LINE_HAS_LEVEL)) && (pos < len) &&
+        (' ' == line[pos]))
+    {
+        pos++;
+    }
+
+    out->msg     = &line[pos];
+    out->msg_len = len - pos;
+
+    return count;
+}
+
+void debug_line_compact_init(debug_line_compact_t *c)
+{
+    memset(c, 0, sizeof(*c));
+}
+
+int debug_line_expand(debug_line_compact_t *c, const char *line, size_t len,
+                      debug_line_t *out)
+{
+    while ((len > 0U) && (('\n' == line[len - 1U]) || ('\r' == line[len - 1U])))
+    {
+        len--;
+    }
+
+    /* "#T<id> <name>" */
+    if ((len >= 4U) && ('#' == line[0]) && ('T' == line[1]) && (' ' == line[3]) &&
+        (line_thread_id(line[2]) >= 0))
+    {
+        size_t nlen = len - 4U;
+        char  *name = c->thread[line_thread_id(line[2])];
+
+        nlen = (nlen < (DEBUG_LINE_THREAD_LEN - 1U)) ? nlen : (DEBUG_LINE_THREAD_LEN - 1U);
+        memcpy(name, &line[4], nlen);
+        name[nlen] = '\0';
+        memset(out, 0, sizeof(*out));
+        return DEBUG_LINE_BINDING;
+    }
+
+    /* "L[dt][.id][*N] message", with exactly the fields of the keyframe */
+    if ((0U != c->fields) && (len >= 2U))
+    {
+        static const char letters[DEBUG_LINE_LEVELS] = { 'E', 'W', 'I', 'D' };
+
+        int      level  = -1;
+        size_t   pos    = 1;
+        uint64_t dt     = 0;
+        int      id     = -1;
+        uint64_t weight = 0;
+
+        for (int i = 0; i < (int)DEBUG_LINE_LEVELS; i++)
+        {
+            level = (letters[i] == line[0]) ? i : level;
+        }
+
+        while ((pos < len) && (pos <= 8U) &&
+               (((line[pos] >= '0') && (line[pos] <= '9')) ||
+                ((line[pos] >= 'a') && (line[pos] <= 'f'))))
+        {
+            dt = (dt << 4) | (uint64_t)((line[pos] <= '9') ? (line[pos] - '0') :
+                                                             ((line[pos] - 'a') + 10));
+            pos++;
+        }
+
+        int has_dt = (pos > 1U);
+
+        /* A keyframe with a single number was taken for a sequence
+         * number; lines carrying a delta tell it was the timestamp */
+        if ((0 != has_dt) &&
+            ((c->fields & (DEBUG_LINE_HAS_SEQ | DEBUG_LINE_HAS_TS)) == DEBUG_LINE_HAS_SEQ))
+        {
+            c->fields = (c->fields & ~DEBUG_LINE_HAS_SEQ) | DEBUG_LINE_HAS_TS;
+            c->ts     = c->seq;
+        }
+
+        if (((pos + 1U) < len) && ('.' == line[pos]))
+        {
+            id   = line_thread_id(line[pos + 1U]);
+            pos += 2U;
+        }
+
+        int has_weight = ((pos < len) && ('*' == line[pos]));
+
+        if (0 != has_weight)
+        {
+            pos++;
+            while ((pos < len) && (line[pos] >= '0') && (line[pos] <= '9') &&
+                   (weight <= 0xFFFFFFFFULL))
+            {
+                weight = (weight * 10U) + (uint64_t)(line[pos] - '0');
+                pos++;
+            }
+        }
+
+        int match = (level >= 0) && (pos < len) && (' ' == line[pos]) &&
+                    (has_dt == (0U != (c->fields & DEBUG_LINE_HAS_TS))) &&
+                    ((id >= 0) == (0U != (c->fields & DEBUG_LINE_HAS_THREAD))) &&
+                    ((0 == has_weight) || ((0U != weight) && (weight <= 0xFFFFFFFFULL)));
+
+        if (0 != match)
+        {
+            memset(out, 0, sizeof(*out));
+            out->fields = c->fields | DEBUG_LINE_HAS_LEVEL;
+            out->level  = level;
+            out->weight = 1U;
+
+            if (0U != (c->fields & DEBUG_LINE_HAS_SEQ))
+            {
+                c->seq   = (c->seq + 1U) & 0xFFFFFFFFULL;
+                out->seq = c->seq;
+            }
+            if (0 != has_dt)
+            {
+                c->ts   += dt;
+                out->ts  = c->ts;
+            }
+            if (id >= 0)
+            {
+                if ('\0' == c->thread[id][0])
+                {
+                    (void)snprintf(c->thread[id], DEBUG_LINE_THREAD_LEN, "#%d", id);
+                }
+                out->thread     = c->thread[id];
+                out->thread_len = strlen(c->thread[id]);
+            }
+            if (0 != has_weight)
+            {
+                out->weight  = (uint32_t)weight;
+                out->fields |= DEBUG_LINE_HAS_WEIGHT;
+            }
+
+            out->msg     = &line[pos + 1U];
+            out->msg_len = len - pos - 1U;
+            return DEBUG_LINE_EXPANDED;
+        }
+    }
+
+    /* Ordinary line: a full prefix is a keyframe */
+    (void)debug_line_parse(line, len, out);
+
+    if (0U != (out->fields & DEBUG_LINE_HAS_LEVEL))
+    {
+        c->fields = out->fields & (DEBUG_LINE_HAS_SEQ | DEBUG_LINE_HAS_TS |
+                                   DEBUG_LINE_HAS_THREAD | DEBUG_LINE_HAS_LEVEL);
+        c->seq    = out->seq;
+        c->ts     = out->ts;
+    }
+
+    return DEBUG_LINE_TEXT;
+}
+
+size_t debug_line_format(const debug_line_t *ln, char *buf, size_t size)
+{
+    size_t n = 0;
+
+    buf[0] = '\0';
+    if (0U != (ln->fields & DEBUG_LINE_HAS_SEQ))
+    {
+        line_put(buf, size, &n, "[%05llu]", (unsigned long long)ln->seq);
+    }
+    if (0U != (ln->fields & DEBUG_LINE_HAS_TS))
+    {
+        line_put(buf, size, &n, "[%llu]", (unsigned long long)ln->ts);
+    }
+    if (0U != (ln->fields & DEBUG_LINE_HAS_THREAD))
+    {
+        line_put(buf, size, &n, "[%.*s]", (int)ln->thread_len, ln->thread);
+    }
+    if (0U != (ln->fields & DEBUG_LINE_HAS_LEVEL))
+    {
+        line_put(buf, size, &n, "[%s]", debug_line_level_name(ln->level));
+    }
+    if (0U != (ln->fields & DEBUG_LINE_HAS_WEIGHT))
+    {
+        line_put(buf, size, &n, "[1/%lu]", (unsigned long)ln->weight);
+    }
+    line_put(buf, size, &n, "%s%.*s",
+             (0U != (ln->fields & DEBUG_LINE_HAS_LEVEL)) ? " " : "",
+             (int)ln->msg_len, ln->msg);
+
+    return n;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
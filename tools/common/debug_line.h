@@ -0,0 +1,193 @@
+/**
+ * @file      debug_line.h
+ * @brief     Host-side parser for the text line prefix.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Splits a text line produced by debug_log() into its prefix fields:
+ *
+ * @code
+ *   [seq][timestamp][thread][LEVEL] message
+ * @endcode
+ *
+ * Every prefix field is optional on the device side, so the parser
+ * classifies the bracketed groups instead of relying on their position:
+ * a level name is the level, the first numeric group is the sequence
+ * number and a second numeric group is the timestamp, and any other
+ * group is the thread name. A sampled line (LOG_xxx_SAMPLED) has a
+ * "[1/N]" group right after the level; N is the number of calls the
+ * line stands for. The parser never copies; thread and message point
+ * into the caller's buffer.
+ *
+ * Firmware built with DEBUG_ENABLE_COMPACT_PREFIX sends most lines as
+ *
+ * @code
+ *   #T3 SensorTask          thread ID 3 is SensorTask
+ *   D1f4.3 message          DEBUG, 0x1f4 ticks after the previous line,
+ *                           thread 3, sequence number + 1
+ *   I0.3*8 message          INFO, sampled 1-of-8
+ * @endcode
+ *
+ * between keyframes, which are ordinary full-prefix lines.
+ * debug_line_expand() tracks the keyframes and turns compact lines back
+ * into the full fields; debug_line_format() prints them.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_LINE_H
+#define DEBUG_LINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+#define DEBUG_LINE_HAS_SEQ      (1U << 0)   /**< seq is valid */
+#define DEBUG_LINE_HAS_TS       (1U << 1)   /**< ts is valid */
+#define DEBUG_LINE_HAS_THREAD   (1U << 2)   /**< thread is valid */
+#define DEBUG_LINE_HAS_LEVEL    (1U << 3)   /**< level is valid */
+#define DEBUG_LINE_HAS_WEIGHT   (1U << 4)   /**< weight is valid (sampled line) */
+
+/** @brief Number of log levels (LOG_ERROR .. LOG_DEBUG) */
+#define DEBUG_LINE_LEVELS       4U
+
+/** @brief Thread IDs of the compact prefix ('0'..'9', 'a'..'z') */
+#define DEBUG_LINE_THREADS      36U
+
+/** @brief Longest thread name kept for a thread ID */
+#define DEBUG_LINE_THREAD_LEN   32U
+
+/** @brief debug_line_expand() results */
+#define DEBUG_LINE_TEXT         0   /**< Ordinary line, parsed */
+#define DEBUG_LINE_EXPANDED     1   /**< Compact line, fields restored */
+#define DEBUG_LINE_BINDING      2   /**< Thread ID announcement, not a log line */
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Parsed line prefix.
+ */
+typedef struct
+{
+    uint32_t    fields;     /**< DEBUG_LINE_HAS_* mask */
+    uint64_t    seq;        /**< Sequence number */
+    uint64_t    ts;         /**< Device timestamp */
+    const char *thread;     /**< Thread name (not terminated) */
+    size_t      thread_len; /**< Thread name length */
+    int         level;      /**< 0 = ERROR .. 3 = DEBUG */
+    uint32_t    weight;     /**< Calls a sampled line stands for, 1 otherwise */
+    const char *msg;        /**< Message text after the prefix */
+    size_t      msg_len;    /**< Message length */
+} debug_line_t;
+
+/**
+ * @brief Expander state for compact-prefix streams.
+ */
+typedef struct
+{
+    uint32_t fields;        /**< Fields of the last keyframe, 0 = none yet */
+    uint64_t seq;           /**< Sequence number of the last line */
+    uint64_t ts;            /**< Timestamp of the last line */
+    char     thread[DEBUG_LINE_THREADS][DEBUG_LINE_THREAD_LEN];
+} debug_line_compact_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Parse the prefix of one text line.
+ *
+ * @param[in]  line Line text (CR/LF may or may not be included)
+ * @param[in]  len  Line length
+ * @param[out] out  Parsed fields
+ *
+ * @return Number of prefix fields found (0 for a line without a prefix)
+ */
+int debug_line_parse(const char *line, size_t len, debug_line_t *out);
+
+/**
+ * @brief Look up a level by name.
+ *
+ * @param[in] name Level name ("ERROR", "WARN", "INFO", "DEBUG"), any case
+ * @param[in] len  Name length
+ *
+ * @return Level 0..3, or -1 if the name is unknown
+ */
+int debug_line_level(const char *name, size_t len);
+
+/**
+ * @brief Name of a level.
+ *
+ * @param[in] level Level 0..3
+ *
+ * @return Level name, "?" if out of range
+ */
+const char *debug_line_level_name(int level);
+
+/**
+ * @brief Reset the expander (new stream).
+ *
+ * @param[out] c Expander state
+ */
+void debug_line_compact_init(debug_line_compact_t *c);
+
+/**
+ * @brief Parse one line of a stream that may use the compact prefix.
+ *
+ * @param[in,out] c    Expander state
+ * @param[in]     line Line text (CR/LF may or may not be included)
+ * @param[in]     len  Line length
+ * @param[out]    out  Parsed or restored fields
+ *
+ * @retval DEBUG_LINE_TEXT      Ordinary line (as debug_line_parse())
+ * @retval DEBUG_LINE_EXPANDED  Compact line; print it with debug_line_format()
+ * @retval DEBUG_LINE_BINDING   Thread ID announcement: nothing to print
+ *
+ * @note
+ * Compact lines are recognized only after a keyframe and only with the
+ * fields of that keyframe, so plain text is not mistaken for one. The
+ * thread of an ID not announced yet (capture started mid-stream) is
+ * named "#<id>" until the next announcement.
+ */
+int debug_line_expand(debug_line_compact_t *c, const char *line, size_t len,
+                      debug_line_t *out);
+
+/**
+ * @brief Print a line with the full prefix.
+ *
+ * @param[in]  ln   Line fields
+ * @param[out] buf  Output buffer
+ * @param[in]  size Buffer size
+ *
+ * @return Length written (without the terminator), truncated to size - 1
+ */
+size_t debug_line_format(const debug_line_t *ln, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_LINE_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,142 @@
+/**
+ * @file      debug_seq.c
+ * @brief     Sequence number gap and reorder accounting.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_seq.h.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <string.h>
+
+#include "debug_seq.h"
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void seq_set(debug_seq_t *t, uint64_t seq, int missing)
+{
+    uint32_t bit = (uint32_t)(seq % DEBUG_SEQ_WINDOW);
+
+    if (0 != missing)
+    {
+        t->window[bit / 64U] |= 1ULL << (bit % 64U);
+    }
+    else
+    {
+        t->window[bit / 64U] &= ~(1ULL << (bit % 64U));
+    }
+}
+
+static int seq_is_missing(const debug_seq_t *t, uint64_t seq)
+{
+    uint32_t bit = (uint32_t)(seq % DEBUG_SEQ_WINDOW);
+
+    return (0U != (t->window[bit / 64U] & (1ULL << (bit % 64U)))) ? 1 : 0;
+}
+
+static void seq_restart(debug_seq_t *t, uint32_t seq)
+{
+    memset(t->window, 0, sizeof(t->window));
+    t->high    = seq;
+    t->started = 1;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+void debug_seq_init(debug_seq_t *t)
+{
+    memset(t, 0, sizeof(*t));
+}
+
+debug_seq_result_t debug_seq_push(debug_seq_t *t, uint32_t seq)
+{
+    if (0 == t->started)
+    {
+        seq_restart(t, seq);
+        t->received++;
+        return DEBUG_SEQ_FIRST;
+    }
+
+    /* Distance from the highest number, modulo the 32-bit wrap */
+    int64_t delta = (int64_t)(int32_t)(seq - (uint32_t)t->high);
+
+    if ((delta > (int64_t)DEBUG_SEQ_MAX_GAP) ||
+        (delta <= -(int64_t)DEBUG_SEQ_WINDOW))
+    {
+        t->resets++;
+        t->received++;
+        seq_restart(t, seq);
+        return DEBUG_SEQ_RESET;
+    }
+
+    if (delta <= 0)
+    {
+        uint64_t ext = t->high - (uint64_t)(-delta);
+
+        if ((0 != delta) && (0 != seq_is_missing(t, ext)))
+        {
+            seq_set(t, ext, 0);
+            t->missing--;
+            t->late++;
+            t->received++;
+            if ((uint64_t)(-delta) > t->max_late)
+            {
+                t->max_late = (uint64_t)(-delta);
+            }
+            return DEBUG_SEQ_LATE;
+        }
+
+        t->duplicates++;
+        return DEBUG_SEQ_DUPLICATE;
+    }
+
+    uint64_t ext = t->high + (uint64_t)delta;
+    uint64_t gap = (uint64_t)delta - 1U;
+
+    /* Slots reused by the advancing window drop out of late detection */
+    if (gap >= DEBUG_SEQ_WINDOW)
+    {
+        memset(t->window, 0xFF, sizeof(t->window));
+    }
+    else
+    {
+        for (uint64_t s = t->high + 1U; s < ext; s++)
+        {
+            seq_set(t, s, 1);
+        }
+    }
+    seq_set(t, ext, 0);
+
+    t->high = ext;
+    t->received++;
+
+    if (0U == gap)
+    {
+        return DEBUG_SEQ_IN_ORDER;
+    }
+
+    t->gaps++;
+    t->missing += gap;
+    if (gap > t->max_gap)
+    {
+        t->max_gap = gap;
+    }
+
+    return DEBUG_SEQ_GAP;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
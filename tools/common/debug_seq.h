@@ -0,0 +1,113 @@
+/**
+ * @file      debug_seq.h
+ * @brief     Sequence number gap and reorder accounting.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Tracks the 32-bit sequence numbers of received log lines and classifies
+ * every line as in order, after a gap, late (it fills an earlier gap), a
+ * duplicate, or the first line after a device reset.
+ *
+ * The highest sequence number seen so far is kept together with a bitmap
+ * of the last DEBUG_SEQ_WINDOW numbers below it that are still missing.
+ * A line that arrives late clears its bit and is no longer counted as
+ * lost. Wrap-around of the 32-bit counter is handled; a jump backwards by
+ * more than the window, or forwards by more than DEBUG_SEQ_MAX_GAP, is
+ * treated as a device reset.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_SEQ_H
+#define DEBUG_SEQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Late arrivals are recognized up to this far behind (power of 2) */
+#define DEBUG_SEQ_WINDOW    4096U
+
+/** @brief Larger forward jumps are treated as a reset */
+#define DEBUG_SEQ_MAX_GAP   (1UL << 20)
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Classification of one sequence number.
+ */
+typedef enum
+{
+    DEBUG_SEQ_FIRST = 0,    /**< First line seen */
+    DEBUG_SEQ_IN_ORDER,     /**< Exactly the next number */
+    DEBUG_SEQ_GAP,          /**< Numbers were skipped before this one */
+    DEBUG_SEQ_LATE,         /**< Fills an earlier gap (reordered) */
+    DEBUG_SEQ_DUPLICATE,    /**< Already seen */
+    DEBUG_SEQ_RESET         /**< Counter restarted */
+} debug_seq_result_t;
+
+/**
+ * @brief Tracker state and counters.
+ */
+typedef struct
+{
+    uint64_t high;          /**< Highest number seen (unwrapped) */
+    int      started;       /**< At least one number seen */
+    uint64_t received;      /**< Numbers accepted */
+    uint64_t missing;       /**< Currently unaccounted numbers */
+    uint64_t gaps;          /**< Gap events */
+    uint64_t late;          /**< Late arrivals */
+    uint64_t duplicates;    /**< Duplicates */
+    uint64_t resets;        /**< Counter restarts */
+    uint64_t max_gap;       /**< Largest single gap */
+    uint64_t max_late;      /**< Largest distance of a late arrival */
+    uint64_t window[DEBUG_SEQ_WINDOW / 64U]; /**< Missing bitmap */
+} debug_seq_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Reset a tracker.
+ *
+ * @param[out] t Tracker
+ */
+void debug_seq_init(debug_seq_t *t);
+
+/**
+ * @brief Account one received sequence number.
+ *
+ * @param[in,out] t   Tracker
+ * @param[in]     seq Sequence number from the line prefix
+ *
+ * @return Classification of seq
+ */
+debug_seq_result_t debug_seq_push(debug_seq_t *t, uint32_t seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_SEQ_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,212 @@
+/**
+ * @file      debug_stream.c
+ * @brief     Host-side parser for the debug output stream.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Incremental text/record splitter. In text mode bytes are collected up to
+ * a line feed; a NUL byte switches to record mode, where the header, the
+ * payload and the CRC are assembled before the record is delivered.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static void stream_emit_line(debug_stream_t *s);
+static void stream_record_done(debug_stream_t *s);
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void stream_emit_line(debug_stream_t *s)
+{
+    size_t len = s->line_len;
+
+    while ((len > 0U) && ('\r' == s->line[len - 1U]))
+    {
+        len--;
+    }
+
+    s->lines++;
+    if (NULL != s->cb.on_text)
+    {
+        s->line[len] = '\0';
+        s->cb.on_text(s->user, s->line, len);
+    }
+
+    s->line_len = 0;
+}
+
+static void stream_record_done(debug_stream_t *s)
+{
+    size_t  payload_len = s->rec_len - DEBUG_RECORD_HEADER_SIZE -
+                          DEBUG_RECORD_TRAILER_SIZE;
+    uint8_t crc = debug_record_crc8(0, &s->rec[1], s->rec_len - 2U);
+
+    if (crc == s->rec[s->rec_len - 1U])
+    {
+        s->rec_len = 0;
+        s->records++;
+        if (NULL != s->cb.on_record)
+        {
+            s->cb.on_record(s->user, s->rec[1],
+                            &s->rec[DEBUG_RECORD_HEADER_SIZE], payload_len);
+        }
+        return;
+    }
+
+    /* Not a record after all: rescan everything after the marker as text */
+    size_t   n    = s->rec_len - 1U;
+    uint8_t *copy = malloc(n);
+
+    s->crc_errors++;
+    s->rec_len = 0;
+
+    if (NULL != copy)
+    {
+        memcpy(copy, &s->rec[1], n);
+        debug_stream_feed(s, copy, n);
+        free(copy);
+    }
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_stream_init(debug_stream_t *s, const debug_stream_cb_t *cb,
+                      void *user)
+{
+    memset(s, 0, sizeof(*s));
+
+    if (NULL != cb)
+    {
+        s->cb = *cb;
+    }
+    s->user = user;
+    s->rec  = malloc(DEBUG_STREAM_MAX_RECORD);
+
+    return (NULL != s->rec) ? 0 : -1;
+}
+
+void debug_stream_feed(debug_stream_t *s, const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len)
+    {
+        if (0U == s->rec_len)
+        {
+            /* Text mode: copy up to the next LF or NUL */
+            while (i < len)
+            {
+                uint8_t c = data[i++];
+
+                if (DEBUG_RECORD_MARKER == c)
+                {
+                    s->rec[0]  = c;
+                    s->rec_len = 1;
+                    break;
+                }
+
+                s->line[s->line_len++] = (char)c;
+
+                if (('\n' == c) || (s->line_len >= (sizeof(s->line) - 1U)))
+                {
+                    if ('\n' == c)
+                    {
+                        s->line_len--;
+                    }
+                    stream_emit_line(s);
+                }
+            }
+            continue;
+        }
+
+        /* Record mode: header first, then payload + CRC */
+        size_t need;
+
+        if (s->rec_len < DEBUG_RECORD_HEADER_SIZE)
+        {
+            need = DEBUG_RECORD_HEADER_SIZE - s->rec_len;
+        }
+        else
+        {
+            size_t payload_len = (size_t)s->rec[2] | ((size_t)s->rec[3] << 8);
+            need = DEBUG_RECORD_HEADER_SIZE + payload_len +
+                   DEBUG_RECORD_TRAILER_SIZE - s->rec_len;
+        }
+
+        size_t chunk = len - i;
+        if (chunk > need)
+        {
+            chunk = need;
+        }
+
+        memcpy(&s->rec[s->rec_len], &data[i], chunk);
+        s->rec_len += chunk;
+        i += chunk;
+
+        /* A completed header alone is not a record; the CRC always follows */
+        if ((chunk == need) && (s->rec_len > DEBUG_RECORD_HEADER_SIZE))
+        {
+            stream_record_done(s);
+        }
+    }
+}
+
+void debug_stream_finish(debug_stream_t *s)
+{
+    if (s->line_len > 0U)
+    {
+        stream_emit_line(s);
+    }
+}
+
+void debug_stream_free(debug_stream_t *s)
+{
+    free(s->rec);
+    s->rec = NULL;
+}
+
+long debug_stream_record_at(const uint8_t *buf, size_t avail)
+{
+    if ((0U == avail) || (DEBUG_RECORD_MARKER != buf[0]))
+    {
+        return 0;
+    }
+    if (avail < DEBUG_RECORD_HEADER_SIZE)
+    {
+        return -1;
+    }
+
+    size_t total = DEBUG_RECORD_HEADER_SIZE +
+                   ((size_t)buf[2] | ((size_t)buf[3] << 8)) +
+                   DEBUG_RECORD_TRAILER_SIZE;
+
+    if (avail < total)
+    {
+        return -1;
+    }
+
+    return (debug_record_crc8(0, &buf[1], total - 2U) == buf[total - 1U]) ?
+           (long)total : 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
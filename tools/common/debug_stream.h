@@ -0,0 +1,145 @@
+/**
+ * @file      debug_stream.h
+ * @brief     Host-side parser for the debug output stream.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Splits a raw byte stream captured from the debug transport into text
+ * lines and binary records (see core/debug_record.h). The parser is
+ * incremental: feed it chunks of any size as they arrive from a file,
+ * a tty or a socket.
+ *
+ * Records with a bad CRC are counted and their bytes are re-scanned as
+ * text, so the parser resynchronizes on the next valid marker.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_STREAM_H
+#define DEBUG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "debug_record.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Longest text line kept before it is force-split */
+#define DEBUG_STREAM_MAX_LINE   4096U
+
+/** @brief Largest possible record (header + 64 KiB payload + CRC) */
+#define DEBUG_STREAM_MAX_RECORD (DEBUG_RECORD_HEADER_SIZE + 0xFFFFU + \
+                                 DEBUG_RECORD_TRAILER_SIZE)
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Stream parser callbacks.
+ */
+typedef struct
+{
+    /** Complete text line, without the trailing CR/LF */
+    void (*on_text)(void *user, const char *line, size_t len);
+    /** Binary record with a valid CRC */
+    void (*on_record)(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len);
+} debug_stream_cb_t;
+
+/**
+ * @brief Stream parser state.
+ */
+typedef struct
+{
+    debug_stream_cb_t cb;                       /**< Callbacks */
+    void             *user;                     /**< Callback context */
+    char              line[DEBUG_STREAM_MAX_LINE]; /**< Pending text */
+    size_t            line_len;                 /**< Bytes in line */
+    uint8_t          *rec;                      /**< Record assembly buffer */
+    size_t            rec_len;                  /**< Bytes in rec (0 = text mode) */
+    uint64_t          records;                  /**< Valid records seen */
+    uint64_t          lines;                    /**< Text lines seen */
+    uint64_t          crc_errors;               /**< Records dropped on CRC */
+} debug_stream_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Initialize a stream parser.
+ *
+ * @param[out] s    Parser state
+ * @param[in]  cb   Callbacks (either may be NULL)
+ * @param[in]  user Context passed to the callbacks
+ *
+ * @retval 0   Success
+ * @retval -1  Out of memory
+ */
+int debug_stream_init(debug_stream_t *s, const debug_stream_cb_t *cb,
+                      void *user);
+
+/**
+ * @brief Feed raw bytes into the parser.
+ *
+ * @param[in,out] s    Parser state
+ * @param[in]     data Received bytes
+ * @param[in]     len  Number of bytes
+ */
+void debug_stream_feed(debug_stream_t *s, const uint8_t *data, size_t len);
+
+/**
+ * @brief Flush a pending partial text line at end of input.
+ *
+ * @param[in,out] s Parser state
+ */
+void debug_stream_finish(debug_stream_t *s);
+
+/**
+ * @brief Release parser resources.
+ *
+ * @param[in,out] s Parser state
+ */
+void debug_stream_free(debug_stream_t *s);
+
+/**
+ * @brief Check whether a complete, valid record starts at a buffer position.
+ *
+ * Stateless counterpart of the record mode of debug_stream_feed(), for
+ * tools that walk a mapped capture in place.
+ *
+ * @param[in] buf   Bytes starting at a candidate marker
+ * @param[in] avail Bytes available from buf
+ *
+ * @return Total record length (header + payload + CRC) if a valid record
+ *         starts at buf, 0 if it does not, -1 if more bytes are needed
+ *         to decide
+ */
+long debug_stream_record_at(const uint8_t *buf, size_t avail);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_STREAM_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,240 @@
+/**
+ * @file      debug_symbols.c
+ * @brief     Host-side address symbolization via addr2line.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Runs "addr2line -f -C -e <elf>" as a coprocess connected through two
+ * pipes. Each lookup writes one address and reads back the function and
+ * location lines. Results are kept in a direct-mapped cache.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "debug_symbols.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Number of cache slots (power of two) */
+#define SYM_CACHE_SLOTS   8192U
+
+/** @brief Maximum length of cached strings */
+#define SYM_NAME_LEN      128U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+typedef struct
+{
+    uint64_t addr;                 /**< Cached address + 1 (0 = empty) */
+    int      known;                /**< Lookup result */
+    char     func[SYM_NAME_LEN];   /**< Function name */
+    char     loc[SYM_NAME_LEN];    /**< file:line */
+} sym_cache_t;
+
+struct debug_symbols
+{
+    pid_t        pid;              /**< addr2line process */
+    FILE        *to;               /**< Pipe to addr2line stdin */
+    FILE        *from;             /**< Pipe from addr2line stdout */
+    sym_cache_t *cache;            /**< Lookup cache */
+};
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void sym_copy(char *dst, size_t dlen, const char *src)
+{
+    if ((NULL == dst) || (0U == dlen))
+    {
+        return;
+    }
+
+    snprintf(dst, dlen, "%s", src);
+}
+
+static void sym_chomp(char *s)
+{
+    size_t n = strlen(s);
+
+    while ((n > 0U) && (('\n' == s[n - 1U]) || ('\r' == s[n - 1U])))
+    {
+        s[--n] = '\0';
+    }
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+debug_symbols_t *debug_symbols_open(const char *elf, const char *addr2line)
+{
+    int in_pipe[2];
+    int out_pipe[2];
+
+    if (NULL == elf)
+    {
+        return NULL;
+    }
+    if (NULL == addr2line)
+    {
+        addr2line = DEBUG_SYMBOLS_DEFAULT_ADDR2LINE;
+    }
+
+    if (0 != access(elf, R_OK))
+    {
+        return NULL;
+    }
+
+    if (0 != pipe(in_pipe))
+    {
+        return NULL;
+    }
+    if (0 != pipe(out_pipe))
+    {
+        close(in_pipe[0]);
+        close(in_pipe[1]);
+        return NULL;
+    }
+
+    /* A missing or dead addr2line must not kill the caller on write */
+    signal(SIGPIPE, SIG_IGN);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(in_pipe[0]);
+        close(in_pipe[1]);
+        close(out_pipe[0]);
+        close(out_pipe[1]);
+        return NULL;
+    }
+
+    if (0 == pid)
+    {
+        dup2(in_pipe[0], STDIN_FILENO);
+        dup2(out_pipe[1], STDOUT_FILENO);
+        close(in_pipe[0]);
+        close(in_pipe[1]);
+        close(out_pipe[0]);
+        close(out_pipe[1]);
+        execlp(addr2line, addr2line, "-f", "-C", "-e", elf, (char *)NULL);
+        _exit(127);
+    }
+
+    close(in_pipe[0]);
+    close(out_pipe[1]);
+
+    debug_symbols_t *sym = calloc(1, sizeof(*sym));
+    if (NULL == sym)
+    {
+        close(in_pipe[1]);
+        close(out_pipe[0]);
+        return NULL;
+    }
+
+    sym->pid   = pid;
+    sym->to    = fdopen(in_pipe[1], "w");
+    sym->from  = fdopen(out_pipe[0], "r");
+    sym->cache = calloc(SYM_CACHE_SLOTS, sizeof(sym_cache_t));
+
+    if ((NULL == sym->to) || (NULL == sym->from) || (NULL == sym->cache))
+    {
+        debug_symbols_close(sym);
+        return NULL;
+    }
+
+    return sym;
+}
+
+int debug_symbols_lookup(debug_symbols_t *sym, uint64_t addr,
+                         char *func, size_t flen, char *loc, size_t llen)
+{
+    sym_copy(func, flen, "??");
+    sym_copy(loc, llen, "??:0");
+
+    if (NULL == sym)
+    {
+        return 0;
+    }
+
+    /* Thumb state bit is not part of the instruction address */
+    addr &= ~(uint64_t)1U;
+
+    sym_cache_t *slot = &sym->cache[(addr >> 1) & (SYM_CACHE_SLOTS - 1U)];
+
+    if (slot->addr != (addr + 1U))
+    {
+        char fbuf[512];
+        char lbuf[512];
+
+        if ((fprintf(sym->to, "0x%llx\n", (unsigned long long)addr) < 0) ||
+            (0 != fflush(sym->to)) ||
+            (NULL == fgets(fbuf, sizeof(fbuf), sym->from)) ||
+            (NULL == fgets(lbuf, sizeof(lbuf), sym->from)))
+        {
+            return 0;
+        }
+        sym_chomp(fbuf);
+        sym_chomp(lbuf);
+
+        slot->addr  = addr + 1U;
+        slot->known = (0 != strcmp(fbuf, "??")) ? 1 : 0;
+        sym_copy(slot->func, sizeof(slot->func), fbuf);
+        sym_copy(slot->loc, sizeof(slot->loc), lbuf);
+    }
+
+    sym_copy(func, flen, slot->func);
+    sym_copy(loc, llen, slot->loc);
+
+    return slot->known;
+}
+
+void debug_symbols_close(debug_symbols_t *sym)
+{
+    if (NULL == sym)
+    {
+        return;
+    }
+
+    if (NULL != sym->to)
+    {
+        fclose(sym->to);
+    }
+    if (NULL != sym->from)
+    {
+        fclose(sym->from);
+    }
+    if (sym->pid > 0)
+    {
+        kill(sym->pid, SIGTERM);
+        waitpid(sym->pid, NULL, 0);
+    }
+
+    free(sym->cache);
+    free(sym);
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,95 @@
+/**
+ * @file      debug_symbols.h
+ * @brief     Host-side address symbolization via addr2line.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Resolves raw code addresses captured on the target (crash dumps,
+ * backtraces, profiling samples) to function names and source locations.
+ *
+ * A single addr2line process is kept running for the lifetime of the
+ * resolver and fed one address at a time, and results are cached, so
+ * symbolizing large sample sets stays cheap.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_SYMBOLS_H
+#define DEBUG_SYMBOLS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Default addr2line binary for Cortex-M targets */
+#define DEBUG_SYMBOLS_DEFAULT_ADDR2LINE  "arm-none-eabi-addr2line"
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/** @brief Opaque resolver handle */
+typedef struct debug_symbols debug_symbols_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Start a resolver for an ELF file.
+ *
+ * @param[in] elf       Path to the firmware ELF
+ * @param[in] addr2line addr2line binary (NULL for the default)
+ *
+ * @return Resolver handle, or NULL on failure
+ */
+debug_symbols_t *debug_symbols_open(const char *elf, const char *addr2line);
+
+/**
+ * @brief Resolve an address.
+ *
+ * @param[in]  sym  Resolver (NULL yields "??")
+ * @param[in]  addr Code address (Thumb bit is ignored)
+ * @param[out] func Function name, "??" if unknown (may be NULL)
+ * @param[in]  flen Size of @p func
+ * @param[out] loc  "file:line", "??:0" if unknown (may be NULL)
+ * @param[in]  llen Size of @p loc
+ *
+ * @retval 1  Address resolved to a function
+ * @retval 0  Address unknown
+ */
+int debug_symbols_lookup(debug_symbols_t *sym, uint64_t addr,
+                         char *func, size_t flen, char *loc, size_t llen);
+
+/**
+ * @brief Stop the resolver and free its resources.
+ *
+ * @param[in] sym Resolver handle (may be NULL)
+ */
+void debug_symbols_close(debug_symbols_t *sym);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_SYMBOLS_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
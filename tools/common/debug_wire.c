@@ -0,0 +1,476 @@
+/**
+ * @file      debug_wire.c
+ * @brief     Host renderer for the interned wire format.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_wire.h. Each conversion of the format string is printed with
+ * the host snprintf: the length modifier is replaced by the one matching
+ * the decoded 64-bit value, and the value is first narrowed as the
+ * device's hh/h modifier would have done.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug_record.h"
+#include "debug_line.h"
+#include "debug_wire.h"
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Argument reader */
+typedef struct
+{
+    const uint8_t *p;
+    size_t         len;
+    size_t         pos;
+    int            error;
+} wire_args_t;
+
+/** @brief Output writer */
+typedef struct
+{
+    char  *buf;
+    size_t cap;
+    size_t len;     /**< May exceed cap - 1; output is truncated */
+} wire_out_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static uint64_t wire_uvar(wire_args_t *a)
+{
+    uint64_t v     = 0;
+    unsigned shift = 0;
+
+    while ((a->pos < a->len) && (shift < 64U))
+    {
+        uint8_t b = a->p[a->pos++];
+
+        v |= (uint64_t)(b & 0x7FU) << shift;
+        if (0U == (b & 0x80U))
+        {
+            return v;
+        }
+        shift += 7U;
+    }
+
+    a->error = 1;
+    return 0;
+}
+
+static int64_t wire_svar(wire_args_t *a)
+{
+    uint64_t v = wire_uvar(a);
+
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1U);
+}
+
+static void wire_put(wire_out_t *o, const char *s, size_t n)
+{
+    if (o->len < o->cap)
+    {
+        size_t room = o->cap - 1U - o->len;
+
+        memcpy(&o->buf[o->len], s, (n < room) ? n : room);
+    }
+    o->len += n;
+}
+
+static void wire_printf(wire_out_t *o, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void wire_printf(wire_out_t *o, const char *fmt, ...)
+{
+    char    tmp[4096];
+    va_list args;
+
+    va_start(args, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, args);
+    va_end(args);
+
+    if (n > 0)
+    {
+        wire_put(o, tmp, ((size_t)n < sizeof(tmp)) ? (size_t)n : (sizeof(tmp) - 1U));
+    }
+}
+
+/**
+ * @brief Render the "[seq][ts][thread][LEVEL]" prefix of a record.
+ */
+static void wire_prefix(const debug_wire_t *w, wire_out_t *o, uint8_t flags,
+                        uint32_t seq, uint32_t ts, uint16_t thread_id,
+                        uint8_t level)
+{
+    if (0U != (flags & DEBUG_LOG_HAS_SEQ))
+    {
+        wire_printf(o, "[%05lu]", (unsigned long)seq);
+    }
+    if (0U != (flags & DEBUG_LOG_HAS_TS))
+    {
+        wire_printf(o, "[%lu]", (unsigned long)ts);
+    }
+    if (0U != (flags & DEBUG_LOG_HAS_THREAD))
+    {
+        if (NULL != w->text[thread_id])
+        {
+            wire_printf(o, "[%s]", w->text[thread_id]);
+        }
+        else
+        {
+            wire_printf(o, "[<thread #%u>]", (unsigned)thread_id);
+        }
+    }
+    wire_printf(o, "[%s]", (level < DEBUG_LINE_LEVELS) ?
+                debug_line_level_name(level) : "LOG");
+}
+
+/**
+ * @brief Render the message part of a record.
+ */
+static void wire_message(wire_out_t *o, const char *fmt, wire_args_t *a)
+{
+    for (const char *p = fmt; '\0' != *p; )
+    {
+        if ('%' != *p)
+        {
+            const char *next = strchr(p, '%');
+            size_t      n    = (NULL != next) ? (size_t)(next - p) : strlen(p);
+
+            wire_put(o, p, n);
+            p += n;
+            continue;
+        }
+        if ('%' == p[1])
+        {
+            wire_put(o, "%", 1U);
+            p += 2;
+            continue;
+        }
+
+        /* Rebuild the conversion: flags, width, precision, then our modifier */
+        char spec[64];
+        size_t sl = 0;
+
+        spec[sl++] = *p++;
+        while (('\0' != *p) && (NULL != strchr("-+ #0'", *p)) && (sl < 8U))
+        {
+            spec[sl++] = *p++;
+        }
+        for (int part = 0; part < 2; part++)
+        {
+            if (1 == part)
+            {
+                if ('.' != *p)
+                {
+                    break;
+                }
+                spec[sl++] = *p++;
+            }
+            if ('*' == *p)
+            {
+                sl += (size_t)snprintf(&spec[sl], sizeof(spec) - sl - 8U, "%d",
+                                       (int)wire_svar(a));
+                p++;
+            }
+            while ((*p >= '0') && (*p <= '9') && (sl < 40U))
+            {
+                spec[sl++] = *p++;
+            }
+        }
+
+        int hh = 0, h = 0, big_l = 0;
+
+        if (('h' == p[0]) && ('h' == p[1]))      { hh = 1; p += 2; }
+        else if (('l' == p[0]) && ('l' == p[1])) { p += 2; }
+        else if ('h' == *p)                      { h = 1; p++; }
+        else if ('L' == *p)                      { big_l = 1; p++; }
+        else if (NULL != strchr("lzjt", *p) && ('\0' != *p)) { p++; }
+        (void)big_l;
+
+        char conv = *p;
+
+        if ('\0' == conv)
+        {
+            break;
+        }
+        p++;
+
+        switch (conv)
+        {
+            case 'd':
+            case 'i':
+            {
+                int64_t v = wire_svar(a);
+
+                if (0 != hh) v = (signed char)v;
+                if (0 != h)  v = (short)v;
+                memcpy(&spec[sl], "lld", 4U);
+                wire_printf(o, spec, (long long)v);
+                break;
+            }
+
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            {
+                uint64_t v = wire_uvar(a);
+
+                if (0 != hh) v = (unsigned char)v;
+                if (0 != h)  v = (unsigned short)v;
+                spec[sl]     = 'l';
+                spec[sl + 1] = 'l';
+                spec[sl + 2] = conv;
+                spec[sl + 3] = '\0';
+                wire_printf(o, spec, (unsigned long long)v);
+                break;
+            }
+
+            case 'c':
+                memcpy(&spec[sl], "c", 2U);
+                wire_printf(o, spec, (int)wire_uvar(a));
+                break;
+
+            case 'p':
+            {
+                char ptr[32];
+
+                snprintf(ptr, sizeof(ptr), "0x%llx", (unsigned long long)wire_uvar(a));
+                memcpy(&spec[sl], "s", 2U);
+                wire_printf(o, spec, ptr);
+                break;
+            }
+
+            case 'a': case 'A':
+            case 'e': case 'E':
+            case 'f': case 'F':
+            case 'g': case 'G':
+            {
+                double v = 0.0;
+
+                if ((a->pos + sizeof(v)) <= a->len)
+                {
+                    memcpy(&v, &a->p[a->pos], sizeof(v));
+                    a->pos += sizeof(v);
+                }
+                else
+                {
+                    a->error = 1;
+                }
+                spec[sl]     = conv;
+                spec[sl + 1] = '\0';
+                wire_printf(o, spec, v);
+                break;
+            }
+
+            case 's':
+            {
+                size_t n = (size_t)wire_uvar(a);
+                char   str[4096];
+
+                if ((n > (a->len - a->pos)) || (n >= sizeof(str)))
+                {
+                    a->error = 1;
+                    n = 0;
+                }
+                memcpy(str, &a->p[a->pos], n);
+                str[n]  = '\0';
+                a->pos += n;
+                memcpy(&spec[sl], "s", 2U);
+                wire_printf(o, spec, str);
+                break;
+            }
+
+            default:
+                a->error = 1;
+                break;
+        }
+
+        if (0 != a->error)
+        {
+            wire_put(o, "<?>", 3U);
+            return;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_wire_init(debug_wire_t *w)
+{
+    memset(w, 0, sizeof(*w));
+    w->text = calloc(DEBUG_WIRE_IDS, sizeof(*w->text));
+
+    return (NULL != w->text) ? 0 : -1;
+}
+
+int debug_wire_define(debug_wire_t *w, const uint8_t *payload, size_t len)
+{
+    debug_dict_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        return -1;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    size_t n    = len - sizeof(rec);
+    char  *text = malloc(n + 1U);
+
+    if (NULL == text)
+    {
+        return -1;
+    }
+    memcpy(text, &payload[sizeof(rec)], n);
+    text[n] = '\0';
+
+    free(w->text[rec.id]);
+    w->text[rec.id] = text;
+    w->defined++;
+
+    return 0;
+}
+
+int debug_wire_render(debug_wire_t *w, const uint8_t *payload, size_t len,
+                      char *out, size_t cap)
+{
+    debug_log_record_t rec;
+    wire_out_t         o = { .buf = out, .cap = cap, .len = 0 };
+
+    if ((len < sizeof(rec)) || (0U == cap))
+    {
+        return -1;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    wire_prefix(w, &o, rec.flags, rec.seq, rec.timestamp, rec.thread_id,
+                rec.level);
+
+    wire_args_t a = { .p = &payload[sizeof(rec)], .len = len - sizeof(rec) };
+
+    if (0U != (rec.flags & DEBUG_LOG_HAS_WEIGHT))
+    {
+        wire_printf(&o, "[1/%llu]", (unsigned long long)wire_uvar(&a));
+    }
+    wire_put(&o, " ", 1U);
+
+    if (NULL == w->text[rec.fmt_id])
+    {
+        wire_printf(&o, "<fmt #%u>", (unsigned)rec.fmt_id);
+        w->unknown++;
+    }
+    else
+    {
+        wire_message(&o, w->text[rec.fmt_id], &a);
+        if (0 != a.error)
+        {
+            w->malformed++;
+        }
+    }
+    w->rendered++;
+
+    size_t n = (o.len < cap) ? o.len : (cap - 1U);
+
+    out[n] = '\0';
+    return (int)n;
+}
+
+int debug_wire_render_array(debug_wire_t *w, const uint8_t *payload,
+                            size_t len, char *out, size_t cap)
+{
+    static const uint8_t size[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8, 8, 8 };
+    debug_array_record_t rec;
+    wire_out_t           o = { .buf = out, .cap = cap, .len = 0 };
+
+    if ((len < sizeof(rec)) || (0U == cap))
+    {
+        return -1;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    wire_prefix(w, &o, rec.flags, rec.seq, rec.timestamp, rec.thread_id,
+                rec.level);
+
+    if (NULL == w->text[rec.name_id])
+    {
+        wire_printf(&o, " <fmt #%u>[%u]:", (unsigned)rec.name_id,
+                    (unsigned)rec.index);
+        w->unknown++;
+    }
+    else
+    {
+        wire_printf(&o, " %s[%u]:", w->text[rec.name_id], (unsigned)rec.index);
+    }
+
+    size_t         n = (rec.type < sizeof(size)) ? size[rec.type] : 0U;
+    const uint8_t *p = &payload[sizeof(rec)];
+
+    if ((0U == n) || (0U != ((len - sizeof(rec)) % n)))
+    {
+        wire_printf(&o, " <type %u, %zu bytes>", (unsigned)rec.type,
+                    len - sizeof(rec));
+        w->malformed++;
+        n = 0;
+    }
+
+    for (size_t i = 0; (0U != n) && ((i + n) <= (len - sizeof(rec))); i += n)
+    {
+        union { uint8_t u8; int8_t i8; uint16_t u16; int16_t i16; uint32_t u32;
+                int32_t i32; uint64_t u64; int64_t i64; float f32; double f64; } v;
+
+        memcpy(&v, &p[i], n);
+        switch (rec.type)
+        {
+            case DEBUG_ARRAY_U8:  wire_printf(&o, " %u", (unsigned)v.u8);   break;
+            case DEBUG_ARRAY_I8:  wire_printf(&o, " %d", (int)v.i8);        break;
+            case DEBUG_ARRAY_U16: wire_printf(&o, " %u", (unsigned)v.u16);  break;
+            case DEBUG_ARRAY_I16: wire_printf(&o, " %d", (int)v.i16);       break;
+            case DEBUG_ARRAY_U32: wire_printf(&o, " %lu", (unsigned long)v.u32); break;
+            case DEBUG_ARRAY_I32: wire_printf(&o, " %ld", (long)v.i32);     break;
+            case DEBUG_ARRAY_U64: wire_printf(&o, " %llu", (unsigned long long)v.u64); break;
+            case DEBUG_ARRAY_I64: wire_printf(&o, " %lld", (long long)v.i64); break;
+            case DEBUG_ARRAY_F32: wire_printf(&o, " %g", (double)v.f32);    break;
+            default:              wire_printf(&o, " %g", v.f64);            break;
+        }
+    }
+    w->rendered++;
+
+    size_t end = (o.len < cap) ? o.len : (cap - 1U);
+
+    out[end] = '\0';
+    return (int)end;
+}
+
+void debug_wire_free(debug_wire_t *w)
+{
+    if (NULL != w->text)
+    {
+        for (size_t i = 0; i < DEBUG_WIRE_IDS; i++)
+        {
+            free(w->text[i]);
+        }
+        free(w->text);
+    }
+    memset(w, 0, sizeof(*w));
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
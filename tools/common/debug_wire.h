@@ -0,0 +1,130 @@
+/**
+ * @file      debug_wire.h
+ * @brief     Host renderer for the interned wire format.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Firmware built with DEBUG_WIRE_INTERNED sends DEBUG_RECORD_DICT records
+ * (ID -> format string or thread name) and DEBUG_RECORD_LOG records (IDs
+ * plus binary arguments). This module keeps the dictionary and turns each
+ * log record back into the text line the firmware would have sent in
+ * text mode:
+ *
+ * @code
+ *   [00042][123456][net][INFO] link up after 3 tries
+ * @endcode
+ *
+ * DEBUG_RECORD_ARRAY records (LOG_ARRAY()) are rendered the same way, as
+ * "name[index]: v v ..." after the prefix.
+ *
+ * A record whose format ID has not been defined yet (capture started
+ * after the definition) is rendered as "<fmt #ID>" and counted.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_WIRE_H
+#define DEBUG_WIRE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Number of possible IDs */
+#define DEBUG_WIRE_IDS  65536U
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Dictionary and counters.
+ */
+typedef struct
+{
+    char    **text;         /**< String per ID, NULL = undefined */
+    uint64_t  defined;      /**< Dictionary records accepted */
+    uint64_t  rendered;     /**< Log records rendered */
+    uint64_t  unknown;      /**< Log records with an undefined format */
+    uint64_t  malformed;    /**< Log records whose arguments did not decode */
+} debug_wire_t;
+
+/*******************************************************************************
+ * Public Function Declarations
+ *******************************************************************************/
+
+/**
+ * @brief Initialize an empty dictionary.
+ * @param[out] w Dictionary
+ * @retval 0   Success
+ * @retval -1  Out of memory
+ */
+int debug_wire_init(debug_wire_t *w);
+
+/**
+ * @brief Apply a DEBUG_RECORD_DICT payload.
+ * @param[in,out] w       Dictionary
+ * @param[in]     payload Record payload
+ * @param[in]     len     Payload length
+ * @retval 0   Success
+ * @retval -1  Truncated record or out of memory
+ */
+int debug_wire_define(debug_wire_t *w, const uint8_t *payload, size_t len);
+
+/**
+ * @brief Render a DEBUG_RECORD_LOG payload as a text line.
+ * @param[in,out] w       Dictionary (counters are updated)
+ * @param[in]     payload Record payload
+ * @param[in]     len     Payload length
+ * @param[out]    out     Line buffer (NUL terminated, no CR/LF)
+ * @param[in]     cap     Size of out
+ * @return Line length (truncated to cap - 1), or -1 if the record is
+ *         too short to hold a header
+ */
+int debug_wire_render(debug_wire_t *w, const uint8_t *payload, size_t len,
+                      char *out, size_t cap);
+
+/**
+ * @brief Render a DEBUG_RECORD_ARRAY payload as a text line.
+ * @param[in,out] w       Dictionary (counters are updated)
+ * @param[in]     payload Record payload
+ * @param[in]     len     Payload length
+ * @param[out]    out     Line buffer (NUL terminated, no CR/LF)
+ * @param[in]     cap     Size of out
+ * @return Line length (truncated to cap - 1), or -1 if the record is
+ *         too short to hold a header
+ */
+int debug_wire_render_array(debug_wire_t *w, const uint8_t *payload,
+                            size_t len, char *out, size_t cap);
+
+/**
+ * @brief Release the dictionary.
+ * @param[in,out] w Dictionary
+ */
+void debug_wire_free(debug_wire_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_WIRE_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
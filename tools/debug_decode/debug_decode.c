@@ -0,0 +1,737 @@
+/**
+ * @file      debug_decode.c
+ * @brief     Host decoder for captured debug streams.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Reads a raw capture of the debug transport (file or stdin), passes text
+ * lines through unchanged and renders binary records in human-readable
+ * form. Lines with the compact prefix (DEBUG_ENABLE_COMPACT_PREFIX) are
+ * printed with the full prefix again. With --elf, code addresses are symbolized through addr2line.
+ *
+ * Supported records:
+ *  - DEBUG_RECORD_CRASH     : fault dump with decoded CFSR/HFSR and stack scan
+ *  - DEBUG_RECORD_BACKTRACE : call chain attached to a LOG_ERROR line
+ *  - DEBUG_RECORD_SYNC      : clock beacon (timestamp, cycles and rates)
+ *  - DEBUG_RECORD_PONG      : answer to a host ping (see log_ingest --ping)
+ *  - DEBUG_RECORD_DICT      : interned string definition (not printed)
+ *  - DEBUG_RECORD_LOG       : interned log line, printed as the text line
+ *  - DEBUG_RECORD_ARRAY     : LOG_ARRAY() slice, rendered like a LOG record
+ *  - DEBUG_RECORD_GOVERNOR  : effective log level change and its cause
+ *  - DEBUG_RECORD_SCOPE     : slow run or summary of a LOG_TIME_SCOPE() block
+ *  - DEBUG_RECORD_TASK_STATS: per-task CPU share and stack (see tools/task_stats)
+ *  - DEBUG_RECORD_KTRACE    : batch of kernel events, summarized (see
+ *                             tools/ktrace_perfetto)
+ *  - DEBUG_RECORD_HEAP      : batch of heap events, summarized (see
+ *                             tools/heap_replay)
+ *  - DEBUG_RECORD_WATCH_DEF : watched variables, summarized (see
+ *                             tools/watch_export)
+ *  - DEBUG_RECORD_WATCH     : batch of watch samples, summarized
+ *  - DEBUG_RECORD_MUX       : channel frame, summarized (split the stream
+ *                             with tools/debug_demux first)
+ *  - DEBUG_RECORD_PROF      : batch of function entries/exits, summarized
+ *                             (see tools/prof_flame)
+ *  - DEBUG_RECORD_SAMPLE    : batch of PC samples, summarized (see
+ *                             tools/prof_sample)
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o debug_decode \
+ *       debug_decode.c ../common/debug_stream.c ../common/debug_symbols.c \
+ *       ../common/debug_wire.c ../common/debug_line.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   debug_decode [--elf firmware.elf] [--addr2line tool] [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_line.h"
+#include "debug_stream.h"
+#include "debug_symbols.h"
+#include "debug_wire.h"
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Status register bit description */
+typedef struct
+{
+    uint32_t    mask;   /**< Bit mask */
+    const char *name;   /**< Mnemonic */
+    const char *text;   /**< Explanation */
+} decode_bit_t;
+
+/** @brief Decoder context */
+typedef struct
+{
+    debug_symbols_t *sym;       /**< Resolver, NULL without --elf */
+    FILE            *out;       /**< Output stream */
+    debug_wire_t     wire;      /**< Interned string dictionary */
+    debug_line_compact_t compact; /**< Compact prefix expander */
+} decode_ctx_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static const decode_bit_t CFSR_BITS[] =
+{
+    { 1UL << 0,  "IACCVIOL",    "instruction fetch from XN/protected region" },
+    { 1UL << 1,  "DACCVIOL",    "data access violation (see MMFAR)" },
+    { 1UL << 3,  "MUNSTKERR",   "MemManage fault on exception return unstacking" },
+    { 1UL << 4,  "MSTKERR",     "MemManage fault on exception entry stacking" },
+    { 1UL << 5,  "MLSPERR",     "MemManage fault during lazy FP state save" },
+    { 1UL << 7,  "MMARVALID",   "MMFAR holds the faulting address" },
+    { 1UL << 8,  "IBUSERR",     "bus error on instruction fetch" },
+    { 1UL << 9,  "PRECISERR",   "precise data bus error (see BFAR)" },
+    { 1UL << 10, "IMPRECISERR", "imprecise data bus error (PC is not exact)" },
+    { 1UL << 11, "UNSTKERR",    "bus fault on exception return unstacking" },
+    { 1UL << 12, "STKERR",      "bus fault on exception entry stacking (stack overflow?)" },
+    { 1UL << 13, "LSPERR",      "bus fault during lazy FP state save" },
+    { 1UL << 15, "BFARVALID",   "BFAR holds the faulting address" },
+    { 1UL << 16, "UNDEFINSTR",  "undefined instruction" },
+    { 1UL << 17, "INVSTATE",    "invalid EPSR state (ARM mode / bad function pointer)" },
+    { 1UL << 18, "INVPC",       "invalid EXC_RETURN on exception return" },
+    { 1UL << 19, "NOCP",        "coprocessor access with FPU disabled" },
+    { 1UL << 20, "STKOF",       "stack limit overflow (ARMv8-M)" },
+    { 1UL << 24, "UNALIGNED",   "unaligned access with UNALIGN_TRP set" },
+    { 1UL << 25, "DIVBYZERO",   "integer divide by zero with DIV_0_TRP set" },
+};
+
+static const decode_bit_t HFSR_BITS[] =
+{
+    { 1UL << 1,  "VECTTBL",  "bus fault on vector table read" },
+    { 1UL << 30, "FORCED",   "escalated configurable fault (see CFSR)" },
+    { 1UL << 31, "DEBUGEVT", "debug event" },
+};
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void decode_bits(FILE *out, const char *reg, uint32_t value,
+                        const decode_bit_t *bits, size_t count)
+{
+    fprintf(out, "  %-5s 0x%08lx\n", reg, (unsigned long)value);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (0U != (value & bits[i].mask))
+        {
+            fprintf(out, "          %-11s %s\n", bits[i].name, bits[i].text);
+        }
+    }
+}
+
+static void decode_addr(decode_ctx_t *ctx, const char *label, uint32_t addr,
+                        int is_return)
+{
+    char func[128];
+    char loc[256];
+
+    /* A return address points after the call; look up the call itself */
+    uint64_t lookup = ((0 != is_return) && (addr > 1U)) ? (addr & ~1UL) - 1U :
+                                                          addr;
+
+    debug_symbols_lookup(ctx->sym, lookup, func, sizeof(func), loc, sizeof(loc));
+    fprintf(ctx->out, "  %-5s 0x%08lx  %s (%s)\n", label,
+            (unsigned long)addr, func, loc);
+}
+
+static void decode_crash(decode_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_crash_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated crash record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    size_t words = rec.stack_words;
+    if ((sizeof(rec) + (words * 4U)) > len)
+    {
+        words = (len - sizeof(rec)) / 4U;
+    }
+
+    char task[DEBUG_RECORD_NAME_LEN + 1U];
+    memcpy(task, rec.task, DEBUG_RECORD_NAME_LEN);
+    task[DEBUG_RECORD_NAME_LEN] = '\0';
+
+    fprintf(ctx->out, "======== CRASH v%u  task=%s  ts=%lu  %s%s%s ========\n",
+            rec.version, task, (unsigned long)rec.timestamp,
+            (0U != (rec.flags & DEBUG_CRASH_FLAG_THREAD)) ? "thread" : "handler",
+            (0U != (rec.flags & DEBUG_CRASH_FLAG_PSP)) ? "/PSP" : "/MSP",
+            (0U != (rec.flags & DEBUG_CRASH_FLAG_FPU)) ? "/FPU" : "");
+
+    decode_addr(ctx, "pc", rec.pc, 0);
+    decode_addr(ctx, "lr", rec.lr, 1);
+    fprintf(ctx->out, "  r0    0x%08lx  r1  0x%08lx  r2   0x%08lx  r3 0x%08lx\n",
+            (unsigned long)rec.r0, (unsigned long)rec.r1,
+            (unsigned long)rec.r2, (unsigned long)rec.r3);
+    fprintf(ctx->out, "  r12   0x%08lx  sp  0x%08lx  xpsr 0x%08lx  exc_return 0x%08lx\n",
+            (unsigned long)rec.r12, (unsigned long)rec.sp,
+            (unsigned long)rec.xpsr, (unsigned long)rec.exc_return);
+
+    decode_bits(ctx->out, "cfsr", rec.cfsr, CFSR_BITS,
+                sizeof(CFSR_BITS) / sizeof(CFSR_BITS[0]));
+    decode_bits(ctx->out, "hfsr", rec.hfsr, HFSR_BITS,
+                sizeof(HFSR_BITS) / sizeof(HFSR_BITS[0]));
+
+    if (0U != (rec.cfsr & (1UL << 7)))
+    {
+        fprintf(ctx->out, "  mmfar 0x%08lx\n", (unsigned long)rec.mmfar);
+    }
+    if (0U != (rec.cfsr & (1UL << 15)))
+    {
+        fprintf(ctx->out, "  bfar  0x%08lx\n", (unsigned long)rec.bfar);
+    }
+
+    fprintf(ctx->out, "  stack (%zu words from sp):\n", words);
+
+    for (size_t i = 0; i < words; i++)
+    {
+        uint32_t w;
+        char     func[128];
+        char     loc[256];
+
+        memcpy(&w, &payload[sizeof(rec) + (i * 4U)], sizeof(w));
+
+        /* Odd values may be Thumb return addresses; try to resolve them */
+        if ((0U != (w & 1U)) &&
+            (0 != debug_symbols_lookup(ctx->sym, (uint64_t)(w & ~1UL) - 1U,
+                                       func, sizeof(func), loc, sizeof(loc))))
+        {
+            fprintf(ctx->out, "    [sp+0x%03zx] 0x%08lx  <- %s (%s)\n",
+                    i * 4U, (unsigned long)w, func, loc);
+        }
+        else
+        {
+            fprintf(ctx->out, "    [sp+0x%03zx] 0x%08lx\n",
+                    i * 4U, (unsigned long)w);
+        }
+    }
+
+    fprintf(ctx->out, "=================================================\n");
+}
+
+static void decode_backtrace(decode_ctx_t *ctx, const uint8_t *payload,
+                             size_t len)
+{
+    debug_backtrace_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated backtrace record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    if ((4U != rec.addr_size) && (8U != rec.addr_size))
+    {
+        fprintf(ctx->out, "[decode] bad backtrace address size %u\n",
+                (unsigned)rec.addr_size);
+        return;
+    }
+
+    size_t depth = rec.depth;
+    if ((sizeof(rec) + (depth * rec.addr_size)) > len)
+    {
+        depth = (len - sizeof(rec)) / rec.addr_size;
+    }
+
+    fprintf(ctx->out, "  backtrace seq=%05lu  capture=%lu cycles\n",
+            (unsigned long)rec.seq, (unsigned long)rec.cycles);
+
+    for (size_t i = 0; i < depth; i++)
+    {
+        uint64_t addr = 0;
+        char     func[128];
+        char     loc[256];
+
+        if (4U == rec.addr_size)
+        {
+            uint32_t a32;
+            memcpy(&a32, &payload[sizeof(rec) + (i * 4U)], sizeof(a32));
+            addr = a32;
+        }
+        else
+        {
+            memcpy(&addr, &payload[sizeof(rec) + (i * 8U)], sizeof(addr));
+        }
+
+        /* Every entry is a return address; look up the call itself */
+        debug_symbols_lookup(ctx->sym, (addr > 1U) ? (addr & ~1ULL) - 1U : addr,
+                             func, sizeof(func), loc, sizeof(loc));
+        fprintf(ctx->out, "    #%zu 0x%0*llx  %s (%s)\n", i,
+                (int)(rec.addr_size * 2U), (unsigned long long)addr, func, loc);
+    }
+}
+
+static void decode_sync(decode_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_sync_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated sync record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    fprintf(ctx->out, "  sync seq=%05lu ts=%lu @ %lu Hz cycles=%lu @ %lu Hz\n",
+            (unsigned long)rec.seq, (unsigned long)rec.timestamp,
+            (unsigned long)rec.tick_hz, (unsigned long)rec.cycles,
+            (unsigned long)rec.cycles_hz);
+}
+
+static void decode_pong(decode_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_pong_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated pong record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    fprintf(ctx->out, "  pong id=%lu host=%llu rx ts=%lu cycles=%lu "
+            "tx ts=%lu cycles=%lu\n", (unsigned long)rec.id,
+            (unsigned long long)rec.host_time,
+            (unsigned long)rec.rx_timestamp, (unsigned long)rec.rx_cycles,
+            (unsigned long)rec.tx_timestamp, (unsigned long)rec.tx_cycles);
+}
+
+static void decode_governor(decode_ctx_t *ctx, const uint8_t *payload,
+                            size_t len)
+{
+    static const char *const LEVELS[] = { "ERROR", "WARN", "INFO", "DEBUG" };
+    debug_governor_record_t  rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated governor record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    fprintf(ctx->out, "  governor ts=%lu level %s (set %s)%s%s%s%s%s shed=%lu",
+            (unsigned long)rec.timestamp,
+            (rec.level < 4U) ? LEVELS[rec.level] : "?",
+            (rec.base < 4U) ? LEVELS[rec.base] : "?",
+            (0U == rec.reasons) ? " calm" : "",
+            (0U != (rec.reasons & DEBUG_GOVERNOR_FILL)) ? " fill" : "",
+            (0U != (rec.reasons & DEBUG_GOVERNOR_DROP)) ? " drop" : "",
+            (0U != (rec.reasons & DEBUG_GOVERNOR_RATE)) ? " rate" : "",
+            (0U != (rec.reasons & DEBUG_GOVERNOR_CPU)) ? " cpu" : "",
+            (unsigned long)rec.shed);
+    fprintf(ctx->out, " | window %lu ticks: offered=%lu dropped=%lu cpu=%u.%u%%",
+            (unsigned long)rec.window, (unsigned long)rec.offered,
+            (unsigned long)rec.dropped, (unsigned)(rec.cpu_permille / 10U),
+            (unsigned)(rec.cpu_permille % 10U));
+    if (0xFFU != rec.fill)
+    {
+        fprintf(ctx->out, " fill=%u%%", (unsigned)rec.fill);
+    }
+    fputc('\n', ctx->out);
+}
+
+/**
+ * @brief Print a cycle count in microseconds (or raw cycles if the rate
+ *        is unknown).
+ */
+static void decode_cycles(FILE *out, const char *label, uint64_t cycles,
+                          uint32_t hz)
+{
+    if (0U != hz)
+    {
+        fprintf(out, " %s=%.1fus", label, ((double)cycles * 1e6) / (double)hz);
+    }
+    else
+    {
+        fprintf(out, " %s=%llu cyc", label, (unsigned long long)cycles);
+    }
+}
+
+static void decode_scope(decode_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_scope_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated scope record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    size_t name_len = len - sizeof(rec);
+
+    if (rec.name_len < name_len)
+    {
+        name_len = rec.name_len;
+    }
+
+    fprintf(ctx->out, "  scope \"%.*s\" ts=%lu", (int)name_len,
+            (const char *)&payload[sizeof(rec)], (unsigned long)rec.timestamp);
+    if (0U != (rec.flags & DEBUG_SCOPE_SLOW))
+    {
+        fprintf(ctx->out, " SLOW");
+        decode_cycles(ctx->out, "took", rec.elapsed, rec.cycles_hz);
+    }
+    else
+    {
+        fprintf(ctx->out, " summary");
+    }
+    decode_cycles(ctx->out, "limit", rec.threshold, rec.cycles_hz);
+
+    if ((0U != (rec.flags & DEBUG_SCOPE_HAS_STATS)) && (0U != rec.count))
+    {
+        uint64_t total = rec.total;
+
+        fprintf(ctx->out, " | runs=%lu over=%lu", (unsigned long)rec.count,
+                (unsigned long)rec.over);
+        decode_cycles(ctx->out, "min", rec.min, rec.cycles_hz);
+        decode_cycles(ctx->out, "avg", total / rec.count, rec.cycles_hz);
+        decode_cycles(ctx->out, "max", rec.max, rec.cycles_hz);
+    }
+    fputc('\n', ctx->out);
+}
+
+static void decode_task_stats(decode_ctx_t *ctx, const uint8_t *payload,
+                              size_t len)
+{
+    debug_task_stats_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        fprintf(ctx->out, "[decode] truncated task stats record (%zu bytes)\n", len);
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    fprintf(ctx->out, "  task %-16.*s sample=%u ts=%lu cpu=%.1f%% prio=%u/%u "
+            "state=%u stack_free=%lu%s\n", (int)DEBUG_RECORD_NAME_LEN, rec.name,
+            (unsigned)rec.sample, (unsigned long)rec.timestamp,
+            (0U != rec.total_time) ?
+            ((100.0 * (double)rec.run_time) / (double)rec.total_time) : 0.0,
+            (unsigned)rec.priority, (unsigned)rec.base_priority,
+            (unsigned)rec.state, (unsigned long)rec.stack_free,
+            (0U != (rec.flags & DEBUG_TASK_STATS_NEW)) ? " (new)" : "");
+}
+
+static void on_text(void *user, const char *line, size_t len)
+{
+    decode_ctx_t *ctx = user;
+    debug_line_t  ln;
+    char          full[DEBUG_STREAM_MAX_LINE + 64];
+
+    switch (debug_line_expand(&ctx->compact, line, len, &ln))
+    {
+        case DEBUG_LINE_BINDING:
+            return;
+
+        case DEBUG_LINE_EXPANDED:
+            len  = debug_line_format(&ln, full, sizeof(full));
+            line = full;
+            break;
+
+        default:
+            break;
+    }
+
+    fwrite(line, 1, len, ctx->out);
+    fputc('\n', ctx->out);
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    decode_ctx_t *ctx = user;
+
+    switch (type)
+    {
+        case DEBUG_RECORD_CRASH:
+            decode_crash(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_BACKTRACE:
+            decode_backtrace(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_SYNC:
+            decode_sync(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_PONG:
+            decode_pong(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_GOVERNOR:
+            decode_governor(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_SCOPE:
+            decode_scope(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_TASK_STATS:
+            decode_task_stats(ctx, payload, len);
+            break;
+
+        case DEBUG_RECORD_KTRACE:
+            if (len >= sizeof(debug_ktrace_record_t))
+            {
+                debug_ktrace_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                fprintf(ctx->out, "  ktrace %u event(s), %lu dropped\n",
+                        (unsigned)rec.count, (unsigned long)rec.dropped);
+            }
+            break;
+
+        case DEBUG_RECORD_HEAP:
+            if (len >= sizeof(debug_heap_record_t))
+            {
+                debug_heap_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                fprintf(ctx->out, "  heap %u event(s), %lu dropped\n",
+                        (unsigned)rec.count, (unsigned long)rec.dropped);
+            }
+            break;
+
+        case DEBUG_RECORD_WATCH_DEF:
+            if (len >= sizeof(debug_watch_def_record_t))
+            {
+                debug_watch_def_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                fprintf(ctx->out, "  watch layout %u: %u variable(s)\n",
+                        (unsigned)rec.layout, (unsigned)rec.count);
+            }
+            break;
+
+        case DEBUG_RECORD_WATCH:
+            if (len >= sizeof(debug_watch_record_t))
+            {
+                debug_watch_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                fprintf(ctx->out, "  watch %u frame(s) from seq %lu, %lu dropped\n",
+                        (unsigned)rec.count, (unsigned long)rec.seq,
+                        (unsigned long)rec.dropped);
+            }
+            break;
+
+        case DEBUG_RECORD_MUX:
+            if (len >= sizeof(debug_mux_record_t))
+            {
+                debug_mux_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                fprintf(ctx->out, "  mux channel %u frame %u, %zu byte(s)%s\n",
+                        (unsigned)(rec.channel & DEBUG_MUX_CHANNEL_MASK),
+                        (unsigned)rec.seq, len - sizeof(rec),
+                        (0U != (rec.channel & DEBUG_MUX_FLAG_DROPPED)) ?
+                        " after drops" : "");
+            }
+            break;
+
+        case DEBUG_RECORD_PROF:
+            if (len >= sizeof(debug_prof_record_t))
+            {
+                debug_prof_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                if (0U != (rec.flags & DEBUG_PROF_FLAG_NAME))
+                {
+                    fprintf(ctx->out, "  prof thread %u: %.*s\n", (unsigned)rec.thread,
+                            (int)strnlen((const char *)&payload[sizeof(rec)],
+                                         len - sizeof(rec)),
+                            (const char *)&payload[sizeof(rec)]);
+                }
+                else
+                {
+                    fprintf(ctx->out, "  prof thread %u: %u event(s), %lu dropped\n",
+                            (unsigned)rec.thread, (unsigned)rec.count,
+                            (unsigned long)rec.dropped);
+                }
+            }
+            break;
+
+        case DEBUG_RECORD_SAMPLE:
+            if (len >= sizeof(debug_sample_record_t))
+            {
+                debug_sample_record_t rec;
+
+                memcpy(&rec, payload, sizeof(rec));
+                if (0U != (rec.flags & DEBUG_SAMPLE_FLAG_NAME))
+                {
+                    fprintf(ctx->out, "  sample thread %u: %.*s\n", (unsigned)rec.thread,
+                            (int)strnlen((const char *)&payload[sizeof(rec)],
+                                         len - sizeof(rec)),
+                            (const char *)&payload[sizeof(rec)]);
+                }
+                else
+                {
+                    fprintf(ctx->out, "  %u PC sample(s) at %lu Hz, %lu dropped\n",
+                            (unsigned)rec.count, (unsigned long)rec.rate_hz,
+                            (unsigned long)rec.dropped);
+                }
+            }
+            break;
+
+        case DEBUG_RECORD_DICT:
+            debug_wire_define(&ctx->wire, payload, len);
+            break;
+
+        case DEBUG_RECORD_LOG:
+        case DEBUG_RECORD_ARRAY:
+        {
+            char line[4096];
+            int  n = (DEBUG_RECORD_LOG == type) ?
+                     debug_wire_render(&ctx->wire, payload, len, line, sizeof(line)) :
+                     debug_wire_render_array(&ctx->wire, payload, len, line,
+                                             sizeof(line));
+
+            if (n < 0)
+            {
+                fprintf(ctx->out, "[decode] truncated log record (%zu bytes)\n", len);
+            }
+            else
+            {
+                on_text(ctx, line, (size_t)n);
+            }
+            break;
+        }
+
+        default:
+            fprintf(ctx->out, "[decode] record type %u, %zu bytes\n",
+                    (unsigned)type, len);
+            break;
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--elf firmware.elf] [--addr2line tool] [capture]\n"
+            "  Reads the capture (or stdin), prints text lines and decodes\n"
+            "  binary records. --elf enables symbolization.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char  *elf       = NULL;
+    const char  *addr2line = NULL;
+    const char  *path      = NULL;
+    decode_ctx_t ctx       = { .sym = NULL, .out = stdout };
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "--elf")) && ((i + 1) < argc))
+        {
+            elf = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--addr2line")) && ((i + 1) < argc))
+        {
+            addr2line = argv[++i];
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        return 1;
+    }
+
+    if (NULL != elf)
+    {
+        ctx.sym = debug_symbols_open(elf, addr2line);
+        if (NULL == ctx.sym)
+        {
+            fprintf(stderr, "warning: cannot symbolize with %s\n", elf);
+        }
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = on_text, .on_record = on_record };
+
+    debug_line_compact_init(&ctx.compact);
+    if ((0 != debug_wire_init(&ctx.wire)) ||
+        (0 != debug_stream_init(&stream, &cb, &ctx)))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+
+    if (0U != stream.crc_errors)
+    {
+        fprintf(stderr, "%llu record(s) dropped on CRC error\n",
+                (unsigned long long)stream.crc_errors);
+    }
+
+    if ((0U != ctx.wire.unknown) || (0U != ctx.wire.malformed))
+    {
+        fprintf(stderr, "%llu log record(s) with an unknown format, "
+                "%llu with bad arguments\n",
+                (unsigned long long)ctx.wire.unknown,
+                (unsigned long long)ctx.wire.malformed);
+    }
+
+    debug_stream_free(&stream);
+    debug_wire_free(&ctx.wire);
+    debug_symbols_close(ctx.sym);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,571 @@
+/**
+ * @file      debug_demux.c
+ * @brief     Splits a multiplexed debug stream into its channels.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Firmware built with DEBUG_USE_TRANSPORT_MUX carries several channels
+ * over one link as DEBUG_RECORD_MUX frames (see
+ * transport/mux/debug_transport_mux.h). This tool reads that stream from
+ * a capture, stdin or a tty and writes the bytes of each channel to its
+ * own output:
+ *  - a file (or "-" for stdout), e.g. the log channel for debug_decode;
+ *  - unix:PATH, a UNIX stream socket: every subscriber gets the channel
+ *    from the moment it connects. A subscriber that cannot keep up loses
+ *    whole frames (counted) once DEMUX_SUB_BUFFER bytes are queued.
+ *
+ * Lost frames are counted from the per-channel frame counters, and the
+ * writes each channel dropped on the target from the counts the frames
+ * carry after a drop. The counters go to stderr on exit.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o debug_demux \
+ *       debug_demux.c ../common/debug_stream.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   debug_demux [-c CH:TARGET]... [--prefix P] [input]
+ *   debug_demux -c 0:log.bin -c 1:unix:/tmp/telemetry.sock /dev/ttyACM0
+ * @endcode
+ *
+ * The tty must be configured beforehand (e.g. stty -F /dev/ttyACM0 raw).
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+#define DEMUX_CHANNELS      128U        /**< Channel IDs on the wire */
+#define DEMUX_MAX_SUBS      16U         /**< Subscribers per socket */
+#define DEMUX_SUB_BUFFER    (1U << 20)  /**< Queued bytes per subscriber */
+#define DEMUX_READ_SIZE     65536U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Socket subscriber */
+typedef struct
+{
+    int      fd;            /**< -1 = free slot */
+    char    *buf;           /**< Bytes not yet accepted by the socket */
+    size_t   len;
+} demux_sub_t;
+
+/** @brief Channel output and counters */
+typedef struct
+{
+    const char  *target;    /**< As given on the command line */
+    FILE        *file;
+    int          listen_fd; /**< -1 unless unix: */
+    demux_sub_t  subs[DEMUX_MAX_SUBS];
+
+    int          seen;
+    uint8_t      next_seq;
+    uint64_t     frames;
+    uint64_t     bytes;
+    uint64_t     lost;      /**< Frames missing from the counter */
+    uint32_t     dropped;   /**< Writes dropped on the target */
+    uint64_t     sub_dropped;
+} demux_channel_t;
+
+/** @brief Demultiplexer state */
+typedef struct
+{
+    demux_channel_t ch[DEMUX_CHANNELS];
+    const char     *prefix;
+    uint64_t        other;  /**< Lines and records outside channel frames */
+    uint64_t        malformed;
+} demux_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static volatile sig_atomic_t s_stop = 0;
+
+static const char *const s_name[] = { "log", "telemetry", "trace", "command" };
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    s_stop = 1;
+}
+
+static int listen_open(const char *path)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if ((fd < 0) ||
+        (0 != bind(fd, (struct sockaddr *)&addr, sizeof(addr))) ||
+        (0 != listen(fd, 8)))
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Open the output of a channel.
+ */
+static int channel_open(demux_channel_t *c, const char *target)
+{
+    c->target = target;
+
+    if (0 == strncmp(target, "unix:", 5))
+    {
+        c->listen_fd = listen_open(&target[5]);
+        if (c->listen_fd < 0)
+        {
+            perror(&target[5]);
+            return -1;
+        }
+        return 0;
+    }
+
+    c->file = (0 == strcmp(target, "-")) ? stdout : fopen(target, "wb");
+    if (NULL == c->file)
+    {
+        perror(target);
+        return -1;
+    }
+    return 0;
+}
+
+static void sub_close(demux_sub_t *s)
+{
+    close(s->fd);
+    free(s->buf);
+    s->fd  = -1;
+    s->buf = NULL;
+    s->len = 0;
+}
+
+/**
+ * @brief Send queued bytes to a subscriber.
+ */
+static void sub_flush(demux_sub_t *s)
+{
+    while (s->len > 0U)
+    {
+        ssize_t n = send(s->fd, s->buf, s->len, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (n <= 0)
+        {
+            if ((n < 0) && (EAGAIN != errno) && (EINTR != errno))
+            {
+                sub_close(s);
+            }
+            return;
+        }
+        memmove(s->buf, &s->buf[n], s->len - (size_t)n);
+        s->len -= (size_t)n;
+    }
+}
+
+/**
+ * @brief Queue a frame's data for a subscriber, whole or not at all.
+ */
+static void sub_send(demux_channel_t *c, demux_sub_t *s, const uint8_t *data,
+                     size_t len)
+{
+    if ((s->len + len) > DEMUX_SUB_BUFFER)
+    {
+        c->sub_dropped++;
+        return;
+    }
+    if (NULL == s->buf)
+    {
+        s->buf = malloc(DEMUX_SUB_BUFFER);
+        if (NULL == s->buf)
+        {
+            c->sub_dropped++;
+            return;
+        }
+    }
+    memcpy(&s->buf[s->len], data, len);
+    s->len += len;
+    sub_flush(s);
+}
+
+static void sub_accept(demux_channel_t *c)
+{
+    int fd = accept4(c->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return;
+    }
+    for (unsigned i = 0; i < DEMUX_MAX_SUBS; i++)
+    {
+        if (c->subs[i].fd < 0)
+        {
+            c->subs[i].fd = fd;
+            return;
+        }
+    }
+    close(fd);      /* No free slot */
+}
+
+static void on_text(void *user, const char *line, size_t len)
+{
+    demux_t *d = user;
+
+    (void)line;
+    (void)len;
+    d->other++;
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    demux_t           *d = user;
+    debug_mux_record_t hdr;
+
+    if (DEBUG_RECORD_MUX != type)
+    {
+        d->other++;
+        return;
+    }
+    if (len < sizeof(hdr))
+    {
+        d->malformed++;
+        return;
+    }
+    memcpy(&hdr, payload, sizeof(hdr));
+    payload += sizeof(hdr);
+    len     -= sizeof(hdr);
+
+    demux_channel_t *c = &d->ch[hdr.channel & DEBUG_MUX_CHANNEL_MASK];
+
+    if (0U != (hdr.channel & DEBUG_MUX_FLAG_DROPPED))
+    {
+        if (len < sizeof(uint32_t))
+        {
+            d->malformed++;
+            return;
+        }
+        memcpy(&c->dropped, payload, sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+        len     -= sizeof(uint32_t);
+    }
+
+    if ((0 != c->seen) && (hdr.seq != c->next_seq))
+    {
+        c->lost += (uint8_t)(hdr.seq - c->next_seq);
+    }
+    c->seen     = 1;
+    c->next_seq = (uint8_t)(hdr.seq + 1U);
+    c->frames++;
+    c->bytes   += len;
+
+    /* Channels without -c go to PREFIX<ch>.bin, if a prefix was given */
+    if ((NULL == c->file) && (c->listen_fd < 0) && (NULL == c->target) &&
+        (NULL != d->prefix))
+    {
+        char *path = NULL;
+
+        if ((asprintf(&path, "%s%u.bin", d->prefix,
+                      (unsigned)(hdr.channel & DEBUG_MUX_CHANNEL_MASK)) < 0) ||
+            (0 != channel_open(c, path)))
+        {
+            free(path);
+            c->target = "";     /* Do not retry */
+        }
+    }
+
+    if (NULL != c->file)
+    {
+        fwrite(payload, 1, len, c->file);
+    }
+    for (unsigned i = 0; i < DEMUX_MAX_SUBS; i++)
+    {
+        if (c->subs[i].fd >= 0)
+        {
+            sub_send(c, &c->subs[i], payload, len);
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-c CH:TARGET]... [--prefix P] [input]\n"
+            "  Splits a multiplexed debug stream (file, tty or stdin) into\n"
+            "  channels. TARGET is a file, - for stdout, or unix:PATH for a\n"
+            "  socket. With --prefix, other channels go to P<CH>.bin.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    demux_t    *d    = calloc(1, sizeof(*d));
+
+    if (NULL == d)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (unsigned i = 0; i < DEMUX_CHANNELS; i++)
+    {
+        d->ch[i].listen_fd = -1;
+        for (unsigned j = 0; j < DEMUX_MAX_SUBS; j++)
+        {
+            d->ch[i].subs[j].fd = -1;
+        }
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(argv[i], "-c")) && (NULL != val))
+        {
+            char         *end;
+            unsigned long ch = strtoul(argv[++i], &end, 0);
+
+            if ((':' != *end) || (ch >= DEMUX_CHANNELS) ||
+                (0 != channel_open(&d->ch[ch], end + 1)))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if ((0 == strcmp(argv[i], "--prefix")) && (NULL != val))
+        {
+            d->prefix = argv[++i];
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    int in = (NULL != path) ? open(path, O_RDONLY | O_CLOEXEC) : STDIN_FILENO;
+    if (in < 0)
+    {
+        perror(path);
+        return 1;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = on_text, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, d))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    static uint8_t buf[DEMUX_READ_SIZE];
+    struct pollfd  pfd[1U + (DEMUX_CHANNELS * (1U + DEMUX_MAX_SUBS))];
+
+    while (0 == s_stop)
+    {
+        nfds_t n = 0;
+
+        pfd[n++] = (struct pollfd){ .fd = in, .events = POLLIN };
+        for (unsigned i = 0; i < DEMUX_CHANNELS; i++)
+        {
+            demux_channel_t *c = &d->ch[i];
+
+            if (c->listen_fd < 0)
+            {
+                continue;
+            }
+            pfd[n++] = (struct pollfd){ .fd = c->listen_fd, .events = POLLIN };
+            for (unsigned j = 0; j < DEMUX_MAX_SUBS; j++)
+            {
+                if (c->subs[j].fd >= 0)
+                {
+                    pfd[n++] = (struct pollfd){
+                        .fd     = c->subs[j].fd,
+                        .events = (c->subs[j].len > 0U) ? POLLOUT : 0 };
+                }
+            }
+        }
+
+        if (poll(pfd, n, -1) < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            perror("poll");
+            break;
+        }
+
+        /* Sockets: new subscribers, queued data, hang-ups */
+        for (unsigned i = 0; i < DEMUX_CHANNELS; i++)
+        {
+            demux_channel_t *c = &d->ch[i];
+
+            if (c->listen_fd < 0)
+            {
+                continue;
+            }
+            sub_accept(c);
+            for (unsigned j = 0; j < DEMUX_MAX_SUBS; j++)
+            {
+                if (c->subs[j].fd >= 0)
+                {
+                    sub_flush(&c->subs[j]);
+                }
+            }
+        }
+        for (nfds_t k = 1; k < n; k++)
+        {
+            if (0 != (pfd[k].revents & (POLLHUP | POLLERR)))
+            {
+                for (unsigned i = 0; i < DEMUX_CHANNELS; i++)
+                {
+                    for (unsigned j = 0; j < DEMUX_MAX_SUBS; j++)
+                    {
+                        if (d->ch[i].subs[j].fd == pfd[k].fd)
+                        {
+                            sub_close(&d->ch[i].subs[j]);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (0 == (pfd[0].revents & (POLLIN | POLLHUP | POLLERR)))
+        {
+            continue;
+        }
+
+        ssize_t got = read(in, buf, sizeof(buf));
+
+        if (got < 0)
+        {
+            if ((EINTR == errno) || (EAGAIN == errno))
+            {
+                continue;
+            }
+            perror("read");
+            break;
+        }
+        if (0 == got)
+        {
+            break;      /* End of input */
+        }
+        debug_stream_feed(&stream, buf, (size_t)got);
+    }
+    debug_stream_finish(&stream);
+
+    for (unsigned i = 0; i < DEMUX_CHANNELS; i++)
+    {
+        demux_channel_t *c = &d->ch[i];
+
+        if (0 == c->seen)
+        {
+            continue;
+        }
+        fprintf(stderr, "channel %3u %-9s  %10llu bytes  %8llu frames  "
+                        "%llu lost  %lu dropped on the target",
+                i, (i < (sizeof(s_name) / sizeof(s_name[0]))) ? s_name[i] : "",
+                (unsigned long long)c->bytes, (unsigned long long)c->frames,
+                (unsigned long long)c->lost, (unsigned long)c->dropped);
+        if (0U != c->sub_dropped)
+        {
+            fprintf(stderr, "  %llu frames not delivered to subscribers",
+                    (unsigned long long)c->sub_dropped);
+        }
+        fputc('\n', stderr);
+
+        if ((NULL != c->file) && (stdout != c->file))
+        {
+            fclose(c->file);
+        }
+        for (unsigned j = 0; j < DEMUX_MAX_SUBS; j++)
+        {
+            if (c->subs[j].fd >= 0)
+            {
+                sub_close(&c->subs[j]);
+            }
+        }
+        if (c->listen_fd >= 0)
+        {
+            close(c->listen_fd);
+            unlink(&c->target[5]);
+        }
+    }
+    if ((0U != d->other) || (0U != d->malformed) || (0U != stream.crc_errors))
+    {
+        fprintf(stderr, "%llu line(s)/record(s) outside channel frames, "
+                        "%llu malformed frame(s), %llu CRC error(s)\n",
+                (unsigned long long)d->other, (unsigned long long)d->malformed,
+                (unsigned long long)stream.crc_errors);
+    }
+
+    debug_stream_free(&stream);
+    if (STDIN_FILENO != in)
+    {
+        close(in);
+    }
+    free(d);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
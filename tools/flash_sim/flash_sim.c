@@ -0,0 +1,426 @@
+/**
+ * @file      flash_sim.c
+ * @brief     Host benchmark and power-fail test for the flash log sink.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Runs transport/flash/debug_flash_log.c against the file-backed NOR
+ * stand-in (debug_flash_file.c).
+ *
+ * Commands:
+ *  - bench    : append synthetic log lines, report throughput, page and
+ *               erase counts, write amplification and wear spread
+ *  - powercut : repeatedly cut power at a random program/erase, remount
+ *               and verify that the recovered log is ordered, uncorrupted
+ *               and contains everything flushed before the cut
+ *  - dump     : write the stored log to stdout (pipe into debug_decode)
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../../transport/flash -o flash_sim \
+ *       flash_sim.c ../../transport/flash/debug_flash_log.c \
+ *       ../../transport/flash/debug_flash_file.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   flash_sim bench    [--sector-size N] [--sectors N] [--page N] [--mb N] image
+ *   flash_sim powercut [--sector-size N] [--sectors N] [--page N]
+ *                      [--cycles N] [--seed N] image
+ *   flash_sim dump     [--sector-size N] [--sectors N] [--page N] image
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "debug_flash_log.h"
+#include "debug_flash_file.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Largest supported geometry */
+#define SIM_MAX_SECTORS   4096U
+#define SIM_MAX_PAGE      4096U
+
+/** @brief Length of a synthetic line: "L%010u %08x\n" */
+#define SIM_LINE_LEN      21U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Command line options */
+typedef struct
+{
+    uint32_t    sector_size;
+    uint32_t    sectors;
+    uint32_t    page;
+    uint32_t    mb;
+    uint32_t    cycles;
+    uint32_t    seed;
+    const char *image;
+} sim_opts_t;
+
+/** @brief Result of verifying a recovered log */
+typedef struct
+{
+    char     line[64];   /**< Partial line */
+    size_t   len;        /**< Bytes in line */
+    uint64_t valid;      /**< Well-formed lines */
+    uint64_t torn;       /**< Malformed lines (pages lost to cuts) */
+    uint64_t disorder;   /**< Lines out of order (must stay 0) */
+    int64_t  last;       /**< Highest line number seen (-1 = none) */
+} sim_verify_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static debug_flash_sector_t s_sectors[SIM_MAX_SECTORS];
+static uint8_t              s_page[SIM_MAX_PAGE];
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static uint32_t sim_hash(uint32_t n)
+{
+    return n * 2654435761UL;
+}
+
+static size_t sim_line(char *buf, uint32_t n)
+{
+    snprintf(buf, SIM_LINE_LEN + 1U, "L%010lu %08lx\n", (unsigned long)n,
+             (unsigned long)sim_hash(n));
+    return SIM_LINE_LEN;
+}
+
+static double sim_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static void sim_verify_line(sim_verify_t *v)
+{
+    unsigned long n = 0;
+    unsigned long h = 0;
+    char          tail = 0;
+
+    v->line[v->len] = '\0';
+
+    if ((SIM_LINE_LEN - 1U == v->len) &&
+        (2 == sscanf(v->line, "L%10lu %8lx%c", &n, &h, &tail)) &&
+        (sim_hash((uint32_t)n) == (uint32_t)h))
+    {
+        if ((int64_t)n <= v->last)
+        {
+            v->disorder++;
+        }
+        v->last = (int64_t)n;
+        v->valid++;
+    }
+    else
+    {
+        v->torn++;
+    }
+
+    v->len = 0;
+}
+
+static int sim_verify_sink(void *user, const uint8_t *data, size_t len)
+{
+    sim_verify_t *v = user;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if ('\n' == data[i])
+        {
+            sim_verify_line(v);
+        }
+        else if (v->len < (sizeof(v->line) - 1U))
+        {
+            v->line[v->len++] = (char)data[i];
+        }
+    }
+
+    return 0;
+}
+
+static int sim_stdout_sink(void *user, const uint8_t *data, size_t len)
+{
+    (void)user;
+    return (fwrite(data, 1, len, stdout) == len) ? 0 : 1;
+}
+
+static int sim_mount(const sim_opts_t *o, debug_flash_file_t *flash,
+                     debug_flash_log_t *log)
+{
+    if (0 != debug_flash_file_open(flash, o->image, o->sector_size, o->sectors,
+                                   o->page))
+    {
+        fprintf(stderr, "flash_sim: cannot open %s\n", o->image);
+        return -1;
+    }
+
+    if (0 != debug_flash_log_mount(log, &flash->dev, s_sectors, s_page))
+    {
+        fprintf(stderr, "flash_sim: mount failed\n");
+        debug_flash_file_close(flash);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int sim_bench(const sim_opts_t *o)
+{
+    debug_flash_file_t flash;
+    debug_flash_log_t  log;
+
+    if (0 != sim_mount(o, &flash, &log))
+    {
+        return 1;
+    }
+    (void)debug_flash_log_format(&log);
+
+    const uint64_t target = (uint64_t)o->mb * 1024U * 1024U;
+    uint64_t bytes = 0;
+    uint32_t n = 0;
+    char     line[SIM_LINE_LEN + 1U];
+    double   t0 = sim_now();
+
+    flash.programs = 0;
+    flash.erases = 0;
+    flash.programmed = 0;
+
+    while (bytes < target)
+    {
+        size_t len = sim_line(line, n++);
+
+        bytes += debug_flash_log_append(&log, (const uint8_t *)line, len);
+
+        /* Idle time between bursts: keep a spare sector ready */
+        if (0U == (n % 64U))
+        {
+            (void)debug_flash_log_service(&log);
+        }
+    }
+    (void)debug_flash_log_flush(&log);
+
+    double   dt = sim_now() - t0;
+    uint32_t ec_min = UINT32_MAX;
+    uint32_t ec_max = 0;
+
+    for (uint32_t i = 0; i < o->sectors; i++)
+    {
+        ec_min = (s_sectors[i].erase_count < ec_min) ? s_sectors[i].erase_count : ec_min;
+        ec_max = (s_sectors[i].erase_count > ec_max) ? s_sectors[i].erase_count : ec_max;
+    }
+
+    printf("appended      %llu bytes in %.3f s (%.1f MB/s)\n",
+           (unsigned long long)bytes, dt, ((double)bytes / 1e6) / dt);
+    printf("programs      %llu, %lu bytes dropped\n",
+           (unsigned long long)flash.programs,
+           (unsigned long)log.stats.bytes_dropped);
+    printf("erases        %llu\n", (unsigned long long)flash.erases);
+    printf("amplification %.3f (programmed / appended)\n",
+           (double)flash.programmed / (double)bytes);
+    printf("wear          erase count min %lu max %lu\n",
+           (unsigned long)ec_min, (unsigned long)ec_max);
+
+    debug_flash_file_close(&flash);
+    return 0;
+}
+
+static int sim_powercut(const sim_opts_t *o)
+{
+    debug_flash_file_t flash;
+    debug_flash_log_t  log;
+    uint32_t next = 0;
+    int64_t  durable = -1;
+    uint64_t torn = 0;
+    uint32_t rng = (0U != o->seed) ? o->seed : 1U;
+    char     line[SIM_LINE_LEN + 1U];
+
+    if (0 != sim_mount(o, &flash, &log))
+    {
+        return 1;
+    }
+    (void)debug_flash_log_format(&log);
+    debug_flash_file_close(&flash);
+
+    for (uint32_t cycle = 0; cycle < o->cycles; cycle++)
+    {
+        if (0 != sim_mount(o, &flash, &log))
+        {
+            fprintf(stderr, "cycle %lu: FAIL, log does not mount\n",
+                    (unsigned long)cycle);
+            return 1;
+        }
+
+        sim_verify_t v = { .last = -1 };
+        if (debug_flash_log_dump(&log, sim_verify_sink, &v) < 0)
+        {
+            fprintf(stderr, "cycle %lu: FAIL, dump error\n", (unsigned long)cycle);
+            return 1;
+        }
+
+        if ((0U != v.disorder) || (v.last < durable))
+        {
+            fprintf(stderr, "cycle %lu: FAIL, disorder %llu, last %lld, "
+                    "durable %lld\n", (unsigned long)cycle,
+                    (unsigned long long)v.disorder, (long long)v.last,
+                    (long long)durable);
+            return 1;
+        }
+        torn += v.torn;
+
+        /* Cut power somewhere within the next couple of sectors */
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        uint32_t ops = 1U + (rng % (2U * (o->sector_size / o->page)));
+        debug_flash_file_power_cut(&flash, ops, rng);
+
+        while (0 == flash.dead)
+        {
+            size_t len = sim_line(line, next);
+
+            (void)debug_flash_log_append(&log, (const uint8_t *)line, len);
+            next++;
+
+            if ((0U == (next % 8U)) && (0 == debug_flash_log_flush(&log)) &&
+                (0 == flash.dead))
+            {
+                durable = (int64_t)next - 1;
+            }
+            if (0U == (next % 16U))
+            {
+                (void)debug_flash_log_service(&log);
+            }
+        }
+
+        debug_flash_file_close(&flash);
+    }
+
+    printf("powercut: %lu cycles OK, %lu lines written, %llu torn lines\n",
+           (unsigned long)o->cycles, (unsigned long)next,
+           (unsigned long long)torn);
+    return 0;
+}
+
+static int sim_dump(const sim_opts_t *o)
+{
+    debug_flash_file_t flash;
+    debug_flash_log_t  log;
+
+    if (0 != sim_mount(o, &flash, &log))
+    {
+        return 1;
+    }
+
+    long n = debug_flash_log_dump(&log, sim_stdout_sink, NULL);
+    debug_flash_file_close(&flash);
+
+    return (n < 0) ? 1 : 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s bench|powercut|dump [--sector-size N] [--sectors N]\n"
+            "          [--page N] [--mb N] [--cycles N] [--seed N] image\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    sim_opts_t o = { .sector_size = 4096U, .sectors = 16U, .page = 256U,
+                     .mb = 16U, .cycles = 200U, .seed = 1U, .image = NULL };
+
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (int i = 2; i < argc; i++)
+    {
+        uint32_t *opt = NULL;
+
+        if (0 == strcmp(argv[i], "--sector-size"))  opt = &o.sector_size;
+        else if (0 == strcmp(argv[i], "--sectors")) opt = &o.sectors;
+        else if (0 == strcmp(argv[i], "--page"))    opt = &o.page;
+        else if (0 == strcmp(argv[i], "--mb"))      opt = &o.mb;
+        else if (0 == strcmp(argv[i], "--cycles"))  opt = &o.cycles;
+        else if (0 == strcmp(argv[i], "--seed"))    opt = &o.seed;
+
+        if (NULL != opt)
+        {
+            if ((i + 1) >= argc)
+            {
+                usage(argv[0]);
+                return 2;
+            }
+            *opt = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            o.image = argv[i];
+        }
+    }
+
+    if ((NULL == o.image) || (o.sectors > SIM_MAX_SECTORS) ||
+        (o.page > SIM_MAX_PAGE))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (0 == strcmp(argv[1], "bench"))
+    {
+        return sim_bench(&o);
+    }
+    if (0 == strcmp(argv[1], "powercut"))
+    {
+        return sim_powercut(&o);
+    }
+    if (0 == strcmp(argv[1], "dump"))
+    {
+        return sim_dump(&o);
+    }
+
+    usage(argv[0]);
+    return 2;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,621 @@
+/**
+ * @file      heap_replay.c
+ * @brief     Replays heap trace records into usage and leak reports.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Rebuilds the live heap from the DEBUG_RECORD_HEAP records of a capture
+ * (see core/debug_heap.h) and reports:
+ *  - allocation, free and failure counts, frees of unknown blocks
+ *    (double frees, or blocks allocated before the capture started);
+ *  - live bytes and blocks at the end, and the peak with its timestamp;
+ *  - leak candidates: blocks still live at the end, grouped by the
+ *    allocating caller and thread, largest first. --min-age skips blocks
+ *    allocated in the last TICKS of the capture, which are usually just
+ *    in use;
+ *  - optionally (--timeline) a CSV of live bytes and blocks over time.
+ *
+ * With --elf, callers are symbolized through addr2line.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o heap_replay \
+ *       heap_replay.c ../common/debug_stream.c ../common/debug_symbols.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   heap_replay [--elf firmware.elf] [--addr2line tool] [--top N]
+ *               [--min-age TICKS] [--timeline out.csv [--interval TICKS]]
+ *               [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+#include "debug_symbols.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Thread table size (indexes are one byte) */
+#define REPLAY_THREADS  256U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Live block (hash table entry; addr 0 = empty) */
+typedef struct
+{
+    uint64_t addr;
+    uint64_t size;
+    uint64_t caller;
+    uint64_t ts;
+    uint8_t  thread;
+    uint8_t  gone;      /**< Freed (tombstone) */
+} replay_block_t;
+
+/** @brief Leak group */
+typedef struct
+{
+    uint64_t caller;
+    uint8_t  thread;
+    uint64_t blocks;
+    uint64_t bytes;
+    uint64_t oldest;
+} replay_group_t;
+
+/** @brief Replay state */
+typedef struct
+{
+    replay_block_t  *table;
+    size_t           cap;       /**< Power of two */
+    size_t           used;      /**< Live + tombstones */
+
+    uint64_t         now;       /**< Unwrapped timestamp of the last event */
+    uint32_t         last_raw;
+    int              started;
+
+    uint64_t         allocs;
+    uint64_t         frees;
+    uint64_t         failed;
+    uint64_t         unknown_frees;
+    uint64_t         live_bytes;
+    uint64_t         live_blocks;
+    uint64_t         peak_bytes;
+    uint64_t         peak_ts;
+    uint32_t         dropped;
+    uint64_t         malformed;
+
+    char             thread[REPLAY_THREADS][DEBUG_RECORD_NAME_LEN + 1U];
+
+    FILE            *timeline;
+    uint64_t         interval;
+    uint64_t         next_row;
+} replay_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static size_t replay_hash(uint64_t addr, size_t cap)
+{
+    addr ^= addr >> 33;
+    addr *= 0xFF51AFD7ED558CCDULL;
+    addr ^= addr >> 33;
+    return (size_t)addr & (cap - 1U);
+}
+
+static int replay_grow(replay_ctx_t *ctx)
+{
+    size_t          cap   = (0U != ctx->cap) ? (ctx->cap * 2U) : 4096U;
+    replay_block_t *table = calloc(cap, sizeof(*table));
+
+    if (NULL == table)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < ctx->cap; i++)
+    {
+        const replay_block_t *b = &ctx->table[i];
+
+        if ((0U != b->addr) && (0U == b->gone))
+        {
+            size_t h = replay_hash(b->addr, cap);
+
+            while (0U != table[h].addr)
+            {
+                h = (h + 1U) & (cap - 1U);
+            }
+            table[h] = *b;
+        }
+    }
+
+    free(ctx->table);
+    ctx->table = table;
+    ctx->cap   = cap;
+    ctx->used  = ctx->live_blocks;
+    return 0;
+}
+
+/**
+ * @brief Find the live block at an address.
+ */
+static replay_block_t *replay_find(replay_ctx_t *ctx, uint64_t addr)
+{
+    if (0U == ctx->cap)
+    {
+        return NULL;
+    }
+
+    for (size_t h = replay_hash(addr, ctx->cap); 0U != ctx->table[h].addr;
+         h = (h + 1U) & (ctx->cap - 1U))
+    {
+        if ((ctx->table[h].addr == addr) && (0U == ctx->table[h].gone))
+        {
+            return &ctx->table[h];
+        }
+    }
+    return NULL;
+}
+
+static void replay_timeline(replay_ctx_t *ctx)
+{
+    if ((NULL == ctx->timeline) || (ctx->now < ctx->next_row))
+    {
+        return;
+    }
+    fprintf(ctx->timeline, "%llu,%llu,%llu\n", (unsigned long long)ctx->now,
+            (unsigned long long)ctx->live_bytes,
+            (unsigned long long)ctx->live_blocks);
+    ctx->next_row = ctx->now + ctx->interval;
+}
+
+static void replay_alloc(replay_ctx_t *ctx, uint64_t addr, uint64_t size,
+                         uint64_t caller, uint8_t thread)
+{
+    ctx->allocs++;
+    if (0U == addr)
+    {
+        ctx->failed++;
+        return;
+    }
+
+    replay_block_t *b = replay_find(ctx, addr);
+
+    if (NULL != b)
+    {
+        /* Free lost (dropped event): replace the stale block */
+        ctx->live_bytes -= b->size;
+        ctx->live_blocks--;
+        b->gone = 1;
+    }
+
+    if (((ctx->used + 1U) * 2U) > ctx->cap)
+    {
+        if (0 != replay_grow(ctx))
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    size_t h = replay_hash(addr, ctx->cap);
+
+    while (0U != ctx->table[h].addr)
+    {
+        h = (h + 1U) & (ctx->cap - 1U);
+    }
+    ctx->table[h] = (replay_block_t){ .addr = addr, .size = size,
+                                      .caller = caller, .ts = ctx->now,
+                                      .thread = thread };
+    ctx->used++;
+
+    ctx->live_bytes += size;
+    ctx->live_blocks++;
+    if (ctx->live_bytes > ctx->peak_bytes)
+    {
+        ctx->peak_bytes = ctx->live_bytes;
+        ctx->peak_ts    = ctx->now;
+    }
+}
+
+static void replay_free(replay_ctx_t *ctx, uint64_t addr)
+{
+    replay_block_t *b = replay_find(ctx, addr);
+
+    ctx->frees++;
+    if (NULL == b)
+    {
+        ctx->unknown_frees++;
+        return;
+    }
+    ctx->live_bytes -= b->size;
+    ctx->live_blocks--;
+    b->gone = 1;
+}
+
+static int replay_uvar(const uint8_t *p, size_t len, size_t *pos, uint64_t *v)
+{
+    unsigned shift = 0;
+
+    *v = 0;
+    while ((*pos < len) && (shift < 64U))
+    {
+        uint8_t b = p[(*pos)++];
+
+        *v |= (uint64_t)(b & 0x7FU) << shift;
+        if (0U == (b & 0x80U))
+        {
+            return 0;
+        }
+        shift += 7U;
+    }
+    return -1;
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    replay_ctx_t       *ctx = user;
+    debug_heap_record_t rec;
+
+    if ((DEBUG_RECORD_HEAP != type) || (len < sizeof(rec)))
+    {
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+    ctx->dropped = rec.dropped;
+
+    /* Timestamps are 32-bit; carry the unwrapped time across records */
+    if (0 == ctx->started)
+    {
+        ctx->started  = 1;
+        ctx->now      = rec.timestamp;
+        ctx->next_row = 0;
+    }
+    else
+    {
+        ctx->now += (uint64_t)(int64_t)(int32_t)(rec.timestamp - ctx->last_raw);
+    }
+    ctx->last_raw = rec.timestamp;
+
+    size_t pos = sizeof(rec);
+
+    for (unsigned i = 0; i < rec.count; i++)
+    {
+        if ((pos + 2U) > len)
+        {
+            ctx->malformed++;
+            return;
+        }
+
+        uint8_t ev     = payload[pos++];
+        uint8_t thread = payload[pos++];
+
+        if (DEBUG_HEAP_THREAD == ev)
+        {
+            size_t n = (pos < len) ? payload[pos++] : 0U;
+
+            if (((pos + n) > len) || (n > DEBUG_RECORD_NAME_LEN))
+            {
+                ctx->malformed++;
+                return;
+            }
+            memcpy(ctx->thread[thread], &payload[pos], n);
+            ctx->thread[thread][n] = '\0';
+            pos += n;
+            continue;
+        }
+
+        uint64_t zz, addr, size, caller;
+
+        if ((0 != replay_uvar(payload, len, &pos, &zz)) ||
+            (0 != replay_uvar(payload, len, &pos, &addr)) ||
+            (0 != replay_uvar(payload, len, &pos, &size)) ||
+            (0 != replay_uvar(payload, len, &pos, &caller)))
+        {
+            ctx->malformed++;
+            return;
+        }
+
+        int64_t delta = (int64_t)(zz >> 1) ^ -(int64_t)(zz & 1U);
+
+        ctx->now      += (uint64_t)delta;
+        ctx->last_raw += (uint32_t)delta;
+
+        if (DEBUG_HEAP_ALLOC == ev)
+        {
+            replay_alloc(ctx, addr, size, caller, thread);
+        }
+        else if (DEBUG_HEAP_FREE == ev)
+        {
+            replay_free(ctx, addr);
+        }
+        replay_timeline(ctx);
+    }
+}
+
+static int replay_by_bytes(const void *a, const void *b)
+{
+    const replay_group_t *x = a;
+    const replay_group_t *y = b;
+
+    return (x->bytes < y->bytes) - (x->bytes > y->bytes);
+}
+
+static int replay_by_site(const void *a, const void *b)
+{
+    const replay_block_t *x = a;
+    const replay_block_t *y = b;
+
+    if (x->caller != y->caller)
+    {
+        return (x->caller > y->caller) - (x->caller < y->caller);
+    }
+    return (int)x->thread - (int)y->thread;
+}
+
+/**
+ * @brief Print the blocks still live, grouped by caller and thread.
+ */
+static void replay_leaks(replay_ctx_t *ctx, debug_symbols_t *sym, size_t top,
+                         uint64_t min_age)
+{
+    replay_block_t *live = malloc((ctx->live_blocks + 1U) * sizeof(*live));
+    replay_group_t *grp  = malloc((ctx->live_blocks + 1U) * sizeof(*grp));
+    size_t          n    = 0;
+    size_t          g    = 0;
+
+    if ((NULL == live) || (NULL == grp))
+    {
+        free(live);
+        free(grp);
+        return;
+    }
+
+    for (size_t i = 0; i < ctx->cap; i++)
+    {
+        const replay_block_t *b = &ctx->table[i];
+
+        if ((0U != b->addr) && (0U == b->gone) &&
+            ((b->ts + min_age) <= ctx->now))
+        {
+            live[n++] = *b;
+        }
+    }
+    qsort(live, n, sizeof(*live), replay_by_site);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if ((0U == g) || (grp[g - 1U].caller != live[i].caller) ||
+            (grp[g - 1U].thread != live[i].thread))
+        {
+            grp[g++] = (replay_group_t){ .caller = live[i].caller,
+                                         .thread = live[i].thread,
+                                         .oldest = live[i].ts };
+        }
+        grp[g - 1U].blocks++;
+        grp[g - 1U].bytes += live[i].size;
+        if (live[i].ts < grp[g - 1U].oldest)
+        {
+            grp[g - 1U].oldest = live[i].ts;
+        }
+    }
+    qsort(grp, g, sizeof(*grp), replay_by_bytes);
+
+    printf("\nleak candidates (%zu block(s) live", n);
+    if (0U != min_age)
+    {
+        printf(" for at least %llu ticks", (unsigned long long)min_age);
+    }
+    printf("):\n  %10s  %7s  %12s  %-16s  %s\n", "BYTES", "BLOCKS", "OLDEST",
+           "THREAD", "CALLER");
+
+    for (size_t i = 0; (i < g) && (i < top); i++)
+    {
+        const replay_group_t *r = &grp[i];
+        char func[256] = "";
+        char loc[512]  = "";
+        char thread[32];
+
+        if (DEBUG_HEAP_NO_THREAD == r->thread)
+        {
+            snprintf(thread, sizeof(thread), "?");
+        }
+        else if ('\0' != ctx->thread[r->thread][0])
+        {
+            snprintf(thread, sizeof(thread), "%s", ctx->thread[r->thread]);
+        }
+        else
+        {
+            snprintf(thread, sizeof(thread), "#%u", (unsigned)r->thread);
+        }
+
+        /* The caller is a return address; look up the call itself */
+        debug_symbols_lookup(sym, (r->caller > 1U) ? (r->caller & ~1ULL) - 1U :
+                                                     r->caller,
+                             func, sizeof(func), loc, sizeof(loc));
+        printf("  %10llu  %7llu  %12llu  %-16s  0x%08llx  %s (%s)\n",
+               (unsigned long long)r->bytes, (unsigned long long)r->blocks,
+               (unsigned long long)r->oldest, thread,
+               (unsigned long long)r->caller, func, loc);
+    }
+
+    free(live);
+    free(grp);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--elf firmware.elf] [--addr2line tool] [--top N]\n"
+            "          [--min-age TICKS] [--timeline out.csv [--interval TICKS]]\n"
+            "          [capture]\n"
+            "  Replays the heap trace records of the capture (or stdin) and\n"
+            "  reports peak usage and blocks never freed.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char   *elf       = NULL;
+    const char   *addr2line = NULL;
+    const char   *path      = NULL;
+    const char   *timeline  = NULL;
+    size_t        top       = 20;
+    uint64_t      min_age   = 0;
+    replay_ctx_t *ctx       = calloc(1, sizeof(*ctx));
+
+    if (NULL == ctx)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(argv[i], "--elf")) && (NULL != val))
+        {
+            elf = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--addr2line")) && (NULL != val))
+        {
+            addr2line = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--top")) && (NULL != val))
+        {
+            top = (size_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--min-age")) && (NULL != val))
+        {
+            min_age = strtoull(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--timeline")) && (NULL != val))
+        {
+            timeline = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--interval")) && (NULL != val))
+        {
+            ctx->interval = strtoull(argv[++i], NULL, 0);
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            free(ctx);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        free(ctx);
+        return 1;
+    }
+    if (NULL != timeline)
+    {
+        ctx->timeline = fopen(timeline, "w");
+        if (NULL == ctx->timeline)
+        {
+            perror(timeline);
+            free(ctx);
+            return 1;
+        }
+        fprintf(ctx->timeline, "timestamp,live_bytes,live_blocks\n");
+    }
+
+    debug_symbols_t *sym = NULL;
+
+    if (NULL != elf)
+    {
+        sym = debug_symbols_open(elf, addr2line);
+        if (NULL == sym)
+        {
+            fprintf(stderr, "warning: cannot symbolize with %s\n", elf);
+        }
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, ctx))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(ctx);
+        return 1;
+    }
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+
+    printf("allocations    %llu (%llu failed)\n"
+           "frees          %llu (%llu of unknown blocks)\n"
+           "live at end    %llu bytes in %llu block(s)\n"
+           "peak           %llu bytes at %llu\n"
+           "dropped        %lu event(s) on the target\n",
+           (unsigned long long)ctx->allocs, (unsigned long long)ctx->failed,
+           (unsigned long long)ctx->frees, (unsigned long long)ctx->unknown_frees,
+           (unsigned long long)ctx->live_bytes, (unsigned long long)ctx->live_blocks,
+           (unsigned long long)ctx->peak_bytes, (unsigned long long)ctx->peak_ts,
+           (unsigned long)ctx->dropped);
+    if ((0U != ctx->malformed) || (0U != stream.crc_errors))
+    {
+        printf("malformed      %llu record(s), %llu dropped on CRC error\n",
+               (unsigned long long)ctx->malformed,
+               (unsigned long long)stream.crc_errors);
+    }
+
+    replay_leaks(ctx, sym, top, min_age);
+
+    debug_stream_free(&stream);
+    debug_symbols_close(sym);
+    if (NULL != ctx->timeline)
+    {
+        fclose(ctx->timeline);
+    }
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+    free(ctx->table);
+    free(ctx);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
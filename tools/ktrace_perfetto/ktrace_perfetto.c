@@ -0,0 +1,551 @@
+/**
+ * @file      ktrace_perfetto.c
+ * @brief     Kernel trace records to a Perfetto / Chrome JSON trace.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Converts the DEBUG_RECORD_KTRACE records of a capture (see
+ * port/freertos/debug_freertos_trace.h) into the JSON trace event format,
+ * which ui.perfetto.dev and chrome://tracing open directly:
+ *
+ *  - "CPU" track: one slice per time a task ran, named after the task.
+ *  - One track per task: its running slices, plus instant events for the
+ *    queue, semaphore, mutex and notification calls it made.
+ *  - One track per interrupt: enter to exit slices, plus the ISR API
+ *    calls made from it.
+ *
+ * Task names come from the create events, so tasks created before the
+ * capture started are shown by address. The 32-bit cycle timestamps are
+ * unwrapped, so a capture may last any time as long as the ring is drained
+ * more often than the counter wraps (25 s at 168 MHz).
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o ktrace_perfetto \
+ *       ktrace_perfetto.c ../common/debug_stream.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   ktrace_perfetto [-o trace.json] [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Trace process ids */
+#define PID_TASKS       1
+#define PID_IRQS        2
+
+/** @brief Thread id of the CPU track */
+#define TID_CPU         0
+
+/** @brief Deepest interrupt nesting tracked */
+#define IRQ_NEST_MAX    16U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Known task */
+typedef struct
+{
+    uint32_t tcb;                       /**< Task handle on the target */
+    char     name[32];                  /**< Name from the create events */
+    size_t   name_len;                  /**< Bytes of name received */
+    int      named;                     /**< Metadata event written */
+} kt_task_t;
+
+/** @brief Converter state */
+typedef struct
+{
+    FILE      *out;
+    int        first;                   /**< No event written yet */
+    kt_task_t *task;
+    size_t     tasks;
+    size_t     task_cap;
+    uint32_t   hz;                      /**< Cycle counter rate */
+    int        started;                 /**< A timestamp has been seen */
+    uint32_t   last_cycles;             /**< Last raw timestamp */
+    uint64_t   now;                     /**< Unwrapped cycles since the first event */
+    uint32_t   running;                 /**< Task switched in (0 = none) */
+    uint64_t   running_since;
+    uint32_t   irq[IRQ_NEST_MAX];       /**< Active interrupt numbers */
+    uint64_t   irq_since[IRQ_NEST_MAX];
+    unsigned   irq_depth;
+    uint8_t    irq_named[512 / 8];      /**< Interrupt track metadata written */
+    uint64_t   events;
+    uint32_t   dropped;                 /**< Last drop count reported */
+} kt_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static double kt_us(const kt_ctx_t *ctx, uint64_t cycles)
+{
+    return ((double)cycles * 1e6) / (double)ctx->hz;
+}
+
+static void kt_sep(kt_ctx_t *ctx)
+{
+    fputs(ctx->first ? "\n" : ",\n", ctx->out);
+    ctx->first = 0;
+}
+
+static kt_task_t *kt_task(kt_ctx_t *ctx, uint32_t tcb)
+{
+    for (size_t i = 0; i < ctx->tasks; i++)
+    {
+        if (ctx->task[i].tcb == tcb)
+        {
+            return &ctx->task[i];
+        }
+    }
+
+    if (ctx->tasks == ctx->task_cap)
+    {
+        size_t     cap = (0U != ctx->task_cap) ? (ctx->task_cap * 2U) : 32U;
+        kt_task_t *t   = realloc(ctx->task, cap * sizeof(*t));
+
+        if (NULL == t)
+        {
+            return NULL;
+        }
+        ctx->task     = t;
+        ctx->task_cap = cap;
+    }
+
+    kt_task_t *t = &ctx->task[ctx->tasks++];
+
+    memset(t, 0, sizeof(*t));
+    t->tcb = tcb;
+    snprintf(t->name, sizeof(t->name), "task 0x%08lx", (unsigned long)tcb);
+    return t;
+}
+
+static void kt_json_str(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; '\0' != *s; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+
+        if (('"' == c) || ('\\' == c))
+        {
+            fprintf(out, "\\%c", c);
+        }
+        else if (c < 0x20U)
+        {
+            fprintf(out, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the thread_name metadata of a task track (once).
+ */
+static void kt_name_task(kt_ctx_t *ctx, kt_task_t *t)
+{
+    if ((NULL == t) || (0 != t->named))
+    {
+        return;
+    }
+    kt_sep(ctx);
+    fprintf(ctx->out, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%lu,"
+            "\"name\":\"thread_name\",\"args\":{\"name\":", PID_TASKS,
+            (unsigned long)t->tcb);
+    kt_json_str(ctx->out, t->name);
+    fputs("}}", ctx->out);
+    t->named = 1;
+}
+
+static void kt_name_irq(kt_ctx_t *ctx, uint32_t irq)
+{
+    irq &= 0x1FFU;
+    if (0U != (ctx->irq_named[irq / 8U] & (1U << (irq % 8U))))
+    {
+        return;
+    }
+    kt_sep(ctx);
+    fprintf(ctx->out, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%lu,"
+            "\"name\":\"thread_name\",\"args\":{\"name\":\"%s %lu\"}}",
+            PID_IRQS, (unsigned long)irq,
+            (irq < 16U) ? "exception" : "IRQ",
+            (unsigned long)((irq < 16U) ? irq : (irq - 16U)));
+    ctx->irq_named[irq / 8U] |= (uint8_t)(1U << (irq % 8U));
+}
+
+static void kt_slice(kt_ctx_t *ctx, int pid, uint32_t tid, const char *name,
+                     uint64_t start, uint64_t end)
+{
+    kt_sep(ctx);
+    fprintf(ctx->out, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%lu,\"ts\":%.3f,"
+            "\"dur\":%.3f,\"name\":", pid, (unsigned long)tid,
+            kt_us(ctx, start), kt_us(ctx, end - start));
+    kt_json_str(ctx->out, name);
+    fputc('}', ctx->out);
+}
+
+/**
+ * @brief Close the running slice of the current task.
+ */
+static void kt_switch_out(kt_ctx_t *ctx)
+{
+    if (0U == ctx->running)
+    {
+        return;
+    }
+
+    kt_task_t *t = kt_task(ctx, ctx->running);
+
+    if (NULL != t)
+    {
+        kt_name_task(ctx, t);
+        kt_slice(ctx, PID_TASKS, TID_CPU, t->name, ctx->running_since, ctx->now);
+        kt_slice(ctx, PID_TASKS, t->tcb, "running", ctx->running_since, ctx->now);
+    }
+    ctx->running = 0;
+}
+
+static const char *kt_queue_kind(uint32_t type)
+{
+    /* queueQUEUE_TYPE_xxx of FreeRTOS queue.h */
+    static const char *const KINDS[] =
+    {
+        "queue", "mutex", "counting semaphore", "binary semaphore",
+        "recursive mutex"
+    };
+
+    return (type < (sizeof(KINDS) / sizeof(KINDS[0]))) ? KINDS[type] : "queue";
+}
+
+/**
+ * @brief Instant event on the track of the current context.
+ */
+static void kt_instant(kt_ctx_t *ctx, const char *what, const char *kind,
+                       uint32_t object, const char *target)
+{
+    int      pid = PID_TASKS;
+    uint32_t tid = ctx->running;
+
+    if (0U != ctx->irq_depth)
+    {
+        pid = PID_IRQS;
+        tid = ctx->irq[ctx->irq_depth - 1U];
+    }
+    else if (0U != tid)
+    {
+        kt_name_task(ctx, kt_task(ctx, tid));
+    }
+
+    kt_sep(ctx);
+    fprintf(ctx->out, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%lu,"
+            "\"ts\":%.3f,\"name\":\"%s %s\",\"args\":{\"object\":\"0x%08lx\"",
+            pid, (unsigned long)tid, kt_us(ctx, ctx->now), what, kind,
+            (unsigned long)object);
+    if (NULL != target)
+    {
+        fputs(",\"task\":", ctx->out);
+        kt_json_str(ctx->out, target);
+    }
+    fputs("}}", ctx->out);
+}
+
+static void kt_event(kt_ctx_t *ctx, const debug_ktrace_event_t *ev)
+{
+    /* Unwrap; small steps backwards (an ISR preempting a producer between
+       timestamp and publish) are kept as they are */
+    if (0 == ctx->started)
+    {
+        ctx->started = 1;
+        ctx->now     = 0;
+    }
+    else
+    {
+        int32_t step = (int32_t)(ev->cycles - ctx->last_cycles);
+
+        ctx->now = ((step < 0) && ((uint64_t)-(int64_t)step > ctx->now)) ?
+                   0U : (uint64_t)((int64_t)ctx->now + step);
+    }
+    ctx->last_cycles = ev->cycles;
+    ctx->events++;
+
+    switch (ev->type)
+    {
+        case DEBUG_KTRACE_SWITCH_IN:
+            kt_switch_out(ctx);
+            ctx->running       = ev->object;
+            ctx->running_since = ctx->now;
+            break;
+
+        case DEBUG_KTRACE_SWITCH_OUT:
+            kt_switch_out(ctx);
+            break;
+
+        case DEBUG_KTRACE_TASK_CREATE:
+        {
+            kt_task_t *t = kt_task(ctx, ev->object);
+
+            if (NULL != t)
+            {
+                t->name[0]  = '\0';
+                t->name_len = 0;
+                t->named    = 0;
+            }
+            break;
+        }
+
+        case DEBUG_KTRACE_TASK_NAME:
+        {
+            kt_task_t *t = kt_task(ctx, ev->object);
+            uint8_t    chunk[7];
+
+            if (NULL == t)
+            {
+                break;
+            }
+            memcpy(chunk, &ev->arg, 4U);
+            memcpy(&chunk[4], ev->data, 3U);
+            for (size_t i = 0; (i < sizeof(chunk)) &&
+                               (t->name_len < (sizeof(t->name) - 1U)); i++)
+            {
+                t->name[t->name_len++] = (char)chunk[i];
+            }
+            t->name[t->name_len] = '\0';
+            break;
+        }
+
+        case DEBUG_KTRACE_TASK_DELETE:
+        {
+            kt_task_t *t = kt_task(ctx, ev->object);
+
+            if (ctx->running == ev->object)
+            {
+                kt_switch_out(ctx);
+            }
+            kt_instant(ctx, "delete", "task", ev->object,
+                       (NULL != t) ? t->name : NULL);
+            break;
+        }
+
+        case DEBUG_KTRACE_ISR_ENTER:
+            if (ctx->irq_depth < IRQ_NEST_MAX)
+            {
+                kt_name_irq(ctx, ev->object);
+                ctx->irq[ctx->irq_depth]       = ev->object & 0x1FFU;
+                ctx->irq_since[ctx->irq_depth] = ctx->now;
+            }
+            ctx->irq_depth++;
+            break;
+
+        case DEBUG_KTRACE_ISR_EXIT:
+            if (0U != ctx->irq_depth)
+            {
+                ctx->irq_depth--;
+                if (ctx->irq_depth < IRQ_NEST_MAX)
+                {
+                    kt_slice(ctx, PID_IRQS, ctx->irq[ctx->irq_depth], "isr",
+                             ctx->irq_since[ctx->irq_depth], ctx->now);
+                }
+            }
+            break;
+
+        case DEBUG_KTRACE_QUEUE_SEND:
+            kt_instant(ctx, (ev->arg == 0U) ? "send" : "give",
+                       kt_queue_kind(ev->arg), ev->object, NULL);
+            break;
+
+        case DEBUG_KTRACE_QUEUE_RECEIVE:
+            kt_instant(ctx, (ev->arg == 0U) ? "receive" : "take",
+                       kt_queue_kind(ev->arg), ev->object, NULL);
+            break;
+
+        case DEBUG_KTRACE_BLOCK_SEND:
+            kt_instant(ctx, "block on full", kt_queue_kind(ev->arg), ev->object, NULL);
+            break;
+
+        case DEBUG_KTRACE_BLOCK_RECEIVE:
+            kt_instant(ctx, "block on", kt_queue_kind(ev->arg), ev->object, NULL);
+            break;
+
+        case DEBUG_KTRACE_NOTIFY:
+        {
+            kt_task_t *t = kt_task(ctx, ev->object);
+
+            kt_instant(ctx, "notify", "task", ev->object,
+                       (NULL != t) ? t->name : NULL);
+            break;
+        }
+
+        case DEBUG_KTRACE_NOTIFY_WAIT:
+            kt_instant(ctx, "wait", "notification", ev->object, NULL);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    kt_ctx_t             *ctx = user;
+    debug_ktrace_record_t rec;
+
+    if ((DEBUG_RECORD_KTRACE != type) || (len < sizeof(rec)))
+    {
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    if (0U != rec.cycles_hz)
+    {
+        ctx->hz = rec.cycles_hz;
+    }
+    ctx->dropped = rec.dropped;
+
+    for (size_t i = 0; (i < rec.count) &&
+                       ((sizeof(rec) + ((i + 1U) * sizeof(debug_ktrace_event_t))) <= len); i++)
+    {
+        debug_ktrace_event_t ev;
+
+        memcpy(&ev, &payload[sizeof(rec) + (i * sizeof(ev))], sizeof(ev));
+        kt_event(ctx, &ev);
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-o trace.json] [capture]\n"
+            "  Converts the kernel trace records of the capture (or stdin)\n"
+            "  into a JSON trace for ui.perfetto.dev.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char *path     = NULL;
+    const char *out_path = NULL;
+    kt_ctx_t    ctx      = { .out = stdout, .first = 1, .hz = 1000000U };
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-o")) && ((i + 1) < argc))
+        {
+            out_path = argv[++i];
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        return 1;
+    }
+    if (NULL != out_path)
+    {
+        ctx.out = fopen(out_path, "w");
+        if (NULL == ctx.out)
+        {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, &ctx))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", ctx.out);
+    kt_sep(&ctx);
+    fprintf(ctx.out, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\","
+            "\"args\":{\"name\":\"Tasks\"}},\n"
+            "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\","
+            "\"args\":{\"name\":\"CPU\"}},\n"
+            "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\","
+            "\"args\":{\"name\":\"Interrupts\"}}", PID_TASKS, PID_TASKS,
+            TID_CPU, PID_IRQS);
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+    kt_switch_out(&ctx);
+    for (size_t i = 0; i < ctx.tasks; i++)
+    {
+        kt_name_task(&ctx, &ctx.task[i]);
+    }
+    fputs("\n]}\n", ctx.out);
+
+    fprintf(stderr, "%llu event(s), %zu task(s), %lu dropped on the target",
+            (unsigned long long)ctx.events, ctx.tasks, (unsigned long)ctx.dropped);
+    if (0U != stream.crc_errors)
+    {
+        fprintf(stderr, ", %llu record(s) dropped on CRC error",
+                (unsigned long long)stream.crc_errors);
+    }
+    fputc('\n', stderr);
+
+    debug_stream_free(&stream);
+    free(ctx.task);
+    if (stdout != ctx.out)
+    {
+        fclose(ctx.out);
+    }
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
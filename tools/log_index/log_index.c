@@ -0,0 +1,1094 @@
+/**
+ * @file      log_index.c
+ * @brief     Indexed viewer for large text captures.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Memory-maps a capture of the debug stream and keeps a compact sidecar
+ * index next to it (<capture>.idx) so that range and filter queries do
+ * not have to scan the whole file.
+ *
+ * The capture is cut into blocks of IDX_BLOCK_ENTRIES lines/records. For
+ * every block the index stores its byte range, the seq and timestamp
+ * range of its lines, a bitmap of the levels present and a bitmap of the
+ * threads present (up to IDX_MAX_THREADS distinct names; blocks holding
+ * other threads are flagged and always scanned). A block entry is 64
+ * bytes, well under 2% of a typical capture.
+ *
+ * Building runs on all cores: the file is split at line starts and every
+ * worker indexes its part. A split that landed inside a binary record is
+ * detected when the previous part does not end exactly there, and that
+ * part is then re-indexed from the right position.
+ *
+ * The index is incremental: it remembers how far the capture was indexed
+ * and a checksum of the bytes just before that point. When the capture
+ * has grown, only the new tail (plus the last partial block) is indexed;
+ * when it has been truncated or replaced, the index is rebuilt. Queries
+ * bring the index up to date before they run.
+ *
+ * A query selects candidate blocks (binary search when seq/timestamps
+ * are monotonic, a linear pass over the block table otherwise), then
+ * parses only the lines of those blocks. Matching lines are printed
+ * unchanged; binary records are skipped.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -pthread -I../../core -I../common -o log_index \
+ *       log_index.c ../common/debug_capture.c ../common/debug_stream.c \
+ *       ../common/debug_line.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   log_index build [-j N] [--follow] [--interval MS] capture.log
+ *   log_index query [--seq A-B] [--time A-B] [--level L[,L..]]
+ *                   [--thread NAME] [--count] capture.log
+ *   log_index stats capture.log
+ * @endcode
+ *
+ * Ranges are inclusive; either end may be omitted ("1000-", "-5000").
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "debug_capture.h"
+#include "debug_line.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+#define IDX_MAGIC           "DLOGIDX1"
+#define IDX_VERSION         1U
+#define IDX_BLOCK_ENTRIES   64U     /**< Lines + records per block */
+#define IDX_MAX_THREADS     64U     /**< Names tracked in thread bitmaps */
+#define IDX_THREAD_NAME     32U     /**< Stored thread name length */
+#define IDX_TAIL_CHECK      32U     /**< Bytes compared on update */
+#define IDX_MIN_CHUNK       (1UL << 20)   /**< Smallest part per worker */
+
+/* Block flags */
+#define IDX_BLOCK_ANY_THREAD    (1U << 0)   /**< Thread not in the bitmap */
+
+/* Header flags */
+#define IDX_SEQ_SORTED      (1U << 0)   /**< Block seq ranges ascend */
+#define IDX_TS_SORTED       (1U << 1)   /**< Block time ranges ascend */
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Sidecar file header */
+typedef struct
+{
+    char     magic[8];                  /**< IDX_MAGIC */
+    uint32_t version;                   /**< IDX_VERSION */
+    uint32_t block_entries;             /**< IDX_BLOCK_ENTRIES */
+    uint64_t indexed_size;              /**< Capture bytes covered */
+    uint64_t lines;                     /**< Text lines covered */
+    uint64_t records;                   /**< Binary records covered */
+    uint32_t block_count;               /**< Entries in the block table */
+    uint32_t thread_count;              /**< Entries in the thread table */
+    uint32_t flags;                     /**< IDX_SEQ_SORTED | IDX_TS_SORTED */
+    uint32_t reserved;
+    uint8_t  tail_check[IDX_TAIL_CHECK]; /**< Bytes before indexed_size */
+} idx_header_t;
+
+/** @brief Block table entry (64 bytes) */
+typedef struct
+{
+    uint64_t offset;        /**< First byte of the block */
+    uint64_t end;           /**< One past the last byte */
+    uint64_t seq_min;       /**< Lowest seq (UINT64_MAX if none) */
+    uint64_t seq_max;       /**< Highest seq */
+    uint64_t ts_min;        /**< Lowest timestamp (UINT64_MAX if none) */
+    uint64_t ts_max;        /**< Highest timestamp */
+    uint64_t thread_mask;   /**< Bit n: thread n has lines here */
+    uint32_t lines;         /**< Text lines */
+    uint16_t records;       /**< Binary records */
+    uint8_t  level_mask;    /**< Bit n: level n has lines here */
+    uint8_t  flags;         /**< IDX_BLOCK_* */
+} idx_block_t;
+
+/** @brief In-memory index */
+typedef struct
+{
+    idx_header_t hdr;
+    idx_block_t *blocks;
+    size_t       cap;
+    char         threads[IDX_MAX_THREADS][IDX_THREAD_NAME];
+} idx_t;
+
+/** @brief Per-worker build state */
+typedef struct
+{
+    idx_block_t   *blocks;
+    size_t         count;
+    size_t         cap;
+    uint64_t       lines;
+    uint64_t       records;
+    char           names[IDX_MAX_THREADS][IDX_THREAD_NAME];
+    size_t         name_len[IDX_MAX_THREADS];
+    uint32_t       name_count;
+    int            error;
+} idx_worker_t;
+
+/** @brief Query filter */
+typedef struct
+{
+    uint64_t seq_lo, seq_hi;
+    uint64_t ts_lo, ts_hi;
+    int      use_seq;
+    int      use_ts;
+    uint8_t  levels;            /**< Wanted levels, 0 = any */
+    const char *thread;         /**< Wanted thread, NULL = any */
+    int      count_only;
+} idx_query_t;
+
+/*******************************************************************************
+ * Private Functions
+ *******************************************************************************/
+
+static double idx_now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double)t.tv_sec * 1000.0) + ((double)t.tv_nsec / 1e6);
+}
+
+static idx_block_t *idx_worker_block(idx_worker_t *w, uint64_t offset)
+{
+    if (w->count == w->cap)
+    {
+        size_t       cap = (0U != w->cap) ? (w->cap * 2U) : 1024U;
+        idx_block_t *b   = realloc(w->blocks, cap * sizeof(*b));
+
+        if (NULL == b)
+        {
+            w->error = 1;
+            return NULL;
+        }
+        w->blocks = b;
+        w->cap    = cap;
+    }
+
+    idx_block_t *b = &w->blocks[w->count++];
+
+    memset(b, 0, sizeof(*b));
+    b->offset  = offset;
+    b->end     = offset;
+    b->seq_min = UINT64_MAX;
+    b->ts_min  = UINT64_MAX;
+
+    return b;
+}
+
+/**
+ * @brief Map a thread name to a worker-local bit.
+ *
+ * @return Bit number, or -1 if the local table is full
+ */
+static int idx_worker_thread(idx_worker_t *w, const char *name, size_t len)
+{
+    if (len >= IDX_THREAD_NAME)
+    {
+        len = IDX_THREAD_NAME - 1U;
+    }
+
+    for (uint32_t i = 0; i < w->name_count; i++)
+    {
+        if ((w->name_len[i] == len) && (0 == memcmp(w->names[i], name, len)))
+        {
+            return (int)i;
+        }
+    }
+
+    if (w->name_count == IDX_MAX_THREADS)
+    {
+        return -1;
+    }
+
+    memcpy(w->names[w->name_count], name, len);
+    w->names[w->name_count][len] = '\0';
+    w->name_len[w->name_count]   = len;
+
+    return (int)w->name_count++;
+}
+
+/**
+ * @brief Index the entries of one part (debug_capture_walk_t).
+ */
+static void idx_walk(debug_capture_part_t *part)
+{
+    idx_worker_t *w = part->user;
+    idx_block_t  *b = NULL;
+    uint64_t      p = part->start;
+    int          last_thread = -1;
+    const char  *last_name   = NULL;
+    size_t       last_len    = 0;
+
+    /* Restart cleanly when called again after a bad split */
+    w->count      = 0;
+    w->lines      = 0;
+    w->records    = 0;
+    w->name_count = 0;
+
+    while ((p < part->stop) && (0 == w->error))
+    {
+        uint64_t              len;
+        debug_capture_entry_t kind = debug_capture_entry(part->buf, part->size,
+                                                         p, &len);
+
+        if (DEBUG_CAPTURE_NONE == kind)
+        {
+            break;
+        }
+
+        if ((NULL == b) || ((b->lines + b->records) == IDX_BLOCK_ENTRIES))
+        {
+            b = idx_worker_block(w, p);
+            if (NULL == b)
+            {
+                break;
+            }
+        }
+
+        if (DEBUG_CAPTURE_RECORD == kind)
+        {
+            b->records++;
+            w->records++;
+        }
+        else
+        {
+            debug_line_t ln;
+
+            (void)debug_line_parse((const char *)&part->buf[p], (size_t)len, &ln);
+
+            if (0U != (ln.fields & DEBUG_LINE_HAS_SEQ))
+            {
+                if (ln.seq < b->seq_min) b->seq_min = ln.seq;
+                if (ln.seq > b->seq_max) b->seq_max = ln.seq;
+            }
+            if (0U != (ln.fields & DEBUG_LINE_HAS_TS))
+            {
+                if (ln.ts < b->ts_min) b->ts_min = ln.ts;
+                if (ln.ts > b->ts_max) b->ts_max = ln.ts;
+            }
+            if (0U != (ln.fields & DEBUG_LINE_HAS_LEVEL))
+            {
+                b->level_mask |= (uint8_t)(1U << ln.level);
+            }
+            if (0U != (ln.fields & DEBUG_LINE_HAS_THREAD))
+            {
+                /* Consecutive lines mostly come from the same thread */
+                if ((NULL == last_name) || (last_len != ln.thread_len) ||
+                    (0 != memcmp(last_name, ln.thread, last_len)))
+                {
+                    last_thread = idx_worker_thread(w, ln.thread, ln.thread_len);
+                    last_name   = ln.thread;
+                    last_len    = ln.thread_len;
+                }
+
+                if (last_thread >= 0)
+                {
+                    b->thread_mask |= 1ULL << last_thread;
+                }
+                else
+                {
+                    b->flags |= IDX_BLOCK_ANY_THREAD;
+                }
+            }
+
+            b->lines++;
+            w->lines++;
+        }
+
+        p     += len;
+        b->end = p;
+    }
+
+    part->end = (p > part->start) ? p : part->start;
+}
+
+/**
+ * @brief Add worker results to the index, remapping thread bits.
+ */
+static int idx_merge(idx_t *idx, idx_worker_t *w)
+{
+    int      map[IDX_MAX_THREADS];
+    uint32_t i;
+
+    for (i = 0; i < w->name_count; i++)
+    {
+        uint32_t g;
+
+        map[i] = -1;
+        for (g = 0; g < idx->hdr.thread_count; g++)
+        {
+            if (0 == strcmp(idx->threads[g], w->names[i]))
+            {
+                break;
+            }
+        }
+        if ((g == idx->hdr.thread_count) && (g < IDX_MAX_THREADS))
+        {
+            memcpy(idx->threads[g], w->names[i], IDX_THREAD_NAME);
+            idx->hdr.thread_count++;
+        }
+        if (g < IDX_MAX_THREADS)
+        {
+            map[i] = (int)g;
+        }
+    }
+
+    if ((idx->hdr.block_count + w->count) > idx->cap)
+    {
+        size_t       cap = (idx->hdr.block_count + w->count) * 2U;
+        idx_block_t *b   = realloc(idx->blocks, cap * sizeof(*b));
+
+        if (NULL == b)
+        {
+            return -1;
+        }
+        idx->blocks = b;
+        idx->cap    = cap;
+    }
+
+    for (size_t k = 0; k < w->count; k++)
+    {
+        idx_block_t *b    = &w->blocks[k];
+        uint64_t     mask = b->thread_mask;
+
+        b->thread_mask = 0;
+        for (i = 0; mask != 0U; i++, mask >>= 1)
+        {
+            if (0U != (mask & 1U))
+            {
+                if (map[i] >= 0)
+                {
+                    b->thread_mask |= 1ULL << map[i];
+                }
+                else
+                {
+                    b->flags |= IDX_BLOCK_ANY_THREAD;
+                }
+            }
+        }
+
+        idx->blocks[idx->hdr.block_count++] = *b;
+    }
+
+    idx->hdr.lines   += w->lines;
+    idx->hdr.records += w->records;
+
+    return 0;
+}
+
+static void idx_tail_check(const debug_capture_map_t *m, uint64_t at,
+                           uint8_t out[IDX_TAIL_CHECK])
+{
+    uint64_t from = (at > IDX_TAIL_CHECK) ? (at - IDX_TAIL_CHECK) : 0U;
+
+    memset(out, 0, IDX_TAIL_CHECK);
+    if (at <= m->size)
+    {
+        memcpy(out, &m->buf[from], (size_t)(at - from));
+    }
+}
+
+static void idx_reset(idx_t *idx)
+{
+    memset(&idx->hdr, 0, sizeof(idx->hdr));
+    memcpy(idx->hdr.magic, IDX_MAGIC, sizeof(idx->hdr.magic));
+    idx->hdr.version       = IDX_VERSION;
+    idx->hdr.block_entries = IDX_BLOCK_ENTRIES;
+}
+
+static void idx_sort_flags(idx_t *idx)
+{
+    uint64_t seq = 0;
+    uint64_t ts  = 0;
+
+    idx->hdr.flags = IDX_SEQ_SORTED | IDX_TS_SORTED;
+
+    for (uint32_t i = 0; i < idx->hdr.block_count; i++)
+    {
+        const idx_block_t *b = &idx->blocks[i];
+
+        if (UINT64_MAX != b->seq_min)
+        {
+            if (b->seq_min < seq) idx->hdr.flags &= ~IDX_SEQ_SORTED;
+            seq = b->seq_max;
+        }
+        if (UINT64_MAX != b->ts_min)
+        {
+            if (b->ts_min < ts) idx->hdr.flags &= ~IDX_TS_SORTED;
+            ts = b->ts_max;
+        }
+    }
+}
+
+/**
+ * @brief Bring the index up to date with the capture.
+ *
+ * @return 1 if the index changed, 0 if it was current, -1 on error
+ */
+static int idx_update(idx_t *idx, const debug_capture_map_t *m, unsigned jobs)
+{
+    uint8_t  check[IDX_TAIL_CHECK];
+    uint64_t from = 0;
+
+    idx_tail_check(m, idx->hdr.indexed_size, check);
+
+    if ((idx->hdr.indexed_size <= m->size) &&
+        (0 == memcmp(check, idx->hdr.tail_check, IDX_TAIL_CHECK)))
+    {
+        if (idx->hdr.indexed_size == m->size)
+        {
+            return 0;
+        }
+
+        from = idx->hdr.indexed_size;
+
+        /* Reopen a partial last block so appends keep blocks full */
+        if (0U != idx->hdr.block_count)
+        {
+            idx_block_t *b = &idx->blocks[idx->hdr.block_count - 1U];
+
+            if ((b->lines + b->records) < IDX_BLOCK_ENTRIES)
+            {
+                from               = b->offset;
+                idx->hdr.lines    -= b->lines;
+                idx->hdr.records  -= b->records;
+                idx->hdr.block_count--;
+            }
+        }
+    }
+    else
+    {
+        idx_reset(idx);     /* Truncated or replaced: start over */
+    }
+
+    debug_capture_part_t parts[DEBUG_CAPTURE_MAX_JOBS];
+    idx_worker_t        *w = calloc(DEBUG_CAPTURE_MAX_JOBS, sizeof(*w));
+    int                  rc = 1;
+
+    if (NULL == w)
+    {
+        return -1;
+    }
+    for (unsigned i = 0; i < DEBUG_CAPTURE_MAX_JOBS; i++)
+    {
+        parts[i].user = &w[i];
+    }
+
+    unsigned n   = debug_capture_parallel(m->buf, m->size, from, jobs,
+                                          IDX_MIN_CHUNK, parts, idx_walk);
+    uint64_t cur = parts[n - 1U].end;
+
+    for (unsigned i = 0; i < n; i++)
+    {
+        if ((rc > 0) && ((0 != w[i].error) || (0 != idx_merge(idx, &w[i]))))
+        {
+            rc = -1;
+        }
+    }
+    for (unsigned i = 0; i < DEBUG_CAPTURE_MAX_JOBS; i++)
+    {
+        free(w[i].blocks);
+    }
+    free(w);
+
+    idx->hdr.indexed_size = cur;
+    idx_tail_check(m, cur, idx->hdr.tail_check);
+    idx_sort_flags(idx);
+
+    return rc;
+}
+
+static char *idx_path(const char *capture)
+{
+    size_t n    = strlen(capture);
+    char  *path = malloc(n + 5U);
+
+    if (NULL != path)
+    {
+        memcpy(path, capture, n);
+        memcpy(&path[n], ".idx", 5);
+    }
+
+    return path;
+}
+
+/**
+ * @brief Load a sidecar; a missing or foreign file yields an empty index.
+ */
+static void idx_load(idx_t *idx, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+
+    idx_reset(idx);
+    if (NULL == f)
+    {
+        return;
+    }
+
+    idx_header_t hdr;
+
+    if ((1U == fread(&hdr, sizeof(hdr), 1, f)) &&
+        (0 == memcmp(hdr.magic, IDX_MAGIC, sizeof(hdr.magic))) &&
+        (IDX_VERSION == hdr.version) &&
+        (IDX_BLOCK_ENTRIES == hdr.block_entries) &&
+        (hdr.thread_count <= IDX_MAX_THREADS))
+    {
+        idx_block_t *b = malloc(((size_t)hdr.block_count + 1U) * sizeof(*b));
+
+        if ((NULL != b) &&
+            (hdr.block_count == fread(b, sizeof(*b), hdr.block_count, f)) &&
+            (hdr.thread_count == fread(idx->threads, IDX_THREAD_NAME,
+                                       hdr.thread_count, f)))
+        {
+            free(idx->blocks);
+            idx->blocks = b;
+            idx->cap    = (size_t)hdr.block_count + 1U;
+            idx->hdr    = hdr;
+        }
+        else
+        {
+            free(b);
+        }
+    }
+
+    fclose(f);
+}
+
+/**
+ * @brief Write the sidecar atomically (temporary file + rename).
+ */
+static int idx_save(const idx_t *idx, const char *path)
+{
+    size_t n   = strlen(path);
+    char  *tmp = malloc(n + 5U);
+    int    rc  = -1;
+
+    if (NULL == tmp)
+    {
+        return -1;
+    }
+    memcpy(tmp, path, n);
+    memcpy(&tmp[n], ".tmp", 5);
+
+    FILE *f = fopen(tmp, "wb");
+
+    if (NULL != f)
+    {
+        int ok = (1U == fwrite(&idx->hdr, sizeof(idx->hdr), 1, f)) &&
+                 (idx->hdr.block_count ==
+                  fwrite(idx->blocks, sizeof(idx_block_t), idx->hdr.block_count, f)) &&
+                 (idx->hdr.thread_count ==
+                  fwrite(idx->threads, IDX_THREAD_NAME, idx->hdr.thread_count, f));
+
+        ok = (0 == fclose(f)) && ok;
+        rc = (ok && (0 == rename(tmp, path))) ? 0 : -1;
+        if (0 != rc)
+        {
+            unlink(tmp);
+        }
+    }
+
+    free(tmp);
+    return rc;
+}
+
+/**
+ * @brief Map the capture, load its sidecar and bring it up to date.
+ */
+static int idx_open(idx_t *idx, debug_capture_map_t *m, const char *capture,
+                    unsigned jobs, int verbose)
+{
+    char  *path = idx_path(capture);
+    double t0   = idx_now_ms();
+
+    if ((NULL == path) || (0 != debug_capture_map(m, capture)))
+    {
+        fprintf(stderr, "log_index: %s: %s\n", capture, strerror(errno));
+        free(path);
+        return -1;
+    }
+
+    idx_load(idx, path);
+
+    uint64_t before = idx->hdr.indexed_size;
+    int      rc     = idx_update(idx, m, jobs);
+
+    if ((rc > 0) && (0 != idx_save(idx, path)))
+    {
+        fprintf(stderr, "log_index: cannot write %s\n", path);
+    }
+
+    if ((0 != verbose) && (rc > 0))
+    {
+        double ms = idx_now_ms() - t0;
+        double mb = (double)(idx->hdr.indexed_size -
+                             ((before <= idx->hdr.indexed_size) ? before : 0U)) / 1e6;
+
+        fprintf(stderr, "indexed %.1f MB in %.1f ms (%.0f MB/s, %u jobs): "
+                "%llu lines, %llu records, %u blocks, %u threads\n",
+                mb, ms, (ms > 0.0) ? (mb * 1000.0 / ms) : 0.0, jobs,
+                (unsigned long long)idx->hdr.lines,
+                (unsigned long long)idx->hdr.records,
+                idx->hdr.block_count, idx->hdr.thread_count);
+    }
+
+    free(path);
+    return (rc < 0) ? -1 : 0;
+}
+
+static int idx_parse_range(const char *s, uint64_t *lo, uint64_t *hi)
+{
+    char *end;
+
+    *lo = 0;
+    *hi = UINT64_MAX;
+
+    if ('-' != *s)
+    {
+        *lo = strtoull(s, &end, 0);
+        if (end == s)
+        {
+            return -1;
+        }
+        s = end;
+        if ('\0' == *s)
+        {
+            *hi = *lo;
+            return 0;
+        }
+    }
+    if ('-' != *s++)
+    {
+        return -1;
+    }
+    if ('\0' != *s)
+    {
+        *hi = strtoull(s, &end, 0);
+        if ('\0' != *end)
+        {
+            return -1;
+        }
+    }
+
+    return (*lo <= *hi) ? 0 : -1;
+}
+
+static int idx_parse_levels(const char *s, uint8_t *mask)
+{
+    *mask = 0;
+
+    while ('\0' != *s)
+    {
+        size_t n     = strcspn(s, ",");
+        int    level = debug_line_level(s, n);
+
+        if (level < 0)
+        {
+            return -1;
+        }
+        *mask |= (uint8_t)(1U << level);
+        s     += n;
+        s     += (',' == *s) ? 1 : 0;
+    }
+
+    return (0U != *mask) ? 0 : -1;
+}
+
+/**
+ * @brief First block that may hold a value >= lo, for sorted ranges.
+ */
+static uint32_t idx_lower_bound(const idx_t *idx, uint64_t lo, int use_ts)
+{
+    uint32_t a = 0;
+    uint32_t b = idx->hdr.block_count;
+
+    while (a < b)
+    {
+        uint32_t           mid = a + ((b - a) / 2U);
+        const idx_block_t *blk = &idx->blocks[mid];
+        uint64_t           max = (0 != use_ts) ? blk->ts_max : blk->seq_max;
+        uint64_t           min = (0 != use_ts) ? blk->ts_min : blk->seq_min;
+
+        /* Blocks without values sort as "before" */
+        if ((UINT64_MAX == min) || (max < lo))
+        {
+            a = mid + 1U;
+        }
+        else
+        {
+            b = mid;
+        }
+    }
+
+    /* Step back over value-less blocks the search skipped */
+    while ((a > 0U) &&
+           (UINT64_MAX == ((0 != use_ts) ? idx->blocks[a - 1U].ts_min
+                                         : idx->blocks[a - 1U].seq_min)))
+    {
+        a--;
+    }
+
+    return a;
+}
+
+static int idx_block_matches(const idx_t *idx, const idx_block_t *b,
+                             const idx_query_t *q, int thread_bit)
+{
+    if ((0 != q->use_seq) &&
+        ((UINT64_MAX == b->seq_min) || (b->seq_max < q->seq_lo) ||
+         (b->seq_min > q->seq_hi)))
+    {
+        return 0;
+    }
+    if ((0 != q->use_ts) &&
+        ((UINT64_MAX == b->ts_min) || (b->ts_max < q->ts_lo) ||
+         (b->ts_min > q->ts_hi)))
+    {
+        return 0;
+    }
+    if ((0U != q->levels) && (0U == (b->level_mask & q->levels)))
+    {
+        return 0;
+    }
+    if ((NULL != q->thread) && (0U == (b->flags & IDX_BLOCK_ANY_THREAD)) &&
+        ((thread_bit < 0) || (0U == (b->thread_mask & (1ULL << thread_bit)))))
+    {
+        return 0;
+    }
+
+    (void)idx;
+    return 1;
+}
+
+static int idx_line_matches(const debug_line_t *ln, const idx_query_t *q)
+{
+    if ((0 != q->use_seq) &&
+        ((0U == (ln->fields & DEBUG_LINE_HAS_SEQ)) ||
+         (ln->seq < q->seq_lo) || (ln->seq > q->seq_hi)))
+    {
+        return 0;
+    }
+    if ((0 != q->use_ts) &&
+        ((0U == (ln->fields & DEBUG_LINE_HAS_TS)) ||
+         (ln->ts < q->ts_lo) || (ln->ts > q->ts_hi)))
+    {
+        return 0;
+    }
+    if ((0U != q->levels) &&
+        ((0U == (ln->fields & DEBUG_LINE_HAS_LEVEL)) ||
+         (0U == (q->levels & (1U << ln->level)))))
+    {
+        return 0;
+    }
+    if ((NULL != q->thread) &&
+        ((0U == (ln->fields & DEBUG_LINE_HAS_THREAD)) ||
+         (strlen(q->thread) != ln->thread_len) ||
+         (0 != memcmp(q->thread, ln->thread, ln->thread_len))))
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+static int cmd_query(const idx_t *idx, const debug_capture_map_t *m,
+                     const idx_query_t *q, int verbose)
+{
+    double   t0       = idx_now_ms();
+    uint64_t matches  = 0;
+    uint32_t scanned  = 0;
+    uint32_t first    = 0;
+    int      bit      = -1;
+
+    if (NULL != q->thread)
+    {
+        for (uint32_t i = 0; i < idx->hdr.thread_count; i++)
+        {
+            if (0 == strncmp(idx->threads[i], q->thread, IDX_THREAD_NAME))
+            {
+                bit = (int)i;
+            }
+        }
+    }
+
+    /* Sorted ranges: skip straight to the first candidate */
+    int sorted_seq = (0 != q->use_seq) && (0U != (idx->hdr.flags & IDX_SEQ_SORTED));
+    int sorted_ts  = (0 != q->use_ts) && (0U != (idx->hdr.flags & IDX_TS_SORTED));
+
+    if (0 != sorted_seq)
+    {
+        first = idx_lower_bound(idx, q->seq_lo, 0);
+    }
+    else if (0 != sorted_ts)
+    {
+        first = idx_lower_bound(idx, q->ts_lo, 1);
+    }
+
+    for (uint32_t i = first; i < idx->hdr.block_count; i++)
+    {
+        const idx_block_t *b = &idx->blocks[i];
+
+        if (((0 != sorted_seq) && (UINT64_MAX != b->seq_min) && (b->seq_min > q->seq_hi)) ||
+            ((0 == sorted_seq) && (0 != sorted_ts) &&
+             (UINT64_MAX != b->ts_min) && (b->ts_min > q->ts_hi)))
+        {
+            break;
+        }
+        if (0 == idx_block_matches(idx, b, q, bit))
+        {
+            continue;
+        }
+
+        scanned++;
+        for (uint64_t p = b->offset; p < b->end; )
+        {
+            uint64_t              len;
+            debug_capture_entry_t kind = debug_capture_entry(m->buf, b->end, p, &len);
+            debug_line_t          ln;
+
+            if (DEBUG_CAPTURE_NONE == kind)
+            {
+                break;
+            }
+            if (DEBUG_CAPTURE_LINE == kind)
+            {
+                (void)debug_line_parse((const char *)&m->buf[p], (size_t)len, &ln);
+                if (0 != idx_line_matches(&ln, q))
+                {
+                    matches++;
+                    if (0 == q->count_only)
+                    {
+                        fwrite(&m->buf[p], 1, (size_t)len, stdout);
+                    }
+                }
+            }
+            p += len;
+        }
+    }
+
+    if (0 != q->count_only)
+    {
+        printf("%llu\n", (unsigned long long)matches);
+    }
+    if (0 != verbose)
+    {
+        fprintf(stderr, "%llu matches, %u of %u blocks scanned in %.2f ms\n",
+                (unsigned long long)matches, scanned, idx->hdr.block_count,
+                idx_now_ms() - t0);
+    }
+
+    return 0;
+}
+
+static void cmd_stats(const idx_t *idx)
+{
+    uint64_t level_blocks[DEBUG_LINE_LEVELS] = { 0 };
+    uint64_t any_thread = 0;
+
+    for (uint32_t i = 0; i < idx->hdr.block_count; i++)
+    {
+        for (unsigned l = 0; l < DEBUG_LINE_LEVELS; l++)
+        {
+            level_blocks[l] += (idx->blocks[i].level_mask >> l) & 1U;
+        }
+        any_thread += (idx->blocks[i].flags & IDX_BLOCK_ANY_THREAD) ? 1U : 0U;
+    }
+
+    printf("indexed bytes : %llu\n", (unsigned long long)idx->hdr.indexed_size);
+    printf("lines         : %llu\n", (unsigned long long)idx->hdr.lines);
+    printf("records       : %llu\n", (unsigned long long)idx->hdr.records);
+    printf("blocks        : %u (%zu bytes of index)\n", idx->hdr.block_count,
+           sizeof(idx_header_t) + (idx->hdr.block_count * sizeof(idx_block_t)) +
+           (idx->hdr.thread_count * IDX_THREAD_NAME));
+    printf("seq sorted    : %s\n", (idx->hdr.flags & IDX_SEQ_SORTED) ? "yes" : "no");
+    printf("time sorted   : %s\n", (idx->hdr.flags & IDX_TS_SORTED) ? "yes" : "no");
+    for (unsigned l = 0; l < DEBUG_LINE_LEVELS; l++)
+    {
+        printf("blocks %-6s : %llu\n", debug_line_level_name((int)l),
+               (unsigned long long)level_blocks[l]);
+    }
+    printf("threads       : %u%s\n", idx->hdr.thread_count,
+           (0U != any_thread) ? " (table full, some blocks untracked)" : "");
+    for (uint32_t i = 0; i < idx->hdr.thread_count; i++)
+    {
+        uint64_t n = 0;
+
+        for (uint32_t k = 0; k < idx->hdr.block_count; k++)
+        {
+            n += (idx->blocks[k].thread_mask >> i) & 1U;
+        }
+        printf("  %-*s %llu blocks\n", (int)IDX_THREAD_NAME, idx->threads[i],
+               (unsigned long long)n);
+    }
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: log_index build [-j N] [--follow] [--interval MS] capture\n"
+            "       log_index query [--seq A-B] [--time A-B] [--level L[,L..]]\n"
+            "                       [--thread NAME] [--count] [-v] capture\n"
+            "       log_index stats capture\n");
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    idx_query_t q        = { 0 };
+    unsigned    jobs     = (unsigned)sysconf(_SC_NPROCESSORS_ONLN);
+    int         follow   = 0;
+    long        interval = 500;
+    int         verbose  = 0;
+    const char *capture  = NULL;
+
+    if (argc < 3)
+    {
+        usage();
+        return 2;
+    }
+
+    const char *cmd = argv[1];
+
+    for (int i = 2; i < argc; i++)
+    {
+        const char *a   = argv[i];
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+        int         bad = 0;
+
+        if ((0 == strcmp(a, "-j")) && (NULL != val))
+        {
+            jobs = (unsigned)strtoul(val, NULL, 0);
+            i++;
+        }
+        else if (0 == strcmp(a, "--follow"))
+        {
+            follow = 1;
+        }
+        else if ((0 == strcmp(a, "--interval")) && (NULL != val))
+        {
+            interval = strtol(val, NULL, 0);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--seq")) && (NULL != val))
+        {
+            bad = idx_parse_range(val, &q.seq_lo, &q.seq_hi);
+            q.use_seq = 1;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--time")) && (NULL != val))
+        {
+            bad = idx_parse_range(val, &q.ts_lo, &q.ts_hi);
+            q.use_ts = 1;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--level")) && (NULL != val))
+        {
+            bad = idx_parse_levels(val, &q.levels);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--thread")) && (NULL != val))
+        {
+            q.thread = val;
+            i++;
+        }
+        else if (0 == strcmp(a, "--count"))
+        {
+            q.count_only = 1;
+        }
+        else if (0 == strcmp(a, "-v"))
+        {
+            verbose = 1;
+        }
+        else if (('-' != a[0]) && (NULL == capture))
+        {
+            capture = a;
+        }
+        else
+        {
+            bad = 1;
+        }
+
+        if (0 != bad)
+        {
+            fprintf(stderr, "log_index: bad argument '%s'\n", a);
+            return 2;
+        }
+    }
+
+    if (NULL == capture)
+    {
+        usage();
+        return 2;
+    }
+
+    idx_t     idx = { 0 };
+    debug_capture_map_t m   = { .fd = -1 };
+    int       rc  = 0;
+
+    if (0 == strcmp(cmd, "build"))
+    {
+        rc = idx_open(&idx, &m, capture, jobs, 1);
+
+        while ((0 == rc) && (0 != follow))
+        {
+            usleep((useconds_t)interval * 1000U);
+            rc = idx_open(&idx, &m, capture, jobs, 0);
+        }
+    }
+    else if (0 == strcmp(cmd, "query"))
+    {
+        rc = idx_open(&idx, &m, capture, jobs, verbose);
+        if (0 == rc)
+        {
+            rc = cmd_query(&idx, &m, &q, verbose);
+        }
+    }
+    else if (0 == strcmp(cmd, "stats"))
+    {
+        rc = idx_open(&idx, &m, capture, jobs, 0);
+        if (0 == rc)
+        {
+            cmd_stats(&idx);
+        }
+    }
+    else
+    {
+        usage();
+        rc = 2;
+    }
+
+    debug_capture_unmap(&m);
+    free(idx.blocks);
+
+    return (0 == rc) ? 0 : ((2 == rc) ? 2 : 1);
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,1492 @@
+/**
+ * @file      log_ingest.c
+ * @brief     Live receiver for the debug stream of a serial or CDC port.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Reads the device stream from a tty (or a pty loopback), splits it into
+ * lines and records, parses the line prefix and accounts the sequence
+ * numbers, so lost and reordered lines are counted instead of guessed.
+ *
+ * Every line is stamped with the host wall-clock time of the read that
+ * completed it. With --tick-hz, the device timestamp is converted to
+ * seconds and the transport latency is measured: the host-minus-device
+ * time difference is compared against its minimum over the last
+ * INGEST_FLOOR_SECONDS seconds (the fastest line seen), so the result is
+ * the queueing delay on top of the fixed link delay, and a slow clock
+ * drift between device and host does not skew it.
+ *
+ * Output fan-out, all from one epoll loop:
+ *  - -o FILE     : lines prefixed with the host time ("sec.usec ") plus
+ *                  "# gap" markers where lines were lost
+ *  - --raw FILE  : the unmodified byte stream (for debug_decode/log_index)
+ *  - --listen P  : UNIX stream socket; every subscriber gets the -o
+ *                  output. A subscriber that cannot keep up loses lines
+ *                  (counted) once INGEST_SUB_BUFFER bytes are queued.
+ *
+ * Clock correlation: with --ping MS the tool sends a ping record every MS
+ * milliseconds on the same port (firmware built with DEBUG_ENABLE_SYNC
+ * answers from debug_service()). Each pong gives the device time at
+ * which the ping was read and the pong sent; with the host send and
+ * receive times this bounds the host time of the device instant to half
+ * the round trip. The samples are fitted (weighted by 1 / rtt^2) to the
+ * device clock offset and drift, reported with the statistics, and
+ * written to -o as
+ *
+ * @code
+ *   # sync ts=123456 frac=0.000412345 hz=1000 host=1760680000.1234567 rtt=182.4
+ * @endcode
+ *
+ * lines for log_merge. The tick and cycle counter rates come from the
+ * device's sync beacons (DEBUG_RECORD_SYNC), or --tick-hz.
+ *
+ * Firmware built with DEBUG_WIRE_INTERNED sends log records instead of
+ * text; they are rendered back to text lines (debug_wire.c) and then
+ * handled like any other line. Lines with the compact prefix
+ * (DEBUG_ENABLE_COMPACT_PREFIX) get their full prefix back the same way.
+ *
+ * Statistics go to stderr every --stats seconds and on exit (SIGINT or
+ * end of input). With --reopen a vanished port (USB re-enumeration) is
+ * reopened once per second.
+ *
+ * --loopback replaces the device by a child process writing synthetic
+ * lines into a pty, optionally dropping and swapping lines, and prints
+ * what it injected so the accounting can be checked. Its clock runs
+ * INGEST_LOOP_DRIFT fast and it answers pings, so --ping can be checked
+ * the same way.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o log_ingest \
+ *       log_ingest.c ../common/debug_stream.c ../common/debug_line.c \
+ *       ../common/debug_seq.c ../common/debug_clock.c \
+ *       ../common/debug_wire.c -lm
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   log_ingest [--baud N] [--tick-hz HZ] [-o FILE] [--raw FILE]
+ *              [--listen SOCKET] [--stats SEC] [--reopen] [--ping MS]
+ *              /dev/ttyACM0
+ *   log_ingest --loopback [--count N] [--rate LINES_PER_S]
+ *              [--drop PERMILLE] [--swap PERMILLE] [options]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "debug_stream.h"
+#include "debug_line.h"
+#include "debug_seq.h"
+#include "debug_clock.h"
+#include "debug_wire.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+#define INGEST_READ_SIZE        65536U
+#define INGEST_MAX_SUBS         32U
+#define INGEST_SUB_BUFFER       (1U << 20)  /**< Queued bytes per subscriber */
+#define INGEST_FLOOR_SECONDS    10U         /**< Latency floor window */
+#define INGEST_HIST_US          10U         /**< Latency bucket width */
+#define INGEST_HIST_BUCKETS     100000U     /**< Up to 1 s, then overflow */
+#define INGEST_LINE_MAX         (DEBUG_STREAM_MAX_LINE + 64U)
+#define INGEST_PONG_MAX_RTT     1.0         /**< Older pongs are stale */
+#define INGEST_LOOP_DRIFT       25e-6       /**< Loopback device clock error */
+#define INGEST_LOOP_TICK_HZ     1000000.0   /**< Loopback timestamp rate */
+#define INGEST_LOOP_CYCLES_HZ   100000000.0 /**< Loopback cycle counter rate */
+
+/* epoll tags */
+#define TAG_INPUT   0U
+#define TAG_LISTEN  1U
+#define TAG_TIMER   2U
+#define TAG_SIGNAL  3U
+#define TAG_PING    4U
+#define TAG_SUB     16U     /**< TAG_SUB + subscriber index */
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Socket subscriber */
+typedef struct
+{
+    int      fd;            /**< -1 = free slot */
+    char    *buf;           /**< Bytes not yet accepted by the socket */
+    size_t   len;
+    uint64_t dropped;       /**< Lines lost to back-pressure */
+} ingest_sub_t;
+
+/** @brief Loopback generator settings */
+typedef struct
+{
+    uint64_t count;         /**< Lines to send */
+    uint64_t rate;          /**< Lines per second, 0 = unthrottled */
+    unsigned drop;          /**< Per-mille of lines skipped */
+    unsigned swap;          /**< Per-mille of lines sent after the next */
+} ingest_loop_t;
+
+/** @brief Receiver state */
+typedef struct
+{
+    int             ep;
+    int             in_fd;
+    const char     *in_path;
+    speed_t         baud;
+    int             reopen;
+    debug_stream_t  stream;
+    debug_seq_t     seq;
+    debug_wire_t    wire;           /**< Interned string dictionary */
+    debug_line_compact_t compact;   /**< Compact prefix expander */
+    FILE           *out;
+    FILE           *raw;
+    int             listen_fd;
+    ingest_sub_t    subs[INGEST_MAX_SUBS];
+
+    /* Arrival time of the current read */
+    struct timespec now;
+
+    /* Latency */
+    double          tick_hz;
+    double          floor_min[INGEST_FLOOR_SECONDS]; /**< Per-second minima */
+    uint64_t        floor_sec[INGEST_FLOOR_SECONDS]; /**< Second of each slot */
+    uint64_t       *hist;
+    uint64_t        hist_over;
+    uint64_t        hist_count;
+    double          lat_max;
+
+    /* Clock correlation */
+    debug_clock_dev_t dev;
+    debug_clock_t   clock;
+    int             ping;           /**< --ping given */
+    uint32_t        ping_id;
+    uint64_t        pings;
+    uint64_t        pongs;
+    uint64_t        pongs_stale;
+    uint64_t        syncs;
+    double          rtt_min;
+
+    /* Counters */
+    uint64_t        bytes;
+    uint64_t        lines;
+    uint64_t        no_seq;
+    uint64_t        sub_dropped;
+    uint64_t        last_lines;
+    double          started;
+    double          last_report;
+} ingest_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static const struct { unsigned long rate; speed_t code; } BAUD_RATES[] =
+{
+    { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 },
+    { 57600, B57600 }, { 115200, B115200 }, { 230400, B230400 },
+    { 460800, B460800 }, { 921600, B921600 }, { 1000000, B1000000 },
+    { 2000000, B2000000 }, { 3000000, B3000000 }, { 4000000, B4000000 },
+};
+
+/*******************************************************************************
+ * Private Functions
+ *******************************************************************************/
+
+static double ts_seconds(const struct timespec *t)
+{
+    return (double)t->tv_sec + ((double)t->tv_nsec / 1e9);
+}
+
+static double mono_now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ts_seconds(&t);
+}
+
+/** @brief Frame a record into buf, return its length */
+static size_t record_frame(uint8_t *buf, uint8_t type, const void *payload,
+                           size_t len)
+{
+    buf[0] = DEBUG_RECORD_MARKER;
+    buf[1] = type;
+    buf[2] = (uint8_t)(len & 0xFFU);
+    buf[3] = (uint8_t)(len >> 8);
+    memcpy(&buf[DEBUG_RECORD_HEADER_SIZE], payload, len);
+    buf[DEBUG_RECORD_HEADER_SIZE + len] =
+        debug_record_crc8(0, &buf[1], (DEBUG_RECORD_HEADER_SIZE - 1U) + len);
+
+    return DEBUG_RECORD_HEADER_SIZE + len + DEBUG_RECORD_TRAILER_SIZE;
+}
+
+static int set_raw(int fd, speed_t baud)
+{
+    struct termios tio;
+
+    if (0 != tcgetattr(fd, &tio))
+    {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    if (0 != baud)
+    {
+        cfsetispeed(&tio, baud);
+        cfsetospeed(&tio, baud);
+    }
+
+    return tcsetattr(fd, TCSANOW, &tio);
+}
+
+/*------------------------------------------------------------------------------
+ * Fan-out
+ *----------------------------------------------------------------------------*/
+
+static void sub_close(ingest_t *g, unsigned i)
+{
+    ingest_sub_t *s = &g->subs[i];
+
+    g->sub_dropped += s->dropped;
+    epoll_ctl(g->ep, EPOLL_CTL_DEL, s->fd, NULL);
+    close(s->fd);
+    free(s->buf);
+    memset(s, 0, sizeof(*s));
+    s->fd = -1;
+}
+
+static void sub_flush(ingest_t *g, unsigned i)
+{
+    ingest_sub_t *s = &g->subs[i];
+
+    while (s->len > 0U)
+    {
+        ssize_t n = send(s->fd, s->buf, s->len, MSG_NOSIGNAL);
+
+        if (n < 0)
+        {
+            if ((EAGAIN != errno) && (EINTR != errno))
+            {
+                sub_close(g, i);
+            }
+            break;
+        }
+        memmove(s->buf, &s->buf[n], s->len - (size_t)n);
+        s->len -= (size_t)n;
+    }
+
+    if (s->fd >= 0)
+    {
+        struct epoll_event ev = { .data.u32 = TAG_SUB + i };
+
+        ev.events = EPOLLIN | EPOLLRDHUP | ((s->len > 0U) ? EPOLLOUT : 0U);
+        epoll_ctl(g->ep, EPOLL_CTL_MOD, s->fd, &ev);
+    }
+}
+
+static void sub_send(ingest_t *g, unsigned i, const char *data, size_t len)
+{
+    ingest_sub_t *s = &g->subs[i];
+
+    /* Fast path: nothing queued, hand it to the socket directly */
+    if (0U == s->len)
+    {
+        ssize_t n = send(s->fd, data, len, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if ((size_t)n == len)
+        {
+            return;
+        }
+        if ((n < 0) && (EAGAIN != errno) && (EINTR != errno))
+        {
+            sub_close(g, i);
+            return;
+        }
+        if (n > 0)
+        {
+            data += n;
+            len  -= (size_t)n;
+        }
+    }
+
+    if ((s->len + len) > INGEST_SUB_BUFFER)
+    {
+        s->dropped++;
+        return;
+    }
+    if (NULL == s->buf)
+    {
+        s->buf = malloc(INGEST_SUB_BUFFER);
+        if (NULL == s->buf)
+        {
+            s->dropped++;
+            return;
+        }
+    }
+
+    int was_empty = (0U == s->len);
+
+    memcpy(&s->buf[s->len], data, len);
+    s->len += len;
+
+    if (0 != was_empty)
+    {
+        sub_flush(g, i);    /* Arms EPOLLOUT */
+    }
+}
+
+static void emit(ingest_t *g, const char *data, size_t len)
+{
+    if (NULL != g->out)
+    {
+        fwrite(data, 1, len, g->out);
+    }
+    for (unsigned i = 0; i < INGEST_MAX_SUBS; i++)
+    {
+        if (g->subs[i].fd >= 0)
+        {
+            sub_send(g, i, data, len);
+        }
+    }
+}
+
+static void sub_accept(ingest_t *g)
+{
+    int fd = accept4(g->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    for (unsigned i = 0; i < INGEST_MAX_SUBS; i++)
+    {
+        if (g->subs[i].fd < 0)
+        {
+            struct epoll_event ev = { .events = EPOLLIN | EPOLLRDHUP,
+                                      .data.u32 = TAG_SUB + i };
+
+            g->subs[i].fd = fd;
+            epoll_ctl(g->ep, EPOLL_CTL_ADD, fd, &ev);
+            return;
+        }
+    }
+
+    close(fd);      /* No free slot */
+}
+
+static int listen_open(const char *path)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if ((fd < 0) ||
+        (0 != bind(fd, (struct sockaddr *)&addr, sizeof(addr))) ||
+        (0 != listen(fd, 8)))
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+
+    return fd;
+}
+
+/*------------------------------------------------------------------------------
+ * Latency
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Minimum of (host - device) over the floor window.
+ */
+static double latency_floor(ingest_t *g, double diff)
+{
+    uint64_t sec  = (uint64_t)g->now.tv_sec;
+    unsigned slot = (unsigned)(sec % INGEST_FLOOR_SECONDS);
+    double   min  = diff;
+
+    if (g->floor_sec[slot] != sec)
+    {
+        g->floor_sec[slot] = sec;
+        g->floor_min[slot] = diff;
+    }
+    else if (diff < g->floor_min[slot])
+    {
+        g->floor_min[slot] = diff;
+    }
+
+    for (unsigned i = 0; i < INGEST_FLOOR_SECONDS; i++)
+    {
+        if (((sec - g->floor_sec[i]) < INGEST_FLOOR_SECONDS) &&
+            (g->floor_min[i] < min))
+        {
+            min = g->floor_min[i];
+        }
+    }
+
+    return min;
+}
+
+static void latency_add(ingest_t *g, uint64_t dev_ts)
+{
+    double diff = ts_seconds(&g->now) - ((double)dev_ts / g->tick_hz);
+    double lat  = diff - latency_floor(g, diff);
+    double us   = lat * 1e6;
+
+    if (lat > g->lat_max)
+    {
+        g->lat_max = lat;
+    }
+
+    uint64_t bucket = (uint64_t)(us / INGEST_HIST_US);
+
+    if (bucket < INGEST_HIST_BUCKETS)
+    {
+        g->hist[bucket]++;
+    }
+    else
+    {
+        g->hist_over++;
+    }
+    g->hist_count++;
+}
+
+/**
+ * @brief Latency percentile in milliseconds.
+ */
+static double latency_pct(const ingest_t *g, double pct)
+{
+    uint64_t want = (uint64_t)((double)g->hist_count * pct);
+    uint64_t sum  = 0;
+
+    for (unsigned i = 0; i < INGEST_HIST_BUCKETS; i++)
+    {
+        sum += g->hist[i];
+        if (sum > want)
+        {
+            return ((double)(i + 1U) * INGEST_HIST_US) / 1000.0;
+        }
+    }
+
+    return g->lat_max * 1000.0;
+}
+
+/*------------------------------------------------------------------------------
+ * Stream handling
+ *----------------------------------------------------------------------------*/
+
+static void on_text(void *user, const char *line, size_t len)
+{
+    ingest_t    *g = user;
+    debug_line_t ln;
+    char         buf[INGEST_LINE_MAX];
+    char         full[INGEST_LINE_MAX];
+    int          n;
+
+    switch (debug_line_expand(&g->compact, line, len, &ln))
+    {
+        case DEBUG_LINE_BINDING:
+            return;
+
+        case DEBUG_LINE_EXPANDED:
+            len  = debug_line_format(&ln, full, sizeof(full));
+            line = full;
+            break;
+
+        default:
+            break;
+    }
+
+    g->lines++;
+
+    if (0U != (ln.fields & DEBUG_LINE_HAS_SEQ))
+    {
+        uint64_t           missing = g->seq.missing;
+        debug_seq_result_t r       = debug_seq_push(&g->seq, (uint32_t)ln.seq);
+
+        if (DEBUG_SEQ_GAP == r)
+        {
+            n = snprintf(buf, sizeof(buf), "# gap: %llu line(s) lost before seq %llu\n",
+                         (unsigned long long)(g->seq.missing - missing),
+                         (unsigned long long)ln.seq);
+            emit(g, buf, (size_t)n);
+        }
+        else if (DEBUG_SEQ_RESET == r)
+        {
+            n = snprintf(buf, sizeof(buf), "# reset: sequence restarted at %llu\n",
+                         (unsigned long long)ln.seq);
+            emit(g, buf, (size_t)n);
+
+            /* New device clock */
+            debug_clock_dev_init(&g->dev, g->dev.tick_hz, g->dev.cycles_hz);
+            debug_clock_free(&g->clock);
+            debug_clock_init(&g->clock, 0, 0.0);
+        }
+    }
+    else
+    {
+        g->no_seq++;
+    }
+
+    if ((g->tick_hz > 0.0) && (0U != (ln.fields & DEBUG_LINE_HAS_TS)))
+    {
+        latency_add(g, ln.ts);
+    }
+
+    n = snprintf(buf, sizeof(buf), "%lld.%06ld %.*s\n", (long long)g->now.tv_sec,
+                 g->now.tv_nsec / 1000L, (int)len, line);
+    if (n > 0)
+    {
+        emit(g, buf, ((size_t)n < sizeof(buf)) ? (size_t)n : (sizeof(buf) - 1U));
+    }
+}
+
+static void on_pong(ingest_t *g, const debug_pong_record_t *rec)
+{
+    double t4 = ts_seconds(&g->now);
+    double t1 = (double)rec->host_time / 1e9;
+    double frac;
+
+    if (!(g->dev.tick_hz > 0.0))
+    {
+        g->pongs_stale++;       /* Rates unknown until the first beacon */
+        return;
+    }
+
+    double rx  = debug_clock_dev_time(&g->dev, rec->rx_timestamp, rec->rx_cycles, NULL);
+    double tx  = debug_clock_dev_time(&g->dev, rec->tx_timestamp, rec->tx_cycles, &frac);
+    double rtt = (t4 - t1) - (tx - rx);
+
+    if ((t4 < t1) || (rtt > INGEST_PONG_MAX_RTT))
+    {
+        g->pongs_stale++;
+        return;
+    }
+    if (rtt < 1e-6)
+    {
+        rtt = 1e-6;
+    }
+
+    /* Host time of the pong's tx instant: midpoint plus the device's turnaround half */
+    double host = ((t1 + t4) / 2.0) + ((tx - rx) / 2.0);
+
+    g->pongs++;
+    if ((0.0 == g->rtt_min) || (rtt < g->rtt_min))
+    {
+        g->rtt_min = rtt;
+    }
+    (void)debug_clock_add(&g->clock, tx, host, 1.0 / (rtt * rtt));
+
+    char buf[160];
+    int  n = snprintf(buf, sizeof(buf),
+                      "# sync ts=%lu frac=%.9f hz=%.0f host=%.7f rtt=%.1f\n",
+                      (unsigned long)rec->tx_timestamp, frac, g->dev.tick_hz,
+                      host, rtt * 1e6);
+    emit(g, buf, (size_t)n);
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    ingest_t *g = user;
+
+    if ((DEBUG_RECORD_SYNC == type) && (len >= sizeof(debug_sync_record_t)))
+    {
+        debug_sync_record_t rec;
+
+        memcpy(&rec, payload, sizeof(rec));
+        g->syncs++;
+        if ((0U != rec.tick_hz) &&
+            (((double)rec.tick_hz != g->dev.tick_hz) ||
+             ((double)rec.cycles_hz != g->dev.cycles_hz)))
+        {
+            debug_clock_dev_init(&g->dev, rec.tick_hz, rec.cycles_hz);
+            debug_clock_free(&g->clock);
+            debug_clock_init(&g->clock, 0, 0.0);
+            if (!(g->tick_hz > 0.0))
+            {
+                g->tick_hz = rec.tick_hz;   /* Enables the latency figures */
+            }
+        }
+        if (g->dev.tick_hz > 0.0)
+        {
+            (void)debug_clock_dev_time(&g->dev, rec.timestamp, rec.cycles, NULL);
+        }
+    }
+    else if ((DEBUG_RECORD_PONG == type) && (len >= sizeof(debug_pong_record_t)))
+    {
+        debug_pong_record_t rec;
+
+        memcpy(&rec, payload, sizeof(rec));
+        on_pong(g, &rec);
+    }
+    else if (DEBUG_RECORD_DICT == type)
+    {
+        debug_wire_define(&g->wire, payload, len);
+    }
+    else if ((DEBUG_RECORD_LOG == type) || (DEBUG_RECORD_ARRAY == type))
+    {
+        char line[DEBUG_STREAM_MAX_LINE];
+        int  n = (DEBUG_RECORD_LOG == type) ?
+                 debug_wire_render(&g->wire, payload, len, line, sizeof(line)) :
+                 debug_wire_render_array(&g->wire, payload, len, line, sizeof(line));
+
+        if (n >= 0)
+        {
+            on_text(g, line, (size_t)n);
+        }
+    }
+}
+
+static void ping_send(ingest_t *g)
+{
+    debug_ping_record_t ping;
+    uint8_t             frame[DEBUG_RECORD_HEADER_SIZE + sizeof(ping) +
+                              DEBUG_RECORD_TRAILER_SIZE];
+    struct timespec     now;
+
+    if (g->in_fd < 0)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    ping.id        = ++g->ping_id;
+    ping.host_time = ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+
+    size_t n = record_frame(frame, DEBUG_RECORD_PING, &ping, sizeof(ping));
+
+    if (write(g->in_fd, frame, n) == (ssize_t)n)
+    {
+        g->pings++;
+    }
+}
+
+static int input_open(ingest_t *g)
+{
+    int fd = open(g->in_path, ((0 != g->ping) ? O_RDWR : O_RDONLY) |
+                              O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (isatty(fd))
+    {
+        (void)set_raw(fd, g->baud);
+    }
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_INPUT };
+
+    if (0 != epoll_ctl(g->ep, EPOLL_CTL_ADD, fd, &ev))
+    {
+        close(fd);
+        return -1;
+    }
+
+    g->in_fd = fd;
+    return 0;
+}
+
+/**
+ * @brief Drain the input.
+ *
+ * @return 0 while the input is open, -1 once it has ended
+ */
+static int input_read(ingest_t *g)
+{
+    static uint8_t data[INGEST_READ_SIZE];
+
+    for (;;)
+    {
+        ssize_t n = read(g->in_fd, data, sizeof(data));
+
+        if (n > 0)
+        {
+            clock_gettime(CLOCK_REALTIME, &g->now);
+            g->bytes += (uint64_t)n;
+            if (NULL != g->raw)
+            {
+                fwrite(data, 1, (size_t)n, g->raw);
+            }
+            debug_stream_feed(&g->stream, data, (size_t)n);
+            continue;
+        }
+        if ((n < 0) && (EINTR == errno))
+        {
+            continue;
+        }
+        if ((n < 0) && (EAGAIN == errno))
+        {
+            return 0;
+        }
+
+        /* EOF, or EIO once the other side of a tty/pty is gone */
+        epoll_ctl(g->ep, EPOLL_CTL_DEL, g->in_fd, NULL);
+        close(g->in_fd);
+        g->in_fd = -1;
+        debug_stream_finish(&g->stream);
+        return -1;
+    }
+}
+
+static void report_clock(const ingest_t *g)
+{
+    debug_clock_fit_t fit;
+
+    if (0 != debug_clock_solve(&g->clock, &fit))
+    {
+        return;
+    }
+
+    fprintf(stderr, "clock        : host = dev %+.6f s, drift %+.3f ppm, "
+            "jitter %.1f us, rtt min %.1f us (%llu points)\n",
+            debug_clock_map(&fit, fit.t0) - fit.t0, fit.drift * 1e6,
+            fit.jitter * 1e6, g->rtt_min * 1e6, (unsigned long long)fit.points);
+}
+
+static void report(ingest_t *g, int final)
+{
+    double   now  = mono_now();
+    double   span = now - g->last_report;
+    uint64_t dropped = g->sub_dropped;
+    unsigned subs = 0;
+
+    for (unsigned i = 0; i < INGEST_MAX_SUBS; i++)
+    {
+        if (g->subs[i].fd >= 0)
+        {
+            dropped += g->subs[i].dropped;
+            subs++;
+        }
+    }
+
+    if (0 == final)
+    {
+        fprintf(stderr, "lines %llu (%.0f/s) records %llu lost %llu gaps %llu "
+                "late %llu dup %llu resets %llu",
+                (unsigned long long)g->lines,
+                (span > 0.0) ? ((double)(g->lines - g->last_lines) / span) : 0.0,
+                (unsigned long long)g->stream.records,
+                (unsigned long long)g->seq.missing,
+                (unsigned long long)g->seq.gaps,
+                (unsigned long long)g->seq.late,
+                (unsigned long long)g->seq.duplicates,
+                (unsigned long long)g->seq.resets);
+        if (0U != g->hist_count)
+        {
+            fprintf(stderr, " latency p50 %.2f p99 %.2f max %.2f ms",
+                    latency_pct(g, 0.50), latency_pct(g, 0.99),
+                    g->lat_max * 1000.0);
+        }
+        fprintf(stderr, " subs %u dropped %llu\n", subs,
+                (unsigned long long)dropped);
+        report_clock(g);
+
+        g->last_lines  = g->lines;
+        g->last_report = now;
+        return;
+    }
+
+    double total = now - g->started;
+
+    fprintf(stderr, "bytes        : %llu\n", (unsigned long long)g->bytes);
+    fprintf(stderr, "lines        : %llu (%.0f/s), %llu without seq\n",
+            (unsigned long long)g->lines,
+            (total > 0.0) ? ((double)g->lines / total) : 0.0,
+            (unsigned long long)g->no_seq);
+    fprintf(stderr, "records      : %llu (%llu bad CRC)\n",
+            (unsigned long long)g->stream.records,
+            (unsigned long long)g->stream.crc_errors);
+    if (0U != g->wire.rendered)
+    {
+        fprintf(stderr, "interned     : %llu lines, %llu unknown format, "
+                "%llu bad args\n", (unsigned long long)g->wire.rendered,
+                (unsigned long long)g->wire.unknown,
+                (unsigned long long)g->wire.malformed);
+    }
+    fprintf(stderr, "lost         : %llu in %llu gaps (largest %llu)\n",
+            (unsigned long long)g->seq.missing,
+            (unsigned long long)g->seq.gaps,
+            (unsigned long long)g->seq.max_gap);
+    fprintf(stderr, "late         : %llu (up to %llu behind)\n",
+            (unsigned long long)g->seq.late,
+            (unsigned long long)g->seq.max_late);
+    fprintf(stderr, "duplicates   : %llu\n", (unsigned long long)g->seq.duplicates);
+    fprintf(stderr, "resets       : %llu\n", (unsigned long long)g->seq.resets);
+    if (0U != g->hist_count)
+    {
+        fprintf(stderr, "latency (ms) : p50 %.3f p90 %.3f p99 %.3f p99.9 %.3f max %.3f\n",
+                latency_pct(g, 0.50), latency_pct(g, 0.90),
+                latency_pct(g, 0.99), latency_pct(g, 0.999),
+                g->lat_max * 1000.0);
+    }
+    fprintf(stderr, "sub dropped  : %llu\n", (unsigned long long)dropped);
+    if ((0 != g->ping) || (0U != g->syncs))
+    {
+        fprintf(stderr, "clock sync   : %llu beacons, %llu pings, %llu pongs (%llu stale)\n",
+                (unsigned long long)g->syncs, (unsigned long long)g->pings,
+                (unsigned long long)g->pongs, (unsigned long long)g->pongs_stale);
+        report_clock(g);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ * Loopback
+ *----------------------------------------------------------------------------*/
+
+static uint32_t loop_rand(uint32_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+static void loopback_write(int fd, const char *data, size_t len)
+{
+    for (size_t off = 0; off < len; )
+    {
+        ssize_t w = write(fd, &data[off], len - off);
+
+        if (w < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            _exit(1);
+        }
+        off += (size_t)w;
+    }
+}
+
+/** @brief Loopback device clock and request parser */
+typedef struct
+{
+    int            fd;
+    debug_stream_t rx;
+    uint32_t       rx_ts;       /**< Device time of the current read */
+    uint32_t       rx_cycles;
+    double         next_sync;
+} ingest_loop_dev_t;
+
+/** @brief Device time: CLOCK_MONOTONIC running INGEST_LOOP_DRIFT fast */
+static double loop_dev_time(uint32_t *ts, uint32_t *cycles)
+{
+    double dev = mono_now() * (1.0 + INGEST_LOOP_DRIFT);
+
+    if (NULL != ts)
+    {
+        *ts = (uint32_t)(uint64_t)(dev * INGEST_LOOP_TICK_HZ);
+    }
+    if (NULL != cycles)
+    {
+        *cycles = (uint32_t)(uint64_t)(dev * INGEST_LOOP_CYCLES_HZ);
+    }
+    return dev;
+}
+
+/** @brief Answer a ping like debug_service() does */
+static void loop_on_record(void *user, uint8_t type, const uint8_t *payload,
+                           size_t len)
+{
+    ingest_loop_dev_t  *d = user;
+    debug_ping_record_t ping;
+    debug_pong_record_t pong;
+    uint8_t             frame[DEBUG_RECORD_HEADER_SIZE + sizeof(pong) +
+                              DEBUG_RECORD_TRAILER_SIZE];
+    uint32_t            tx_ts;
+    uint32_t            tx_cycles;
+
+    if ((DEBUG_RECORD_PING != type) || (len < sizeof(ping)))
+    {
+        return;
+    }
+    memcpy(&ping, payload, sizeof(ping));
+
+    pong.id           = ping.id;
+    pong.host_time    = ping.host_time;
+    pong.rx_timestamp = d->rx_ts;
+    pong.rx_cycles    = d->rx_cycles;
+    (void)loop_dev_time(&tx_ts, &tx_cycles);
+    pong.tx_timestamp = tx_ts;
+    pong.tx_cycles    = tx_cycles;
+
+    loopback_write(d->fd, (const char *)frame,
+                   record_frame(frame, DEBUG_RECORD_PONG, &pong, sizeof(pong)));
+}
+
+/**
+ * @brief Serve pings and beacons, waiting up to @p wait seconds for input.
+ */
+static void loop_service(ingest_loop_dev_t *d, double wait)
+{
+    struct pollfd pfd = { .fd = d->fd, .events = POLLIN };
+
+    for (;;)
+    {
+        struct timespec ts = { .tv_sec  = (time_t)wait,
+                               .tv_nsec = (long)((wait - (double)(time_t)wait) * 1e9) };
+
+        if (ppoll(&pfd, 1, &ts, NULL) <= 0)
+        {
+            break;
+        }
+
+        uint8_t buf[256];
+        ssize_t n = read(d->fd, buf, sizeof(buf));
+
+        if (n <= 0)
+        {
+            break;
+        }
+        (void)loop_dev_time(&d->rx_ts, &d->rx_cycles);
+        debug_stream_feed(&d->rx, buf, (size_t)n);
+        wait = 0.0;
+    }
+
+    if (mono_now() >= d->next_sync)
+    {
+        debug_sync_record_t rec;
+        uint8_t             frame[DEBUG_RECORD_HEADER_SIZE + sizeof(rec) +
+                                  DEBUG_RECORD_TRAILER_SIZE];
+        uint32_t            ts;
+        uint32_t            cycles;
+
+        (void)loop_dev_time(&ts, &cycles);
+        memset(&rec, 0, sizeof(rec));
+        rec.version   = DEBUG_SYNC_VERSION;
+        rec.timestamp = ts;
+        rec.tick_hz   = (uint32_t)INGEST_LOOP_TICK_HZ;
+        rec.cycles    = cycles;
+        rec.cycles_hz = (uint32_t)INGEST_LOOP_CYCLES_HZ;
+        loopback_write(d->fd, (const char *)frame,
+                       record_frame(frame, DEBUG_RECORD_SYNC, &rec, sizeof(rec)));
+        d->next_sync = mono_now() + 1.0;
+    }
+}
+
+/**
+ * @brief Generator process: write synthetic lines into the pty slave.
+ *
+ * Timestamps are microseconds of the loopback device clock (use
+ * --tick-hz 1000000 before the first beacon has arrived).
+ */
+static void loopback_child(int fd, const ingest_loop_t *cfg)
+{
+    static const char *const THREADS[] = { "main", "net", "sensor", "ui" };
+    static const char *const LEVELS[]  = { "ERROR", "WARN", "INFO", "DEBUG" };
+    static ingest_loop_dev_t dev;
+    debug_stream_cb_t cb       = { .on_record = loop_on_record };
+    char              out[65536];
+    char              held[256];
+    size_t            held_len = 0;
+    size_t            len      = 0;
+    uint32_t          rng      = 0x9E3779B9UL;
+    uint64_t          dropped  = 0;
+    uint64_t          swapped  = 0;
+    double            t0       = mono_now();
+
+    dev.fd = fd;
+    if (0 != debug_stream_init(&dev.rx, &cb, &dev))
+    {
+        _exit(1);
+    }
+
+    for (uint64_t seq = 1; seq <= cfg->count; seq++)
+    {
+        uint32_t r = loop_rand(&rng);
+
+        if ((r % 1000U) < cfg->drop)
+        {
+            dropped++;
+            continue;
+        }
+
+        char     line[256];
+        double   now = mono_now();
+        int      n   = snprintf(line, sizeof(line),
+                                "[%05llu][%llu][%s][%s] loopback line value=%u\r\n",
+                                (unsigned long long)seq,
+                                (unsigned long long)(loop_dev_time(NULL, NULL) *
+                                                     INGEST_LOOP_TICK_HZ),
+                                THREADS[(r >> 10) % 4U], LEVELS[(r >> 12) % 4U], r);
+
+        if ((0U == held_len) && (((r >> 20) % 1000U) < cfg->swap) &&
+            (seq < cfg->count))
+        {
+            memcpy(held, line, (size_t)n);     /* Sent after the next line */
+            held_len = (size_t)n;
+            swapped++;
+            continue;
+        }
+
+        memcpy(&out[len], line, (size_t)n);
+        len += (size_t)n;
+        if (0U != held_len)
+        {
+            memcpy(&out[len], held, held_len);
+            len     += held_len;
+            held_len = 0;
+        }
+
+        /* Throttle in ~1 ms steps; flush at least that often */
+        int    flush = (len > (sizeof(out) - 512U)) || (seq == cfg->count);
+        double due   = now;
+
+        if (0U != cfg->rate)
+        {
+            due = t0 + ((double)seq / (double)cfg->rate);
+            if (due > now)
+            {
+                flush = 1;
+            }
+        }
+
+        if ((0 != flush) && (len > 0U))
+        {
+            loopback_write(fd, out, len);
+            len = 0;
+        }
+        if (0 != flush)
+        {
+            /* Pings are answered while waiting, as an idle task would */
+            do
+            {
+                loop_service(&dev, (due > now) ? (due - now) : 0.0);
+                now = mono_now();
+            } while (due > now);
+        }
+    }
+
+    /* Trailing lines when the last ones were dropped or held */
+    memcpy(&out[len], held, held_len);
+    loopback_write(fd, out, len + held_len);
+
+    /* Let the reader drain before the slave side closes */
+    (void)tcdrain(fd);
+    fprintf(stderr, "loopback: sent %llu lines, dropped %llu, swapped %llu\n",
+            (unsigned long long)(cfg->count - dropped),
+            (unsigned long long)dropped, (unsigned long long)swapped);
+    _exit(0);
+}
+
+static int loopback_start(ingest_t *g, const ingest_loop_t *cfg, pid_t *pid)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if ((master < 0) || (0 != grantpt(master)) || (0 != unlockpt(master)))
+    {
+        return -1;
+    }
+
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+
+    if ((slave < 0) || (0 != set_raw(slave, 0)))
+    {
+        return -1;
+    }
+
+    *pid = fork();
+    if (*pid < 0)
+    {
+        return -1;
+    }
+    if (0 == *pid)
+    {
+        close(master);
+        loopback_child(slave, cfg);
+    }
+
+    /* The child now holds the only slave descriptor */
+    close(slave);
+    fcntl(master, F_SETFL, O_NONBLOCK);
+    fcntl(master, F_SETFD, FD_CLOEXEC);
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_INPUT };
+
+    if (0 != epoll_ctl(g->ep, EPOLL_CTL_ADD, master, &ev))
+    {
+        return -1;
+    }
+
+    g->in_fd = master;
+    return 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: log_ingest [--baud N] [--tick-hz HZ] [-o FILE] [--raw FILE]\n"
+            "                  [--listen SOCKET] [--stats SEC] [--reopen] [--ping MS] tty\n"
+            "       log_ingest --loopback [--count N] [--rate N] [--drop PERMILLE]\n"
+            "                  [--swap PERMILLE] [options]\n");
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static ingest_t g;
+    ingest_loop_t   loop        = { .count = 1000000U };
+    int             loopback    = 0;
+    const char     *out_path    = NULL;
+    const char     *raw_path    = NULL;
+    const char     *listen_path = NULL;
+    unsigned        stats_every = 10;
+    unsigned        ping_ms     = 0;
+    pid_t           child       = -1;
+
+    g.in_fd     = -1;
+    g.listen_fd = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a   = argv[i];
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(a, "--baud")) && (NULL != val))
+        {
+            unsigned long rate = strtoul(val, NULL, 0);
+
+            for (size_t k = 0; k < (sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0])); k++)
+            {
+                if (BAUD_RATES[k].rate == rate)
+                {
+                    g.baud = BAUD_RATES[k].code;
+                }
+            }
+            if (0 == g.baud)
+            {
+                fprintf(stderr, "log_ingest: unsupported baud rate %lu\n", rate);
+                return 2;
+            }
+            i++;
+        }
+        else if ((0 == strcmp(a, "--tick-hz")) && (NULL != val))
+        {
+            g.tick_hz = strtod(val, NULL);
+            i++;
+        }
+        else if ((0 == strcmp(a, "-o")) && (NULL != val))
+        {
+            out_path = val;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--raw")) && (NULL != val))
+        {
+            raw_path = val;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--listen")) && (NULL != val))
+        {
+            listen_path = val;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--stats")) && (NULL != val))
+        {
+            stats_every = (unsigned)strtoul(val, NULL, 0);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--ping")) && (NULL != val))
+        {
+            ping_ms = (unsigned)strtoul(val, NULL, 0);
+            g.ping  = (0U != ping_ms);
+            i++;
+        }
+        else if (0 == strcmp(a, "--reopen"))
+        {
+            g.reopen = 1;
+        }
+        else if (0 == strcmp(a, "--loopback"))
+        {
+            loopback = 1;
+        }
+        else if ((0 == strcmp(a, "--count")) && (NULL != val))
+        {
+            loop.count = strtoull(val, NULL, 0);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--rate")) && (NULL != val))
+        {
+            loop.rate = strtoull(val, NULL, 0);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--drop")) && (NULL != val))
+        {
+            loop.drop = (unsigned)strtoul(val, NULL, 0);
+            i++;
+        }
+        else if ((0 == strcmp(a, "--swap")) && (NULL != val))
+        {
+            loop.swap = (unsigned)strtoul(val, NULL, 0);
+            i++;
+        }
+        else if (('-' != a[0]) && (NULL == g.in_path))
+        {
+            g.in_path = a;
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    if ((0 == loopback) == (NULL == g.in_path))
+    {
+        usage();
+        return 2;
+    }
+
+    debug_stream_cb_t cb = { .on_text = on_text, .on_record = on_record };
+    sigset_t          sigs;
+
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGTERM);
+    sigprocmask(SIG_BLOCK, &sigs, NULL);
+
+    g.hist = calloc(INGEST_HIST_BUCKETS, sizeof(*g.hist));
+    g.ep   = epoll_create1(EPOLL_CLOEXEC);
+    debug_line_compact_init(&g.compact);
+
+    if ((NULL == g.hist) || (g.ep < 0) || (0 != debug_wire_init(&g.wire)) ||
+        (0 != debug_stream_init(&g.stream, &cb, &g)))
+    {
+        fprintf(stderr, "log_ingest: out of resources\n");
+        return 1;
+    }
+    debug_seq_init(&g.seq);
+    debug_clock_init(&g.clock, 0, 0.0);
+    if (g.tick_hz > 0.0)
+    {
+        debug_clock_dev_init(&g.dev, g.tick_hz, 0.0);
+    }
+
+    for (unsigned i = 0; i < INGEST_MAX_SUBS; i++)
+    {
+        g.subs[i].fd = -1;
+    }
+
+    if ((NULL != out_path) &&
+        (NULL == (g.out = (0 == strcmp(out_path, "-")) ? stdout : fopen(out_path, "a"))))
+    {
+        fprintf(stderr, "log_ingest: %s: %s\n", out_path, strerror(errno));
+        return 1;
+    }
+    if ((NULL != raw_path) && (NULL == (g.raw = fopen(raw_path, "ab"))))
+    {
+        fprintf(stderr, "log_ingest: %s: %s\n", raw_path, strerror(errno));
+        return 1;
+    }
+    if (NULL != listen_path)
+    {
+        g.listen_fd = listen_open(listen_path);
+        if (g.listen_fd < 0)
+        {
+            fprintf(stderr, "log_ingest: cannot listen on %s\n", listen_path);
+            return 1;
+        }
+
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_LISTEN };
+        epoll_ctl(g.ep, EPOLL_CTL_ADD, g.listen_fd, &ev);
+    }
+
+    int sfd = signalfd(-1, &sigs, SFD_NONBLOCK | SFD_CLOEXEC);
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec tick = { .it_interval = { 1, 0 }, .it_value = { 1, 0 } };
+    struct epoll_event ev  = { .events = EPOLLIN, .data.u32 = TAG_SIGNAL };
+
+    epoll_ctl(g.ep, EPOLL_CTL_ADD, sfd, &ev);
+    ev.data.u32 = TAG_TIMER;
+    epoll_ctl(g.ep, EPOLL_CTL_ADD, tfd, &ev);
+    timerfd_settime(tfd, 0, &tick, NULL);
+
+    int pfd = -1;
+
+    if (0U != ping_ms)
+    {
+        struct itimerspec period = {
+            .it_interval = { ping_ms / 1000U, (long)(ping_ms % 1000U) * 1000000L },
+            .it_value    = { ping_ms / 1000U, (long)(ping_ms % 1000U) * 1000000L },
+        };
+
+        pfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        ev.data.u32 = TAG_PING;
+        epoll_ctl(g.ep, EPOLL_CTL_ADD, pfd, &ev);
+        timerfd_settime(pfd, 0, &period, NULL);
+    }
+
+    int rc = (0 != loopback) ? loopback_start(&g, &loop, &child)
+                             : input_open(&g);
+
+    if (0 != rc)
+    {
+        fprintf(stderr, "log_ingest: cannot open %s: %s\n",
+                (0 != loopback) ? "pty" : g.in_path, strerror(errno));
+        return 1;
+    }
+
+    g.started     = mono_now();
+    g.last_report = g.started;
+
+    unsigned ticks   = 0;
+    int      running = 1;
+
+    while (0 != running)
+    {
+        struct epoll_event evs[16];
+        int n = epoll_wait(g.ep, evs, 16, -1);
+
+        for (int k = 0; (k < n) && (0 != running); k++)
+        {
+            uint32_t tag = evs[k].data.u32;
+
+            if (TAG_INPUT == tag)
+            {
+                if ((0 != input_read(&g)) && ((0 == g.reopen) || (0 != loopback)))
+                {
+                    running = 0;
+                }
+            }
+            else if (TAG_LISTEN == tag)
+            {
+                sub_accept(&g);
+            }
+            else if (TAG_SIGNAL == tag)
+            {
+                running = 0;
+            }
+            else if (TAG_PING == tag)
+            {
+                uint64_t expired;
+
+                (void)read(pfd, &expired, sizeof(expired));
+                ping_send(&g);
+            }
+            else if (TAG_TIMER == tag)
+            {
+                uint64_t expired;
+
+                (void)read(tfd, &expired, sizeof(expired));
+                if (NULL != g.out)
+                {
+                    fflush(g.out);
+                }
+                if ((g.in_fd < 0) && (0 != g.reopen))
+                {
+                    (void)input_open(&g);
+                }
+                if ((0U != stats_every) && (0U == (++ticks % stats_every)))
+                {
+                    report(&g, 0);
+                }
+            }
+            else
+            {
+                unsigned i = tag - TAG_SUB;
+
+                if ((i < INGEST_MAX_SUBS) && (g.subs[i].fd >= 0))
+                {
+                    if (0U != (evs[k].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)))
+                    {
+                        sub_close(&g, i);
+                    }
+                    else if (0U != (evs[k].events & EPOLLOUT))
+                    {
+                        sub_flush(&g, i);
+                    }
+                    else
+                    {
+                        char sink[256];    /* Subscribers do not talk */
+                        (void)read(g.subs[i].fd, sink, sizeof(sink));
+                    }
+                }
+            }
+        }
+    }
+
+    if (child > 0)
+    {
+        waitpid(child, NULL, 0);
+    }
+
+    report(&g, 1);
+
+    for (unsigned i = 0; i < INGEST_MAX_SUBS; i++)
+    {
+        if (g.subs[i].fd >= 0)
+        {
+            int fl = fcntl(g.subs[i].fd, F_GETFL);
+
+            fcntl(g.subs[i].fd, F_SETFL, fl & ~O_NONBLOCK);
+            sub_flush(&g, i);
+            sub_close(&g, i);
+        }
+    }
+    if ((NULL != g.out) && (stdout != g.out))
+    {
+        fclose(g.out);
+    }
+    if (NULL != g.raw)
+    {
+        fclose(g.raw);
+    }
+    if (NULL != listen_path)
+    {
+        unlink(listen_path);
+    }
+    debug_stream_free(&g.stream);
+    debug_wire_free(&g.wire);
+    debug_clock_free(&g.clock);
+    free(g.hist);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
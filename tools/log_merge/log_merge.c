@@ -0,0 +1,835 @@
+/**
+ * @file      log_merge.c
+ * @brief     Time-aligned merge of the captures of several devices.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Every board timestamps its lines with its own get_timestamp() ticks.
+ * This tool estimates, per device, the offset and drift of that clock
+ * against a common time base and writes all lines in one globally
+ * time-ordered stream:
+ *
+ * @code
+ *   1760680000.123456 board3   [00042][123456][net][INFO] link up
+ * @endcode
+ *
+ * Clock sources, per device:
+ *  - Ping sync: captures written by log_ingest -o --ping contain
+ *    "# sync" lines, each relating a device instant to host time within
+ *    half a ping round trip. They are fitted weighted by 1 / rtt^2 and
+ *    also give the tick rate (no --hz needed).
+ *  - Host stamps: captures written by log_ingest -o carry the host
+ *    arrival time of every line. The fit keeps the least delayed line per
+ *    second of device time (see debug_clock.h), so queueing delay does
+ *    not bias it; the result is in host wall-clock time.
+ *  - Shared events (--event TEXT): the n-th line containing TEXT is taken
+ *    to be the same physical event on every device (e.g. a broadcast
+ *    trigger). Devices are aligned to the first input, which itself uses
+ *    host stamps if it has them.
+ *  - Neither: the raw device time is used, offset 0.
+ *
+ * A device reset (its sequence counter restarting) starts a new clock
+ * segment with its own fit; 32-bit timestamp wrap-around is undone.
+ *
+ * Processing is two-pass over mapped files. The first pass collects the
+ * clock samples of all devices concurrently. The second pass is a k-way
+ * merge driven by a binary heap holding one pending line per device, so
+ * memory does not depend on the capture sizes and the merge costs
+ * O(log N) per line for N devices. Binary records stay attached to the
+ * line they follow.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -pthread -I../../core -I../common -o log_merge \
+ *       log_merge.c ../common/debug_capture.c ../common/debug_stream.c \
+ *       ../common/debug_line.c ../common/debug_seq.c \
+ *       ../common/debug_clock.c -lm
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   log_merge [--hz TICKS_PER_S] [--event TEXT] [--no-records] [-j N]
+ *             [NAME=]capture [[NAME=]capture ...]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "debug_capture.h"
+#include "debug_line.h"
+#include "debug_seq.h"
+#include "debug_clock.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+#define MERGE_MAX_DEVICES   256U
+#define MERGE_MAX_SEGMENTS  64U     /**< Resets tracked per device */
+#define MERGE_BUCKET_S      1.0     /**< One-sided fit bucket length */
+#define MERGE_OUT_BUFFER    (1U << 20)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Clock segment (between device resets) */
+typedef struct
+{
+    debug_clock_t     host;     /**< Host stamp samples */
+    debug_clock_fit_t fit;
+    int               fitted;
+    debug_clock_t     sync;     /**< Ping sync samples */
+    const char       *method;   /**< "sync", "host", "event" or "raw" */
+} merge_seg_t;
+
+/** @brief One entry: a text line plus the records that follow it */
+typedef struct
+{
+    uint64_t    start;      /**< Line start (after a host stamp) */
+    uint64_t    len;        /**< Line length without CR/LF */
+    uint64_t    rec_start;  /**< Records following the line */
+    uint64_t    rec_end;
+    int         has_dev;    /**< dev is valid */
+    double      dev;        /**< Device time, seconds (unwrapped) */
+    int         has_host;   /**< host is valid */
+    double      host;       /**< Host arrival stamp, seconds */
+    unsigned    seg;        /**< Clock segment */
+    int         sync;       /**< "# sync" annotation, not a line */
+    double      rtt;        /**< Ping round trip of a sync entry */
+    debug_line_t ln;        /**< Parsed prefix */
+} merge_entry_t;
+
+/** @brief Per-device state */
+typedef struct
+{
+    const char         *name;
+    const char         *path;
+    debug_capture_map_t map;
+    double              hz;         /**< Tick rate */
+
+    /* Walk */
+    uint64_t            pos;
+    debug_seq_t         seq;
+    int                 ts_started;
+    uint32_t            ts_last;
+    int64_t             ts_ext;
+    unsigned            seg;
+
+    /* Clock */
+    merge_seg_t         segs[MERGE_MAX_SEGMENTS];
+    unsigned            seg_count;
+    double             *ev;         /**< Device time of each event */
+    unsigned           *ev_seg;
+    size_t              ev_count;
+    size_t              ev_cap;
+
+    /* Merge */
+    merge_entry_t       cur;
+    double              key;
+    double              last_key;
+    uint64_t            lines;
+    int                 error;
+} merge_dev_t;
+
+/** @brief Run settings */
+typedef struct
+{
+    double      hz;
+    int         hz_set;     /**< --hz given; overrides "# sync" lines */
+    const char *event;
+    int         records;
+} merge_cfg_t;
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+static merge_cfg_t   s_cfg = { .hz = 1000.0, .records = 1 };
+static merge_dev_t  *s_dev;
+static unsigned      s_count;
+static unsigned      s_jobs;
+
+/*******************************************************************************
+ * Private Functions
+ *******************************************************************************/
+
+/**
+ * @brief Parse a "sec.usec " host stamp written by log_ingest.
+ *
+ * @return Bytes consumed, 0 if the line has no stamp
+ */
+static size_t merge_host_stamp(const uint8_t *p, size_t len, double *t)
+{
+    uint64_t sec  = 0;
+    uint64_t frac = 0;
+    double   div  = 1.0;
+    size_t   i    = 0;
+
+    while ((i < len) && (p[i] >= '0') && (p[i] <= '9'))
+    {
+        sec = (sec * 10U) + (uint64_t)(p[i++] - '0');
+    }
+    if ((0U == i) || (i >= len) || ('.' != p[i]))
+    {
+        return 0;
+    }
+    i++;
+    while ((i < len) && (p[i] >= '0') && (p[i] <= '9'))
+    {
+        frac = (frac * 10U) + (uint64_t)(p[i++] - '0');
+        div *= 10.0;
+    }
+    if ((i >= len) || (' ' != p[i]))
+    {
+        return 0;
+    }
+
+    *t = (double)sec + ((double)frac / div);
+    return i + 1U;
+}
+
+/**
+ * @brief Parse a "# sync ts=.. frac=.. hz=.. host=.. rtt=.." annotation.
+ *
+ * @return 0 on success, -1 if the line is not a sync annotation
+ */
+static int merge_sync_line(const uint8_t *p, size_t len, uint32_t *ts,
+                           double *frac, double *hz, double *host, double *rtt)
+{
+    char line[256];
+    unsigned long t;
+
+    if ((len < 7U) || (len >= sizeof(line)) || (0 != memcmp(p, "# sync ", 7U)))
+    {
+        return -1;
+    }
+    memcpy(line, p, len);
+    line[len] = '\0';
+
+    if (5 != sscanf(line, "# sync ts=%lu frac=%lf hz=%lf host=%lf rtt=%lf",
+                    &t, frac, hz, host, rtt))
+    {
+        return -1;
+    }
+    *ts   = (uint32_t)t;
+    *rtt /= 1e6;
+
+    return 0;
+}
+
+/**
+ * @brief Unwrap a raw timestamp of a device to seconds.
+ */
+static double merge_unwrap(merge_dev_t *d, uint32_t ts)
+{
+    if (0 == d->ts_started)
+    {
+        d->ts_ext     = ts;
+        d->ts_started = 1;
+    }
+    else
+    {
+        d->ts_ext += (int32_t)(ts - d->ts_last);    /* Undo wrap */
+    }
+    d->ts_last = ts;
+
+    return (double)d->ts_ext / d->hz;
+}
+
+/**
+ * @brief Read the next entry of a device.
+ *
+ * @return 1 if an entry was read, 0 at end of capture
+ */
+static int merge_next(merge_dev_t *d, merge_entry_t *e)
+{
+    const uint8_t *buf  = d->map.buf;
+    uint64_t       size = d->map.size;
+
+    for (;;)
+    {
+        uint64_t              len;
+        debug_capture_entry_t kind;
+
+        if (d->pos >= size)
+        {
+            return 0;
+        }
+        kind = debug_capture_entry(buf, size, d->pos, &len);
+        if (DEBUG_CAPTURE_NONE == kind)
+        {
+            return 0;
+        }
+
+        memset(e, 0, sizeof(*e));
+        e->start = d->pos;
+        d->pos  += len;
+
+        if (DEBUG_CAPTURE_RECORD == kind)
+        {
+            /* Record without a line before it: an entry of its own */
+            e->rec_start = e->start;
+            e->rec_end   = d->pos;
+            e->seg       = d->seg;
+            return 1;
+        }
+
+        /* Strip the line end and an optional host stamp */
+        while ((len > 0U) && (('\n' == buf[e->start + len - 1U]) ||
+                              ('\r' == buf[e->start + len - 1U])))
+        {
+            len--;
+        }
+
+        size_t stamp = merge_host_stamp(&buf[e->start], (size_t)len, &e->host);
+
+        e->has_host = (0U != stamp);
+        e->start   += stamp;
+        e->len      = len - stamp;
+
+        if ((0U != e->len) && ('#' == buf[e->start]))
+        {
+            uint32_t ts;
+            double   frac;
+            double   hz;
+
+            if (0 == merge_sync_line(&buf[e->start], (size_t)e->len, &ts, &frac,
+                                     &hz, &e->host, &e->rtt))
+            {
+                e->sync    = 1;
+                e->has_dev = 1;
+                e->dev     = merge_unwrap(d, ts) + frac;
+                e->seg     = d->seg;
+                return 1;
+            }
+        }
+        if ((0U == e->len) || ('#' == buf[e->start]))
+        {
+            continue;       /* Blank line or log_ingest annotation */
+        }
+
+        (void)debug_line_parse((const char *)&buf[e->start], (size_t)e->len, &e->ln);
+
+        if ((0U != (e->ln.fields & DEBUG_LINE_HAS_SEQ)) &&
+            (DEBUG_SEQ_RESET == debug_seq_push(&d->seq, (uint32_t)e->ln.seq)))
+        {
+            if ((d->seg + 1U) < MERGE_MAX_SEGMENTS)
+            {
+                d->seg++;
+            }
+            d->ts_started = 0;
+        }
+
+        if (0U != (e->ln.fields & DEBUG_LINE_HAS_TS))
+        {
+            e->has_dev = 1;
+            e->dev     = merge_unwrap(d, (uint32_t)e->ln.ts);
+        }
+        e->seg = d->seg;
+
+        /* Attach the records that follow */
+        e->rec_start = d->pos;
+        e->rec_end   = d->pos;
+        while ((d->pos < size) &&
+               (DEBUG_CAPTURE_RECORD == debug_capture_entry(buf, size, d->pos, &len)))
+        {
+            d->pos    += len;
+            e->rec_end = d->pos;
+        }
+
+        return 1;
+    }
+}
+
+/**
+ * @brief Read the next line (or orphan record) of a device for output.
+ */
+static int merge_next_out(merge_dev_t *d, merge_entry_t *e)
+{
+    int rc;
+
+    while ((0 != (rc = merge_next(d, e))) && (0 != e->sync))
+    {
+    }
+    return rc;
+}
+
+static void merge_reset_walk(merge_dev_t *d)
+{
+    d->pos        = 0;
+    d->seg        = 0;
+    d->ts_started = 0;
+    d->ts_ext     = 0;
+    debug_seq_init(&d->seq);
+}
+
+static int merge_add_event(merge_dev_t *d, double dev, unsigned seg)
+{
+    if (d->ev_count == d->ev_cap)
+    {
+        size_t    cap = (0U != d->ev_cap) ? (d->ev_cap * 2U) : 256U;
+        double   *ev  = realloc(d->ev, cap * sizeof(*ev));
+        unsigned *es  = (NULL != ev) ? realloc(d->ev_seg, cap * sizeof(*es)) : NULL;
+
+        if (NULL != ev)
+        {
+            d->ev = ev;
+        }
+        if (NULL == es)
+        {
+            return -1;
+        }
+        d->ev_seg = es;
+        d->ev_cap = cap;
+    }
+
+    d->ev[d->ev_count]     = dev;
+    d->ev_seg[d->ev_count] = seg;
+    d->ev_count++;
+
+    return 0;
+}
+
+/**
+ * @brief First pass over one device: clock samples and events.
+ */
+static void merge_scan(merge_dev_t *d)
+{
+    merge_entry_t e;
+
+    for (unsigned s = 0; s < MERGE_MAX_SEGMENTS; s++)
+    {
+        debug_clock_init(&d->segs[s].host, 1, MERGE_BUCKET_S);
+        debug_clock_init(&d->segs[s].sync, 0, 0.0);
+    }
+
+    merge_reset_walk(d);
+    while (0 != merge_next(d, &e))
+    {
+        if ((e.seg + 1U) > d->seg_count)
+        {
+            d->seg_count = e.seg + 1U;
+        }
+        if (0 != e.sync)
+        {
+            if (0 != debug_clock_add(&d->segs[e.seg].sync, e.dev, e.host,
+                                     1.0 / (e.rtt * e.rtt)))
+            {
+                d->error = 1;
+            }
+            continue;
+        }
+        if (0 == e.has_dev)
+        {
+            continue;
+        }
+        if ((0 != e.has_host) &&
+            (0 != debug_clock_add(&d->segs[e.seg].host, e.dev, e.host, 0.0)))
+        {
+            d->error = 1;
+        }
+        if ((NULL != s_cfg.event) &&
+            (NULL != memmem(e.ln.msg, e.ln.msg_len, s_cfg.event, strlen(s_cfg.event))) &&
+            (0 != merge_add_event(d, e.dev, e.seg)))
+        {
+            d->error = 1;
+        }
+    }
+
+    for (unsigned s = 0; s < d->seg_count; s++)
+    {
+        merge_seg_t *seg = &d->segs[s];
+
+        if (0 == debug_clock_solve(&seg->sync, &seg->fit))
+        {
+            seg->fitted = 1;
+            seg->method = "sync";
+        }
+        else if (0 == debug_clock_solve(&seg->host, &seg->fit))
+        {
+            seg->fitted = 1;
+            seg->method = "host";
+        }
+    }
+}
+
+static void *merge_scan_thread(void *arg)
+{
+    for (unsigned i = (unsigned)(uintptr_t)arg; i < s_count; i += s_jobs)
+    {
+        merge_scan(&s_dev[i]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Reference time of an event of the first device.
+ */
+static double merge_ref_time(const merge_dev_t *ref, size_t k)
+{
+    const merge_seg_t *seg = &ref->segs[ref->ev_seg[k]];
+
+    return (0 != seg->fitted) ? debug_clock_map(&seg->fit, ref->ev[k]) : ref->ev[k];
+}
+
+/**
+ * @brief Fit devices 1..N-1 to the events of device 0.
+ */
+static void merge_align_events(void)
+{
+    const merge_dev_t *ref = &s_dev[0];
+
+    for (unsigned i = 1; i < s_count; i++)
+    {
+        merge_dev_t *d = &s_dev[i];
+        size_t       n = (d->ev_count < ref->ev_count) ? d->ev_count : ref->ev_count;
+
+        if (n != d->ev_count)
+        {
+            fprintf(stderr, "log_merge: %s: %zu events, %s has %zu; using %zu\n",
+                    d->name, d->ev_count, ref->name, ref->ev_count, n);
+        }
+
+        for (unsigned s = 0; s < d->seg_count; s++)
+        {
+            debug_clock_t     c;
+            debug_clock_fit_t fit;
+
+            debug_clock_init(&c, 0, 0.0);
+            for (size_t k = 0; k < n; k++)
+            {
+                if (d->ev_seg[k] == s)
+                {
+                    (void)debug_clock_add(&c, d->ev[k], merge_ref_time(ref, k), 1.0);
+                }
+            }
+            if (0 == debug_clock_solve(&c, &fit))
+            {
+                d->segs[s].fit    = fit;
+                d->segs[s].fitted = 1;
+                d->segs[s].method = "event";
+            }
+            debug_clock_free(&c);
+        }
+    }
+}
+
+/**
+ * @brief Merge key of the current entry (monotonic per device).
+ */
+static void merge_key(merge_dev_t *d)
+{
+    const merge_entry_t *e   = &d->cur;
+    const merge_seg_t   *seg = &d->segs[e->seg];
+    double               key = d->last_key;
+
+    if ((0 != e->has_dev) && (0 != seg->fitted))
+    {
+        key = debug_clock_map(&seg->fit, e->dev);
+    }
+    else if (0 != e->has_host)
+    {
+        key = e->host;
+    }
+    else if (0 != e->has_dev)
+    {
+        key = e->dev;
+    }
+
+    if (key < d->last_key)
+    {
+        key = d->last_key;
+    }
+    d->key      = key;
+    d->last_key = key;
+}
+
+/*------------------------------------------------------------------------------
+ * Heap of devices ordered by (key, index)
+ *----------------------------------------------------------------------------*/
+
+static int merge_less(unsigned a, unsigned b)
+{
+    return (s_dev[a].key < s_dev[b].key) ||
+           ((s_dev[a].key == s_dev[b].key) && (a < b));
+}
+
+static void merge_sift_down(unsigned *heap, unsigned n, unsigned i)
+{
+    for (;;)
+    {
+        unsigned l = (2U * i) + 1U;
+        unsigned m = i;
+
+        if ((l < n) && merge_less(heap[l], heap[m]))        m = l;
+        if (((l + 1U) < n) && merge_less(heap[l + 1U], heap[m])) m = l + 1U;
+        if (m == i)
+        {
+            return;
+        }
+
+        unsigned t = heap[i];
+        heap[i] = heap[m];
+        heap[m] = t;
+        i = m;
+    }
+}
+
+static void merge_emit(const merge_dev_t *d, int name_width)
+{
+    const merge_entry_t *e = &d->cur;
+
+    if (0U != e->len)
+    {
+        printf("%.6f %-*s %.*s\n", d->key, name_width, d->name, (int)e->len,
+               (const char *)&d->map.buf[e->start]);
+    }
+    if ((0 != s_cfg.records) && (e->rec_end > e->rec_start))
+    {
+        fwrite(&d->map.buf[e->rec_start], 1, (size_t)(e->rec_end - e->rec_start),
+               stdout);
+    }
+}
+
+/**
+ * @brief Tick rate of a device: --hz, else the first "# sync" line.
+ */
+static double merge_file_hz(const merge_dev_t *d)
+{
+    const uint8_t *p;
+    uint32_t       ts;
+    double         frac, hz, host, rtt;
+
+    if ((0 != s_cfg.hz_set) || (NULL == d->map.buf) ||
+        (NULL == (p = memmem(d->map.buf, (size_t)d->map.size, "\n# sync ", 8U))))
+    {
+        return s_cfg.hz;
+    }
+
+    p++;
+    const uint8_t *end = memchr(p, '\n', (size_t)(d->map.size - (uint64_t)(p - d->map.buf)));
+    size_t         len = (NULL != end) ? (size_t)(end - p) : 0U;
+
+    if ((0 == merge_sync_line(p, len, &ts, &frac, &hz, &host, &rtt)) && (hz > 0.0))
+    {
+        return hz;
+    }
+    return s_cfg.hz;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: log_merge [--hz TICKS_PER_S] [--event TEXT] [--no-records] [-j N]\n"
+            "                 [NAME=]capture [[NAME=]capture ...]\n");
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    unsigned jobs = (unsigned)sysconf(_SC_NPROCESSORS_ONLN);
+
+    s_dev = calloc(MERGE_MAX_DEVICES, sizeof(*s_dev));
+    if (NULL == s_dev)
+    {
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a   = argv[i];
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(a, "--hz")) && (NULL != val))
+        {
+            s_cfg.hz     = strtod(val, NULL);
+            s_cfg.hz_set = 1;
+            i++;
+        }
+        else if ((0 == strcmp(a, "--event")) && (NULL != val))
+        {
+            s_cfg.event = val;
+            i++;
+        }
+        else if (0 == strcmp(a, "--no-records"))
+        {
+            s_cfg.records = 0;
+        }
+        else if ((0 == strcmp(a, "-j")) && (NULL != val))
+        {
+            jobs = (unsigned)strtoul(val, NULL, 0);
+            i++;
+        }
+        else if (('-' != a[0]) && (s_count < MERGE_MAX_DEVICES))
+        {
+            merge_dev_t *d  = &s_dev[s_count++];
+            const char  *eq = strchr(a, '=');
+
+            d->path   = (NULL != eq) ? (eq + 1) : a;
+            d->name   = (NULL != eq) ? strndup(a, (size_t)(eq - a)) : a;
+            d->map.fd = -1;
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    if ((0U == s_count) || !(s_cfg.hz > 0.0))
+    {
+        usage();
+        return 2;
+    }
+
+    int name_width = 0;
+
+    for (unsigned i = 0; i < s_count; i++)
+    {
+        if (0 != debug_capture_map(&s_dev[i].map, s_dev[i].path))
+        {
+            fprintf(stderr, "log_merge: %s: %s\n", s_dev[i].path, strerror(errno));
+            return 1;
+        }
+        s_dev[i].hz = merge_file_hz(&s_dev[i]);
+        if ((int)strlen(s_dev[i].name) > name_width)
+        {
+            name_width = (int)strlen(s_dev[i].name);
+        }
+    }
+
+    /* Pass 1: clock samples, all devices concurrently */
+    pthread_t tid[MERGE_MAX_DEVICES];
+
+    if (jobs < 1U)      jobs = 1U;
+    if (jobs > s_count) jobs = s_count;
+    s_jobs = jobs;
+    for (unsigned t = 1; t < jobs; t++)
+    {
+        if (0 != pthread_create(&tid[t], NULL, merge_scan_thread, (void *)(uintptr_t)t))
+        {
+            fprintf(stderr, "log_merge: cannot start thread\n");
+            return 1;
+        }
+    }
+    merge_scan_thread((void *)(uintptr_t)0);
+    for (unsigned t = 1; t < jobs; t++)
+    {
+        pthread_join(tid[t], NULL);
+    }
+
+    if (NULL != s_cfg.event)
+    {
+        merge_align_events();
+    }
+
+    for (unsigned i = 0; i < s_count; i++)
+    {
+        merge_dev_t *d = &s_dev[i];
+
+        if (0 != d->error)
+        {
+            fprintf(stderr, "log_merge: %s: out of memory\n", d->name);
+            return 1;
+        }
+        for (unsigned s = 0; s < d->seg_count; s++)
+        {
+            const merge_seg_t *seg = &d->segs[s];
+
+            fprintf(stderr, "%-*s seg %u: %-5s offset %+.6f s drift %+.2f ppm "
+                    "jitter %.1f us (%llu points)\n", name_width, d->name, s,
+                    (0 != seg->fitted) ? seg->method : "raw",
+                    seg->fit.offset, seg->fit.drift * 1e6, seg->fit.jitter * 1e6,
+                    (unsigned long long)seg->fit.points);
+        }
+    }
+
+    /* Pass 2: k-way merge */
+    static char outbuf[MERGE_OUT_BUFFER];
+    unsigned   *heap = malloc(s_count * sizeof(*heap));
+    unsigned    n    = 0;
+
+    if (NULL == heap)
+    {
+        return 1;
+    }
+    setvbuf(stdout, outbuf, _IOFBF, sizeof(outbuf));
+
+    for (unsigned i = 0; i < s_count; i++)
+    {
+        merge_dev_t *d = &s_dev[i];
+
+        merge_reset_walk(d);
+        d->last_key = -INFINITY;
+        if (0 != merge_next_out(d, &d->cur))
+        {
+            merge_key(d);
+            heap[n++] = i;
+        }
+    }
+    for (unsigned i = n / 2U; i-- > 0U; )
+    {
+        merge_sift_down(heap, n, i);
+    }
+
+    while (n > 0U)
+    {
+        merge_dev_t *d = &s_dev[heap[0]];
+
+        merge_emit(d, name_width);
+        d->lines++;
+
+        if (0 != merge_next_out(d, &d->cur))
+        {
+            merge_key(d);
+        }
+        else
+        {
+            heap[0] = heap[--n];
+        }
+        merge_sift_down(heap, n, 0);
+    }
+
+    fflush(stdout);
+
+    for (unsigned i = 0; i < s_count; i++)
+    {
+        for (unsigned s = 0; s < MERGE_MAX_SEGMENTS; s++)
+        {
+            debug_clock_free(&s_dev[i].segs[s].host);
+            debug_clock_free(&s_dev[i].segs[s].sync);
+        }
+        free(s_dev[i].ev);
+        free(s_dev[i].ev_seg);
+        debug_capture_unmap(&s_dev[i].map);
+    }
+    free(heap);
+    free(s_dev);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
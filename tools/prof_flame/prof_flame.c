@@ -0,0 +1,851 @@
+/**
+ * @file      prof_flame.c
+ * @brief     Builds flame graphs and call tables from profiler records.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Replays the DEBUG_RECORD_PROF records of a capture (function entries
+ * and exits from core/debug_prof.c) into one call tree per thread and
+ * reports:
+ *  - a call table: calls, inclusive and self time per function, largest
+ *    self time first (recursive calls are counted once in the inclusive
+ *    time);
+ *  - optionally (--folded) the folded stacks "thread;main;f;g <ns>" of
+ *    self time, for flamegraph.pl, speedscope or inferno;
+ *  - optionally (--svg) a flame graph rendered directly.
+ *
+ * When a thread lost events on the target, its open calls are discarded
+ * and the replay starts again from the next event; exits of calls entered
+ * before the capture started are skipped. Both are counted.
+ *
+ * With --elf, functions are symbolized through addr2line. On a host
+ * build, link with -no-pie so the addresses match the ELF.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o prof_flame \
+ *       prof_flame.c ../common/debug_stream.c ../common/debug_symbols.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   prof_flame [--elf firmware.elf] [--addr2line tool] [--top N]
+ *              [--folded out.folded] [--svg out.svg] [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+#include "debug_symbols.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Thread table size (indexes are one byte) */
+#define FLAME_THREADS   256U
+
+/** @brief Flame graph geometry */
+#define FLAME_WIDTH     1200.0
+#define FLAME_ROW       16
+#define FLAME_MIN_PX    0.1     /**< Frames narrower than this are not drawn */
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Call tree node: one function at one call path */
+typedef struct flame_node
+{
+    uint64_t           fn;          /**< Function address, 0 = thread root */
+    struct flame_node *parent;
+    struct flame_node *child;       /**< First child */
+    struct flame_node *next;        /**< Next sibling */
+    uint64_t           calls;
+    uint64_t           self;        /**< Cycles in the function itself */
+    uint64_t           total;       /**< Self plus children (computed at the end) */
+} flame_node_t;
+
+/** @brief Open call */
+typedef struct
+{
+    flame_node_t *node;
+    uint64_t      start;
+    uint64_t      child;            /**< Cycles spent in callees */
+} flame_frame_t;
+
+/** @brief Per-thread replay state */
+typedef struct
+{
+    int            seen;
+    char           name[DEBUG_RECORD_NAME_LEN + 1U];
+    flame_node_t   root;
+    flame_frame_t *stack;
+    size_t         depth;
+    size_t         cap;
+    uint64_t       last;            /**< Time of the last event */
+    uint32_t       dropped;         /**< Target drop counter last seen */
+} flame_thread_t;
+
+/** @brief Per-function totals */
+typedef struct
+{
+    uint64_t fn;
+    uint64_t calls;
+    uint64_t self;
+    uint64_t incl;
+} flame_func_t;
+
+/** @brief Replay context */
+typedef struct
+{
+    flame_thread_t   thread[FLAME_THREADS];
+    uint64_t         now;           /**< Latest time seen, extended to 64 bits */
+    int              have_now;
+    uint32_t         cycles_hz;
+
+    flame_func_t    *func;          /**< Open-addressing table */
+    size_t           func_cap;
+    size_t           func_len;
+
+    debug_symbols_t *sym;
+
+    uint64_t         events;
+    uint64_t         records;
+    uint64_t         unmatched;     /**< Exits without an entry */
+    uint64_t         resyncs;       /**< Stacks discarded after target drops */
+    uint64_t         dropped;       /**< Events lost on the target */
+    uint64_t         malformed;
+} flame_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static flame_node_t *flame_child(flame_node_t *parent, uint64_t fn)
+{
+    for (flame_node_t *n = parent->child; NULL != n; n = n->next)
+    {
+        if (n->fn == fn)
+        {
+            return n;
+        }
+    }
+
+    flame_node_t *n = calloc(1, sizeof(*n));
+
+    if (NULL == n)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    n->fn         = fn;
+    n->parent     = parent;
+    n->next       = parent->child;
+    parent->child = n;
+
+    return n;
+}
+
+static void flame_free(flame_node_t *n)
+{
+    while (NULL != n)
+    {
+        flame_node_t *next = n->next;
+
+        flame_free(n->child);
+        free(n);
+        n = next;
+    }
+}
+
+/**
+ * @brief Close the innermost open call at time @p t.
+ */
+static void flame_pop(flame_thread_t *th, uint64_t t)
+{
+    flame_frame_t *f   = &th->stack[--th->depth];
+    uint64_t       dur = (t > f->start) ? (t - f->start) : 0U;
+
+    f->node->calls++;
+    f->node->self += (dur > f->child) ? (dur - f->child) : 0U;
+    if (th->depth > 0U)
+    {
+        th->stack[th->depth - 1U].child += dur;
+    }
+}
+
+static void flame_enter(flame_thread_t *th, uint64_t fn, uint64_t t)
+{
+    if (th->depth == th->cap)
+    {
+        size_t         cap = (0U != th->cap) ? (th->cap * 2U) : 64U;
+        flame_frame_t *s   = realloc(th->stack, cap * sizeof(*s));
+
+        if (NULL == s)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        th->stack = s;
+        th->cap   = cap;
+    }
+
+    flame_node_t *parent = (0U != th->depth) ? th->stack[th->depth - 1U].node :
+                                               &th->root;
+
+    th->stack[th->depth++] = (flame_frame_t){ .node  = flame_child(parent, fn),
+                                              .start = t };
+}
+
+static void flame_exit(flame_ctx_t *ctx, flame_thread_t *th, uint64_t fn,
+                       uint64_t t)
+{
+    size_t i = th->depth;
+
+    while ((i > 0U) && (th->stack[i - 1U].node->fn != fn))
+    {
+        i--;
+    }
+    if (0U == i)
+    {
+        ctx->unmatched++;   /* Entered before the capture (or the drop) */
+        return;
+    }
+
+    /* Calls whose exits were lost end here too */
+    while (th->depth >= i)
+    {
+        flame_pop(th, t);
+    }
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    flame_ctx_t        *ctx = user;
+    debug_prof_record_t rec;
+
+    if (DEBUG_RECORD_PROF != type)
+    {
+        return;
+    }
+    if (len < sizeof(rec))
+    {
+        ctx->malformed++;
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+    if (DEBUG_PROF_VERSION != rec.version)
+    {
+        ctx->malformed++;
+        return;
+    }
+    ctx->records++;
+    ctx->cycles_hz = rec.cycles_hz;
+
+    flame_thread_t *th = &ctx->thread[rec.thread];
+
+    if (0U != (rec.flags & DEBUG_PROF_FLAG_NAME))
+    {
+        size_t n = len - sizeof(rec);
+
+        n = (n < DEBUG_RECORD_NAME_LEN) ? n : DEBUG_RECORD_NAME_LEN;
+        memcpy(th->name, &payload[sizeof(rec)], n);
+        th->name[n] = '\0';
+        th->seen    = 1;
+        return;
+    }
+
+    if ((len - sizeof(rec)) < ((size_t)rec.count * sizeof(debug_prof_event_t)))
+    {
+        ctx->malformed++;
+        return;
+    }
+
+    /* Extend the 32-bit counter from the latest time of any thread */
+    if (0 == ctx->have_now)
+    {
+        ctx->now      = rec.cycles;
+        ctx->have_now = 1;
+    }
+    uint64_t t = ctx->now + (uint64_t)(int64_t)(int32_t)(rec.cycles - (uint32_t)ctx->now);
+
+    th->seen      = 1;
+    ctx->dropped += (uint32_t)(rec.dropped - th->dropped);
+    th->dropped   = rec.dropped;
+
+    for (size_t i = 0; i < rec.count; i++)
+    {
+        debug_prof_event_t ev;
+
+        memcpy(&ev, &payload[sizeof(rec) + (i * sizeof(ev))], sizeof(ev));
+        t += ev.delta & DEBUG_PROF_DELTA_MASK;
+
+        uint64_t fn = ((uint64_t)rec.addr_hi << 32) | ev.addr;
+
+        if (0U == ev.addr)
+        {
+            if (0U != th->depth)
+            {
+                th->depth = 0;  /* Events were lost here: start over */
+                ctx->resyncs++;
+            }
+        }
+        else if (0U != (ev.delta & DEBUG_PROF_EXIT))
+        {
+            flame_exit(ctx, th, fn, t);
+        }
+        else
+        {
+            flame_enter(th, fn, t);
+        }
+        ctx->events++;
+    }
+
+    th->last = t;
+    if ((int64_t)(t - ctx->now) > 0)
+    {
+        ctx->now = t;
+    }
+}
+
+static size_t flame_hash(uint64_t fn, size_t cap)
+{
+    fn ^= fn >> 29;
+    fn *= 0xBF58476D1CE4E5B9ULL;
+    fn ^= fn >> 32;
+
+    return (size_t)fn & (cap - 1U);
+}
+
+static flame_func_t *flame_func(flame_ctx_t *ctx, uint64_t fn)
+{
+    if ((2U * (ctx->func_len + 1U)) > ctx->func_cap)
+    {
+        size_t        cap = (0U != ctx->func_cap) ? (ctx->func_cap * 2U) : 1024U;
+        flame_func_t *tab = calloc(cap, sizeof(*tab));
+
+        if (NULL == tab)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < ctx->func_cap; i++)
+        {
+            if (0U != ctx->func[i].fn)
+            {
+                size_t h = flame_hash(ctx->func[i].fn, cap);
+
+                while (0U != tab[h].fn)
+                {
+                    h = (h + 1U) & (cap - 1U);
+                }
+                tab[h] = ctx->func[i];
+            }
+        }
+        free(ctx->func);
+        ctx->func     = tab;
+        ctx->func_cap = cap;
+    }
+
+    size_t h = flame_hash(fn, ctx->func_cap);
+
+    while ((0U != ctx->func[h].fn) && (fn != ctx->func[h].fn))
+    {
+        h = (h + 1U) & (ctx->func_cap - 1U);
+    }
+    if (0U == ctx->func[h].fn)
+    {
+        ctx->func[h].fn = fn;
+        ctx->func_len++;
+    }
+
+    return &ctx->func[h];
+}
+
+/**
+ * @brief Compute totals and fold the tree into the function table.
+ *
+ * @param[in] path  Functions from the root to @p n (exclusive)
+ * @param[in] depth Entries in path
+ */
+static uint64_t flame_fold(flame_ctx_t *ctx, flame_node_t *n, uint64_t *path,
+                           size_t depth)
+{
+    uint64_t total = n->self;
+
+    for (flame_node_t *c = n->child; NULL != c; c = c->next)
+    {
+        path[depth] = n->fn;
+        total += flame_fold(ctx, c, path, depth + ((0U != n->fn) ? 1U : 0U));
+    }
+    n->total = total;
+
+    if (0U != n->fn)
+    {
+        flame_func_t *f         = flame_func(ctx, n->fn);
+        int           recursive = 0;
+
+        for (size_t i = 0; i < depth; i++)
+        {
+            recursive |= (path[i] == n->fn);
+        }
+        f->calls += n->calls;
+        f->self  += n->self;
+        if (0 == recursive)
+        {
+            f->incl += total;
+        }
+    }
+
+    return total;
+}
+
+static size_t flame_max_depth(const flame_node_t *n)
+{
+    size_t max = 0;
+
+    for (const flame_node_t *c = n->child; NULL != c; c = c->next)
+    {
+        size_t d = flame_max_depth(c);
+
+        max = (d > max) ? d : max;
+    }
+
+    return max + 1U;
+}
+
+static const char *flame_name(flame_ctx_t *ctx, uint64_t fn, char *buf,
+                              size_t cap)
+{
+    if ((NULL == ctx->sym) ||
+        (1 != debug_symbols_lookup(ctx->sym, fn, buf, cap, NULL, 0)))
+    {
+        snprintf(buf, cap, "0x%llx", (unsigned long long)fn);
+    }
+
+    return buf;
+}
+
+static double flame_ms(const flame_ctx_t *ctx, uint64_t cycles)
+{
+    return (0U != ctx->cycles_hz) ? ((double)cycles * 1e3 / (double)ctx->cycles_hz) : 0.0;
+}
+
+/**
+ * @brief Write the folded stacks of a subtree.
+ */
+static void flame_folded(flame_ctx_t *ctx, FILE *out, const flame_node_t *n,
+                         char *path, size_t len, size_t cap)
+{
+    for (const flame_node_t *c = n->child; NULL != c; c = c->next)
+    {
+        char   name[256];
+        int    k = snprintf(&path[len], cap - len, ";%s",
+                            flame_name(ctx, c->fn, name, sizeof(name)));
+        size_t l = len + (((size_t)k < (cap - len)) ? (size_t)k : (cap - len - 1U));
+
+        if ((0U != c->self) && (0U != ctx->cycles_hz))
+        {
+            fprintf(out, "%s %llu\n", path,
+                    (unsigned long long)((double)c->self * 1e9 / ctx->cycles_hz + 0.5));
+        }
+        flame_folded(ctx, out, c, path, l, cap);
+        path[len] = '\0';
+    }
+}
+
+static void svg_escape(FILE *out, const char *s)
+{
+    for (; '\0' != *s; s++)
+    {
+        switch (*s)
+        {
+            case '<': fputs("&lt;", out);   break;
+            case '>': fputs("&gt;", out);   break;
+            case '&': fputs("&amp;", out);  break;
+            case '"': fputs("&quot;", out); break;
+            default:  fputc(*s, out);       break;
+        }
+    }
+}
+
+/**
+ * @brief Draw one frame and its callees above it.
+ */
+static void svg_frame(flame_ctx_t *ctx, FILE *out, const char *label,
+                      uint64_t calls, uint64_t total, double x, size_t depth,
+                      size_t rows, uint64_t all)
+{
+    double w = FLAME_WIDTH * (double)total / (double)all;
+    int    y = (int)((rows - 1U - depth) * FLAME_ROW);
+
+    /* Warm colour from the name, as flame graphs usually are */
+    unsigned h = 5381U;
+
+    for (const char *p = label; '\0' != *p; p++)
+    {
+        h = (h * 33U) ^ (unsigned char)*p;
+    }
+
+    fprintf(out, "<g><title>");
+    svg_escape(out, label);
+    if (0U != calls)
+    {
+        fprintf(out, " (%llu call(s),", (unsigned long long)calls);
+    }
+    else
+    {
+        fprintf(out, " (");
+    }
+    fprintf(out, " %.3f ms, %.2f%%)</title>", flame_ms(ctx, total),
+            100.0 * (double)total / (double)all);
+    fprintf(out, "<rect x=\"%.2f\" y=\"%d\" width=\"%.2f\" height=\"%d\" "
+                 "fill=\"rgb(%u,%u,%u)\" rx=\"2\"/>",
+            x, y, w, FLAME_ROW - 1, 205U + (h % 50U), 80U + ((h >> 8) % 130U),
+            (h >> 16) % 55U);
+
+    size_t fit = (size_t)(w / 7.0);
+
+    if (fit > 3U)
+    {
+        fprintf(out, "<text x=\"%.2f\" y=\"%d\">", x + 3.0, y + FLAME_ROW - 4);
+        if (strlen(label) <= fit)
+        {
+            svg_escape(out, label);
+        }
+        else
+        {
+            char cut[512];
+
+            snprintf(cut, sizeof(cut), "%.*s..", (int)(fit - 2U), label);
+            svg_escape(out, cut);
+        }
+        fprintf(out, "</text>");
+    }
+    fprintf(out, "</g>\n");
+}
+
+static void svg_tree(flame_ctx_t *ctx, FILE *out, const flame_node_t *n,
+                     double x, size_t depth, size_t rows, uint64_t all)
+{
+    for (const flame_node_t *c = n->child; NULL != c; c = c->next)
+    {
+        double w = FLAME_WIDTH * (double)c->total / (double)all;
+
+        if (w >= FLAME_MIN_PX)
+        {
+            char name[256];
+
+            svg_frame(ctx, out, flame_name(ctx, c->fn, name, sizeof(name)),
+                      c->calls, c->total, x, depth, rows, all);
+            svg_tree(ctx, out, c, x, depth + 1U, rows, all);
+        }
+        x += w;
+    }
+}
+
+static void flame_svg(flame_ctx_t *ctx, FILE *out)
+{
+    uint64_t all  = 0;
+    size_t   rows = 1;
+
+    for (size_t i = 0; i < FLAME_THREADS; i++)
+    {
+        size_t d = flame_max_depth(&ctx->thread[i].root) + 1U;
+
+        all += ctx->thread[i].root.total;
+        rows = (d > rows) ? d : rows;
+    }
+    if (0U == all)
+    {
+        all = 1;
+    }
+
+    fprintf(out, "<?xml version=\"1.0\" standalone=\"no\"?>\n"
+                 "<svg version=\"1.1\" width=\"%d\" height=\"%d\" "
+                 "xmlns=\"http://www.w3.org/2000/svg\" "
+                 "font-family=\"Verdana\" font-size=\"11\">\n"
+                 "<rect width=\"100%%\" height=\"100%%\" fill=\"#f8f8f0\"/>\n",
+            (int)FLAME_WIDTH, (int)(rows * FLAME_ROW));
+
+    svg_frame(ctx, out, "all", 0U, all, 0.0, 0U, rows, all);
+
+    double x = 0.0;
+
+    for (size_t i = 0; i < FLAME_THREADS; i++)
+    {
+        flame_thread_t *th = &ctx->thread[i];
+
+        if (0U == th->root.total)
+        {
+            continue;
+        }
+
+        char label[64];
+
+        snprintf(label, sizeof(label), "%s", ('\0' != th->name[0]) ? th->name : "?");
+        svg_frame(ctx, out, label, 0U, th->root.total, x, 1U, rows, all);
+        svg_tree(ctx, out, &th->root, x, 2U, rows, all);
+        x += FLAME_WIDTH * (double)th->root.total / (double)all;
+    }
+
+    fprintf(out, "</svg>\n");
+}
+
+static int flame_by_self(const void *a, const void *b)
+{
+    const flame_func_t *x = a;
+    const flame_func_t *y = b;
+
+    return (x->self < y->self) ? 1 : ((x->self > y->self) ? -1 : 0);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--elf firmware.elf] [--addr2line tool] [--top N]\n"
+            "          [--folded out.folded] [--svg out.svg] [capture]\n"
+            "  Rebuilds the call trees of the function profiler records in\n"
+            "  the capture (or stdin) and prints a call table.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char  *elf       = NULL;
+    const char  *addr2line = NULL;
+    const char  *path      = NULL;
+    const char  *folded    = NULL;
+    const char  *svg       = NULL;
+    size_t       top       = 30;
+    flame_ctx_t *ctx       = calloc(1, sizeof(*ctx));
+
+    if (NULL == ctx)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(argv[i], "--elf")) && (NULL != val))
+        {
+            elf = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--addr2line")) && (NULL != val))
+        {
+            addr2line = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--top")) && (NULL != val))
+        {
+            top = (size_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--folded")) && (NULL != val))
+        {
+            folded = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--svg")) && (NULL != val))
+        {
+            svg = argv[++i];
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            free(ctx);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        free(ctx);
+        return 1;
+    }
+
+    if (NULL != elf)
+    {
+        ctx->sym = debug_symbols_open(elf, addr2line);
+        if (NULL == ctx->sym)
+        {
+            fprintf(stderr, "warning: cannot symbolize with %s\n", elf);
+        }
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, ctx))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(ctx);
+        return 1;
+    }
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+
+    /* Calls still open at the end are cut at their thread's last event */
+    uint64_t path_buf[4096];
+    size_t   max_depth = 0;
+
+    for (size_t i = 0; i < FLAME_THREADS; i++)
+    {
+        flame_thread_t *th = &ctx->thread[i];
+
+        while (th->depth > 0U)
+        {
+            flame_pop(th, th->last);
+        }
+        size_t d = flame_max_depth(&th->root);
+
+        max_depth = (d > max_depth) ? d : max_depth;
+    }
+    if (max_depth > (sizeof(path_buf) / sizeof(path_buf[0])))
+    {
+        fprintf(stderr, "call tree too deep (%zu)\n", max_depth);
+        return 1;
+    }
+    for (size_t i = 0; i < FLAME_THREADS; i++)
+    {
+        (void)flame_fold(ctx, &ctx->thread[i].root, path_buf, 0);
+    }
+
+    /* Call table */
+    flame_func_t *list = calloc((0U != ctx->func_len) ? ctx->func_len : 1U,
+                                sizeof(*list));
+    size_t        cnt  = 0;
+
+    if (NULL == list)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < ctx->func_cap; i++)
+    {
+        if (0U != ctx->func[i].fn)
+        {
+            list[cnt++] = ctx->func[i];
+        }
+    }
+    qsort(list, cnt, sizeof(*list), flame_by_self);
+
+    printf("%10s %12s %12s %10s  %s\n", "calls", "total_ms", "self_ms",
+           "avg_us", "function");
+    for (size_t i = 0; (i < cnt) && ((0U == top) || (i < top)); i++)
+    {
+        char name[256];
+
+        printf("%10llu %12.3f %12.3f %10.3f  %s\n",
+               (unsigned long long)list[i].calls, flame_ms(ctx, list[i].incl),
+               flame_ms(ctx, list[i].self),
+               (0U != list[i].calls) ? (flame_ms(ctx, list[i].incl) * 1e3 /
+                                        (double)list[i].calls) : 0.0,
+               flame_name(ctx, list[i].fn, name, sizeof(name)));
+    }
+    printf("%llu event(s) in %llu record(s), %llu dropped on the target, "
+           "%llu unmatched exit(s), %llu resync(s)\n",
+           (unsigned long long)ctx->events, (unsigned long long)ctx->records,
+           (unsigned long long)ctx->dropped, (unsigned long long)ctx->unmatched,
+           (unsigned long long)ctx->resyncs);
+    if ((0U != ctx->malformed) || (0U != stream.crc_errors))
+    {
+        printf("%llu malformed record(s), %llu dropped on CRC error\n",
+               (unsigned long long)ctx->malformed,
+               (unsigned long long)stream.crc_errors);
+    }
+
+    if (NULL != folded)
+    {
+        FILE *out = fopen(folded, "w");
+
+        if (NULL == out)
+        {
+            perror(folded);
+        }
+        else
+        {
+            for (size_t i = 0; i < FLAME_THREADS; i++)
+            {
+                char line[65536];
+
+                if (0U == ctx->thread[i].root.total)
+                {
+                    continue;
+                }
+                snprintf(line, sizeof(line), "%s",
+                         ('\0' != ctx->thread[i].name[0]) ? ctx->thread[i].name : "?");
+                flame_folded(ctx, out, &ctx->thread[i].root, line, strlen(line),
+                             sizeof(line));
+            }
+            fclose(out);
+        }
+    }
+
+    if (NULL != svg)
+    {
+        FILE *out = fopen(svg, "w");
+
+        if (NULL == out)
+        {
+            perror(svg);
+        }
+        else
+        {
+            flame_svg(ctx, out);
+            fclose(out);
+        }
+    }
+
+    debug_stream_free(&stream);
+    debug_symbols_close(ctx->sym);
+    for (size_t i = 0; i < FLAME_THREADS; i++)
+    {
+        flame_free(ctx->thread[i].root.child);
+        free(ctx->thread[i].stack);
+    }
+    free(list);
+    free(ctx->func);
+    free(ctx);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
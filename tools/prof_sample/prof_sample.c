@@ -0,0 +1,467 @@
+/**
+ * @file      prof_sample.c
+ * @brief     Aggregates PC samples by function.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Reads the DEBUG_RECORD_SAMPLE records of a capture (core/debug_sample.c)
+ * and prints where the time went:
+ *  - per function (or per source line with --lines): samples, share of
+ *    all samples and the estimated time at the sampling rate;
+ *  - per thread: samples and share, with interrupt handlers as "[isr]".
+ *
+ * Samples outside the image (shared libraries on a host build) are
+ * counted as "[outside]". --thread keeps only one thread's samples.
+ *
+ * With --elf, PCs are symbolized through addr2line. On a host build,
+ * link with -no-pie so the addresses match the ELF.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o prof_sample \
+ *       prof_sample.c ../common/debug_stream.c ../common/debug_symbols.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   prof_sample [--elf firmware.elf] [--addr2line tool] [--top N]
+ *               [--lines] [--thread NAME] [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+#include "debug_symbols.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Thread indexes are one byte */
+#define SAMPLE_THREADS  256U
+
+/** @brief Longest function or location text */
+#define SAMPLE_NAME_LEN 256U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Samples of one PC */
+typedef struct
+{
+    uint64_t pc;
+    uint64_t count;
+    uint8_t  used;
+} sample_pc_t;
+
+/** @brief Samples of one function or line */
+typedef struct
+{
+    char     name[(2U * SAMPLE_NAME_LEN) + 4U];   /**< "file:line (function)" */
+    uint64_t count;
+} sample_func_t;
+
+/** @brief Aggregation context */
+typedef struct
+{
+    char         name[SAMPLE_THREADS][DEBUG_RECORD_NAME_LEN + 1U];
+    uint64_t     per_thread[SAMPLE_THREADS];
+    const char  *only;          /**< --thread filter, NULL = all */
+
+    sample_pc_t *pcs;           /**< Open-addressing table */
+    size_t       pcs_cap;
+    size_t       pcs_len;
+
+    uint64_t     total;
+    uint64_t     outside;
+    uint32_t     rate_hz;
+    uint32_t     dropped;
+    uint64_t     records;
+    uint64_t     malformed;
+} sample_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static size_t sample_hash(uint64_t pc, size_t cap)
+{
+    pc ^= pc >> 29;
+    pc *= 0xBF58476D1CE4E5B9ULL;
+    pc ^= pc >> 32;
+
+    return (size_t)pc & (cap - 1U);
+}
+
+static void sample_count(sample_ctx_t *ctx, uint64_t pc)
+{
+    if ((2U * (ctx->pcs_len + 1U)) > ctx->pcs_cap)
+    {
+        size_t       cap = (0U != ctx->pcs_cap) ? (ctx->pcs_cap * 2U) : 4096U;
+        sample_pc_t *tab = calloc(cap, sizeof(*tab));
+
+        if (NULL == tab)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < ctx->pcs_cap; i++)
+        {
+            if (0U != ctx->pcs[i].used)
+            {
+                size_t h = sample_hash(ctx->pcs[i].pc, cap);
+
+                while (0U != tab[h].used)
+                {
+                    h = (h + 1U) & (cap - 1U);
+                }
+                tab[h] = ctx->pcs[i];
+            }
+        }
+        free(ctx->pcs);
+        ctx->pcs     = tab;
+        ctx->pcs_cap = cap;
+    }
+
+    size_t h = sample_hash(pc, ctx->pcs_cap);
+
+    while ((0U != ctx->pcs[h].used) && (pc != ctx->pcs[h].pc))
+    {
+        h = (h + 1U) & (ctx->pcs_cap - 1U);
+    }
+    if (0U == ctx->pcs[h].used)
+    {
+        ctx->pcs[h].used = 1;
+        ctx->pcs[h].pc   = pc;
+        ctx->pcs_len++;
+    }
+    ctx->pcs[h].count++;
+}
+
+static const char *thread_label(const sample_ctx_t *ctx, unsigned thread)
+{
+    if (DEBUG_SAMPLE_ISR == thread)
+    {
+        return "[isr]";
+    }
+    if ((DEBUG_SAMPLE_NO_THREAD == thread) || ('\0' == ctx->name[thread][0]))
+    {
+        return "[unknown]";
+    }
+
+    return ctx->name[thread];
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    sample_ctx_t         *ctx = user;
+    debug_sample_record_t rec;
+
+    if (DEBUG_RECORD_SAMPLE != type)
+    {
+        return;
+    }
+    if (len < sizeof(rec))
+    {
+        ctx->malformed++;
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+    if (DEBUG_SAMPLE_VERSION != rec.version)
+    {
+        ctx->malformed++;
+        return;
+    }
+    ctx->records++;
+    ctx->rate_hz = rec.rate_hz;
+    ctx->dropped = rec.dropped;
+
+    if (0U != (rec.flags & DEBUG_SAMPLE_FLAG_NAME))
+    {
+        size_t n = len - sizeof(rec);
+
+        n = (n < DEBUG_RECORD_NAME_LEN) ? n : DEBUG_RECORD_NAME_LEN;
+        memcpy(ctx->name[rec.thread], &payload[sizeof(rec)], n);
+        ctx->name[rec.thread][n] = '\0';
+        return;
+    }
+
+    if ((len - sizeof(rec)) < ((size_t)rec.count * sizeof(debug_sample_t)))
+    {
+        ctx->malformed++;
+        return;
+    }
+
+    for (size_t i = 0; i < rec.count; i++)
+    {
+        debug_sample_t s;
+
+        memcpy(&s, &payload[sizeof(rec) + (i * sizeof(s))], sizeof(s));
+        if ((NULL != ctx->only) &&
+            (0 != strcmp(ctx->only, thread_label(ctx, s.thread))))
+        {
+            continue;
+        }
+
+        ctx->total++;
+        ctx->per_thread[s.thread]++;
+        if (0U == s.pc)
+        {
+            ctx->outside++;
+        }
+        else
+        {
+            sample_count(ctx, ((uint64_t)rec.addr_hi << 32) | s.pc);
+        }
+    }
+}
+
+static int by_name(const void *a, const void *b)
+{
+    return strcmp(((const sample_func_t *)a)->name, ((const sample_func_t *)b)->name);
+}
+
+static int by_count(const void *a, const void *b)
+{
+    const sample_func_t *x = a;
+    const sample_func_t *y = b;
+
+    if (x->count != y->count)
+    {
+        return (x->count < y->count) ? 1 : -1;
+    }
+
+    return strcmp(x->name, y->name);
+}
+
+static void print_row(const sample_ctx_t *ctx, uint64_t count, const char *name)
+{
+    printf("%10llu %7.2f%% %12.3f  %s\n", (unsigned long long)count,
+           100.0 * (double)count / (double)ctx->total,
+           (0U != ctx->rate_hz) ? ((double)count * 1e3 / (double)ctx->rate_hz) : 0.0,
+           name);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--elf firmware.elf] [--addr2line tool] [--top N]\n"
+            "          [--lines] [--thread NAME] [capture]\n"
+            "  Counts the PC samples in the capture (or stdin) per function.\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char   *elf       = NULL;
+    const char   *addr2line = NULL;
+    const char   *path      = NULL;
+    size_t        top       = 30;
+    int           lines     = 0;
+    sample_ctx_t *ctx       = calloc(1, sizeof(*ctx));
+
+    if (NULL == ctx)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(argv[i], "--elf")) && (NULL != val))
+        {
+            elf = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--addr2line")) && (NULL != val))
+        {
+            addr2line = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--top")) && (NULL != val))
+        {
+            top = (size_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "--thread")) && (NULL != val))
+        {
+            ctx->only = argv[++i];
+        }
+        else if (0 == strcmp(argv[i], "--lines"))
+        {
+            lines = 1;
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            free(ctx);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        free(ctx);
+        return 1;
+    }
+
+    debug_symbols_t *sym = NULL;
+
+    if (NULL != elf)
+    {
+        sym = debug_symbols_open(elf, addr2line);
+        if (NULL == sym)
+        {
+            fprintf(stderr, "warning: cannot symbolize with %s\n", elf);
+        }
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, ctx))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(ctx);
+        return 1;
+    }
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+
+    /* Name every PC, then merge the PCs of the same function or line */
+    sample_func_t *funcs = calloc(ctx->pcs_len + 1U, sizeof(*funcs));
+    size_t         cnt   = 0;
+
+    if (NULL == funcs)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < ctx->pcs_cap; i++)
+    {
+        const sample_pc_t *p = &ctx->pcs[i];
+        char               func[SAMPLE_NAME_LEN];
+        char               loc[SAMPLE_NAME_LEN];
+
+        if (0U == p->used)
+        {
+            continue;
+        }
+        if ((NULL == sym) ||
+            (1 != debug_symbols_lookup(sym, p->pc, func, sizeof(func), loc, sizeof(loc))))
+        {
+            snprintf(funcs[cnt].name, sizeof(funcs[cnt].name), "0x%llx",
+                     (unsigned long long)p->pc);
+        }
+        else if (0 != lines)
+        {
+            snprintf(funcs[cnt].name, sizeof(funcs[cnt].name), "%s (%s)", loc, func);
+        }
+        else
+        {
+            snprintf(funcs[cnt].name, sizeof(funcs[cnt].name), "%s", func);
+        }
+        funcs[cnt++].count = p->count;
+    }
+    qsort(funcs, cnt, sizeof(*funcs), by_name);
+
+    size_t merged = 0;
+
+    for (size_t i = 0; i < cnt; i++)
+    {
+        if ((0U != merged) && (0 == strcmp(funcs[merged - 1U].name, funcs[i].name)))
+        {
+            funcs[merged - 1U].count += funcs[i].count;
+        }
+        else
+        {
+            funcs[merged++] = funcs[i];
+        }
+    }
+    if (0U != ctx->outside)
+    {
+        snprintf(funcs[merged].name, sizeof(funcs[merged].name), "[outside]");
+        funcs[merged++].count = ctx->outside;
+    }
+    qsort(funcs, merged, sizeof(*funcs), by_count);
+
+    if (0U == ctx->total)
+    {
+        printf("no samples\n");
+    }
+    else
+    {
+        printf("%10s %8s %12s  %s\n", "samples", "share", "est_ms",
+               (0 != lines) ? "line" : "function");
+        for (size_t i = 0; (i < merged) && ((0U == top) || (i < top)); i++)
+        {
+            print_row(ctx, funcs[i].count, funcs[i].name);
+        }
+
+        printf("\n%10s %8s %12s  %s\n", "samples", "share", "est_ms", "thread");
+        for (unsigned t = 0; t < SAMPLE_THREADS; t++)
+        {
+            if (0U != ctx->per_thread[t])
+            {
+                print_row(ctx, ctx->per_thread[t], thread_label(ctx, t));
+            }
+        }
+    }
+
+    printf("\n%llu sample(s) at %lu Hz in %llu record(s), %lu dropped on the target\n",
+           (unsigned long long)ctx->total, (unsigned long)ctx->rate_hz,
+           (unsigned long long)ctx->records, (unsigned long)ctx->dropped);
+    if ((0U != ctx->malformed) || (0U != stream.crc_errors))
+    {
+        printf("%llu malformed record(s), %llu dropped on CRC error\n",
+               (unsigned long long)ctx->malformed,
+               (unsigned long long)stream.crc_errors);
+    }
+
+    debug_stream_free(&stream);
+    debug_symbols_close(sym);
+    free(funcs);
+    free(ctx->pcs);
+    free(ctx);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,296 @@
+/**
+ * @file      task_stats.c
+ * @brief     Host renderer for FreeRTOS task statistics records.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Collects the DEBUG_RECORD_TASK_STATS records of a capture (see
+ * port/freertos/debug_freertos_stats.h) and prints one table per sample,
+ * busiest task first:
+ *
+ * @code
+ *   sample 12 at 12000: 5 tasks
+ *     TASK              STATE     PRIO   CPU%   STACK FREE
+ *     ctrl              blocked   5/5    41.2   312
+ *     IDLE              ready     0/0    52.0   88
+ * @endcode
+ *
+ * With --csv it writes one row per task and sample instead, for plotting.
+ * A sample is printed when its last record arrives, or when the next
+ * sample starts if that record was lost; the table then notes how many
+ * records are missing. Text lines and other records are ignored.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o task_stats \
+ *       task_stats.c ../common/debug_stream.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   task_stats [--csv] [capture.bin]
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Most tasks held per sample */
+#define STATS_MAX_TASKS    256U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Renderer state */
+typedef struct
+{
+    FILE                     *out;
+    int                       csv;      /**< CSV rows instead of tables */
+    int                       open;     /**< A sample is being collected */
+    uint16_t                  sample;   /**< Sample being collected */
+    size_t                    count;    /**< Records held */
+    debug_task_stats_record_t task[STATS_MAX_TASKS];
+    uint64_t                  samples;  /**< Samples printed */
+    uint64_t                  partial;  /**< Samples with missing records */
+} stats_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static const char *stats_state(uint8_t state)
+{
+    static const char *const NAMES[] =
+    {
+        "running", "ready", "blocked", "suspended", "deleted"
+    };
+
+    return (state < (sizeof(NAMES) / sizeof(NAMES[0]))) ? NAMES[state] : "?";
+}
+
+static double stats_cpu(const debug_task_stats_record_t *t)
+{
+    return (0U != t->total_time) ?
+           ((100.0 * (double)t->run_time) / (double)t->total_time) : 0.0;
+}
+
+static int stats_by_cpu(const void *a, const void *b)
+{
+    const debug_task_stats_record_t *x = a;
+    const debug_task_stats_record_t *y = b;
+
+    return (x->run_time < y->run_time) - (x->run_time > y->run_time);
+}
+
+/**
+ * @brief Print the sample being collected and start over.
+ */
+static void stats_flush(stats_ctx_t *ctx)
+{
+    if ((0 == ctx->open) || (0U == ctx->count))
+    {
+        ctx->open  = 0;
+        ctx->count = 0;
+        return;
+    }
+
+    const debug_task_stats_record_t *first = &ctx->task[0];
+
+    if (0 == ctx->csv)
+    {
+        qsort(ctx->task, ctx->count, sizeof(ctx->task[0]), stats_by_cpu);
+
+        fprintf(ctx->out, "sample %u at %lu: %u tasks", (unsigned)first->sample,
+                (unsigned long)first->timestamp, (unsigned)first->tasks);
+        if (ctx->count < first->tasks)
+        {
+            fprintf(ctx->out, " (%zu records missing)", first->tasks - ctx->count);
+        }
+        fprintf(ctx->out, "\n  %-16s  %-9s  %-5s  %5s  %10s\n",
+                "TASK", "STATE", "PRIO", "CPU%", "STACK FREE");
+    }
+
+    for (size_t i = 0; i < ctx->count; i++)
+    {
+        const debug_task_stats_record_t *t = &ctx->task[i];
+        char name[DEBUG_RECORD_NAME_LEN + 1];
+
+        memcpy(name, t->name, DEBUG_RECORD_NAME_LEN);
+        name[DEBUG_RECORD_NAME_LEN] = '\0';
+
+        if (0 != ctx->csv)
+        {
+            fprintf(ctx->out, "%u,%lu,%lu,%s,%s,%u,%u,%lu,%lu,%.2f,%lu,%d\n",
+                    (unsigned)t->sample, (unsigned long)t->timestamp,
+                    (unsigned long)t->task_number, name, stats_state(t->state),
+                    (unsigned)t->priority, (unsigned)t->base_priority,
+                    (unsigned long)t->run_time, (unsigned long)t->total_time,
+                    stats_cpu(t), (unsigned long)t->stack_free,
+                    (0U != (t->flags & DEBUG_TASK_STATS_NEW)) ? 1 : 0);
+        }
+        else
+        {
+            char prio[16];
+
+            snprintf(prio, sizeof(prio), "%u/%u", (unsigned)t->priority,
+                     (unsigned)t->base_priority);
+            fprintf(ctx->out, "  %-16s  %-9s  %-5s  %5.1f  %10lu%s\n", name,
+                    stats_state(t->state), prio, stats_cpu(t),
+                    (unsigned long)t->stack_free,
+                    (0U != (t->flags & DEBUG_TASK_STATS_NEW)) ? "  (new)" : "");
+        }
+    }
+
+    if (ctx->count < first->tasks)
+    {
+        ctx->partial++;
+    }
+    ctx->samples++;
+    ctx->open  = 0;
+    ctx->count = 0;
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    stats_ctx_t              *ctx = user;
+    debug_task_stats_record_t rec;
+
+    if ((DEBUG_RECORD_TASK_STATS != type) || (len < sizeof(rec)))
+    {
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+
+    if ((0 != ctx->open) && (rec.sample != ctx->sample))
+    {
+        stats_flush(ctx);
+    }
+    ctx->open   = 1;
+    ctx->sample = rec.sample;
+    if (ctx->count < STATS_MAX_TASKS)
+    {
+        ctx->task[ctx->count++] = rec;
+    }
+    if (0U != (rec.flags & DEBUG_TASK_STATS_LAST))
+    {
+        stats_flush(ctx);
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--csv] [capture]\n"
+            "  Prints the task statistics records of the capture (or stdin)\n"
+            "  as one table per sample, or as CSV rows with --csv.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char  *path = NULL;
+    stats_ctx_t *ctx  = calloc(1, sizeof(*ctx));
+
+    if (NULL == ctx)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    ctx->out = stdout;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--csv"))
+        {
+            ctx->csv = 1;
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            free(ctx);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        free(ctx);
+        return 1;
+    }
+
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, ctx))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(ctx);
+        return 1;
+    }
+
+    if (0 != ctx->csv)
+    {
+        fprintf(ctx->out, "sample,timestamp,task,name,state,priority,"
+                "base_priority,run_time,total_time,cpu_percent,stack_free,new\n");
+    }
+
+    uint8_t buf[65536];
+    size_t  n;
+
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0U)
+    {
+        debug_stream_feed(&stream, buf, n);
+    }
+    debug_stream_finish(&stream);
+    stats_flush(ctx);
+
+    fprintf(stderr, "%llu sample(s), %llu with missing records",
+            (unsigned long long)ctx->samples, (unsigned long long)ctx->partial);
+    if (0U != stream.crc_errors)
+    {
+        fprintf(stderr, ", %llu record(s) dropped on CRC error",
+                (unsigned long long)stream.crc_errors);
+    }
+    fputc('\n', stderr);
+
+    debug_stream_free(&stream);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+    free(ctx);
+
+    return 0;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
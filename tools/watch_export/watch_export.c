@@ -0,0 +1,478 @@
+/**
+ * @file      watch_export.c
+ * @brief     Exports variable watch frames to CSV and gnuplot.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Decodes the DEBUG_RECORD_WATCH_DEF / DEBUG_RECORD_WATCH records of a
+ * capture (see core/debug_watch.h) into one CSV row per sample:
+ *
+ *   seq,time_s,<var>,<var>,...
+ *
+ * The columns are every variable seen in the capture, in order of first
+ * appearance; a variable not watched at the time of a sample has an empty
+ * cell. time_s comes from the frame cycle counter (unwrapped) and the
+ * rate announced by the target.
+ *
+ * With --plot, also writes a gnuplot script that plots every column of
+ * the CSV against time. Frames whose table never arrived (capture started
+ * mid-stream, before the periodic re-send) and samples lost on the target
+ * are counted on stderr.
+ *
+ * Build:
+ * @code
+ *   gcc -O2 -Wall -I../../core -I../common -o watch_export \
+ *       watch_export.c ../common/debug_stream.c
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   watch_export [-o out.csv [--plot out.gp]] [capture.bin]
+ *   gnuplot -p out.gp
+ * @endcode
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "debug_record.h"
+#include "debug_stream.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Most distinct variable names in one export */
+#define EXPORT_MAX_COLUMNS  256U
+
+/** @brief Most variables in one layout (mask width on the target) */
+#define EXPORT_MAX_VARS     16U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Layout announced by a table record */
+typedef struct
+{
+    int      valid;
+    uint8_t  count;
+    uint8_t  type[EXPORT_MAX_VARS];
+    size_t   column[EXPORT_MAX_VARS];   /**< CSV column of each variable */
+    size_t   frame_len;                 /**< Bytes per frame */
+    uint32_t cycles_hz;
+} export_layout_t;
+
+/** @brief Export state */
+typedef struct
+{
+    int             pass;               /**< 0: collect names, 1: write rows */
+    FILE           *out;
+
+    char            column[EXPORT_MAX_COLUMNS][DEBUG_RECORD_NAME_LEN + 1U];
+    size_t          columns;
+    export_layout_t layout[256];
+
+    uint64_t        cycles;             /**< Unwrapped cycle counter */
+    uint32_t        last_cycles;
+    int             started;
+    uint32_t        next_seq;
+
+    uint64_t        frames;
+    uint64_t        gaps;               /**< Samples missing from seq */
+    uint64_t        unknown;            /**< Frames without a table */
+    uint64_t        malformed;
+    uint32_t        dropped;            /**< Target counter, last seen */
+} export_ctx_t;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static size_t export_type_size(uint8_t type)
+{
+    static const uint8_t size[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8, 8, 8 };
+
+    return (type < sizeof(size)) ? size[type] : 0U;
+}
+
+/**
+ * @brief CSV column of a variable name, added on first sight.
+ */
+static size_t export_column(export_ctx_t *ctx, const char *name)
+{
+    for (size_t i = 0; i < ctx->columns; i++)
+    {
+        if (0 == strcmp(ctx->column[i], name))
+        {
+            return i;
+        }
+    }
+    if (ctx->columns >= EXPORT_MAX_COLUMNS)
+    {
+        return EXPORT_MAX_COLUMNS;
+    }
+    snprintf(ctx->column[ctx->columns], sizeof(ctx->column[0]), "%s", name);
+    return ctx->columns++;
+}
+
+static void export_def(export_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_watch_def_record_t rec;
+
+    if (len < sizeof(rec))
+    {
+        ctx->malformed++;
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+    if ((rec.count > EXPORT_MAX_VARS) ||
+        ((sizeof(rec) + (rec.count * sizeof(debug_watch_var_t))) > len))
+    {
+        ctx->malformed++;
+        return;
+    }
+
+    export_layout_t *l = &ctx->layout[rec.layout];
+
+    memset(l, 0, sizeof(*l));
+    l->count     = rec.count;
+    l->cycles_hz = rec.cycles_hz;
+
+    for (size_t i = 0; i < rec.count; i++)
+    {
+        debug_watch_var_t var;
+        char              name[DEBUG_RECORD_NAME_LEN + 1U];
+
+        memcpy(&var, &payload[sizeof(rec) + (i * sizeof(var))], sizeof(var));
+        memcpy(name, var.name, sizeof(var.name));
+        name[sizeof(var.name)] = '\0';
+
+        if (0U == export_type_size(var.type))
+        {
+            ctx->malformed++;
+            return;
+        }
+        l->type[i]    = var.type;
+        l->column[i]  = export_column(ctx, name);
+        l->frame_len += export_type_size(var.type);
+    }
+    l->frame_len += sizeof(uint32_t);
+    l->valid      = 1;
+}
+
+static void export_value(FILE *out, uint8_t type, const uint8_t *p)
+{
+    switch (type)
+    {
+        case DEBUG_WATCH_U8:  fprintf(out, "%u", (unsigned)p[0]); break;
+        case DEBUG_WATCH_I8:  fprintf(out, "%d", (int)(int8_t)p[0]); break;
+        case DEBUG_WATCH_U16: { uint16_t v; memcpy(&v, p, 2); fprintf(out, "%u", (unsigned)v); break; }
+        case DEBUG_WATCH_I16: { int16_t v;  memcpy(&v, p, 2); fprintf(out, "%d", (int)v); break; }
+        case DEBUG_WATCH_U32: { uint32_t v; memcpy(&v, p, 4); fprintf(out, "%lu", (unsigned long)v); break; }
+        case DEBUG_WATCH_I32: { int32_t v;  memcpy(&v, p, 4); fprintf(out, "%ld", (long)v); break; }
+        case DEBUG_WATCH_F32: { float v;    memcpy(&v, p, 4); fprintf(out, "%.9g", (double)v); break; }
+        case DEBUG_WATCH_U64: { uint64_t v; memcpy(&v, p, 8); fprintf(out, "%llu", (unsigned long long)v); break; }
+        case DEBUG_WATCH_I64: { int64_t v;  memcpy(&v, p, 8); fprintf(out, "%lld", (long long)v); break; }
+        default:              { double v;   memcpy(&v, p, 8); fprintf(out, "%.17g", v); break; }
+    }
+}
+
+static void export_frames(export_ctx_t *ctx, const uint8_t *payload, size_t len)
+{
+    debug_watch_record_t   rec;
+    const export_layout_t *l;
+
+    if (len < sizeof(rec))
+    {
+        ctx->malformed++;
+        return;
+    }
+    memcpy(&rec, payload, sizeof(rec));
+    ctx->dropped = rec.dropped;
+
+    l = &ctx->layout[rec.layout];
+    if (0 == l->valid)
+    {
+        ctx->unknown += rec.count;
+        return;
+    }
+    if ((sizeof(rec) + (rec.count * l->frame_len)) > len)
+    {
+        ctx->malformed++;
+        return;
+    }
+
+    if ((0 != ctx->started) && (rec.seq != ctx->next_seq))
+    {
+        ctx->gaps += (uint32_t)(rec.seq - ctx->next_seq);
+    }
+    ctx->next_seq = rec.seq + rec.count;
+
+    const uint8_t *p = &payload[sizeof(rec)];
+
+    for (uint32_t f = 0; f < rec.count; f++)
+    {
+        const uint8_t *cell[EXPORT_MAX_COLUMNS + 1U] = { NULL };
+        uint8_t        type[EXPORT_MAX_COLUMNS + 1U];
+        uint32_t       cycles;
+
+        memcpy(&cycles, p, sizeof(cycles));
+        p += sizeof(cycles);
+        for (size_t i = 0; i < l->count; i++)
+        {
+            cell[l->column[i]] = p;
+            type[l->column[i]] = l->type[i];
+            p += export_type_size(l->type[i]);
+        }
+
+        /* The cycle counter wraps; accumulate forward steps */
+        ctx->cycles     += (0 != ctx->started) ? (uint32_t)(cycles - ctx->last_cycles) :
+                                                 cycles;
+        ctx->last_cycles = cycles;
+        ctx->started     = 1;
+        ctx->frames++;
+
+        fprintf(ctx->out, "%lu,", (unsigned long)(rec.seq + f));
+        if (0U != l->cycles_hz)
+        {
+            fprintf(ctx->out, "%.9f", (double)ctx->cycles / (double)l->cycles_hz);
+        }
+        for (size_t c = 0; c < ctx->columns; c++)
+        {
+            fputc(',', ctx->out);
+            if (NULL != cell[c])
+            {
+                export_value(ctx->out, type[c], cell[c]);
+            }
+        }
+        fputc('\n', ctx->out);
+    }
+}
+
+static void on_record(void *user, uint8_t type, const uint8_t *payload,
+                      size_t len)
+{
+    export_ctx_t *ctx = user;
+
+    if (DEBUG_RECORD_WATCH_DEF == type)
+    {
+        export_def(ctx, payload, len);
+    }
+    else if ((DEBUG_RECORD_WATCH == type) && (1 == ctx->pass))
+    {
+        export_frames(ctx, payload, len);
+    }
+}
+
+/**
+ * @brief Run the stream parser over the whole capture.
+ */
+static int export_pass(export_ctx_t *ctx, const uint8_t *data, size_t len,
+                       uint64_t *crc_errors)
+{
+    debug_stream_t          stream;
+    const debug_stream_cb_t cb = { .on_text = NULL, .on_record = on_record };
+
+    if (0 != debug_stream_init(&stream, &cb, ctx))
+    {
+        return -1;
+    }
+    debug_stream_feed(&stream, data, len);
+    debug_stream_finish(&stream);
+    *crc_errors = stream.crc_errors;
+    debug_stream_free(&stream);
+    return 0;
+}
+
+/**
+ * @brief Write a gnuplot script plotting every column against time.
+ */
+static int export_plot(const export_ctx_t *ctx, const char *path,
+                       const char *csv)
+{
+    FILE *gp = fopen(path, "w");
+
+    if (NULL == gp)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(gp, "set datafile separator ','\n"
+                "set key outside right\n"
+                "set grid\n"
+                "set xlabel 'time [s]'\n"
+                "plot");
+    for (size_t c = 0; c < ctx->columns; c++)
+    {
+        fprintf(gp, "%s '%s' using 2:%zu with lines title '%s'",
+                (0U == c) ? "" : ", \\\n    ", csv, c + 3U, ctx->column[c]);
+    }
+    fputc('\n', gp);
+
+    fclose(gp);
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-o out.csv [--plot out.gp]] [capture]\n"
+            "  Exports the variable watch frames of the capture (or stdin)\n"
+            "  as CSV, one row per sample.\n", prog);
+}
+
+/*******************************************************************************
+ * Main
+ *******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char   *path = NULL;
+    const char   *csv  = NULL;
+    const char   *plot = NULL;
+    export_ctx_t *ctx  = calloc(1, sizeof(*ctx));
+
+    if (NULL == ctx)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *val = ((i + 1) < argc) ? argv[i + 1] : NULL;
+
+        if ((0 == strcmp(argv[i], "-o")) && (NULL != val))
+        {
+            csv = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--plot")) && (NULL != val))
+        {
+            plot = argv[++i];
+        }
+        else if ('-' == argv[i][0])
+        {
+            usage(argv[0]);
+            free(ctx);
+            return 2;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+    if ((NULL != plot) && (NULL == csv))
+    {
+        fprintf(stderr, "--plot needs -o (the script reads the CSV file)\n");
+        free(ctx);
+        return 2;
+    }
+
+    /* Columns must be known before the first row: read it all, parse twice */
+    FILE *in = (NULL != path) ? fopen(path, "rb") : stdin;
+    if (NULL == in)
+    {
+        perror(path);
+        free(ctx);
+        return 1;
+    }
+
+    uint8_t *data = NULL;
+    size_t   len  = 0;
+    size_t   cap  = 0;
+    size_t   n;
+
+    do
+    {
+        if ((cap - len) < 65536U)
+        {
+            cap = (0U != cap) ? (cap * 2U) : 1048576U;
+            uint8_t *grown = realloc(data, cap);
+            if (NULL == grown)
+            {
+                fprintf(stderr, "out of memory\n");
+                free(data);
+                free(ctx);
+                return 1;
+            }
+            data = grown;
+        }
+        n    = fread(&data[len], 1, cap - len, in);
+        len += n;
+    } while (n > 0U);
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+
+    ctx->out = (NULL != csv) ? fopen(csv, "w") : stdout;
+    if (NULL == ctx->out)
+    {
+        perror(csv);
+        free(data);
+        free(ctx);
+        return 1;
+    }
+
+    uint64_t crc_errors = 0;
+
+    if (0 == export_pass(ctx, data, len, &crc_errors))
+    {
+        memset(ctx->layout, 0, sizeof(ctx->layout));
+        ctx->pass = 1;
+
+        fprintf(ctx->out, "seq,time_s");
+        for (size_t c = 0; c < ctx->columns; c++)
+        {
+            fprintf(ctx->out, ",%s", ctx->column[c]);
+        }
+        fputc('\n', ctx->out);
+
+        (void)export_pass(ctx, data, len, &crc_errors);
+    }
+
+    fprintf(stderr, "%llu frame(s), %zu variable(s); %llu missing, "
+                    "%lu dropped on the target, %llu without a table",
+            (unsigned long long)ctx->frames, ctx->columns,
+            (unsigned long long)ctx->gaps, (unsigned long)ctx->dropped,
+            (unsigned long long)ctx->unknown);
+    if ((0U != ctx->malformed) || (0U != crc_errors))
+    {
+        fprintf(stderr, "; %llu malformed, %llu CRC error(s)",
+                (unsigned long long)ctx->malformed,
+                (unsigned long long)crc_errors);
+    }
+    fputc('\n', stderr);
+
+    int ret = 0;
+
+    if (NULL != plot)
+    {
+        ret = (0 == export_plot(ctx, plot, csv)) ? 0 : 1;
+    }
+
+    if (stdout != ctx->out)
+    {
+        fclose(ctx->out);
+    }
+    free(data);
+    free(ctx);
+
+    return ret;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -12,6 +12,11 @@
  * Supported transports:
  *   - USB CDC
  *   - UART (STM32, NXP, TI)
+ *   - RAM ring buffer
+ *   - Standard output (host builds)
+ *   - Persistent flash log
+ *   - Buffered file (host builds)
+ *   - Failover chain of the above (CDC -> UART -> RAM)
  *
  * The debug core interacts with the selected transport exclusively
  * through a transport HAL operations table, ensuring portability and
@@ -39,6 +44,30 @@
     #endif
 #endif
 
+#if DEBUG_USE_RAM_BUFFER
+#include "debug_transport_ram.h"
+#endif
+
+#if DEBUG_USE_STDIO
+#include "debug_transport_stdio.h"
+#endif
+
+#if DEBUG_USE_FLASH
+#include "debug_transport_flash.h"
+#endif
+
+#if DEBUG_USE_FILE
+#include "debug_transport_file.h"
+#endif
+
+#if DEBUG_USE_TRANSPORT_FAILOVER
+#include "debug_transport_failover.h"
+#endif
+
+#if DEBUG_USE_TRANSPORT_MUX
+#include "debug_transport_mux.h"
+#endif
+
 /*******************************************************************************
  * Public Function Definitions
  *******************************************************************************/
@@ -65,20 +94,32 @@ int debug_transport_init(debug_transport_hal_t *transport)
         return -1;
     }
 
-#if DEBUG_USE_USB_CDC
+#if DEBUG_USE_TRANSPORT_MUX
+    transport->ops = debug_transport_mux_ops();
+#elif DEBUG_USE_TRANSPORT_FAILOVER
+    transport->ops = debug_transport_failover_ops();
+#elif DEBUG_USE_USB_CDC
     transport->ops = debug_transport_usb_cdc_ops();
 #elif DEBUG_USE_UART
     #if DEBUG_VENDOR_STM32
     	transport->ops =  debug_transport_uart_st_ops();
     #elif DEBUG_VENDOR_NXP
-    	transport->ops =  = debug_transport_uart_nxp_ops();
+    	transport->ops =  debug_transport_uart_nxp_ops();
     #elif DEBUG_VENDOR_TI
-    	transport->ops =  = debug_transport_uart_ti_ops();
+    	transport->ops =  debug_transport_uart_ti_ops();
     #else
         #error "No UART transport vendor selected!"
     #endif
+#elif DEBUG_USE_RAM_BUFFER
+    transport->ops = debug_transport_ram_ops();
+#elif DEBUG_USE_STDIO
+    transport->ops = debug_transport_stdio_ops();
+#elif DEBUG_USE_FLASH
+    transport->ops = debug_transport_flash_ops();
+#elif DEBUG_USE_FILE
+    transport->ops = debug_transport_file_ops();
 #else
-    #error "No debug transport selected! Define DEBUG_USE_USB_CDC or DEBUG_USE_UART in config.h"
+    #error "No debug transport selected! Define DEBUG_USE_USB_CDC, DEBUG_USE_UART, DEBUG_USE_RAM_BUFFER, DEBUG_USE_STDIO, DEBUG_USE_FLASH or DEBUG_USE_FILE in config.h"
 #endif
 
     if(NULL != transport->ops->init)
@@ -51,6 +51,7 @@ typedef struct debug_transport_hal debug_transport_hal_t;
  * by a debug transport backend (e.g., UART, USB CDC, RTT).
  *
  * Each backend provides an instance of this structure to the debug core.
+ * Optional operations may be left NULL.
  */
 typedef struct
 {
@@ -58,6 +59,13 @@ typedef struct
     int (*deinit)(void);                           /**< Deinitialize transport */
     int (*write)(const uint8_t *data,
                  size_t len);                      /**< Write data to transport */
+    int (*is_ready)(void);                         /**< Link state: 1 = up (optional, NULL = always up) */
+    int (*write_polled)(const uint8_t *data,
+                        size_t len);               /**< Polled write usable with IRQs masked (optional) */
+    int (*flush)(void);                            /**< Push out buffered data synchronously (optional) */
+    int (*service)(void);                          /**< Background work, called outside the debug lock (optional) */
+    int (*read)(uint8_t *data, size_t len);        /**< Non-blocking receive: bytes read, 0 if none, <0 on error (optional) */
+    int (*fill)(void);                             /**< Transmit backlog in percent (0..100) of its capacity (optional) */
 } debug_transport_ops_t;
 
 /**
@@ -0,0 +1,692 @@
+/**
+ * @file      debug_transport_failover.c
+ * @brief     Failover debug transport implementation
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This module implements a composite debug transport that walks a
+ * prioritized chain of member transports and writes each record to the
+ * first link that is ready.
+ *
+ * Only a link's is_ready() state moves output along the chain. A ready
+ * link that rejects a write is busy (e.g. a USB transfer still in
+ * flight), so the write is retried up to DEBUG_FAILOVER_BUSY_RETRIES
+ * times; if the link is still busy the record is queued in the RAM ring
+ * (when present) and reaches the link with the next replay, so one host
+ * never sees records that went to another link in between.
+ *
+ * Every write starts from the highest-priority link, so output moves back
+ * automatically once a preferred link (e.g. USB CDC after re-plug) reports
+ * ready again. Before switching away from the RAM ring, its backlog is
+ * replayed to the recovered link so that record order is preserved.
+ *
+ * In panic mode the same routing is done with the members' polled write
+ * operations; links without one are skipped. flush() pushes the RAM
+ * backlog to the best available physical link. service() is forwarded
+ * to every member that has one.
+ *
+ * All calls are serialized by the debug core through the port lock.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include "config.h"
+
+#if DEBUG_USE_TRANSPORT_FAILOVER
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "debug_transport_failover.h"
+#include "debug_transport.h"
+
+#if DEBUG_USE_USB_CDC
+#include "debug_transport_usb_cdc_st.h"
+#endif
+
+#if DEBUG_USE_UART
+    #if DEBUG_VENDOR_STM32
+        #include "debug_transport_uart_st.h"
+    #elif DEBUG_VENDOR_NXP
+        #include "debug_transport_uart_nxp.h"
+    #elif DEBUG_VENDOR_TI
+        #include "debug_transport_uart_ti.h"
+    #endif
+#endif
+
+#if DEBUG_USE_FLASH
+#include "debug_transport_flash.h"
+#endif
+
+#if DEBUG_USE_RAM_BUFFER
+#include "debug_transport_ram.h"
+#endif
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Size of the chunks used to replay the RAM backlog */
+#define FAILOVER_REPLAY_CHUNK   64U
+
+/** @brief Link write result: the link went down during the write */
+#define FAILOVER_LINK_DOWN      (-2)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Member write operation (normal or polled) */
+typedef int (*failover_write_fn_t)(const uint8_t *data, size_t len);
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int  failover_init(void);
+static int  failover_deinit(void);
+static int  failover_write(const uint8_t *data, size_t len);
+static int  failover_write_polled(const uint8_t *data, size_t len);
+static int  failover_flush(void);
+static int  failover_service(void);
+static int  failover_is_ready(void);
+static int  failover_read(uint8_t *data, size_t len);
+static int  failover_fill(void);
+static int  failover_link_ready(size_t index);
+static int  failover_link_write(size_t index, failover_write_fn_t writer,
+                                const uint8_t *data, size_t len);
+static int  failover_route(const uint8_t *data, size_t len, int polled);
+#if DEBUG_USE_RAM_BUFFER
+static int  failover_is_ram(const debug_transport_ops_t *link);
+static int  failover_replay_ram(size_t index, failover_write_fn_t writer);
+static int  failover_queue_ram(const uint8_t *data, size_t len, int polled);
+#endif
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Failover transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_FAILOVER =
+{
+    .init         = failover_init,
+    .deinit       = failover_deinit,
+    .write        = failover_write,
+    .is_ready     = failover_is_ready,
+    .write_polled = failover_write_polled,
+    .flush        = failover_flush,
+    .service      = failover_service,
+    .read         = failover_read,
+    .fill         = failover_fill,
+};
+
+/** @brief Member transports, highest priority first */
+static const debug_transport_ops_t *s_chain[DEBUG_FAILOVER_MAX_LINKS];
+
+/** @brief Number of valid entries in s_chain */
+static size_t s_chain_len = 0;
+
+/** @brief Per-link init result (1 = usable) */
+static uint8_t s_link_up[DEBUG_FAILOVER_MAX_LINKS];
+
+/** @brief Index of the link used for the last successful write */
+static int s_active = -1;
+
+/** @brief Number of link changes */
+static uint32_t s_switches = 0;
+
+#if DEBUG_USE_RAM_BUFFER
+/** @brief Staging buffer for RAM backlog replay */
+static uint8_t s_replay[FAILOVER_REPLAY_CHUNK];
+#endif
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the failover transport and all member links.
+ *
+ * @retval 0   At least one link initialized successfully.
+ * @retval -1  No usable link.
+ *
+ * @note
+ * A member whose init() fails is skipped for the rest of the session.
+ */
+static int failover_init(void)
+{
+    if (0U == s_chain_len)
+    {
+#if DEBUG_USE_USB_CDC
+        s_chain[s_chain_len++] = debug_transport_usb_cdc_ops();
+#endif
+#if DEBUG_USE_UART
+    #if DEBUG_VENDOR_STM32
+        s_chain[s_chain_len++] = debug_transport_uart_st_ops();
+    #elif DEBUG_VENDOR_NXP
+        s_chain[s_chain_len++] = debug_transport_uart_nxp_ops();
+    #elif DEBUG_VENDOR_TI
+        s_chain[s_chain_len++] = debug_transport_uart_ti_ops();
+    #endif
+#endif
+#if DEBUG_USE_FLASH
+        s_chain[s_chain_len++] = debug_transport_flash_ops();
+#endif
+#if DEBUG_USE_RAM_BUFFER
+        s_chain[s_chain_len++] = debug_transport_ram_ops();
+#endif
+    }
+
+    int usable = 0;
+
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        const debug_transport_ops_t *link = s_chain[i];
+
+        s_link_up[i] = 0;
+
+        if ((NULL == link) || (NULL == link->write))
+        {
+            continue;
+        }
+
+        if ((NULL != link->init) && (0 != link->init()))
+        {
+            continue;
+        }
+
+        s_link_up[i] = 1;
+        usable++;
+    }
+
+    s_active   = -1;
+    s_switches = 0;
+
+    return (usable > 0) ? 0 : -1;
+}/* End of failover_init() */
+
+/**
+ * @brief Deinitialize all member links.
+ *
+ * @retval 0  Deinitialization successful.
+ */
+static int failover_deinit(void)
+{
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        if ((0U != s_link_up[i]) && (NULL != s_chain[i]->deinit))
+        {
+            (void)s_chain[i]->deinit();
+        }
+        s_link_up[i] = 0;
+    }
+
+    s_active = -1;
+    return 0;
+}/* End of failover_deinit() */
+
+/**
+ * @brief Check whether a chain member can currently accept data.
+ *
+ * @param[in] index Chain index.
+ *
+ * @return 1 if usable, 0 otherwise.
+ */
+static int failover_link_ready(size_t index)
+{
+    const debug_transport_ops_t *link = s_chain[index];
+
+    if (0U == s_link_up[index])
+    {
+        return 0;
+    }
+
+    if (NULL == link->is_ready)
+    {
+        return 1;
+    }
+
+    return (0 != link->is_ready()) ? 1 : 0;
+}/* End of failover_link_ready() */
+
+/**
+ * @brief Write to a ready chain member, waiting out a busy link.
+ *
+ * @param[in] index  Chain index.
+ * @param[in] writer Write operation of the link.
+ * @param[in] data   Pointer to data buffer.
+ * @param[in] len    Number of bytes to transmit.
+ *
+ * @retval >=0                 Number of bytes written.
+ * @retval FAILOVER_LINK_DOWN  The link stopped reporting ready.
+ * @retval -1                  The link stayed busy for
+ *                             DEBUG_FAILOVER_BUSY_RETRIES attempts.
+ */
+static int failover_link_write(size_t index, failover_write_fn_t writer,
+                               const uint8_t *data, size_t len)
+{
+    for (uint32_t retry = 0; ; retry++)
+    {
+        int ret = writer(data, len);
+
+        if (ret >= 0)
+        {
+            return ret;
+        }
+
+        if (0 == failover_link_ready(index))
+        {
+            return FAILOVER_LINK_DOWN;
+        }
+
+        if (retry >= DEBUG_FAILOVER_BUSY_RETRIES)
+        {
+            return -1;
+        }
+    }
+}/* End of failover_link_write() */
+
+#if DEBUG_USE_RAM_BUFFER
+/**
+ * @brief Check whether a chain member is the RAM ring.
+ */
+static int failover_is_ram(const debug_transport_ops_t *link)
+{
+    return (link == debug_transport_ram_ops()) ? 1 : 0;
+}/* End of failover_is_ram() */
+
+/**
+ * @brief Replay the RAM backlog to a recovered link.
+ *
+ * @param[in] index  Chain index of the link to replay to.
+ * @param[in] writer Write operation of that link.
+ *
+ * @retval 0                   Backlog fully delivered.
+ * @retval FAILOVER_LINK_DOWN  Link went down; the remainder stays in RAM.
+ * @retval -1                  Link stayed busy; the remainder stays in RAM.
+ */
+static int failover_replay_ram(size_t index, failover_write_fn_t writer)
+{
+    while (debug_transport_ram_count() > 0U)
+    {
+        size_t n   = debug_transport_ram_peek(s_replay, sizeof(s_replay));
+        int    ret = failover_link_write(index, writer, s_replay, n);
+
+        if (ret < 0)
+        {
+            return ret;
+        }
+
+        debug_transport_ram_consume(n);
+    }
+
+    return 0;
+}/* End of failover_replay_ram() */
+
+/**
+ * @brief Queue a record behind the RAM backlog.
+ *
+ * @param[in] data   Pointer to data buffer.
+ * @param[in] len    Number of bytes to queue.
+ * @param[in] polled Non-zero to use the polled write operation.
+ *
+ * @retval >=0  Number of bytes queued.
+ * @retval -1   No RAM ring in the chain, or it rejected the record.
+ */
+static int failover_queue_ram(const uint8_t *data, size_t len, int polled)
+{
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        const debug_transport_ops_t *link = s_chain[i];
+        failover_write_fn_t writer = (0 != polled) ? link->write_polled :
+                                                     link->write;
+
+        if ((0 != failover_is_ram(link)) && (NULL != writer) &&
+            (0 != failover_link_ready(i)))
+        {
+            return writer(data, len);
+        }
+    }
+
+    return -1;
+}/* End of failover_queue_ram() */
+#endif
+
+/**
+ * @brief Route a record to the highest-priority available link.
+ *
+ * @param[in] data   Pointer to data buffer.
+ * @param[in] len    Number of bytes to transmit.
+ * @param[in] polled Non-zero to use the members' polled write operations.
+ *
+ * @retval >=0  Number of bytes written (or queued behind the RAM backlog).
+ * @retval -1   No link accepted the record.
+ *
+ * @note
+ * Only a link that is not ready is skipped. A ready link that stays busy
+ * keeps the record: it is queued in the RAM ring, or dropped when the
+ * chain has none, but never sent to a lower-priority link.
+ */
+static int failover_route(const uint8_t *data, size_t len, int polled)
+{
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        const debug_transport_ops_t *link = s_chain[i];
+        failover_write_fn_t writer = (0 != polled) ? link->write_polled :
+                                                     link->write;
+
+        if ((NULL == writer) || (0 == failover_link_ready(i)))
+        {
+            continue;
+        }
+
+        int ret = 0;
+
+#if DEBUG_USE_RAM_BUFFER
+        /*
+         * A link ahead of the RAM ring must drain the backlog first,
+         * otherwise the new record would overtake older ones.
+         */
+        if (0 == failover_is_ram(link))
+        {
+            ret = failover_replay_ram(i, writer);
+        }
+#endif
+
+        if (ret >= 0)
+        {
+            ret = failover_link_write(i, writer, data, len);
+        }
+
+        if (ret >= 0)
+        {
+            if ((int)i != s_active)
+            {
+                s_active = (int)i;
+                s_switches++;
+            }
+            return ret;
+        }
+
+        if (FAILOVER_LINK_DOWN == ret)
+        {
+            continue;
+        }
+
+#if DEBUG_USE_RAM_BUFFER
+        /* Busy, not down: keep the record for this link */
+        if (0 == failover_is_ram(link))
+        {
+            return failover_queue_ram(data, len, polled);
+        }
+#endif
+        return -1;
+    }
+
+    return -1;
+}/* End of failover_route() */
+
+/**
+ * @brief Write a record to the highest-priority available link.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to transmit.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   No link accepted the record.
+ */
+static int failover_write(const uint8_t *data, size_t len)
+{
+    return failover_route(data, len, 0);
+}/* End of failover_write() */
+
+/**
+ * @brief Write a record using the members' polled write operations.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to transmit.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   No polled-capable link accepted the record.
+ */
+static int failover_write_polled(const uint8_t *data, size_t len)
+{
+    return failover_route(data, len, 1);
+}/* End of failover_write_polled() */
+
+/**
+ * @brief Push the RAM backlog to the best available physical link.
+ *
+ * @retval 0   Nothing buffered, or backlog delivered.
+ * @retval -1  No physical link accepted the backlog.
+ *
+ * @note
+ * Uses polled writes where available so it can run in panic mode.
+ * The RAM ring is bounded, so the flush completes in bounded time.
+ */
+static int failover_flush(void)
+{
+#if DEBUG_USE_RAM_BUFFER
+    if (0U == debug_transport_ram_count())
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        const debug_transport_ops_t *link = s_chain[i];
+        failover_write_fn_t writer = (NULL != link->write_polled) ?
+                                     link->write_polled : link->write;
+
+        if ((0 != failover_is_ram(link)) || (0 == failover_link_ready(i)))
+        {
+            continue;
+        }
+
+        int ret = failover_replay_ram(i, writer);
+
+        if (FAILOVER_LINK_DOWN != ret)
+        {
+            /* Delivered, or busy: the rest waits for this link */
+            return (ret >= 0) ? 0 : -1;
+        }
+    }
+
+    return -1;
+#else
+    return 0;
+#endif
+}/* End of failover_flush() */
+
+/**
+ * @brief Run the background work of every member link.
+ *
+ * @retval >0  At least one member did work.
+ * @retval 0   Nothing to do.
+ * @retval <0  A member reported an error.
+ */
+static int failover_service(void)
+{
+    int ret = 0;
+
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        if ((0U == s_link_up[i]) || (NULL == s_chain[i]->service))
+        {
+            continue;
+        }
+
+        int rc = s_chain[i]->service();
+        if (rc < 0)
+        {
+            ret = rc;
+        }
+        else if (ret >= 0)
+        {
+            ret += rc;
+        }
+    }
+
+    return ret;
+}/* End of failover_service() */
+
+/**
+ * @brief Report whether any member link is ready.
+ *
+ * @return 1 if at least one link is ready, 0 otherwise.
+ */
+static int failover_is_ready(void)
+{
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        if (0 != failover_link_ready(i))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}/* End of failover_is_ready() */
+
+/**
+ * @brief Report the transmit backlog of the active link.
+ *
+ * @retval 0..100  Backlog of the active link in percent.
+ * @retval -1      No active link, or it cannot tell.
+ */
+static int failover_fill(void)
+{
+    if ((s_active < 0) || ((size_t)s_active >= s_chain_len) ||
+        (NULL == s_chain[s_active]->fill))
+    {
+        return -1;
+    }
+
+    return s_chain[s_active]->fill();
+}/* End of failover_fill() */
+
+/**
+ * @brief Read host data from the links that can receive.
+ *
+ * @param[out] data Destination buffer.
+ * @param[in]  len  Buffer size.
+ *
+ * @retval >=0  Number of bytes read (0 if nothing is pending).
+ * @retval -1   Invalid parameters.
+ *
+ * @note
+ * The host may be attached to any link, not only to the one currently
+ * written to, so every ready link with a read() is polled in order.
+ */
+static int failover_read(uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < s_chain_len; i++)
+    {
+        if ((NULL == s_chain[i]->read) || (0 == failover_link_ready(i)))
+        {
+            continue;
+        }
+
+        int n = s_chain[i]->read(data, len);
+        if (n > 0)
+        {
+            return n;
+        }
+    }
+
+    return 0;
+}/* End of failover_read() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get failover debug transport operations.
+ *
+ * @return Pointer to the failover transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_failover_ops(void)
+{
+    return &DEBUG_TRANSPORT_FAILOVER;
+}/* End of debug_transport_failover_ops() */
+
+/**
+ * @brief Override the failover chain.
+ *
+ * @param[in] chain Array of transport operations tables, highest priority
+ *                  first.
+ * @param[in] count Number of entries.
+ *
+ * @retval 0   Chain installed.
+ * @retval -1  Invalid parameters.
+ */
+int debug_transport_failover_set_chain(const debug_transport_ops_t *const *chain,
+                                       size_t count)
+{
+    if ((NULL == chain) || (0U == count) ||
+        (count > DEBUG_FAILOVER_MAX_LINKS))
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (NULL == chain[i])
+        {
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        s_chain[i]   = chain[i];
+        s_link_up[i] = 0;
+    }
+    s_chain_len = count;
+
+    return 0;
+}/* End of debug_transport_failover_set_chain() */
+
+/**
+ * @brief Get the index of the link that accepted the most recent write.
+ *
+ * @return Chain index, or -1 if nothing was written yet.
+ */
+int debug_transport_failover_active(void)
+{
+    return s_active;
+}/* End of debug_transport_failover_active() */
+
+/**
+ * @brief Get the number of link changes since init.
+ *
+ * @return Number of link changes.
+ */
+uint32_t debug_transport_failover_switch_count(void)
+{
+    return s_switches;
+}/* End of debug_transport_failover_switch_count() */
+
+#endif /* DEBUG_USE_TRANSPORT_FAILOVER */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
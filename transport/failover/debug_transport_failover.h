@@ -0,0 +1,104 @@
+/**
+ * @file      debug_transport_failover.h
+ * @brief     Failover debug transport interface
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a composite debug transport that forwards output
+ * to the first available link of a prioritized chain, for example
+ * USB CDC -> UART -> RAM ring.
+ *
+ * Link availability is determined from the optional is_ready() operation
+ * of each member transport. A record is retried on the next link when its
+ * link goes down, so it is not lost when a cable is unplugged
+ * mid-session. A link that is up but busy is waited for instead, and the
+ * record is queued in the RAM ring if the wait runs out. When a
+ * higher-priority link comes back, any backlog held in the RAM ring is
+ * replayed to it before new output.
+ *
+ * The failover transport itself implements debug_transport_ops_t and is
+ * installed like any other transport.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_FAILOVER_H
+#define DEBUG_TRANSPORT_FAILOVER_H
+
+#include "config.h"
+
+#if DEBUG_USE_TRANSPORT_FAILOVER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get failover debug transport operations.
+ *
+ * @return Pointer to the failover transport operations table.
+ *
+ * @note
+ * Unless debug_transport_failover_set_chain() was called before init, the
+ * chain is built from the transports enabled in config.h, in the order
+ * USB CDC, UART, RAM ring.
+ */
+const debug_transport_ops_t *debug_transport_failover_ops(void);
+
+/**
+ * @brief Override the failover chain.
+ *
+ * @param[in] chain Array of transport operations tables, highest priority
+ *                  first.
+ * @param[in] count Number of entries (at most DEBUG_FAILOVER_MAX_LINKS).
+ *
+ * @retval 0   Chain installed.
+ * @retval -1  Invalid parameters.
+ *
+ * @note
+ * Must be called before the failover transport is initialized.
+ */
+int debug_transport_failover_set_chain(const debug_transport_ops_t *const *chain,
+                                       size_t count);
+
+/**
+ * @brief Get the index of the link that accepted the most recent write.
+ *
+ * @retval >=0  Chain index of the active link.
+ * @retval -1   No write has succeeded yet.
+ */
+int debug_transport_failover_active(void);
+
+/**
+ * @brief Get the number of link changes since init.
+ *
+ * @return Number of times output moved to a different link.
+ */
+uint32_t debug_transport_failover_switch_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_TRANSPORT_FAILOVER */
+#endif /* DEBUG_TRANSPORT_FAILOVER_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
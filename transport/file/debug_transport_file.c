@@ -0,0 +1,714 @@
+/**
+ * @file      debug_transport_file.c
+ * @brief     Buffered file debug transport implementation (host)
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This module implements a host debug transport that takes write(2) and
+ * fdatasync(2) out of the logging path.
+ *
+ *  - write() copies the record into the current buffer of a pool of
+ *    DEBUG_FILE_BUFFER_COUNT page-aligned buffers of
+ *    DEBUG_FILE_BUFFER_SIZE bytes. A full buffer is queued for the writer
+ *    thread and the next free one is taken.
+ *  - The writer thread writes queued buffers in order. A partially filled
+ *    buffer is picked up once it is older than DEBUG_FILE_FLUSH_MS.
+ *  - Rotation is decided in write(), on a record boundary, and carried
+ *    out by the writer thread once everything before it is written:
+ *    DEBUG_FILE_PATH is renamed to DEBUG_FILE_PATH.1 (older files shift
+ *    up to DEBUG_FILE_ROTATE_KEEP) and a new file is started.
+ *  - fdatasync() is batched according to DEBUG_FILE_DURABILITY.
+ *
+ * Synchronization of write() and flush() callers is provided by the debug
+ * core; the pool itself is shared with the writer thread under s_mutex.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/* Must precede every system header */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "config.h"
+
+#if DEBUG_USE_FILE
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "debug_transport_file.h"
+#include "debug_transport.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Buffer alignment (page size) */
+#define FILE_BUFFER_ALIGN   4096U
+
+/** @brief Longest rotated file name */
+#define FILE_NAME_MAX       512U
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/**
+ * @brief Pool buffer.
+ */
+typedef struct
+{
+    uint8_t  *data;     /**< DEBUG_FILE_BUFFER_SIZE bytes, page aligned */
+    size_t    len;      /**< Bytes used */
+    uint64_t  ticket;   /**< Order in which it was queued */
+    uint8_t   rotate;   /**< Rotate the file after writing this buffer */
+} file_buf_t;
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int      file_init(void);
+static int      file_deinit(void);
+static int      file_write(const uint8_t *data, size_t len);
+static int      file_write_direct(const uint8_t *data, size_t len);
+static int      file_flush(void);
+static int      file_fill(void);
+static void    *file_writer(void *arg);
+static void     file_seal_locked(int rotate);
+static int      file_acquire_locked(void);
+static int      file_write_all(int fd, const uint8_t *data, size_t len);
+static int      file_rotate(void);
+static uint64_t file_now_ms(void);
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief File transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_FILE =
+{
+    .init         = file_init,
+    .deinit       = file_deinit,
+    .write        = file_write,
+    .write_polled = file_write_direct,  /* Bypasses the pool after flush() */
+    .flush        = file_flush,
+    .fill         = file_fill,
+};
+
+/** @brief Buffer pool */
+static file_buf_t s_bufs[DEBUG_FILE_BUFFER_COUNT];
+
+/** @brief Free buffer indices (stack) */
+static size_t s_free[DEBUG_FILE_BUFFER_COUNT];
+static size_t s_free_n = 0;
+
+/** @brief Queued buffer indices (FIFO) */
+static size_t s_full[DEBUG_FILE_BUFFER_COUNT];
+static size_t s_full_head = 0;
+static size_t s_full_n = 0;
+
+/** @brief Buffer being filled by write(), -1 if none */
+static int s_cur = -1;
+
+/** @brief Time the current buffer received its first byte */
+static uint64_t s_cur_since = 0;
+
+/** @brief Tickets: queued, written, requested to sync, synced */
+static uint64_t s_sealed = 0;
+static uint64_t s_done = 0;
+static uint64_t s_sync_req = 0;
+static uint64_t s_synced = 0;
+
+/** @brief Bytes and open time of the current file (rotation policy) */
+static uint64_t s_file_bytes = 0;
+static uint64_t s_file_opened = 0;
+
+/** @brief Open file, owned by the writer thread */
+static int s_fd = -1;
+
+/** @brief Writer thread state */
+static pthread_t       s_thread;
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  s_cond_work;   /**< Writer: buffer queued or sync requested */
+static pthread_cond_t  s_cond_free;   /**< write(): buffer returned to pool */
+static pthread_cond_t  s_cond_done;   /**< flush(): buffer written or synced */
+static int             s_running = 0;
+
+/** @brief Counters */
+static debug_file_stats_t s_stats;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static uint64_t file_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U);
+}
+
+/**
+ * @brief Write a whole buffer, retrying on partial writes and EINTR.
+ *
+ * @return Number of write(2) calls, or -1 on error.
+ */
+static int file_write_all(int fd, const uint8_t *data, size_t len)
+{
+    int calls = 0;
+
+    while (len > 0U)
+    {
+        ssize_t n = write(fd, data, len);
+        calls++;
+
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return -1;
+        }
+
+        data += n;
+        len  -= (size_t)n;
+    }
+
+    return calls;
+}
+
+/**
+ * @brief Shift DEBUG_FILE_PATH.N names up and start a new file.
+ *
+ * @retval 0   New file open.
+ * @retval -1  Rename or open failed.
+ */
+static int file_rotate(void)
+{
+    char from[FILE_NAME_MAX];
+    char to[FILE_NAME_MAX];
+
+    if (s_fd >= 0)
+    {
+        close(s_fd);
+        s_fd = -1;
+    }
+
+    for (int k = DEBUG_FILE_ROTATE_KEEP - 1; k >= 1; k--)
+    {
+        snprintf(from, sizeof(from), "%s.%d", DEBUG_FILE_PATH, k);
+        snprintf(to, sizeof(to), "%s.%d", DEBUG_FILE_PATH, k + 1);
+        (void)rename(from, to);     /* Missing generations are fine */
+    }
+
+#if DEBUG_FILE_ROTATE_KEEP > 0
+    snprintf(to, sizeof(to), "%s.1", DEBUG_FILE_PATH);
+    (void)rename(DEBUG_FILE_PATH, to);
+#endif
+
+    s_fd = open(DEBUG_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    return (s_fd >= 0) ? 0 : -1;
+}
+
+/**
+ * @brief Take a free buffer as the current one, waiting if necessary.
+ *
+ * @return 0 on success, -1 if the transport was stopped.
+ */
+static int file_acquire_locked(void)
+{
+    if (0U == s_free_n)
+    {
+        s_stats.stalls++;
+    }
+
+    while ((0U == s_free_n) && (0 != s_running))
+    {
+        pthread_cond_wait(&s_cond_free, &s_mutex);
+    }
+
+    if (0 == s_running)
+    {
+        return -1;
+    }
+
+    s_cur = (int)s_free[--s_free_n];
+    s_bufs[s_cur].len    = 0;
+    s_bufs[s_cur].rotate = 0;
+    s_cur_since = file_now_ms();
+
+    return 0;
+}
+
+/**
+ * @brief Queue the current buffer for the writer thread.
+ *
+ * @param[in] rotate Rotate the file once this buffer is written; an empty
+ *                   buffer is queued if needed to carry the request.
+ */
+static void file_seal_locked(int rotate)
+{
+    if ((s_cur < 0) || ((0U == s_bufs[s_cur].len) && (0 == rotate)))
+    {
+        if ((0 == rotate) || (0 != file_acquire_locked()))
+        {
+            return;
+        }
+    }
+
+    file_buf_t *buf = &s_bufs[s_cur];
+    buf->rotate = (uint8_t)((0 != rotate) ? 1 : 0);
+    buf->ticket = ++s_sealed;
+
+    s_full[(s_full_head + s_full_n) % DEBUG_FILE_BUFFER_COUNT] = (size_t)s_cur;
+    s_full_n++;
+    s_cur = -1;
+
+    pthread_cond_signal(&s_cond_work);
+}
+
+/**
+ * @brief Background writer: drains queued buffers, rotates and syncs.
+ */
+static void *file_writer(void *arg)
+{
+    (void)arg;
+
+    uint64_t last_sync = file_now_ms();
+    uint64_t dirty     = 0;     /* Tickets written since the last sync */
+
+    pthread_mutex_lock(&s_mutex);
+
+    for (;;)
+    {
+        if (0U == s_full_n)
+        {
+            uint64_t now = file_now_ms();
+
+            /* Explicit flush(), or the sync interval ran out while idle */
+            if (((s_sync_req > s_synced) && (s_done >= s_sync_req)) ||
+                ((DEBUG_FILE_SYNC_INTERVAL == DEBUG_FILE_DURABILITY) &&
+                 (0U != dirty) && ((now - last_sync) >= DEBUG_FILE_SYNC_MS)))
+            {
+                uint64_t done = s_done;
+                pthread_mutex_unlock(&s_mutex);
+                int rc = fdatasync(s_fd);
+                pthread_mutex_lock(&s_mutex);
+
+                s_stats.syncs++;
+                s_stats.errors += (0 != rc) ? 1U : 0U;
+                s_synced  = done;
+                last_sync = now;
+                dirty     = 0;
+                pthread_cond_broadcast(&s_cond_done);
+                continue;
+            }
+
+            if (0 == s_running)
+            {
+                break;
+            }
+
+            /* Do not let a quiet period hold data back for long */
+            if ((s_cur >= 0) && (0U != s_bufs[s_cur].len) &&
+                ((now - s_cur_since) >= DEBUG_FILE_FLUSH_MS))
+            {
+                file_seal_locked(0);
+                continue;
+            }
+
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ts.tv_nsec += (long)DEBUG_FILE_FLUSH_MS * 1000000L;
+            ts.tv_sec  += ts.tv_nsec / 1000000000L;
+            ts.tv_nsec %= 1000000000L;
+            (void)pthread_cond_timedwait(&s_cond_work, &s_mutex, &ts);
+            continue;
+        }
+
+        size_t      idx  = s_full[s_full_head];
+        file_buf_t *buf  = &s_bufs[idx];
+        uint64_t    want = s_sync_req;
+
+        s_full_head = (s_full_head + 1U) % DEBUG_FILE_BUFFER_COUNT;
+        s_full_n--;
+        pthread_mutex_unlock(&s_mutex);
+
+        /* Slow part, done without the pool lock */
+        int      calls  = (0U != buf->len) ? file_write_all(s_fd, buf->data, buf->len) : 0;
+        uint32_t errors = (calls < 0) ? 1U : 0U;
+        uint64_t syncs  = 0;
+        uint64_t now    = file_now_ms();
+        int      synced = 0;
+
+        if ((DEBUG_FILE_SYNC_BUFFER <= DEBUG_FILE_DURABILITY) ||
+            ((DEBUG_FILE_SYNC_INTERVAL == DEBUG_FILE_DURABILITY) &&
+             ((now - last_sync) >= DEBUG_FILE_SYNC_MS)) ||
+            ((0U != buf->rotate) && (DEBUG_FILE_SYNC_NONE != DEBUG_FILE_DURABILITY)) ||
+            ((0U != buf->rotate) && (want >= buf->ticket)))
+        {
+            errors += (0 != fdatasync(s_fd)) ? 1U : 0U;
+            syncs++;
+            synced    = 1;
+            last_sync = now;
+        }
+
+        if ((0U != buf->rotate) && (0 != file_rotate()))
+        {
+            errors++;
+        }
+
+        pthread_mutex_lock(&s_mutex);
+
+        s_stats.bytes  += (calls > 0) ? buf->len : 0U;
+        s_stats.writes += (calls > 0) ? (uint64_t)calls : 0U;
+        s_stats.syncs  += syncs;
+        s_stats.errors += errors;
+        s_stats.rotations += (0U != buf->rotate) ? 1U : 0U;
+
+        s_done = buf->ticket;
+        if (0 != synced)
+        {
+            s_synced = buf->ticket;
+            dirty    = 0;
+        }
+        else
+        {
+            dirty++;
+        }
+
+        s_free[s_free_n++] = idx;
+        pthread_cond_signal(&s_cond_free);
+        pthread_cond_broadcast(&s_cond_done);
+    }
+
+    pthread_mutex_unlock(&s_mutex);
+    return NULL;
+}
+
+/**
+ * @brief Initialize the file debug transport.
+ *
+ * @retval 0   Buffers allocated, file open, writer thread running.
+ * @retval -1  Allocation, open or thread creation failed.
+ *
+ * @note
+ * An existing DEBUG_FILE_PATH from a previous run is rotated away first
+ * when DEBUG_FILE_ROTATE_KEEP is non-zero. Calling init again while the
+ * transport is running has no effect.
+ */
+static int file_init(void)
+{
+    pthread_condattr_t attr;
+
+    if (0 != s_running)
+    {
+        return 0;
+    }
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_free_n = 0;
+    s_full_head = 0;
+    s_full_n = 0;
+    s_cur = -1;
+    s_sealed = 0;
+    s_done = 0;
+    s_sync_req = 0;
+    s_synced = 0;
+
+    for (size_t i = 0; i < DEBUG_FILE_BUFFER_COUNT; i++)
+    {
+        if ((NULL == s_bufs[i].data) &&
+            (0 != posix_memalign((void **)&s_bufs[i].data, FILE_BUFFER_ALIGN,
+                                 DEBUG_FILE_BUFFER_SIZE)))
+        {
+            s_bufs[i].data = NULL;
+            return -1;
+        }
+        s_free[s_free_n++] = i;
+    }
+
+    if (0 != file_rotate())
+    {
+        return -1;
+    }
+    s_file_bytes  = 0;
+    s_file_opened = file_now_ms();
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&s_cond_work, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&s_cond_free, NULL);
+    pthread_cond_init(&s_cond_done, NULL);
+
+    s_running = 1;
+
+    if (0 != pthread_create(&s_thread, NULL, file_writer, NULL))
+    {
+        s_running = 0;
+        close(s_fd);
+        s_fd = -1;
+        return -1;
+    }
+
+    return 0;
+}/* End of file_init() */
+
+/**
+ * @brief Deinitialize the file debug transport.
+ *
+ * @retval 0  All buffered data written, file closed.
+ */
+static int file_deinit(void)
+{
+    pthread_mutex_lock(&s_mutex);
+    if (0 == s_running)
+    {
+        pthread_mutex_unlock(&s_mutex);
+        return 0;
+    }
+    file_seal_locked(0);
+    s_running = 0;
+    pthread_cond_broadcast(&s_cond_work);
+    pthread_cond_broadcast(&s_cond_free);
+    pthread_mutex_unlock(&s_mutex);
+
+    pthread_join(s_thread, NULL);
+
+#if DEBUG_FILE_DURABILITY != DEBUG_FILE_SYNC_NONE
+    (void)fdatasync(s_fd);
+#endif
+    close(s_fd);
+    s_fd = -1;
+
+    for (size_t i = 0; i < DEBUG_FILE_BUFFER_COUNT; i++)
+    {
+        free(s_bufs[i].data);
+        s_bufs[i].data = NULL;
+    }
+
+    return 0;
+}/* End of file_deinit() */
+
+/**
+ * @brief Queue debug data for the writer thread.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to store.
+ *
+ * @retval >=0  Number of bytes accepted (always @p len).
+ * @retval -1   Invalid parameters or transport stopped.
+ */
+static int file_write(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&s_mutex);
+
+    if (0 == s_running)
+    {
+        pthread_mutex_unlock(&s_mutex);
+        return -1;
+    }
+
+    /* Rotate between records, never inside one */
+    if (0U != s_file_bytes)
+    {
+        uint64_t now    = file_now_ms();
+        int      rotate = 0;
+
+#if DEBUG_FILE_ROTATE_BYTES > 0
+        rotate |= ((s_file_bytes + len) > DEBUG_FILE_ROTATE_BYTES) ? 1 : 0;
+#endif
+#if DEBUG_FILE_ROTATE_SECONDS > 0
+        rotate |= ((now - s_file_opened) >=
+                   (DEBUG_FILE_ROTATE_SECONDS * 1000ULL)) ? 1 : 0;
+#endif
+
+        if (0 != rotate)
+        {
+            file_seal_locked(1);
+            s_file_bytes  = 0;
+            s_file_opened = now;
+        }
+    }
+
+    size_t off = 0;
+
+    while (off < len)
+    {
+        if ((s_cur < 0) && (0 != file_acquire_locked()))
+        {
+            pthread_mutex_unlock(&s_mutex);
+            return -1;
+        }
+
+        file_buf_t *buf   = &s_bufs[s_cur];
+        size_t      chunk = DEBUG_FILE_BUFFER_SIZE - buf->len;
+
+        if (chunk > (len - off))
+        {
+            chunk = len - off;
+        }
+
+        memcpy(&buf->data[buf->len], &data[off], chunk);
+        buf->len += chunk;
+        off      += chunk;
+
+        if (DEBUG_FILE_BUFFER_SIZE == buf->len)
+        {
+            file_seal_locked(0);
+        }
+    }
+
+    s_file_bytes += len;
+
+#if DEBUG_FILE_DURABILITY == DEBUG_FILE_SYNC_RECORD
+    file_seal_locked(0);
+    uint64_t target = s_sealed;
+    s_sync_req = target;
+    pthread_cond_signal(&s_cond_work);
+    while ((s_synced < target) && (0 != s_running))
+    {
+        pthread_cond_wait(&s_cond_done, &s_mutex);
+    }
+#endif
+
+    pthread_mutex_unlock(&s_mutex);
+
+    return (int)len;
+}/* End of file_write() */
+
+/**
+ * @brief Write directly to the file, bypassing the pool.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to write.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   Write failed.
+ *
+ * @note Only used in panic mode, after flush() has drained the pool.
+ */
+static int file_write_direct(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (s_fd < 0) || (file_write_all(s_fd, data, len) < 0))
+    {
+        return -1;
+    }
+
+    return (int)len;
+}/* End of file_write_direct() */
+
+/**
+ * @brief Write all buffered data and wait until it is synced.
+ *
+ * @retval 0  Success (also when nothing was buffered).
+ */
+static int file_flush(void)
+{
+    pthread_mutex_lock(&s_mutex);
+
+    if (0 != s_running)
+    {
+        file_seal_locked(0);
+
+        uint64_t target = s_sealed;
+        if (s_sync_req < target)
+        {
+            s_sync_req = target;
+        }
+        pthread_cond_signal(&s_cond_work);
+
+        while ((s_synced < target) && (0 != s_running))
+        {
+            pthread_cond_wait(&s_cond_done, &s_mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&s_mutex);
+
+    return 0;
+}/* End of file_flush() */
+
+/**
+ * @brief Report how much of the buffer pool is waiting for the writer.
+ *
+ * @return Bytes not yet written to the file (queued, being written or
+ *         in the current buffer) in percent of the pool.
+ */
+static int file_fill(void)
+{
+    size_t used;
+
+    pthread_mutex_lock(&s_mutex);
+    used = (DEBUG_FILE_BUFFER_COUNT - s_free_n) * (size_t)DEBUG_FILE_BUFFER_SIZE;
+    if (s_cur >= 0)
+    {
+        used -= DEBUG_FILE_BUFFER_SIZE - s_bufs[s_cur].len;
+    }
+    pthread_mutex_unlock(&s_mutex);
+
+    return (int)((used * 100U) / (DEBUG_FILE_BUFFER_COUNT * (size_t)DEBUG_FILE_BUFFER_SIZE));
+}/* End of file_fill() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get file debug transport operations.
+ *
+ * @return Pointer to the file transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_file_ops(void)
+{
+    return &DEBUG_TRANSPORT_FILE;
+}/* End of debug_transport_file_ops() */
+
+/**
+ * @brief Get the file transport counters.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void debug_transport_file_stats(debug_file_stats_t *stats)
+{
+    if (NULL == stats)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_mutex);
+    *stats = s_stats;
+    pthread_mutex_unlock(&s_mutex);
+}/* End of debug_transport_file_stats() */
+
+#endif /* DEBUG_USE_FILE */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
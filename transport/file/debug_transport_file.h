@@ -0,0 +1,91 @@
+/**
+ * @file      debug_transport_file.h
+ * @brief     Buffered file debug transport interface (host)
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a debug transport for host simulation runs that
+ * produce large amounts of log output. Records are copied into large
+ * page-aligned buffers; a background thread writes full buffers to
+ * DEBUG_FILE_PATH, rotates the file by size or age and batches
+ * fdatasync() according to DEBUG_FILE_DURABILITY:
+ *
+ *  - DEBUG_FILE_SYNC_NONE     : never sync; data reaches the page cache
+ *  - DEBUG_FILE_SYNC_INTERVAL : sync at most every DEBUG_FILE_SYNC_MS
+ *  - DEBUG_FILE_SYNC_BUFFER   : sync after every buffer written
+ *  - DEBUG_FILE_SYNC_RECORD   : every write returns only once it is synced
+ *
+ * When all buffers are in flight the writer blocks until one is free, so
+ * no output is lost.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_FILE_H
+#define DEBUG_TRANSPORT_FILE_H
+
+#include "config.h"
+
+#if DEBUG_USE_FILE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief File transport counters since init.
+ */
+typedef struct
+{
+    uint64_t bytes;       /**< Bytes written to files */
+    uint64_t writes;      /**< write(2) calls */
+    uint64_t syncs;       /**< fdatasync(2) calls */
+    uint32_t rotations;   /**< Files rotated */
+    uint32_t stalls;      /**< Writes that waited for a free buffer */
+    uint32_t errors;      /**< Failed write/sync/rotate operations */
+} debug_file_stats_t;
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get file debug transport operations.
+ *
+ * @return Pointer to the file transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_file_ops(void);
+
+/**
+ * @brief Get the file transport counters.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void debug_transport_file_stats(debug_file_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_FILE */
+#endif /* DEBUG_TRANSPORT_FILE_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,252 @@
+/**
+ * @file      debug_flash_file.c
+ * @brief     File-backed NOR flash stand-in for host builds.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_flash_file.h.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#if defined(__unix__)
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "debug_flash_file.h"
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int      file_read(void *ctx, uint32_t addr, void *buf, size_t len);
+static int      file_program(void *ctx, uint32_t addr, const void *buf,
+                             size_t len);
+static int      file_erase(void *ctx, uint32_t addr);
+static int      file_fill(int fd, uint32_t addr, size_t len);
+static int      file_cut_now(debug_flash_file_t *flash);
+static uint32_t file_rand(debug_flash_file_t *flash);
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Count down to a scheduled power cut.
+ *
+ * @return 1 if this operation is the one to tear
+ */
+static int file_cut_now(debug_flash_file_t *flash)
+{
+    if (0U == flash->cut_after)
+    {
+        return 0;
+    }
+
+    return (0U == --flash->cut_after) ? 1 : 0;
+}
+
+static uint32_t file_rand(debug_flash_file_t *flash)
+{
+    uint32_t x = flash->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    flash->rng = x;
+
+    return x;
+}
+
+/**
+ * @brief Set a file range to 0xFF.
+ */
+static int file_fill(int fd, uint32_t addr, size_t len)
+{
+    uint8_t ff[256];
+    memset(ff, 0xFF, sizeof(ff));
+
+    while (len > 0U)
+    {
+        size_t chunk = (len < sizeof(ff)) ? len : sizeof(ff);
+
+        if (pwrite(fd, ff, chunk, (off_t)addr) != (ssize_t)chunk)
+        {
+            return -1;
+        }
+        addr += (uint32_t)chunk;
+        len  -= chunk;
+    }
+
+    return 0;
+}
+
+static int file_read(void *ctx, uint32_t addr, void *buf, size_t len)
+{
+    debug_flash_file_t *flash = ctx;
+
+    if (0 != flash->dead)
+    {
+        return -1;
+    }
+
+    return (pread(flash->fd, buf, len, (off_t)addr) == (ssize_t)len) ? 0 : -1;
+}
+
+static int file_program(void *ctx, uint32_t addr, const void *buf, size_t len)
+{
+    debug_flash_file_t *flash = ctx;
+    uint8_t cell[256];
+    const uint8_t *src = buf;
+
+    if ((0 != flash->dead) ||
+        ((addr % flash->dev.page_size) + len > flash->dev.page_size))
+    {
+        return -1;
+    }
+
+    /* A torn program stores only a prefix of the data */
+    size_t todo = len;
+    if (0 != file_cut_now(flash))
+    {
+        todo = file_rand(flash) % len;
+        flash->dead = 1;
+    }
+
+    flash->programs++;
+
+    for (size_t off = 0; off < todo; off += sizeof(cell))
+    {
+        size_t chunk = ((todo - off) < sizeof(cell)) ? (todo - off) : sizeof(cell);
+
+        if (pread(flash->fd, cell, chunk, (off_t)(addr + off)) != (ssize_t)chunk)
+        {
+            return -1;
+        }
+        for (size_t i = 0; i < chunk; i++)
+        {
+            cell[i] &= src[off + i];    /* Bits can only be cleared */
+        }
+        if (pwrite(flash->fd, cell, chunk, (off_t)(addr + off)) != (ssize_t)chunk)
+        {
+            return -1;
+        }
+    }
+
+    flash->programmed += todo;
+
+    return (0 != flash->dead) ? -1 : 0;
+}
+
+static int file_erase(void *ctx, uint32_t addr)
+{
+    debug_flash_file_t *flash = ctx;
+    size_t len = flash->dev.sector_size;
+
+    if ((0 != flash->dead) || (0U != (addr % flash->dev.sector_size)))
+    {
+        return -1;
+    }
+
+    /* A torn erase leaves the tail of the sector untouched */
+    if (0 != file_cut_now(flash))
+    {
+        len = file_rand(flash) % len;
+        flash->dead = 1;
+    }
+
+    flash->erases++;
+
+    if (0 != file_fill(flash->fd, addr, len))
+    {
+        return -1;
+    }
+
+    return (0 != flash->dead) ? -1 : 0;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_flash_file_open(debug_flash_file_t *flash, const char *path,
+                          uint32_t sector_size, uint32_t sector_count,
+                          uint32_t page_size)
+{
+    if ((NULL == flash) || (NULL == path) || (0U == page_size) ||
+        (0U == sector_size) || (0U == sector_count))
+    {
+        return -1;
+    }
+
+    memset(flash, 0, sizeof(*flash));
+    flash->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (flash->fd < 0)
+    {
+        return -8;
+    }
+
+    struct stat st;
+    off_t size = (off_t)sector_size * sector_count;
+
+    if ((0 != fstat(flash->fd, &st)) ||
+        ((st.st_size != size) &&
+         ((0 != ftruncate(flash->fd, 0)) ||
+          (0 != file_fill(flash->fd, 0, (size_t)size)))))
+    {
+        close(flash->fd);
+        flash->fd = -1;
+        return -8;
+    }
+
+    flash->rng              = 0x2545F491UL;
+    flash->dev.sector_size  = sector_size;
+    flash->dev.sector_count = sector_count;
+    flash->dev.page_size    = page_size;
+    flash->dev.ctx          = flash;
+    flash->dev.read         = file_read;
+    flash->dev.program      = file_program;
+    flash->dev.erase        = file_erase;
+
+    return 0;
+}
+
+void debug_flash_file_close(debug_flash_file_t *flash)
+{
+    if ((NULL != flash) && (flash->fd >= 0))
+    {
+        close(flash->fd);
+        flash->fd = -1;
+    }
+}
+
+void debug_flash_file_power_cut(debug_flash_file_t *flash, uint32_t ops,
+                                uint32_t seed)
+{
+    if (NULL == flash)
+    {
+        return;
+    }
+
+    flash->cut_after = ops;
+    flash->rng       = (0U != seed) ? seed : 0x2545F491UL;
+}
+
+#endif /* __unix__ */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
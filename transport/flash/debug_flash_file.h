@@ -0,0 +1,114 @@
+/**
+ * @file      debug_flash_file.h
+ * @brief     File-backed NOR flash stand-in for host builds.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Implements @ref debug_flash_dev_t on top of a regular file so the flash
+ * log can be benchmarked and power-fail tested on Linux. NOR semantics
+ * are emulated: the file starts out as 0xFF, erase sets a sector to 0xFF
+ * and program can only clear bits.
+ *
+ * A power cut can be scheduled with debug_flash_file_power_cut(): the
+ * selected program or erase is torn part-way through and every later
+ * operation fails, as if the device had lost power. Reopen the file to
+ * "power up" again.
+ *
+ * Only available on hosts that provide POSIX file I/O.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_FLASH_FILE_H
+#define DEBUG_FLASH_FILE_H
+
+#if defined(__unix__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "debug_flash_log.h"
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief File-backed flash device.
+ */
+typedef struct
+{
+    debug_flash_dev_t dev;        /**< Device handed to the flash log */
+    int               fd;         /**< Backing file */
+    uint32_t          cut_after;  /**< Operations left before the cut (0 = off) */
+    uint32_t          rng;        /**< Tear position generator state */
+    int               dead;       /**< Power is "off" */
+    uint64_t          programs;   /**< Program operations */
+    uint64_t          erases;     /**< Erase operations */
+    uint64_t          programmed; /**< Bytes programmed */
+} debug_flash_file_t;
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Open (or create) a flash image file.
+ *
+ * @param[out] flash        Device instance
+ * @param[in]  path         Image file
+ * @param[in]  sector_size  Sector size in bytes
+ * @param[in]  sector_count Number of sectors
+ * @param[in]  page_size    Page size in bytes
+ *
+ * @retval 0   Success
+ * @retval -1  Invalid parameters
+ * @retval -8  File could not be opened or sized
+ *
+ * @note A new or wrongly sized file is (re)initialized to 0xFF.
+ */
+int debug_flash_file_open(debug_flash_file_t *flash, const char *path,
+                          uint32_t sector_size, uint32_t sector_count,
+                          uint32_t page_size);
+
+/**
+ * @brief Close the image file.
+ *
+ * @param[in,out] flash Device instance
+ */
+void debug_flash_file_close(debug_flash_file_t *flash);
+
+/**
+ * @brief Schedule a power cut.
+ *
+ * @param[in,out] flash Device instance
+ * @param[in]     ops   The ops-th program or erase from now is torn; 0
+ *                      cancels a pending cut
+ * @param[in]     seed  Seed for the tear position
+ */
+void debug_flash_file_power_cut(debug_flash_file_t *flash, uint32_t ops,
+                                uint32_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __unix__ */
+#endif /* DEBUG_FLASH_FILE_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
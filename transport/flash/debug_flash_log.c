@@ -0,0 +1,686 @@
+/**
+ * @file      debug_flash_log.c
+ * @brief     Log-structured storage of debug output in NOR flash sectors.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * See debug_flash_log.h for the on-flash layout and the recovery rules.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "debug_flash_log.h"
+#include "debug_record.h"   /**< Required for debug_record_crc8() */
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+/** @brief Chunk size for scanning and verifying flash */
+#define FLASH_SCAN_CHUNK   64U
+
+/** @brief Marker for an erase count that could not be read back */
+#define FLASH_EC_UNKNOWN   0xFFFFFFFFUL
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/**
+ * @brief Sector header, programmed at offset 0 of an opened sector.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;         /**< DEBUG_FLASH_LOG_MAGIC */
+    uint32_t seq;           /**< Sector sequence number */
+    uint32_t erase_count;   /**< Erase cycles including the last one */
+    uint16_t page_size;     /**< Page size the sector was written with */
+    uint8_t  version;       /**< DEBUG_FLASH_LOG_VERSION */
+    uint8_t  crc;           /**< CRC-8 over the preceding fields */
+} flash_sector_hdr_t;
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static uint32_t flash_pages(const debug_flash_log_t *log);
+static uint32_t flash_addr(const debug_flash_log_t *log, uint32_t sector,
+                           uint32_t page);
+static int      flash_newer(uint32_t a, uint32_t b);
+static int      flash_blank(const debug_flash_log_t *log, uint32_t addr,
+                            size_t len);
+static int      flash_page_check(const debug_flash_log_t *log, uint32_t addr,
+                                 uint16_t *len);
+static int      flash_read_header(const debug_flash_log_t *log,
+                                  uint32_t sector, flash_sector_hdr_t *hdr);
+static int      flash_open_sector(debug_flash_log_t *log);
+static int      flash_program_page(debug_flash_log_t *log);
+static int      flash_erase_sector(debug_flash_log_t *log, uint32_t sector);
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+static uint32_t flash_pages(const debug_flash_log_t *log)
+{
+    return log->dev->sector_size / log->dev->page_size;
+}
+
+static uint32_t flash_addr(const debug_flash_log_t *log, uint32_t sector,
+                           uint32_t page)
+{
+    return (sector * log->dev->sector_size) + (page * log->dev->page_size);
+}
+
+/**
+ * @brief Wrap-safe sequence comparison.
+ *
+ * @return 1 if @p a was assigned after @p b
+ */
+static int flash_newer(uint32_t a, uint32_t b)
+{
+    return ((int32_t)(a - b) > 0) ? 1 : 0;
+}
+
+/**
+ * @brief Check whether a flash range is erased.
+ *
+ * @return 1 if blank, 0 if not, -8 on read failure
+ */
+static int flash_blank(const debug_flash_log_t *log, uint32_t addr, size_t len)
+{
+    uint8_t buf[FLASH_SCAN_CHUNK];
+
+    while (len > 0U)
+    {
+        size_t chunk = (len < sizeof(buf)) ? len : sizeof(buf);
+
+        if (0 != log->dev->read(log->dev->ctx, addr, buf, chunk))
+        {
+            return -8;
+        }
+
+        for (size_t i = 0; i < chunk; i++)
+        {
+            if (0xFFU != buf[i])
+            {
+                return 0;
+            }
+        }
+
+        addr += (uint32_t)chunk;
+        len  -= chunk;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Classify a data page.
+ *
+ * @param[out] len Payload length of a valid page
+ *
+ * @return 1 valid, 0 blank, -1 torn, -8 read failure
+ */
+static int flash_page_check(const debug_flash_log_t *log, uint32_t addr,
+                            uint16_t *len)
+{
+    uint8_t hdr[DEBUG_FLASH_PAGE_HEADER_SIZE];
+
+    if (0 != log->dev->read(log->dev->ctx, addr, hdr, sizeof(hdr)))
+    {
+        return -8;
+    }
+
+    uint16_t plen = (uint16_t)(hdr[0] | ((uint16_t)hdr[1] << 8));
+
+    if ((0xFFFFU == plen) && (0xFFU == hdr[2]) && (0xFFU == hdr[3]))
+    {
+        int blank = flash_blank(log, addr + DEBUG_FLASH_PAGE_HEADER_SIZE,
+                                log->dev->page_size - DEBUG_FLASH_PAGE_HEADER_SIZE);
+        return (blank < 0) ? blank : ((1 == blank) ? 0 : -1);
+    }
+
+    if ((DEBUG_FLASH_PAGE_TAG != hdr[3]) ||
+        (plen > (log->dev->page_size - DEBUG_FLASH_PAGE_HEADER_SIZE)))
+    {
+        return -1;
+    }
+
+    uint8_t  buf[FLASH_SCAN_CHUNK];
+    uint8_t  crc = debug_record_crc8(0, hdr, 2U);
+    uint32_t pos = addr + DEBUG_FLASH_PAGE_HEADER_SIZE;
+    size_t   remaining = plen;
+
+    while (remaining > 0U)
+    {
+        size_t chunk = (remaining < sizeof(buf)) ? remaining : sizeof(buf);
+
+        if (0 != log->dev->read(log->dev->ctx, pos, buf, chunk))
+        {
+            return -8;
+        }
+        crc = debug_record_crc8(crc, buf, chunk);
+        pos += (uint32_t)chunk;
+        remaining -= chunk;
+    }
+
+    if (crc != hdr[2])
+    {
+        return -1;
+    }
+
+    *len = plen;
+    return 1;
+}
+
+/**
+ * @brief Read and validate a sector header.
+ *
+ * @return 1 if valid, 0 otherwise, -8 on read failure
+ */
+static int flash_read_header(const debug_flash_log_t *log, uint32_t sector,
+                             flash_sector_hdr_t *hdr)
+{
+    if (0 != log->dev->read(log->dev->ctx, flash_addr(log, sector, 0),
+                            hdr, sizeof(*hdr)))
+    {
+        return -8;
+    }
+
+    if ((DEBUG_FLASH_LOG_MAGIC != hdr->magic) ||
+        (DEBUG_FLASH_LOG_VERSION != hdr->version) ||
+        (log->dev->page_size != hdr->page_size) ||
+        (debug_record_crc8(0, (const uint8_t *)hdr,
+                           sizeof(*hdr) - 1U) != hdr->crc))
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Open the least worn erased sector as the new head.
+ *
+ * @retval 0   Head opened
+ * @retval -8  No erased sector available
+ */
+static int flash_open_sector(debug_flash_log_t *log)
+{
+    for (;;)
+    {
+        uint32_t best = DEBUG_FLASH_NO_SECTOR;
+
+        for (uint32_t i = 0; i < log->dev->sector_count; i++)
+        {
+            if ((DEBUG_FLASH_SECTOR_ERASED == log->sectors[i].state) &&
+                ((DEBUG_FLASH_NO_SECTOR == best) ||
+                 (log->sectors[i].erase_count < log->sectors[best].erase_count)))
+            {
+                best = i;
+            }
+        }
+
+        if (DEBUG_FLASH_NO_SECTOR == best)
+        {
+            return -8;
+        }
+
+        flash_sector_hdr_t hdr;
+        hdr.magic       = DEBUG_FLASH_LOG_MAGIC;
+        hdr.seq         = log->seq + 1U;
+        hdr.erase_count = log->sectors[best].erase_count;
+        hdr.page_size   = (uint16_t)log->dev->page_size;
+        hdr.version     = DEBUG_FLASH_LOG_VERSION;
+        hdr.crc         = debug_record_crc8(0, (const uint8_t *)&hdr,
+                                            sizeof(hdr) - 1U);
+
+        if (0 != log->dev->program(log->dev->ctx, flash_addr(log, best, 0),
+                                   &hdr, sizeof(hdr)))
+        {
+            log->sectors[best].state = DEBUG_FLASH_SECTOR_BAD;
+            log->stats.bad_sectors++;
+            continue;
+        }
+
+        log->sectors[best].seq   = hdr.seq;
+        log->sectors[best].state = DEBUG_FLASH_SECTOR_USED;
+        log->seq       = hdr.seq;
+        log->head      = best;
+        log->next_page = 1U;
+
+        return 0;
+    }
+}
+
+/**
+ * @brief Program the page buffer into the next free page.
+ *
+ * @retval 0   Programmed
+ * @retval -8  No sector available (buffer kept) or program failed
+ *             (buffer dropped)
+ */
+static int flash_program_page(debug_flash_log_t *log)
+{
+    if ((DEBUG_FLASH_NO_SECTOR == log->head) ||
+        (log->next_page >= flash_pages(log)))
+    {
+        if (0 != flash_open_sector(log))
+        {
+            return -8;
+        }
+    }
+
+    uint8_t *page = log->page;
+    size_t   size = log->dev->page_size;
+
+    page[0] = (uint8_t)(log->fill & 0xFFU);
+    page[1] = (uint8_t)(log->fill >> 8);
+    page[2] = debug_record_crc8(debug_record_crc8(0, page, 2U),
+                                &page[DEBUG_FLASH_PAGE_HEADER_SIZE], log->fill);
+    page[3] = DEBUG_FLASH_PAGE_TAG;
+    memset(&page[DEBUG_FLASH_PAGE_HEADER_SIZE + log->fill], 0xFF,
+           size - DEBUG_FLASH_PAGE_HEADER_SIZE - log->fill);
+
+    uint32_t addr = flash_addr(log, log->head, log->next_page);
+    size_t   fill = log->fill;
+
+    /* A page is used once, whatever the outcome */
+    log->next_page++;
+    log->fill = 0;
+
+    if (0 != log->dev->program(log->dev->ctx, addr, page, size))
+    {
+        log->stats.torn_pages++;
+        log->stats.bytes_dropped += (uint32_t)fill;
+        return -8;
+    }
+
+    log->stats.pages_written++;
+    log->stats.bytes_written += (uint32_t)fill;
+
+    return 0;
+}
+
+/**
+ * @brief Erase and verify one sector.
+ *
+ * @retval 0   Sector erased
+ * @retval -8  Erase or verify failed; the sector was retired
+ */
+static int flash_erase_sector(debug_flash_log_t *log, uint32_t sector)
+{
+    debug_flash_sector_t *s = &log->sectors[sector];
+    uint32_t addr = flash_addr(log, sector, 0);
+
+    s->state = DEBUG_FLASH_SECTOR_ERASING;
+    s->erase_count++;
+
+    if ((0 != log->dev->erase(log->dev->ctx, addr)) ||
+        (1 != flash_blank(log, addr, log->dev->sector_size)))
+    {
+        s->state = DEBUG_FLASH_SECTOR_BAD;
+        log->stats.bad_sectors++;
+        return -8;
+    }
+
+    s->state = DEBUG_FLASH_SECTOR_ERASED;
+    log->stats.sectors_erased++;
+
+    return 0;
+}
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+int debug_flash_log_mount(debug_flash_log_t *log, const debug_flash_dev_t *dev,
+                          debug_flash_sector_t *sectors, uint8_t *page)
+{
+    if ((NULL == log) || (NULL == dev) || (NULL == sectors) || (NULL == page) ||
+        (NULL == dev->read) || (NULL == dev->program) || (NULL == dev->erase) ||
+        (dev->page_size < sizeof(flash_sector_hdr_t)) ||
+        (dev->page_size <= DEBUG_FLASH_PAGE_HEADER_SIZE) ||
+        (dev->page_size > 0xFFFFU) ||
+        (0U != (dev->sector_size % dev->page_size)) ||
+        ((dev->sector_size / dev->page_size) < 2U) ||
+        (dev->sector_count < 2U))
+    {
+        return -1;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->dev       = dev;
+    log->sectors   = sectors;
+    log->page      = page;
+    log->head      = DEBUG_FLASH_NO_SECTOR;
+    log->spares    = 1U;
+
+    uint32_t max_ec = 0;
+
+    for (uint32_t i = 0; i < dev->sector_count; i++)
+    {
+        flash_sector_hdr_t hdr;
+        int rc = flash_read_header(log, i, &hdr);
+
+        if (rc < 0)
+        {
+            return -8;
+        }
+
+        sectors[i].seq         = 0;
+        sectors[i].erase_count = FLASH_EC_UNKNOWN;
+
+        if (1 == rc)
+        {
+            sectors[i].state       = DEBUG_FLASH_SECTOR_USED;
+            sectors[i].seq         = hdr.seq;
+            sectors[i].erase_count = hdr.erase_count;
+            max_ec = (hdr.erase_count > max_ec) ? hdr.erase_count : max_ec;
+
+            if ((DEBUG_FLASH_NO_SECTOR == log->head) ||
+                (0 != flash_newer(hdr.seq, log->seq)))
+            {
+                log->head = i;
+                log->seq  = hdr.seq;
+            }
+            continue;
+        }
+
+        rc = flash_blank(log, flash_addr(log, i, 0), dev->sector_size);
+        if (rc < 0)
+        {
+            return -8;
+        }
+
+        /* Header torn or erase interrupted: content is not trustworthy */
+        sectors[i].state = (1 == rc) ? DEBUG_FLASH_SECTOR_ERASED :
+                                       DEBUG_FLASH_SECTOR_DIRTY;
+    }
+
+    /* Wear of sectors without a header is unknown: assume the worst seen */
+    for (uint32_t i = 0; i < dev->sector_count; i++)
+    {
+        if (FLASH_EC_UNKNOWN == sectors[i].erase_count)
+        {
+            sectors[i].erase_count = max_ec;
+        }
+    }
+
+    if (DEBUG_FLASH_NO_SECTOR != log->head)
+    {
+        uint32_t last = 0;
+
+        for (uint32_t p = 1; p < flash_pages(log); p++)
+        {
+            uint16_t len;
+            int rc = flash_page_check(log, flash_addr(log, log->head, p), &len);
+
+            if (rc < -1)
+            {
+                return -8;
+            }
+            if (0 != rc)
+            {
+                last = p;
+            }
+            if (-1 == rc)
+            {
+                log->stats.torn_pages++;
+            }
+        }
+
+        log->next_page = last + 1U;
+    }
+
+    /* Make sure the first page program will find room */
+    if ((DEBUG_FLASH_NO_SECTOR == log->head) ||
+        (log->next_page >= flash_pages(log)))
+    {
+        int opened = flash_open_sector(log);
+
+        for (uint32_t i = 0; (0 != opened) && (i < dev->sector_count); i++)
+        {
+            if (0 == debug_flash_log_service(log))
+            {
+                break;      /* Nothing left to reclaim */
+            }
+            opened = flash_open_sector(log);
+        }
+
+        if (0 != opened)
+        {
+            return -8;
+        }
+    }
+
+    return 0;
+}
+
+int debug_flash_log_format(debug_flash_log_t *log)
+{
+    if ((NULL == log) || (NULL == log->dev))
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < log->dev->sector_count; i++)
+    {
+        if (DEBUG_FLASH_SECTOR_BAD != log->sectors[i].state)
+        {
+            (void)flash_erase_sector(log, i);
+        }
+    }
+
+    log->head      = DEBUG_FLASH_NO_SECTOR;
+    log->next_page = 0;
+    log->fill      = 0;
+
+    return (0 == flash_open_sector(log)) ? 0 : -8;
+}
+
+size_t debug_flash_log_append(debug_flash_log_t *log, const uint8_t *data,
+                              size_t len)
+{
+    if ((NULL == log) || (NULL == log->dev) || (NULL == data))
+    {
+        return 0;
+    }
+
+    const size_t max = log->dev->page_size - DEBUG_FLASH_PAGE_HEADER_SIZE;
+    size_t done = 0;
+
+    while (done < len)
+    {
+        /* A full buffer here means the last program found no sector */
+        if ((log->fill == max) && (0 != flash_program_page(log)) &&
+            (log->fill == max))
+        {
+            break;
+        }
+
+        size_t chunk = max - log->fill;
+        if (chunk > (len - done))
+        {
+            chunk = len - done;
+        }
+
+        memcpy(&log->page[DEBUG_FLASH_PAGE_HEADER_SIZE + log->fill],
+               &data[done], chunk);
+        log->fill += chunk;
+        done      += chunk;
+
+        if (log->fill == max)
+        {
+            (void)flash_program_page(log);
+        }
+    }
+
+    log->stats.bytes_dropped += (uint32_t)(len - done);
+
+    return done;
+}
+
+int debug_flash_log_flush(debug_flash_log_t *log)
+{
+    if ((NULL == log) || (NULL == log->dev))
+    {
+        return -1;
+    }
+
+    if (0U == log->fill)
+    {
+        return 0;
+    }
+
+    return flash_program_page(log);
+}
+
+int debug_flash_log_service(debug_flash_log_t *log)
+{
+    if ((NULL == log) || (NULL == log->dev))
+    {
+        return -1;
+    }
+
+    uint32_t ready  = 0;
+    uint32_t victim = DEBUG_FLASH_NO_SECTOR;
+    uint32_t oldest = DEBUG_FLASH_NO_SECTOR;
+    const uint32_t head = log->head;
+
+    for (uint32_t i = 0; i < log->dev->sector_count; i++)
+    {
+        const debug_flash_sector_t *s = &log->sectors[i];
+
+        if (DEBUG_FLASH_SECTOR_ERASED == s->state)
+        {
+            ready++;
+        }
+        else if (DEBUG_FLASH_SECTOR_DIRTY == s->state)
+        {
+            if ((DEBUG_FLASH_NO_SECTOR == victim) ||
+                (s->erase_count < log->sectors[victim].erase_count))
+            {
+                victim = i;
+            }
+        }
+        else if ((DEBUG_FLASH_SECTOR_USED == s->state) && (i != head))
+        {
+            if ((DEBUG_FLASH_NO_SECTOR == oldest) ||
+                (0 != flash_newer(log->sectors[oldest].seq, s->seq)))
+            {
+                oldest = i;
+            }
+        }
+    }
+
+    if (ready >= log->spares)
+    {
+        return 0;
+    }
+
+    /* Sectors without data first, then the oldest data */
+    if (DEBUG_FLASH_NO_SECTOR == victim)
+    {
+        victim = oldest;
+    }
+    if (DEBUG_FLASH_NO_SECTOR == victim)
+    {
+        return 0;
+    }
+
+    return (0 == flash_erase_sector(log, victim)) ? 1 : -8;
+}
+
+long debug_flash_log_dump(const debug_flash_log_t *log,
+                          debug_flash_log_sink_t sink, void *user)
+{
+    if ((NULL == log) || (NULL == log->dev) || (NULL == sink))
+    {
+        return -1;
+    }
+
+    long     total    = 0;
+    uint32_t last_age = 0xFFFFFFFFUL;
+
+    for (uint32_t n = 0; n < log->dev->sector_count; n++)
+    {
+        /* Next sector in age order: the oldest one younger than the last */
+        uint32_t pick = DEBUG_FLASH_NO_SECTOR;
+        uint32_t age  = 0;
+
+        for (uint32_t i = 0; i < log->dev->sector_count; i++)
+        {
+            uint32_t a = log->seq - log->sectors[i].seq;
+
+            if ((DEBUG_FLASH_SECTOR_USED == log->sectors[i].state) &&
+                (a < last_age) &&
+                ((DEBUG_FLASH_NO_SECTOR == pick) || (a > age)))
+            {
+                pick = i;
+                age  = a;
+            }
+        }
+
+        if (DEBUG_FLASH_NO_SECTOR == pick)
+        {
+            break;
+        }
+        last_age = age;
+
+        for (uint32_t p = 1; p < flash_pages(log); p++)
+        {
+            uint32_t addr = flash_addr(log, pick, p);
+            uint16_t len  = 0;
+            int rc = flash_page_check(log, addr, &len);
+
+            if (rc < -1)
+            {
+                return -8;
+            }
+            if (1 != rc)
+            {
+                continue;
+            }
+
+            uint8_t buf[FLASH_SCAN_CHUNK];
+            size_t  off = 0;
+
+            while (off < len)
+            {
+                size_t chunk = ((len - off) < sizeof(buf)) ? (len - off) :
+                                                             sizeof(buf);
+
+                if (0 != log->dev->read(log->dev->ctx,
+                                        addr + DEBUG_FLASH_PAGE_HEADER_SIZE +
+                                        (uint32_t)off, buf, chunk))
+                {
+                    return -8;
+                }
+                if (0 != sink(user, buf, chunk))
+                {
+                    return total + (long)chunk;
+                }
+                off   += chunk;
+                total += (long)chunk;
+            }
+        }
+    }
+
+    return total;
+}
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
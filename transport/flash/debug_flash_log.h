@@ -0,0 +1,257 @@
+/**
+ * @file      debug_flash_log.h
+ * @brief     Log-structured storage of debug output in NOR flash sectors.
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Appends the debug byte stream to a ring of flash sectors so that logs
+ * survive power cycles. The flash itself is reached through a small
+ * block-device interface (@ref debug_flash_dev_t), so the same engine runs
+ * on internal flash, external SPI NOR or a file on a Linux host.
+ *
+ * Sector layout (page 0 holds the sector header, the remaining pages hold
+ * data):
+ *
+ * @code
+ *   page 0      : magic | seq | erase_count | page_size | version | crc8
+ *   page 1..N-1 : len (LE) | crc8 | tag | payload (len) | 0xFF padding
+ * @endcode
+ *
+ *  - Data is batched in RAM and programmed one full page at a time; a
+ *    page is never programmed twice.
+ *  - Sectors carry an increasing sequence number. On mount the sector
+ *    with the highest one is the head, and the first blank page after
+ *    its last written page is the append position.
+ *  - A page torn by a power cut fails its CRC and is skipped when the
+ *    log is read back, so a cut loses at most the page in flight.
+ *  - Erases never happen in the append path. debug_flash_log_service()
+ *    keeps spare sectors erased ahead of time, reclaiming the oldest
+ *    sector. When a sector is opened, the erased sector with the lowest
+ *    erase count is used (wear-aware rotation).
+ *
+ * This module does not depend on config.h so host tools can use it.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_FLASH_LOG_H
+#define DEBUG_FLASH_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/** @brief Sector header magic ("DLOG") */
+#define DEBUG_FLASH_LOG_MAGIC         0x474F4C44UL
+
+/** @brief On-flash format version */
+#define DEBUG_FLASH_LOG_VERSION       1U
+
+/** @brief Size of the per-page header (len, crc8, tag) */
+#define DEBUG_FLASH_PAGE_HEADER_SIZE  4U
+
+/** @brief Tag byte of a programmed data page */
+#define DEBUG_FLASH_PAGE_TAG          0x5AU
+
+/** @brief "No sector" index */
+#define DEBUG_FLASH_NO_SECTOR         0xFFFFFFFFUL
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Flash block device.
+ *
+ * Addresses are byte offsets from the start of the log area. Erased flash
+ * reads as 0xFF and programming can only clear bits.
+ */
+typedef struct
+{
+    uint32_t sector_size;   /**< Erase unit in bytes (multiple of page_size) */
+    uint32_t sector_count;  /**< Number of sectors in the log area */
+    uint32_t page_size;     /**< Program batch in bytes */
+    void    *ctx;           /**< Passed back to every operation */
+    int (*read)(void *ctx, uint32_t addr, void *buf,
+                size_t len);                 /**< Read, 0 on success */
+    int (*program)(void *ctx, uint32_t addr, const void *buf,
+                   size_t len);              /**< Program within one page, 0 on success */
+    int (*erase)(void *ctx, uint32_t addr);  /**< Erase the sector at addr, 0 on success */
+} debug_flash_dev_t;
+
+/**
+ * @brief Sector state kept in RAM.
+ */
+typedef enum
+{
+    DEBUG_FLASH_SECTOR_DIRTY = 0,   /**< Unknown content, must be erased */
+    DEBUG_FLASH_SECTOR_ERASED,      /**< Blank, ready to be opened */
+    DEBUG_FLASH_SECTOR_USED,        /**< Valid header, holds log data */
+    DEBUG_FLASH_SECTOR_ERASING,     /**< Being erased by service() */
+    DEBUG_FLASH_SECTOR_BAD,         /**< Erase or program failed, unused */
+} debug_flash_sector_state_t;
+
+/**
+ * @brief Per-sector bookkeeping.
+ */
+typedef struct
+{
+    uint32_t seq;           /**< Sequence number (USED sectors) */
+    uint32_t erase_count;   /**< Erase cycles (estimated if unknown) */
+    uint8_t  state;         /**< debug_flash_sector_state_t */
+} debug_flash_sector_t;
+
+/**
+ * @brief Counters since mount.
+ */
+typedef struct
+{
+    uint32_t bytes_written;   /**< Payload bytes programmed */
+    uint32_t bytes_dropped;   /**< Payload bytes lost (no erased sector) */
+    uint32_t pages_written;   /**< Pages programmed */
+    uint32_t sectors_erased;  /**< Sector erases */
+    uint32_t torn_pages;      /**< Pages that failed to program or verify */
+    uint32_t bad_sectors;     /**< Sectors retired */
+} debug_flash_log_stats_t;
+
+/**
+ * @brief Flash log instance.
+ */
+typedef struct
+{
+    const debug_flash_dev_t *dev;       /**< Block device */
+    debug_flash_sector_t    *sectors;   /**< dev->sector_count entries */
+    uint8_t                 *page;      /**< dev->page_size bytes */
+    uint32_t                 head;      /**< Sector being appended to */
+    uint32_t                 next_page; /**< Next page to program in head */
+    uint32_t                 seq;       /**< Sequence number of head */
+    size_t                   fill;      /**< Payload bytes buffered in page */
+    uint32_t                 spares;    /**< Erased sectors to keep ready */
+    debug_flash_log_stats_t  stats;     /**< Counters */
+} debug_flash_log_t;
+
+/**
+ * @brief Sink used to read the log back.
+ *
+ * @return 0 to continue, non-zero to stop
+ */
+typedef int (*debug_flash_log_sink_t)(void *user, const uint8_t *data,
+                                      size_t len);
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Scan the device and prepare the log for appending.
+ *
+ * @param[out] log     Instance to initialize
+ * @param[in]  dev     Block device
+ * @param[in]  sectors Array of dev->sector_count entries
+ * @param[in]  page    Page buffer of dev->page_size bytes
+ *
+ * @retval 0   Mounted; existing data is kept
+ * @retval -1  Invalid parameters or geometry
+ * @retval -8  Device failure or no usable sector
+ *
+ * @note
+ * If no sector can be opened, one is erased synchronously; mount is not
+ * on the hot path.
+ */
+int debug_flash_log_mount(debug_flash_log_t *log, const debug_flash_dev_t *dev,
+                          debug_flash_sector_t *sectors, uint8_t *page);
+
+/**
+ * @brief Erase the whole log area and mount it empty.
+ *
+ * @param[in,out] log Mounted instance
+ *
+ * @retval 0   Success
+ * @retval -8  Device failure
+ */
+int debug_flash_log_format(debug_flash_log_t *log);
+
+/**
+ * @brief Append bytes to the log.
+ *
+ * @param[in,out] log  Mounted instance
+ * @param[in]     data Bytes to append
+ * @param[in]     len  Number of bytes
+ *
+ * @return Number of bytes accepted; the rest is counted as dropped
+ *
+ * @note
+ * Programs a page whenever the page buffer fills up. Never erases: if the
+ * head sector is full and no erased sector is available, data is dropped
+ * until debug_flash_log_service() has prepared one.
+ */
+size_t debug_flash_log_append(debug_flash_log_t *log, const uint8_t *data,
+                              size_t len);
+
+/**
+ * @brief Program the partially filled page buffer.
+ *
+ * @param[in,out] log Mounted instance
+ *
+ * @retval 0   Nothing pending or page programmed
+ * @retval -8  No sector available or program failed
+ *
+ * @note The rest of the page is left unused.
+ */
+int debug_flash_log_flush(debug_flash_log_t *log);
+
+/**
+ * @brief Erase one sector if fewer than log->spares are ready.
+ *
+ * @param[in,out] log Mounted instance
+ *
+ * @retval 1   A sector was erased
+ * @retval 0   Nothing to do
+ * @retval -8  Erase failed; the sector was retired
+ *
+ * @note
+ * Call from an idle context. The erase only touches a sector that
+ * append() will not use until it is marked erased, so on a single core
+ * this may preempt or be preempted by append().
+ */
+int debug_flash_log_service(debug_flash_log_t *log);
+
+/**
+ * @brief Read the log back, oldest data first.
+ *
+ * @param[in] log  Mounted instance
+ * @param[in] sink Called for every chunk of payload
+ * @param[in] user Passed to @p sink
+ *
+ * @return Number of bytes delivered, or -8 on device failure
+ *
+ * @note Data still in the page buffer is not included; flush first.
+ */
+long debug_flash_log_dump(const debug_flash_log_t *log,
+                          debug_flash_log_sink_t sink, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_FLASH_LOG_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
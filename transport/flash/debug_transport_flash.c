@@ -0,0 +1,290 @@
+/**
+ * @file      debug_transport_flash.c
+ * @brief     Persistent flash log debug transport implementation
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * Binds one debug_flash_log_t instance to the debug transport interface.
+ * Page programs happen inside write(); erases only in service(), so a
+ * full sector never stalls the caller for an erase cycle. While no
+ * erased sector is available, is_ready() reports the link down and
+ * output is dropped (and counted) rather than blocking.
+ *
+ * Synchronization of write() and flush() is provided by the debug core.
+ * service() runs outside the debug lock; see debug_flash_log_service().
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include "config.h"
+
+#if DEBUG_USE_FLASH
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "debug.h"
+#include "debug_transport_flash.h"
+#include "debug_transport.h"
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int flash_init(void);
+static int flash_deinit(void);
+static int flash_write(const uint8_t *data, size_t len);
+static int flash_is_ready(void);
+static int flash_flush(void);
+static int flash_service(void);
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Flash transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_FLASH =
+{
+    .init         = flash_init,
+    .deinit       = flash_deinit,
+    .write        = flash_write,
+    .is_ready     = flash_is_ready,
+    .write_polled = flash_write,    /* Page programs are polled already */
+    .flush        = flash_flush,
+    .service      = flash_service,
+};
+
+/** @brief Device selected by the application */
+static const debug_flash_dev_t *s_dev = NULL;
+
+/** @brief Flash log instance */
+static debug_flash_log_t s_log;
+
+/** @brief Per-sector state */
+static debug_flash_sector_t s_sectors[DEBUG_FLASH_MAX_SECTORS];
+
+/** @brief Page batch buffer */
+static uint8_t s_page[DEBUG_FLASH_PAGE_SIZE_MAX];
+
+/** @brief Mount state */
+static uint8_t s_mounted = 0;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the flash debug transport.
+ *
+ * @retval 0   Log mounted, previous content kept.
+ * @retval -1  No device or unsupported geometry.
+ * @retval -8  Device failure.
+ */
+static int flash_init(void)
+{
+    s_mounted = 0;
+
+    if ((NULL == s_dev) ||
+        (s_dev->sector_count > DEBUG_FLASH_MAX_SECTORS) ||
+        (s_dev->page_size > DEBUG_FLASH_PAGE_SIZE_MAX))
+    {
+        return -1;
+    }
+
+    int ret = debug_flash_log_mount(&s_log, s_dev, s_sectors, s_page);
+    if (0 != ret)
+    {
+        return ret;
+    }
+
+    s_log.spares = DEBUG_FLASH_SPARE_SECTORS;
+    s_mounted = 1;
+
+    return 0;
+}/* End of flash_init() */
+
+/**
+ * @brief Deinitialize the flash debug transport.
+ *
+ * @retval 0  Buffered data programmed (or nothing pending).
+ */
+static int flash_deinit(void)
+{
+    if (0U != s_mounted)
+    {
+        (void)debug_flash_log_flush(&s_log);
+        s_mounted = 0;
+    }
+
+    return 0;
+}/* End of flash_deinit() */
+
+/**
+ * @brief Append debug data to the flash log.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to store.
+ *
+ * @retval >=0  Number of bytes accepted.
+ * @retval -1   Invalid parameters, not mounted, or nothing accepted.
+ */
+static int flash_write(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len) || (0U == s_mounted))
+    {
+        return -1;
+    }
+
+    size_t done = debug_flash_log_append(&s_log, data, len);
+
+    return (0U != done) ? (int)done : -1;
+}/* End of flash_write() */
+
+/**
+ * @brief Report whether the flash log can accept a full page.
+ *
+ * @return 1 if the head sector has room or an erased sector is ready.
+ */
+static int flash_is_ready(void)
+{
+    if (0U == s_mounted)
+    {
+        return 0;
+    }
+
+    if ((DEBUG_FLASH_NO_SECTOR != s_log.head) &&
+        (s_log.next_page < (s_dev->sector_size / s_dev->page_size)))
+    {
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < s_dev->sector_count; i++)
+    {
+        if (DEBUG_FLASH_SECTOR_ERASED == s_sectors[i].state)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}/* End of flash_is_ready() */
+
+/**
+ * @brief Program the partially filled page.
+ *
+ * @retval 0    Success.
+ * @retval -8   No room or program failure.
+ */
+static int flash_flush(void)
+{
+    return (0U != s_mounted) ? debug_flash_log_flush(&s_log) : 0;
+}/* End of flash_flush() */
+
+/**
+ * @brief Erase sectors ahead of the writer.
+ *
+ * @retval 1   A sector was erased.
+ * @retval 0   Nothing to do.
+ * @retval -8  Erase failure.
+ */
+static int flash_service(void)
+{
+    return (0U != s_mounted) ? debug_flash_log_service(&s_log) : 0;
+}/* End of flash_service() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get flash log debug transport operations.
+ *
+ * @return Pointer to the flash transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_flash_ops(void)
+{
+    return &DEBUG_TRANSPORT_FLASH;
+}/* End of debug_transport_flash_ops() */
+
+/**
+ * @brief Select the flash device used by the transport.
+ *
+ * @param[in] dev Flash device.
+ */
+void debug_transport_flash_set_device(const debug_flash_dev_t *dev)
+{
+    s_dev = dev;
+}/* End of debug_transport_flash_set_device() */
+
+/**
+ * @brief Read the stored log back, oldest data first.
+ *
+ * @param[in] sink Called for every chunk of stored output.
+ * @param[in] user Passed to @p sink.
+ *
+ * @return Number of bytes delivered, or negative value on failure.
+ */
+long debug_transport_flash_dump(debug_flash_log_sink_t sink, void *user)
+{
+    if (0U == s_mounted)
+    {
+        return -1;
+    }
+
+    /* The page buffer is shared with flash_write(), which runs under the
+     * core's lock */
+    debug_lock_acquire();
+    (void)debug_flash_log_flush(&s_log);
+    long ret = debug_flash_log_dump(&s_log, sink, user);
+    debug_lock_release();
+
+    return ret;
+}/* End of debug_transport_flash_dump() */
+
+/**
+ * @brief Erase all stored log data.
+ *
+ * @retval 0   Success.
+ * @retval -8  Device failure.
+ */
+int debug_transport_flash_erase(void)
+{
+    if (0U == s_mounted)
+    {
+        return -1;
+    }
+
+    debug_lock_acquire();
+    int ret = debug_flash_log_format(&s_log);
+    debug_lock_release();
+
+    return ret;
+}/* End of debug_transport_flash_erase() */
+
+/**
+ * @brief Get the flash log counters since init.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void debug_transport_flash_stats(debug_flash_log_stats_t *stats)
+{
+    if (NULL != stats)
+    {
+        *stats = s_log.stats;
+    }
+}/* End of debug_transport_flash_stats() */
+
+#endif /* DEBUG_USE_FLASH */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
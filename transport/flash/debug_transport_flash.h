@@ -0,0 +1,111 @@
+/**
+ * @file      debug_transport_flash.h
+ * @brief     Persistent flash log debug transport interface
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a debug transport that appends log output to a
+ * log-structured ring of flash sectors (see debug_flash_log.h), so logs
+ * survive power cycles and can be read back from field returns.
+ *
+ * The flash device is supplied by the application through
+ * debug_transport_flash_set_device() before debug_init(): internal flash,
+ * external SPI NOR, or debug_flash_file.h on a Linux host.
+ *
+ * Writes only program pages. Sector erases are done by the transport's
+ * service operation, which the application drives by calling
+ * debug_service() from an idle context.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_FLASH_H
+#define DEBUG_TRANSPORT_FLASH_H
+
+#include "config.h"
+
+#if DEBUG_USE_FLASH
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+#include "debug_flash_log.h"   /**< Required for debug_flash_dev_t */
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get flash log debug transport operations.
+ *
+ * @return Pointer to the flash transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_flash_ops(void);
+
+/**
+ * @brief Select the flash device used by the transport.
+ *
+ * @param[in] dev Flash device; must stay valid while the transport is used.
+ *
+ * @note
+ * Must be called before the transport is initialized. Geometry is limited
+ * by DEBUG_FLASH_MAX_SECTORS and DEBUG_FLASH_PAGE_SIZE_MAX.
+ */
+void debug_transport_flash_set_device(const debug_flash_dev_t *dev);
+
+/**
+ * @brief Read the stored log back, oldest data first.
+ *
+ * @param[in] sink Called for every chunk of stored output.
+ * @param[in] user Passed to @p sink.
+ *
+ * @return Number of bytes delivered, or negative value on failure.
+ *
+ * @note
+ * Typically called at boot to forward the previous session's log to
+ * another transport. Data still buffered in RAM is flushed first.
+ * Runs under the debug core's lock: @p sink must not log or write
+ * records; write to the other transport's operations directly.
+ */
+long debug_transport_flash_dump(debug_flash_log_sink_t sink, void *user);
+
+/**
+ * @brief Erase all stored log data.
+ *
+ * @retval 0   Success.
+ * @retval -8  Device failure.
+ *
+ * @note
+ * Takes the debug core's lock, so it does not interleave with logging.
+ */
+int debug_transport_flash_erase(void);
+
+/**
+ * @brief Get the flash log counters since init.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void debug_transport_flash_stats(debug_flash_log_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_FLASH */
+#endif /* DEBUG_TRANSPORT_FLASH_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,684 @@
+/**
+ * @file      debug_transport_mux.c
+ * @brief     Channel multiplexer debug transport implementation
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This module implements a composite debug transport that queues the
+ * output of several channels in per-channel ring buffers and drains them
+ * to one link as DEBUG_RECORD_MUX frames.
+ *
+ * Scheduling is deficit round-robin: each time the scheduler reaches a
+ * channel with queued data, the channel is credited weight x
+ * DEBUG_MUX_FRAME_MAX bytes and sends frames while its credit lasts, so
+ * over time each busy channel gets a share of the link proportional to
+ * its weight, and an idle channel's share goes to the others.
+ *
+ * Frames are pushed whenever data is queued and from service(). A frame
+ * the link accepts only partly is finished before the next one starts,
+ * so frames are never interleaved on the wire. In panic mode the queues
+ * are drained with the link's polled write.
+ *
+ * All calls are serialized by the debug core through the port lock;
+ * debug_transport_mux_write() takes the same lock.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include "config.h"
+
+#if DEBUG_USE_TRANSPORT_MUX
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "debug.h"
+#include "debug_record.h"
+#include "debug_transport_mux.h"
+#include "debug_transport.h"
+
+#if DEBUG_USE_TRANSPORT_FAILOVER
+#include "debug_transport_failover.h"
+#elif DEBUG_USE_USB_CDC
+#include "debug_transport_usb_cdc_st.h"
+#elif DEBUG_USE_UART
+    #if DEBUG_VENDOR_STM32
+        #include "debug_transport_uart_st.h"
+    #elif DEBUG_VENDOR_NXP
+        #include "debug_transport_uart_nxp.h"
+    #elif DEBUG_VENDOR_TI
+        #include "debug_transport_uart_ti.h"
+    #endif
+#elif DEBUG_USE_RAM_BUFFER
+#include "debug_transport_ram.h"
+#elif DEBUG_USE_STDIO
+#include "debug_transport_stdio.h"
+#elif DEBUG_USE_FLASH
+#include "debug_transport_flash.h"
+#elif DEBUG_USE_FILE
+#include "debug_transport_file.h"
+#endif
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_MUX_CHANNELS < 1) || (DEBUG_MUX_CHANNELS > 128)
+#error "DEBUG_MUX_CHANNELS must be 1..128."
+#endif
+
+/** @brief Largest frame: record header, mux header, drop count, data, CRC */
+#define MUX_FRAME_SIZE  (DEBUG_RECORD_HEADER_SIZE + sizeof(debug_mux_record_t) + \
+                         sizeof(uint32_t) + DEBUG_MUX_FRAME_MAX +                 \
+                         DEBUG_RECORD_TRAILER_SIZE)
+
+/*******************************************************************************
+ * Private Types
+ *******************************************************************************/
+
+/** @brief Link write operation (normal or polled) */
+typedef int (*mux_write_fn_t)(const uint8_t *data, size_t len);
+
+/** @brief Channel state */
+typedef struct
+{
+    uint8_t  *buf;              /**< Ring buffer (slice of s_pool) */
+    size_t    size;             /**< Ring size (budget) */
+    size_t    head;             /**< Offset of the oldest byte */
+    size_t    len;              /**< Bytes queued */
+    size_t    peak;
+    uint32_t  deficit;          /**< DRR credit in bytes */
+    uint8_t   credited;         /**< Credit given for the current visit */
+    uint8_t   seq;              /**< Next frame counter */
+    uint32_t  sent_bytes;
+    uint32_t  dropped_writes;
+    uint32_t  dropped_bytes;
+    uint32_t  dropped_told;     /**< dropped_writes last sent to the host */
+} mux_channel_t;
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int  mux_init(void);
+static int  mux_deinit(void);
+static int  mux_write(const uint8_t *data, size_t len);
+static int  mux_write_polled(const uint8_t *data, size_t len);
+static int  mux_flush(void);
+static int  mux_service(void);
+static int  mux_is_ready(void);
+static int  mux_read(uint8_t *data, size_t len);
+static int  mux_fill(void);
+static int  mux_queue(uint8_t channel, const uint8_t *data, size_t len);
+static int  mux_next_frame(void);
+static int  mux_pump(mux_write_fn_t writer);
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Multiplexer transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_MUX =
+{
+    .init         = mux_init,
+    .deinit       = mux_deinit,
+    .write        = mux_write,
+    .is_ready     = mux_is_ready,
+    .write_polled = mux_write_polled,
+    .flush        = mux_flush,
+    .service      = mux_service,
+    .read         = mux_read,
+    .fill         = mux_fill,
+};
+
+/** @brief Link the channels are carried over */
+static const debug_transport_ops_t *s_link = NULL;
+
+/** @brief Link init result (1 = usable) */
+static uint8_t s_link_up = 0;
+
+/** @brief Channel settings from debug_transport_mux_set_channel() */
+static uint16_t s_weight[DEBUG_MUX_CHANNELS];
+static size_t   s_budget[DEBUG_MUX_CHANNELS];
+static uint8_t  s_configured = 0;
+
+/** @brief Channel buffers */
+static uint8_t       s_pool[DEBUG_MUX_POOL_SIZE];
+static mux_channel_t s_ch[DEBUG_MUX_CHANNELS];
+
+/** @brief Scheduler position */
+static size_t s_rr = 0;
+
+/** @brief Frame being sent, and how much of it the link has taken */
+static uint8_t s_frame[MUX_FRAME_SIZE];
+static size_t  s_frame_len = 0;
+static size_t  s_frame_off = 0;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the link and share out the channel buffers.
+ *
+ * @retval 0   Multiplexer ready.
+ * @retval -1  No link, link init failed or budgets exceed the pool.
+ */
+static int mux_init(void)
+{
+    if (NULL == s_link)
+    {
+#if DEBUG_USE_TRANSPORT_FAILOVER
+        s_link = debug_transport_failover_ops();
+#elif DEBUG_USE_USB_CDC
+        s_link = debug_transport_usb_cdc_ops();
+#elif DEBUG_USE_UART
+    #if DEBUG_VENDOR_STM32
+        s_link = debug_transport_uart_st_ops();
+    #elif DEBUG_VENDOR_NXP
+        s_link = debug_transport_uart_nxp_ops();
+    #elif DEBUG_VENDOR_TI
+        s_link = debug_transport_uart_ti_ops();
+    #endif
+#elif DEBUG_USE_RAM_BUFFER
+        s_link = debug_transport_ram_ops();
+#elif DEBUG_USE_STDIO
+        s_link = debug_transport_stdio_ops();
+#elif DEBUG_USE_FLASH
+        s_link = debug_transport_flash_ops();
+#elif DEBUG_USE_FILE
+        s_link = debug_transport_file_ops();
+#endif
+    }
+
+    if ((NULL == s_link) || (NULL == s_link->write))
+    {
+        return -1;
+    }
+
+    size_t used = 0;
+
+    for (size_t i = 0; i < DEBUG_MUX_CHANNELS; i++)
+    {
+        mux_channel_t *ch = &s_ch[i];
+
+        memset(ch, 0, sizeof(*ch));
+        ch->size = (0U != s_configured) ? s_budget[i] :
+                                          (DEBUG_MUX_POOL_SIZE / DEBUG_MUX_CHANNELS);
+        if ((used + ch->size) > sizeof(s_pool))
+        {
+            return -1;
+        }
+        ch->buf = &s_pool[used];
+        used   += ch->size;
+    }
+
+    s_rr        = 0;
+    s_frame_len = 0;
+    s_frame_off = 0;
+    s_link_up   = 0;
+
+    if ((NULL != s_link->init) && (0 != s_link->init()))
+    {
+        return -1;
+    }
+
+    s_link_up = 1;
+    return 0;
+}/* End of mux_init() */
+
+/**
+ * @brief Deinitialize the link. Queued data is discarded.
+ *
+ * @retval 0  Deinitialization successful.
+ */
+static int mux_deinit(void)
+{
+    if ((0U != s_link_up) && (NULL != s_link->deinit))
+    {
+        (void)s_link->deinit();
+    }
+    s_link_up = 0;
+
+    return 0;
+}/* End of mux_deinit() */
+
+/**
+ * @brief Queue a whole write on a channel, or drop it whole.
+ *
+ * @retval >=0  Number of bytes queued.
+ * @retval -1   Dropped.
+ */
+static int mux_queue(uint8_t channel, const uint8_t *data, size_t len)
+{
+    if ((channel >= DEBUG_MUX_CHANNELS) || (NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    mux_channel_t *ch = &s_ch[channel];
+
+    if (len > (ch->size - ch->len))
+    {
+        ch->dropped_writes++;
+        ch->dropped_bytes += (uint32_t)len;
+        return -1;
+    }
+
+    size_t tail  = (ch->head + ch->len) % ch->size;
+    size_t first = ch->size - tail;
+
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(&ch->buf[tail], data, first);
+    memcpy(ch->buf, &data[first], len - first);
+
+    ch->len += len;
+    if (ch->len > ch->peak)
+    {
+        ch->peak = ch->len;
+    }
+
+    return (int)len;
+}/* End of mux_queue() */
+
+/**
+ * @brief Build the next frame by deficit round-robin.
+ *
+ * @retval 0   A frame is ready in s_frame.
+ * @retval -1  Nothing queued.
+ */
+static int mux_next_frame(void)
+{
+    /* Any channel with data is served within one round plus one step */
+    for (size_t step = 0; step <= DEBUG_MUX_CHANNELS; step++)
+    {
+        mux_channel_t *ch = &s_ch[s_rr];
+
+        if (0U == ch->len)
+        {
+            ch->deficit  = 0;
+            ch->credited = 0;
+            s_rr = (s_rr + 1U) % DEBUG_MUX_CHANNELS;
+            continue;
+        }
+
+        if (0U == ch->credited)
+        {
+            uint16_t weight = (0U != s_configured) ? s_weight[s_rr] : 1U;
+
+            ch->deficit += (uint32_t)weight * DEBUG_MUX_FRAME_MAX;
+            ch->credited = 1;
+        }
+
+        size_t n = (ch->len < DEBUG_MUX_FRAME_MAX) ? ch->len : DEBUG_MUX_FRAME_MAX;
+
+        if (ch->deficit < n)
+        {
+            /* Credit used up for this round; keep the rest for the next */
+            ch->credited = 0;
+            s_rr = (s_rr + 1U) % DEBUG_MUX_CHANNELS;
+            continue;
+        }
+
+        debug_mux_record_t hdr = { .channel = (uint8_t)s_rr, .seq = ch->seq++ };
+        size_t             pos = DEBUG_RECORD_HEADER_SIZE + sizeof(hdr);
+
+        if (ch->dropped_writes != ch->dropped_told)
+        {
+            hdr.channel |= DEBUG_MUX_FLAG_DROPPED;
+            memcpy(&s_frame[pos], &ch->dropped_writes, sizeof(uint32_t));
+            pos += sizeof(uint32_t);
+            ch->dropped_told = ch->dropped_writes;
+        }
+        memcpy(&s_frame[DEBUG_RECORD_HEADER_SIZE], &hdr, sizeof(hdr));
+
+        size_t first = ch->size - ch->head;
+
+        if (first > n)
+        {
+            first = n;
+        }
+        memcpy(&s_frame[pos], &ch->buf[ch->head], first);
+        memcpy(&s_frame[pos + first], ch->buf, n - first);
+        pos += n;
+
+        ch->head        = (ch->head + n) % ch->size;
+        ch->len        -= n;
+        ch->deficit    -= (uint32_t)n;
+        ch->sent_bytes += (uint32_t)n;
+
+        size_t payload = pos - DEBUG_RECORD_HEADER_SIZE;
+
+        s_frame[0] = DEBUG_RECORD_MARKER;
+        s_frame[1] = DEBUG_RECORD_MUX;
+        s_frame[2] = (uint8_t)(payload & 0xFFU);
+        s_frame[3] = (uint8_t)(payload >> 8);
+        s_frame[pos] = debug_record_crc8(0, &s_frame[1], pos - 1U);
+
+        s_frame_len = pos + DEBUG_RECORD_TRAILER_SIZE;
+        s_frame_off = 0;
+        return 0;
+    }
+
+    return -1;
+}/* End of mux_next_frame() */
+
+/**
+ * @brief Send frames until the queues are empty or the link is full.
+ *
+ * @param[in] writer Link write operation.
+ *
+ * @return Number of frames completed.
+ */
+static int mux_pump(mux_write_fn_t writer)
+{
+    int frames = 0;
+
+    if (NULL == writer)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        if (s_frame_off < s_frame_len)
+        {
+            int n = writer(&s_frame[s_frame_off], s_frame_len - s_frame_off);
+
+            if (n <= 0)
+            {
+                break;          /* Link busy or down; retry later */
+            }
+            s_frame_off += (size_t)n;
+            if (s_frame_off < s_frame_len)
+            {
+                break;          /* Link took part of the frame */
+            }
+            frames++;
+        }
+
+        if (0 != mux_next_frame())
+        {
+            break;
+        }
+    }
+
+    return frames;
+}/* End of mux_pump() */
+
+/**
+ * @brief Queue debug core output on DEBUG_MUX_CH_LOG.
+ *
+ * @retval >=0  Number of bytes queued.
+ * @retval -1   Dropped (buffer full).
+ */
+static int mux_write(const uint8_t *data, size_t len)
+{
+    if (0U == s_link_up)
+    {
+        return -1;
+    }
+
+    int ret = mux_queue(DEBUG_MUX_CH_LOG, data, len);
+
+    (void)mux_pump(s_link->write);
+
+    return ret;
+}/* End of mux_write() */
+
+/**
+ * @brief Queue debug core output and drain every channel, polled.
+ *
+ * @retval >=0  Number of bytes queued.
+ * @retval -1   Dropped (buffer full and the link would not drain).
+ */
+static int mux_write_polled(const uint8_t *data, size_t len)
+{
+    if (0U == s_link_up)
+    {
+        return -1;
+    }
+
+    const mux_channel_t *ch     = &s_ch[DEBUG_MUX_CH_LOG];
+    mux_write_fn_t       writer = (NULL != s_link->write_polled) ?
+                                  s_link->write_polled : s_link->write;
+
+    /* Nothing drains the queues behind us in panic mode: make room first */
+    if (len > (ch->size - ch->len))
+    {
+        (void)mux_pump(writer);
+    }
+
+    int ret = mux_queue(DEBUG_MUX_CH_LOG, data, len);
+
+    (void)mux_pump(writer);
+
+    return ret;
+}/* End of mux_write_polled() */
+
+/**
+ * @brief Push every queued frame to the link, polled where available.
+ *
+ * @retval 0   Queues drained.
+ * @retval -1  The link stopped taking data.
+ */
+static int mux_flush(void)
+{
+    if (0U == s_link_up)
+    {
+        return -1;
+    }
+
+    mux_write_fn_t writer = (NULL != s_link->write_polled) ?
+                            s_link->write_polled : s_link->write;
+
+    (void)mux_pump(writer);
+
+    for (size_t i = 0; i < DEBUG_MUX_CHANNELS; i++)
+    {
+        if (0U != s_ch[i].len)
+        {
+            return -1;
+        }
+    }
+
+    if ((s_frame_off < s_frame_len) ||
+        ((NULL != s_link->flush) && (0 != s_link->flush())))
+    {
+        return -1;
+    }
+
+    return 0;
+}/* End of mux_flush() */
+
+/**
+ * @brief Push queued frames and run the link's background work.
+ *
+ * @retval >0  Frames sent or link work done.
+ * @retval 0   Nothing to do.
+ * @retval <0  The link reported an error.
+ */
+static int mux_service(void)
+{
+    if (0U == s_link_up)
+    {
+        return 0;
+    }
+
+    int ret = mux_pump(s_link->write);
+
+    if (NULL != s_link->service)
+    {
+        int rc = s_link->service();
+
+        ret = (rc < 0) ? rc : (ret + rc);
+    }
+
+    return ret;
+}/* End of mux_service() */
+
+/**
+ * @brief Report whether the link is ready.
+ */
+static int mux_is_ready(void)
+{
+    if (0U == s_link_up)
+    {
+        return 0;
+    }
+
+    return (NULL != s_link->is_ready) ? s_link->is_ready() : 1;
+}/* End of mux_is_ready() */
+
+/**
+ * @brief Read host data from the link (not multiplexed).
+ */
+static int mux_read(uint8_t *data, size_t len)
+{
+    if ((0U == s_link_up) || (NULL == s_link->read))
+    {
+        return 0;
+    }
+
+    return s_link->read(data, len);
+}/* End of mux_read() */
+
+/**
+ * @brief Report the backlog of the log channel.
+ *
+ * @return 0..100: the higher of the log channel's buffer fill and the
+ *         link's own backlog.
+ */
+static int mux_fill(void)
+{
+    const mux_channel_t *ch   = &s_ch[DEBUG_MUX_CH_LOG];
+    int                  fill = (0U != ch->size) ? (int)((ch->len * 100U) / ch->size) :
+                                                   100;
+
+    if ((0U != s_link_up) && (NULL != s_link->fill))
+    {
+        int link = s_link->fill();
+
+        if (link > fill)
+        {
+            fill = link;
+        }
+    }
+
+    return fill;
+}/* End of mux_fill() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get channel multiplexer debug transport operations.
+ *
+ * @return Pointer to the multiplexer transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_mux_ops(void)
+{
+    return &DEBUG_TRANSPORT_MUX;
+}/* End of debug_transport_mux_ops() */
+
+/**
+ * @brief Override the link the channels are carried over.
+ */
+int debug_transport_mux_set_link(const debug_transport_ops_t *link)
+{
+    if ((NULL == link) || (NULL == link->write) || (link == &DEBUG_TRANSPORT_MUX))
+    {
+        return -1;
+    }
+
+    s_link = link;
+    return 0;
+}/* End of debug_transport_mux_set_link() */
+
+/**
+ * @brief Set the scheduling weight and buffer budget of a channel.
+ */
+int debug_transport_mux_set_channel(uint8_t channel, uint16_t weight,
+                                    size_t budget)
+{
+    if ((channel >= DEBUG_MUX_CHANNELS) || (0U == weight) ||
+        (budget > DEBUG_MUX_POOL_SIZE))
+    {
+        return -1;
+    }
+
+    if (0U == s_configured)
+    {
+        for (size_t i = 0; i < DEBUG_MUX_CHANNELS; i++)
+        {
+            s_weight[i] = 1U;
+            s_budget[i] = DEBUG_MUX_POOL_SIZE / DEBUG_MUX_CHANNELS;
+        }
+        s_configured = 1;
+    }
+
+    s_weight[channel] = weight;
+    s_budget[channel] = budget;
+    return 0;
+}/* End of debug_transport_mux_set_channel() */
+
+/**
+ * @brief Queue data on a channel and push frames to the link.
+ */
+int debug_transport_mux_write(uint8_t channel, const void *data, size_t len)
+{
+    if (0U == s_link_up)
+    {
+        return -1;
+    }
+
+    debug_lock_acquire();
+    int ret = mux_queue(channel, (const uint8_t *)data, len);
+    (void)mux_pump(s_link->write);
+    debug_lock_release();
+
+    return ret;
+}/* End of debug_transport_mux_write() */
+
+/**
+ * @brief Read the counters of a channel.
+ */
+int debug_transport_mux_stats(uint8_t channel, debug_mux_stats_t *stats)
+{
+    if ((channel >= DEBUG_MUX_CHANNELS) || (NULL == stats))
+    {
+        return -1;
+    }
+
+    debug_lock_acquire();
+    const mux_channel_t *ch = &s_ch[channel];
+
+    stats->budget         = ch->size;
+    stats->queued         = ch->len;
+    stats->peak           = ch->peak;
+    stats->sent_bytes     = ch->sent_bytes;
+    stats->dropped_writes = ch->dropped_writes;
+    stats->dropped_bytes  = ch->dropped_bytes;
+    debug_lock_release();
+
+    return 0;
+}/* End of debug_transport_mux_stats() */
+
+#endif /* DEBUG_USE_TRANSPORT_MUX */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,168 @@
+/**
+ * @file      debug_transport_mux.h
+ * @brief     Channel multiplexer debug transport interface
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a composite debug transport that carries several
+ * independent byte streams (channels) over one physical link, for example
+ * text logs, binary telemetry, trace events and command responses over a
+ * single UART or USB CDC port.
+ *
+ * Every write is queued whole in its channel's buffer, or dropped whole
+ * and counted when the buffer is full, so one channel can never corrupt
+ * or block another. The buffers are drained to the link in frames of at
+ * most DEBUG_MUX_FRAME_MAX bytes; a deficit round-robin scheduler shares
+ * the link between channels in proportion to their weights. Each frame
+ * is a DEBUG_RECORD_MUX record carrying the channel ID, a per-channel
+ * frame counter and, after a drop, the channel's drop count.
+ *
+ * The debug core writes to DEBUG_MUX_CH_LOG through the normal transport
+ * operations; other producers call debug_transport_mux_write(). The host
+ * tool tools/debug_demux splits the stream back into one file or socket
+ * per channel.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_MUX_H
+#define DEBUG_TRANSPORT_MUX_H
+
+#include "config.h"
+
+#if DEBUG_USE_TRANSPORT_MUX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+
+/*******************************************************************************
+ * Public Types
+ *******************************************************************************/
+
+/**
+ * @brief Channel IDs.
+ *
+ * Only DEBUG_MUX_CH_LOG has a fixed meaning (debug core output); the
+ * others are conventions shared with tools/debug_demux.
+ */
+typedef enum
+{
+    DEBUG_MUX_CH_LOG = 0,       /*!< Debug core: text lines and records */
+    DEBUG_MUX_CH_TELEMETRY,     /*!< Binary telemetry */
+    DEBUG_MUX_CH_TRACE,         /*!< Trace events */
+    DEBUG_MUX_CH_COMMAND,       /*!< Command responses */
+} debug_mux_channel_t;
+
+/**
+ * @brief Channel counters.
+ */
+typedef struct
+{
+    size_t   budget;            /**< Buffer size in bytes */
+    size_t   queued;            /**< Bytes waiting for the link */
+    size_t   peak;              /**< Highest queued since init */
+    uint32_t sent_bytes;        /**< Bytes handed to the link */
+    uint32_t dropped_writes;    /**< Writes dropped on a full buffer */
+    uint32_t dropped_bytes;     /**< Bytes of those writes */
+} debug_mux_stats_t;
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get channel multiplexer debug transport operations.
+ *
+ * @return Pointer to the multiplexer transport operations table.
+ *
+ * @note
+ * write() queues to DEBUG_MUX_CH_LOG. read() is passed through from the
+ * link unchanged; host-to-device data is not multiplexed.
+ */
+const debug_transport_ops_t *debug_transport_mux_ops(void);
+
+/**
+ * @brief Override the link the channels are carried over.
+ *
+ * @param[in] link Transport operations of the link.
+ *
+ * @retval 0   Link installed.
+ * @retval -1  Invalid parameter.
+ *
+ * @note
+ * Must be called before the multiplexer is initialized. By default the
+ * link is the transport selected in config.h (or the failover chain).
+ */
+int debug_transport_mux_set_link(const debug_transport_ops_t *link);
+
+/**
+ * @brief Set the scheduling weight and buffer budget of a channel.
+ *
+ * @param[in] channel Channel ID (below DEBUG_MUX_CHANNELS).
+ * @param[in] weight  Share of the link relative to the other channels
+ *                    (at least 1).
+ * @param[in] budget  Buffer size in bytes; 0 disables the channel.
+ *
+ * @retval 0   Settings stored.
+ * @retval -1  Invalid parameters.
+ *
+ * @note
+ * Must be called before the multiplexer is initialized. By default all
+ * channels have weight 1 and an equal share of DEBUG_MUX_POOL_SIZE. The
+ * budgets of all channels must fit in DEBUG_MUX_POOL_SIZE; init fails
+ * otherwise.
+ */
+int debug_transport_mux_set_channel(uint8_t channel, uint16_t weight,
+                                    size_t budget);
+
+/**
+ * @brief Queue data on a channel and push frames to the link.
+ *
+ * @param[in] channel Channel ID.
+ * @param[in] data    Pointer to data buffer.
+ * @param[in] len     Number of bytes.
+ *
+ * @retval >=0  Number of bytes queued (all of them).
+ * @retval -1   Dropped: buffer full, channel disabled or invalid
+ *              parameters.
+ *
+ * @note
+ * Takes the debug lock, so it is serialized with the debug core's own
+ * output. Not for ISRs.
+ */
+int debug_transport_mux_write(uint8_t channel, const void *data, size_t len);
+
+/**
+ * @brief Read the counters of a channel.
+ *
+ * @param[in]  channel Channel ID.
+ * @param[out] stats   Counters.
+ *
+ * @retval 0   Counters copied.
+ * @retval -1  Invalid parameters.
+ */
+int debug_transport_mux_stats(uint8_t channel, debug_mux_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_TRANSPORT_MUX */
+#endif /* DEBUG_TRANSPORT_MUX_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,281 @@
+/**
+ * @file      debug_transport_ram.c
+ * @brief     RAM ring buffer debug transport implementation
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This module implements a debug transport that keeps the most recent
+ * DEBUG_RAM_BUFFER_SIZE bytes of log output in a static ring buffer.
+ *
+ * The write operation never fails and never blocks, which makes it a
+ * safe fallback when all physical links are unavailable. Oldest data is
+ * overwritten when the ring is full.
+ *
+ * Synchronization is provided by the debug core, which serializes all
+ * transport writes through the port lock.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include "config.h"
+
+#if DEBUG_USE_RAM_BUFFER
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <string.h>
+
+#include "debug_transport_ram.h"
+#include "debug_transport.h"
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int ram_init(void);
+static int ram_deinit(void);
+static int ram_write(const uint8_t *data, size_t len);
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief RAM transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_RAM =
+{
+    .init         = ram_init,
+    .deinit       = ram_deinit,
+    .write        = ram_write,
+    .is_ready     = NULL,          /* Always ready */
+    .write_polled = ram_write,     /* Never blocks, safe in panic mode */
+};
+
+/** @brief Ring storage */
+static uint8_t s_ring[DEBUG_RAM_BUFFER_SIZE];
+
+/** @brief Index of the next byte to write */
+static size_t s_head = 0;
+
+/** @brief Index of the oldest buffered byte */
+static size_t s_tail = 0;
+
+/** @brief Number of buffered bytes */
+static size_t s_count = 0;
+
+/** @brief Bytes lost to overwrites */
+static uint32_t s_overwritten = 0;
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the RAM debug transport.
+ *
+ * @retval 0  Initialization successful.
+ *
+ * @note
+ * Contents are cleared so that stale data from a previous session is
+ * not replayed.
+ */
+static int ram_init(void)
+{
+    s_head        = 0;
+    s_tail        = 0;
+    s_count       = 0;
+    s_overwritten = 0;
+
+    return 0;
+}/* End of ram_init() */
+
+/**
+ * @brief Deinitialize the RAM debug transport.
+ *
+ * @retval 0  Deinitialization successful.
+ *
+ * @note
+ * Buffered data is kept so it can still be drained or inspected.
+ */
+static int ram_deinit(void)
+{
+    return 0;
+}/* End of ram_deinit() */
+
+/**
+ * @brief Append debug data to the RAM ring.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to store.
+ *
+ * @retval >=0  Number of bytes accepted (always @p len).
+ * @retval -1   Invalid parameters.
+ *
+ * @note
+ * If @p len exceeds the ring size, only the trailing part is kept.
+ */
+static int ram_write(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    size_t skip = 0;
+
+    if (len > sizeof(s_ring))
+    {
+        skip = len - sizeof(s_ring);
+        s_overwritten += (uint32_t)skip;
+    }
+
+    size_t remaining = len - skip;
+    const uint8_t *src = &data[skip];
+
+    /* Drop oldest bytes to make room */
+    size_t free_space = sizeof(s_ring) - s_count;
+    if (remaining > free_space)
+    {
+        size_t drop = remaining - free_space;
+        s_tail = (s_tail + drop) % sizeof(s_ring);
+        s_count -= drop;
+        s_overwritten += (uint32_t)drop;
+    }
+
+    while (remaining > 0U)
+    {
+        size_t chunk = sizeof(s_ring) - s_head;
+        if (chunk > remaining)
+        {
+            chunk = remaining;
+        }
+
+        memcpy(&s_ring[s_head], src, chunk);
+        s_head = (s_head + chunk) % sizeof(s_ring);
+        s_count += chunk;
+        src += chunk;
+        remaining -= chunk;
+    }
+
+    return (int)len;
+}/* End of ram_write() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get RAM ring buffer debug transport operations.
+ *
+ * @return Pointer to the RAM transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_ram_ops(void)
+{
+    return &DEBUG_TRANSPORT_RAM;
+}/* End of debug_transport_ram_ops() */
+
+/**
+ * @brief Copy buffered data from the RAM ring without consuming it.
+ *
+ * @param[out] buf Destination buffer.
+ * @param[in]  len Size of the destination buffer in bytes.
+ *
+ * @return Number of bytes copied.
+ */
+size_t debug_transport_ram_peek(uint8_t *buf, size_t len)
+{
+    if (NULL == buf)
+    {
+        return 0;
+    }
+
+    size_t copied = 0;
+    size_t pos    = s_tail;
+    size_t avail  = s_count;
+
+    while ((copied < len) && (avail > 0U))
+    {
+        size_t chunk = sizeof(s_ring) - pos;
+        if (chunk > avail)
+        {
+            chunk = avail;
+        }
+        if (chunk > (len - copied))
+        {
+            chunk = len - copied;
+        }
+
+        memcpy(&buf[copied], &s_ring[pos], chunk);
+        pos = (pos + chunk) % sizeof(s_ring);
+        avail -= chunk;
+        copied += chunk;
+    }
+
+    return copied;
+}/* End of debug_transport_ram_peek() */
+
+/**
+ * @brief Discard the oldest bytes from the RAM ring.
+ *
+ * @param[in] len Number of bytes to discard.
+ */
+void debug_transport_ram_consume(size_t len)
+{
+    if (len > s_count)
+    {
+        len = s_count;
+    }
+
+    s_tail = (s_tail + len) % sizeof(s_ring);
+    s_count -= len;
+}/* End of debug_transport_ram_consume() */
+
+/**
+ * @brief Read and consume buffered data from the RAM ring.
+ *
+ * @param[out] buf Destination buffer.
+ * @param[in]  len Size of the destination buffer in bytes.
+ *
+ * @return Number of bytes copied.
+ */
+size_t debug_transport_ram_read(uint8_t *buf, size_t len)
+{
+    size_t copied = debug_transport_ram_peek(buf, len);
+
+    debug_transport_ram_consume(copied);
+
+    return copied;
+}/* End of debug_transport_ram_read() */
+
+/**
+ * @brief Get the number of bytes currently held in the RAM ring.
+ *
+ * @return Number of buffered bytes.
+ */
+size_t debug_transport_ram_count(void)
+{
+    return s_count;
+}/* End of debug_transport_ram_count() */
+
+/**
+ * @brief Get the number of bytes lost to ring overwrites since init.
+ *
+ * @return Number of overwritten bytes.
+ */
+uint32_t debug_transport_ram_overwritten(void)
+{
+    return s_overwritten;
+}/* End of debug_transport_ram_overwritten() */
+
+#endif /* DEBUG_USE_RAM_BUFFER */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,113 @@
+/**
+ * @file      debug_transport_ram.h
+ * @brief     RAM ring buffer debug transport interface
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a RAM-backed debug transport that stores log data
+ * in a fixed-size ring buffer instead of sending it over a physical link.
+ *
+ * It is intended as the last link of a failover chain (see
+ * debug_transport_failover.h): when every physical link is down, records
+ * are kept in RAM and can be drained later, either to a recovered link or
+ * by a debugger reading the buffer directly.
+ *
+ * When the ring is full the oldest bytes are overwritten, so the buffer
+ * always holds the most recent output.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_RAM_H
+#define DEBUG_TRANSPORT_RAM_H
+
+#include "config.h"
+
+#if DEBUG_USE_RAM_BUFFER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get RAM ring buffer debug transport operations.
+ *
+ * @return Pointer to the RAM transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_ram_ops(void);
+
+/**
+ * @brief Copy buffered data from the RAM ring without consuming it.
+ *
+ * @param[out] buf Destination buffer.
+ * @param[in]  len Size of the destination buffer in bytes.
+ *
+ * @return Number of bytes copied (0 if the ring is empty).
+ *
+ * @note
+ * Data is returned oldest first. Use debug_transport_ram_consume() once
+ * the copied bytes have been delivered elsewhere.
+ */
+size_t debug_transport_ram_peek(uint8_t *buf, size_t len);
+
+/**
+ * @brief Discard the oldest bytes from the RAM ring.
+ *
+ * @param[in] len Number of bytes to discard (clamped to the buffered count).
+ */
+void debug_transport_ram_consume(size_t len);
+
+/**
+ * @brief Read and consume buffered data from the RAM ring.
+ *
+ * @param[out] buf Destination buffer.
+ * @param[in]  len Size of the destination buffer in bytes.
+ *
+ * @return Number of bytes copied (0 if the ring is empty).
+ *
+ * @note
+ * Data is returned oldest first. Must be called with the debug lock held
+ * or from a context that cannot race with writers.
+ */
+size_t debug_transport_ram_read(uint8_t *buf, size_t len);
+
+/**
+ * @brief Get the number of bytes currently held in the RAM ring.
+ *
+ * @return Number of buffered bytes.
+ */
+size_t debug_transport_ram_count(void);
+
+/**
+ * @brief Get the number of bytes lost to ring overwrites since init.
+ *
+ * @return Number of overwritten bytes.
+ */
+uint32_t debug_transport_ram_overwritten(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_RAM_BUFFER */
+#endif /* DEBUG_TRANSPORT_RAM_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
@@ -0,0 +1,171 @@
+/**
+ * @file      debug_transport_stdio.c
+ * @brief     Standard output debug transport implementation (host)
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This module implements a debug transport that writes each record to
+ * STDOUT_FILENO with write(2), retrying on partial writes and EINTR.
+ * Host requests (clock sync pings) are read from STDIN_FILENO without
+ * blocking.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#include "config.h"
+
+#if DEBUG_USE_STDIO
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "debug_transport_stdio.h"
+#include "debug_transport.h"
+
+/*******************************************************************************
+ * Private Function Prototypes (Static)
+ *******************************************************************************/
+static int stdio_init(void);
+static int stdio_deinit(void);
+static int stdio_write(const uint8_t *data, size_t len);
+static int stdio_read(uint8_t *data, size_t len);
+
+/*******************************************************************************
+ * Private Variables (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Stdio transport operations table
+ */
+static const debug_transport_ops_t DEBUG_TRANSPORT_STDIO =
+{
+    .init         = stdio_init,
+    .deinit       = stdio_deinit,
+    .write        = stdio_write,
+    .write_polled = stdio_write,
+    .read         = stdio_read,
+};
+
+/*******************************************************************************
+ * Private Function Definitions (Static)
+ *******************************************************************************/
+
+/**
+ * @brief Initialize the stdio debug transport.
+ *
+ * @retval 0  Initialization successful.
+ */
+static int stdio_init(void)
+{
+    return 0;
+}/* End of stdio_init() */
+
+/**
+ * @brief Deinitialize the stdio debug transport.
+ *
+ * @retval 0  Deinitialization successful.
+ */
+static int stdio_deinit(void)
+{
+    return 0;
+}/* End of stdio_deinit() */
+
+/**
+ * @brief Write debug data to standard output.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to write.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   Write failed or invalid parameters.
+ */
+static int stdio_write(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    size_t done = 0;
+
+    while (done < len)
+    {
+        ssize_t n = write(STDOUT_FILENO, &data[done], len - done);
+
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return -1;
+        }
+        done += (size_t)n;
+    }
+
+    return (int)len;
+}/* End of stdio_write() */
+
+/**
+ * @brief Read pending host data from standard input.
+ *
+ * @param[out] data Destination buffer.
+ * @param[in]  len  Buffer size.
+ *
+ * @retval >0  Number of bytes read.
+ * @retval 0   Nothing pending.
+ * @retval -1  Read failed, end of input or invalid parameters.
+ */
+static int stdio_read(uint8_t *data, size_t len)
+{
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+
+    if ((NULL == data) || (0U == len))
+    {
+        return -1;
+    }
+
+    if (poll(&pfd, 1, 0) <= 0)
+    {
+        return 0;
+    }
+
+    ssize_t n = read(STDIN_FILENO, data, len);
+
+    if ((n < 0) && (EINTR == errno))
+    {
+        return 0;
+    }
+
+    return (n > 0) ? (int)n : -1;
+}/* End of stdio_read() */
+
+/*******************************************************************************
+ * Public Function Definitions
+ *******************************************************************************/
+
+/**
+ * @brief Get standard output debug transport operations.
+ *
+ * @return Pointer to the stdio transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_stdio_ops(void)
+{
+    return &DEBUG_TRANSPORT_STDIO;
+}/* End of debug_transport_stdio_ops() */
+
+#endif /* DEBUG_USE_STDIO */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
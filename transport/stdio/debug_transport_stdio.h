@@ -0,0 +1,57 @@
+/**
+ * @file      debug_transport_stdio.h
+ * @brief     Standard output debug transport interface (host)
+ * @version   1.0.0
+ * @date      2026-10-17
+ * @author    Sarath S
+ *
+ * @details
+ * This header declares a debug transport that writes to the standard
+ * output file descriptor. It is meant for host simulation builds together
+ * with the POSIX port, and is the host counterpart of the UART transport.
+ *
+ * @par Contact
+ * elektronikaembedded@gmail.com
+ *
+ * @par Website
+ * https://elektronikaembedded.wordpress.com
+ */
+
+#ifndef DEBUG_TRANSPORT_STDIO_H
+#define DEBUG_TRANSPORT_STDIO_H
+
+#include "config.h"
+
+#if DEBUG_USE_STDIO
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "common.h"
+#include "debug_transport.h"   /**< Required for debug_transport_ops_t */
+
+/*******************************************************************************
+ * Public Functions
+ *******************************************************************************/
+
+/**
+ * @brief Get standard output debug transport operations.
+ *
+ * @return Pointer to the stdio transport operations table.
+ */
+const debug_transport_ops_t *debug_transport_stdio_ops(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEBUG_USE_STDIO */
+#endif /* DEBUG_TRANSPORT_STDIO_H */
+
+/*******************************************************************************
+ * End of file
+ *******************************************************************************/
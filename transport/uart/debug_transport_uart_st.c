@@ -15,6 +15,10 @@
  * The UART peripheral is expected to be initialized externally
  * (e.g., via HAL_UART_Init or STM32CubeMX configuration).
  *
+ * A register-level polled write is provided for panic mode. It does not
+ * depend on HAL timeouts (SysTick) or interrupts, and every wait is
+ * bounded by DEBUG_PANIC_SPIN_LIMIT.
+ *
  * @par Contact
  * elektronikaembedded@gmail.com
  *
@@ -39,6 +43,9 @@
 static int uart_init(void);
 static int uart_deinit(void);
 static int uart_write(const uint8_t *data, size_t len);
+static int uart_write_polled(const uint8_t *data, size_t len);
+static int uart_read(uint8_t *data, size_t len);
+static int uart_wait_flag(USART_TypeDef *uart, uint32_t flag);
 
 /*******************************************************************************
  * Private Variables (Static)
@@ -49,11 +56,16 @@ static int uart_write(const uint8_t *data, size_t len);
  */
 static const debug_transport_ops_t DEBUG_TRANSPORT_UART =
 {
-    .init   = uart_init,
-    .deinit = uart_deinit,
-    .write  = uart_write,
+    .init         = uart_init,
+    .deinit       = uart_deinit,
+    .write        = uart_write,
+    .write_polled = uart_write_polled,
+    .read         = uart_read,
 };
 
+/** @brief Debug UART handle (defined and initialized by the application) */
+extern UART_HandleTypeDef huart_debug;
+
 /*******************************************************************************
  * Private Function Definitions (Static)
  *******************************************************************************/
@@ -108,8 +120,6 @@ static int uart_write(const uint8_t *data, size_t len)
         return -1;
     }
 
-    extern UART_HandleTypeDef huart_debug;
-
     if (HAL_OK == HAL_UART_Transmit(&huart_debug,
                                    (uint8_t *)data,
                                    len,
@@ -121,6 +131,101 @@ static int uart_write(const uint8_t *data, size_t len)
     return -1;
 }/* End of uart_write() */
 
+/**
+ * @brief Busy-wait until a UART status flag is set.
+ *
+ * @param[in] uart UART register block.
+ * @param[in] flag Status register flag mask (USART_SR_xxx).
+ *
+ * @retval 0   Flag set.
+ * @retval -1  Spin limit reached.
+ */
+static int uart_wait_flag(USART_TypeDef *uart, uint32_t flag)
+{
+    for (uint32_t spin = 0; spin < DEBUG_PANIC_SPIN_LIMIT; spin++)
+    {
+        if (0U != (uart->SR & flag))
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+}/* End of uart_wait_flag() */
+
+/**
+ * @brief Write debug data over UART by polling the data register.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to transmit.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   Invalid parameters or transmitter stalled.
+ *
+ * @note
+ * Safe with interrupts masked. Uses the SR/DR register layout of
+ * STM32F1/F2/F4; adapt to ISR/TDR for families with the newer USART.
+ */
+static int uart_write_polled(const uint8_t *data, size_t len)
+{
+    USART_TypeDef *uart = huart_debug.Instance;
+
+    if ((NULL == data) || (0U == len) || (NULL == uart))
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if (0 != uart_wait_flag(uart, USART_SR_TXE))
+        {
+            return -1;
+        }
+        uart->DR = data[i];
+    }
+
+    /* Make sure the last byte has left the shift register */
+    if (0 != uart_wait_flag(uart, USART_SR_TC))
+    {
+        return -1;
+    }
+
+    return (int)len;
+}/* End of uart_write_polled() */
+
+/**
+ * @brief Read received bytes from the UART data register.
+ *
+ * @param[out] data Destination buffer.
+ * @param[in]  len  Buffer size.
+ *
+ * @retval >=0  Number of bytes read (0 if nothing is pending).
+ * @retval -1   Invalid parameters.
+ *
+ * @note
+ * Non-blocking; returns as soon as RXNE is clear. Only host requests
+ * (clock sync pings) arrive here, so polling from debug_service() keeps
+ * up at the rates the host tools use. An overrun is cleared by the
+ * SR/DR read sequence.
+ */
+static int uart_read(uint8_t *data, size_t len)
+{
+    USART_TypeDef *uart = huart_debug.Instance;
+    size_t n = 0;
+
+    if ((NULL == data) || (0U == len) || (NULL == uart))
+    {
+        return -1;
+    }
+
+    while ((n < len) && (0U != (uart->SR & (USART_SR_RXNE | USART_SR_ORE))))
+    {
+        data[n++] = (uint8_t)uart->DR;
+    }
+
+    return (int)n;
+}/* End of uart_read() */
+
 /*******************************************************************************
  * Public Function Definitions
  *******************************************************************************/
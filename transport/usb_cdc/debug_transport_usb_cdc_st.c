@@ -15,6 +15,14 @@
  * The USB device stack is expected to be initialized externally by
  * the application.
  *
+ * Outgoing data is copied into a private staging buffer before the
+ * transfer is started, because CDC_Transmit_FS() completes asynchronously
+ * and the caller's buffer is reused for the next record.
+ *
+ * In panic mode (interrupts masked) the polled write services the USB OTG
+ * interrupt handler by hand until the transfer has completed, with every
+ * wait bounded by DEBUG_PANIC_SPIN_LIMIT.
+ *
  * @par Contact
  * elektronikaembedded@gmail.com
  *
@@ -29,10 +37,25 @@
 /*******************************************************************************
  * Includes
  *******************************************************************************/
+#include <string.h>
+
 #include "debug_transport_usb_cdc_st.h"
 #include "debug_transport.h"
 #include "usbd_cdc_if.h"
 #include "usbd_def.h"
+#include "debug_record.h"
+
+/*******************************************************************************
+ * Private Macros
+ *******************************************************************************/
+
+#if (DEBUG_USB_CDC_TX_BUFFER_SIZE) < (DEBUG_BUFFER_SIZE)
+#error "DEBUG_USB_CDC_TX_BUFFER_SIZE must be at least DEBUG_BUFFER_SIZE."
+#endif
+
+#if (DEBUG_USB_CDC_TX_BUFFER_SIZE) < (DEBUG_USB_CDC_TX_FRAME_SIZE)
+#error "DEBUG_USB_CDC_TX_BUFFER_SIZE must hold a full record frame."
+#endif
 
 /*******************************************************************************
  * Private Function Prototypes (Static)
@@ -40,6 +63,9 @@
 static int usb_cdc_init(void);
 static int usb_cdc_deinit(void);
 static int usb_cdc_write(const uint8_t *data, size_t len);
+static int usb_cdc_is_ready(void);
+static int usb_cdc_write_polled(const uint8_t *data, size_t len);
+static int usb_cdc_poll_idle(USBD_CDC_HandleTypeDef *hcdc);
 
 /*******************************************************************************
  * Private Variables (Static)
@@ -50,11 +76,22 @@ static int usb_cdc_write(const uint8_t *data, size_t len);
  */
 static const debug_transport_ops_t DEBUG_TRANSPORT_USB_CDC =
 {
-    .init   = usb_cdc_init,
-    .deinit = usb_cdc_deinit,
-    .write  = usb_cdc_write,
+    .init         = usb_cdc_init,
+    .deinit       = usb_cdc_deinit,
+    .write        = usb_cdc_write,
+    .is_ready     = usb_cdc_is_ready,
+    .write_polled = usb_cdc_write_polled,
 };
 
+/** @brief Staging buffer owned by the in-flight CDC transfer */
+static uint8_t s_tx_buf[DEBUG_USB_CDC_TX_BUFFER_SIZE];
+
+/** @brief USB device handle (generated by STM32CubeMX in usb_device.c) */
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/** @brief USB OTG FS peripheral handle (generated by STM32CubeMX) */
+extern PCD_HandleTypeDef hpcd_USB_OTG_FS;
+
 /*******************************************************************************
  * Private Function Definitions (Static)
  *******************************************************************************/
@@ -98,18 +135,30 @@ static int usb_cdc_deinit(void)
  * @retval -1   Transmission failed or USB busy.
  *
  * @note
- * Returns -1 if the USB CDC interface is busy or if the
+ * Returns -1 if the USB CDC interface is busy, the link is not
+ * configured, the record does not fit the staging buffer or the
  * input parameters are invalid.
  */
 static int usb_cdc_write(const uint8_t *data, size_t len)
 {
-    if ((NULL == data) || (0U == len))
+    if ((NULL == data) || (0U == len) || (len > sizeof(s_tx_buf)))
+    {
+        return -1;
+    }
+
+    USBD_CDC_HandleTypeDef *hcdc =
+        (USBD_CDC_HandleTypeDef *)hUsbDeviceFS.pClassData;
+
+    /* Do not overwrite the staging buffer while a transfer is in flight */
+    if ((0 == usb_cdc_is_ready()) || (NULL == hcdc) || (0U != hcdc->TxState))
     {
         return -1;
     }
 
+    memcpy(s_tx_buf, data, len);
+
     /* CDC_Transmit_FS returns USBD_BUSY if previous transfer is ongoing */
-    if (USBD_OK == CDC_Transmit_FS((uint8_t *)data, len))
+    if (USBD_OK == CDC_Transmit_FS(s_tx_buf, (uint16_t)len))
     {
         return (int)len;
     }
@@ -117,6 +166,87 @@ static int usb_cdc_write(const uint8_t *data, size_t len)
     return -1;
 }/* End of usb_cdc_write() */
 
+/**
+ * @brief Report the USB CDC link state.
+ *
+ * @retval 1  Device is configured by a host (cable plugged, port open).
+ * @retval 0  Link is down or suspended.
+ */
+static int usb_cdc_is_ready(void)
+{
+    return (USBD_STATE_CONFIGURED == hUsbDeviceFS.dev_state) ? 1 : 0;
+}/* End of usb_cdc_is_ready() */
+
+/**
+ * @brief Service the USB interrupt by hand until the CDC IN pipe is idle.
+ *
+ * @param[in] hcdc CDC class handle.
+ *
+ * @retval 0   No transfer in flight.
+ * @retval -1  Spin limit reached (host not polling the endpoint).
+ */
+static int usb_cdc_poll_idle(USBD_CDC_HandleTypeDef *hcdc)
+{
+    for (uint32_t spin = 0; 0U != hcdc->TxState; spin++)
+    {
+        if (spin >= DEBUG_PANIC_SPIN_LIMIT)
+        {
+            return -1;
+        }
+        HAL_PCD_IRQHandler(&hpcd_USB_OTG_FS);
+    }
+
+    return 0;
+}/* End of usb_cdc_poll_idle() */
+
+/**
+ * @brief Write debug data over USB CDC with interrupts masked.
+ *
+ * @param[in] data Pointer to data buffer.
+ * @param[in] len  Number of bytes to transmit.
+ *
+ * @retval >=0  Number of bytes written.
+ * @retval -1   Link down, transfer stalled or invalid parameters.
+ *
+ * @note
+ * Waits for both the previous and the new transfer to complete, so the
+ * staging buffer can be reused as soon as this function returns.
+ */
+static int usb_cdc_write_polled(const uint8_t *data, size_t len)
+{
+    if ((NULL == data) || (0U == len) || (len > sizeof(s_tx_buf)))
+    {
+        return -1;
+    }
+
+    USBD_CDC_HandleTypeDef *hcdc =
+        (USBD_CDC_HandleTypeDef *)hUsbDeviceFS.pClassData;
+
+    if ((0 == usb_cdc_is_ready()) || (NULL == hcdc))
+    {
+        return -1;
+    }
+
+    if (0 != usb_cdc_poll_idle(hcdc))
+    {
+        return -1;
+    }
+
+    memcpy(s_tx_buf, data, len);
+
+    if (USBD_OK != CDC_Transmit_FS(s_tx_buf, (uint16_t)len))
+    {
+        return -1;
+    }
+
+    if (0 != usb_cdc_poll_idle(hcdc))
+    {
+        return -1;
+    }
+
+    return (int)len;
+}/* End of usb_cdc_write_polled() */
+
 /*******************************************************************************
  * Public Function Definitions
  *******************************************************************************/